@@ -37,6 +37,7 @@ this program. If not, see <https://www.gnu.org/licenses/>.
 #include "Preferences.h"
 #include "Random.h"
 #include "RoutePlan.h"
+#include "ScratchArena.h"
 #include "Ship.h"
 #include "ShipEvent.h"
 #include "ShipJumpNavigation.h"
@@ -360,6 +361,14 @@ namespace
   // If a ship's velocity is below this value, the ship is considered stopped.
   constexpr double VELOCITY_ZERO = .001;
 
+  // Ships outside the player's system that are at least this far from where they
+  // are going travel there without being flown.
+  const double MIN_BACKGROUND_TRAVEL = 500.;
+
+  // The most NPC route trees to keep at once. Once there are this many, the least
+  // recently used one is replaced, so that the trees that are in use are kept.
+  const size_t MAX_ROUTE_TREES = 256;
+
   // If two ships are within sqrt(SCATTER_TOO_CLOSE) units of one another, they should scatter apart.
   // If they are within sqrt(SCATTER_TRACK) units of one another, they should keep track of one
   // another in case they become too close.
@@ -368,8 +377,14 @@ namespace
 } // namespace
 
 
-AI::AI(PlayerInfo &player, const List<Ship> &ships, const List<Minable> &minables, const List<Flotsam> &flotsam) :
-  player(player), ships(ships), minables(minables), flotsam(flotsam), routeCache()
+AI::AI(
+    PlayerInfo          &player,
+    const List<Ship>    &ships,
+    const List<Minable> &minables,
+    const List<Flotsam> &flotsam,
+    ScratchArena        &scratch) :
+  player(player), ships(ships), minables(minables), flotsam(flotsam), scratch(scratch), shipIndex(1024u, 64u),
+  routeCache()
 {
   // Allocate a starting amount of hardpoints for ships.
   firingCommands.SetHardpoints(12);
@@ -481,8 +496,8 @@ void AI::UpdateKeys(PlayerInfo &player, const Command &activeCommands)
   const Ship *flagship = player.Flagship();
   if(!flagship || flagship->IsDestroyed()) return;
 
-  escortsUseAmmo   = Preferences::Has("Escorts expend ammo");
-  escortsAreFrugal = Preferences::Has("Escorts use ammo frugally");
+  escortsUseAmmo   = Preferences::Current().Has(Preferences::Flag::ESCORTS_EXPEND_AMMO);
+  escortsAreFrugal = Preferences::Current().Has(Preferences::Flag::ESCORTS_USE_AMMO_FRUGALLY);
 
   if(!autoPilot.Has(Command::STOP) && activeCommands.Has(Command::STOP) &&
      flagship->Velocity().Length() > VELOCITY_ZERO)
@@ -579,6 +594,11 @@ void AI::UpdateEvents(const std::list<ShipEvent> &events)
     const auto &target = event.Target();
     if(!target) continue;
 
+    // Ships that are provoked or boarded, or that have just disabled or destroyed
+    // their target, should reconsider what they are doing.
+    if(event.Type() & (ShipEvent::PROVOKE | ShipEvent::DISABLE | ShipEvent::BOARD)) scheduler.Wake(target.get());
+    if(event.Actor() && (event.Type() & (ShipEvent::DISABLE | ShipEvent::DESTROY))) scheduler.Wake(event.Actor().get());
+
     if(event.Actor())
     {
       actions[event.Actor()][target] |= event.Type();
@@ -625,12 +645,13 @@ void AI::Clean()
   boarders.clear();
   closeBy.clear();
   routeCache.clear();
+  routeTrees.clear();
+  scheduler.Clear();
   // Records for formations flying around lead ships and other objects.
   formations.clear();
   // Records that affect the combat behavior of various governments.
   shipStrength.clear();
-  enemyStrength.clear();
-  allyStrength.clear();
+  strengths.Clear();
 }
 
 
@@ -646,10 +667,10 @@ void AI::ClearOrders()
 void AI::Step(Command &activeCommands)
 {
   // First, figure out the comparative strengths of the present governments.
-  const System                         *playerSystem = player.GetSystem();
-  std::map<const Government *, int64_t> strength;
-  UpdateStrengths(strength, playerSystem);
+  const System *playerSystem = player.GetSystem();
+  UpdateStrengths(playerSystem);
   CacheShipLists();
+  scheduler.Step(ships, Preferences::Current().aiDecisionBudget);
 
   // Update the counts of how long ships have been outside the "invisible fence."
   // If a ship ceases to exist, this also ensures that it will be removed from
@@ -681,15 +702,10 @@ void AI::Step(Command &activeCommands)
   // even if it's minor. This means that things occur slightly off of exactly once per second, but the difference in
   // behavior between the two methods is negligible.
   step = (step + 1) & 63;
-  // Targeting occurs about twice per second, so the target step only goes from 0 to 30.
-  int targetStep = step & 31;
-  int targetTurn = 0;
-  // Scatter recalculations occur about once per second, so it can compare against the full step counter.
-  int       scatterTurn          = 0;
   int       minerCount           = 0;
   const int maxMinerCount        = minables.empty() ? 0 : 9;
-  bool      opportunisticEscorts = !Preferences::Has("Turrets focus fire");
-  bool      fightersRetreat      = Preferences::Has("Damaged fighters retreat");
+  bool      opportunisticEscorts = !Preferences::Current().Has(Preferences::Flag::TURRETS_FOCUS_FIRE);
+  bool      fightersRetreat      = Preferences::Current().Has(Preferences::Flag::DAMAGED_FIGHTERS_RETREAT);
   const int npcMaxMiningTime     = GameData::GetGamerules().NPCMaxMiningTime();
   for(const auto &it : ships)
   {
@@ -697,6 +713,9 @@ void AI::Step(Command &activeCommands)
     if(it->IsDestroyed()) continue;
     // Skip any carried fighters or drones that are somehow in the list.
     if(!it->GetSystem()) continue;
+    // Ships that are traveling outside the player's system have nothing to decide
+    // until they arrive.
+    if(it->IsTravelingInBackground() && it->GetSystem() != player.GetSystem()) continue;
 
     if(it.get() == flagship)
     {
@@ -711,10 +730,13 @@ void AI::Step(Command &activeCommands)
     bool               isPresent       = (it->GetSystem() == playerSystem);
     bool               isStranded      = IsStranded(*it);
     bool               thisIsLaunching = (isPresent && HasDeployments(*it));
+    // Slowly changing decisions, like which ship to target, are only reconsidered
+    // on this ship's strategic turns.
+    const bool isStrategic = scheduler.IsStrategicTurn(*it);
     if(isStranded || it->IsDisabled())
     {
       // Attempt to find a friendly ship to render assistance.
-      if(!it->GetPersonality().IsDerelict()) AskForHelp(*it, isStranded, flagship);
+      if(!it->GetPersonality().IsDerelict()) AskForHelp(*it, isStranded, flagship, isStrategic);
 
       if(it->IsDisabled())
       {
@@ -762,8 +784,9 @@ void AI::Step(Command &activeCommands)
       }
     }
 
-    std::shared_ptr<Ship> parent = it->GetParent();
-    if(parent && parent->IsDestroyed())
+    std::shared_ptr<Ship> parent     = it->GetParent();
+    const bool            lostParent = parent && parent->IsDestroyed();
+    if(lostParent)
     {
       // An NPC that loses its fleet leader should attempt to
       // follow that leader's parent. For most mission NPCs,
@@ -798,10 +821,9 @@ void AI::Step(Command &activeCommands)
     }
     if(isPresent && !personality.IsSwarming())
     {
-      // Each ship only switches targets about twice a second, so that it can
-      // focus on damaging one particular ship.
-      targetTurn = (targetTurn + 1) & 31;
-      if(targetTurn == targetStep || !target || target->IsDestroyed() ||
+      // Each ship only switches targets on its strategic turns, about twice a
+      // second, so that it can focus on damaging one particular ship.
+      if(isStrategic || !target || target->IsDestroyed() ||
          (target->IsDisabled() && (personality.Disables() ||
                                    (!FighterHitHelper::IsValidTarget(target.get()) && !personality.IsVindictive()))) ||
          (target->IsFleeing() && personality.IsMerciful()) || !target->IsTargetable())
@@ -983,7 +1005,7 @@ void AI::Step(Command &activeCommands)
           command |= Command::DEPLOY;
           Deploy(*it, false);
         }
-        DoMining(*it, command);
+        DoMining(*it, command, isStrategic);
         it->SetCommands(command);
         it->SetCommands(firingCommands);
         continue;
@@ -1017,7 +1039,10 @@ void AI::Step(Command &activeCommands)
       bool findNewParent  = it->IsYours() ? !Random::Int(30) : !Random::Int(1800);
       bool parentHasSpace = inParentSystem && parent->BaysFree(it->Attributes().Category());
       if(findNewParent && parentHasSpace && it->IsYours()) parentHasSpace = parent->CanCarry(*it);
-      if(!hasParent || (!inParentSystem && !it->JumpNavigation().JumpFuel()) || (!parentHasSpace && findNewParent))
+      // Ships without a parent look for one on their strategic turns, or right away
+      // if their parent was destroyed this step.
+      if(((isStrategic || lostParent) && (!hasParent || (!inParentSystem && !it->JumpNavigation().JumpFuel()))) ||
+         (!parentHasSpace && findNewParent))
       {
         // Find the possible parents for orphaned fighters and drones.
         auto parentChoices = std::vector<std::shared_ptr<Ship>>{};
@@ -1203,10 +1228,9 @@ void AI::Step(Command &activeCommands)
     }
 
     // Force ships that are overlapping each other to "scatter".
-    // About once per second they check which ships they are close to and might need to scatter away from,
+    // On their strategic turns they check which ships they are close to and might need to scatter away from,
     // as ships that were close to each other recently are likely to still be close to each other now.
-    scatterTurn = (scatterTurn + 1) & 63;
-    DoScatter(*it, command, scatterTurn == step);
+    DoScatter(*it, command, isStrategic);
 
     it->SetCommands(command);
     it->SetCommands(firingCommands);
@@ -1218,18 +1242,10 @@ void AI::SetMousePosition(Point position) { mousePosition = position; }
 
 
 // Get the in-system strength of each government's allies and enemies.
-int64_t AI::AllyStrength(const Government *government) const
-{
-  auto it = allyStrength.find(government);
-  return it == allyStrength.end() ? 0 : it->second;
-}
+int64_t AI::AllyStrength(const Government *government) const { return strengths.Ally(government); }
 
 
-int64_t AI::EnemyStrength(const Government *government) const
-{
-  auto it = enemyStrength.find(government);
-  return it == enemyStrength.end() ? 0 : it->second;
-}
+int64_t AI::EnemyStrength(const Government *government) const { return strengths.Enemy(government); }
 
 
 // Find nearest landing location.
@@ -1318,7 +1334,7 @@ bool AI::CanPursue(const Ship &ship, const Ship &target) const
 
 
 // Check if the ship is being helped, and if not, ask for help.
-void AI::AskForHelp(Ship &ship, bool &isStranded, const Ship *flagship)
+void AI::AskForHelp(Ship &ship, bool &isStranded, const Ship *flagship, bool canAsk)
 {
   bool needsFuel   = NeedsFuel(ship);
   bool needsEnergy = NeedsEnergy(ship);
@@ -1326,7 +1342,7 @@ void AI::AskForHelp(Ship &ship, bool &isStranded, const Ship *flagship)
   {
     isStranded = true;
   }
-  else if(!Random::Int(30))
+  else if(canAsk)
   {
     const Government *gov      = ship.GetGovernment();
     bool              hasEnemy = false;
@@ -1518,8 +1534,15 @@ std::shared_ptr<Ship> AI::FindTarget(const Ship &ship) const
   auto    strengthIt  = shipStrength.find(&ship);
   if(!person.IsDaring() && strengthIt != shipStrength.end()) maxStrength = 2 * strengthIt->second;
 
-  // Get a list of all targetable, hostile ships in this system.
-  const auto enemies = GetShipsList(ship, true);
+  // Get a list of all targetable, hostile ships in this system that could be picked.
+  // A foe's rating starts out as its distance a second from now, which is at most as
+  // much less than its distance now as both ships move in that second. The rating can
+  // then drop by at most 3500. Only a nemesis takes a foe whose rating is not below the
+  // starting value of "closest", so other ships can skip any foe that is farther away.
+  double searchRange = -1.;
+  if(!person.IsNemesis() && closest < std::numeric_limits<double>::infinity())
+    searchRange = closest + 3500. + 60. * (ship.Velocity().Length() + shipIndex.MaxSpeed());
+  const auto enemies = GetShipsList(ship, true, searchRange);
   for(const auto &foe : enemies)
   {
     // If this is a "nemesis" ship and it has found one of the player's
@@ -1701,34 +1724,12 @@ std::shared_ptr<Ship> AI::FindNonHostileTarget(const Ship &ship) const
 // Return a list of all targetable ships in the same system as the player that
 // match the desired hostility (i.e. enemy or non-enemy). Does not consider the
 // ship's current target, as its inclusion may or may not be desired.
-std::vector<Ship *> AI::GetShipsList(const Ship &ship, bool targetEnemies, double maxRange) const
+std::pmr::vector<Ship *> AI::GetShipsList(const Ship &ship, bool targetEnemies, double maxRange) const
 {
-  if(maxRange < 0.) maxRange = std::numeric_limits<double>::infinity();
-
-  auto targets = std::vector<Ship *>();
-
-  // The cached lists are built each step based on the current ships in the player's system.
-  const auto &rosters = targetEnemies ? enemyLists : allyLists;
-
-  const auto it = rosters.find(ship.GetGovernment());
-  if(it != rosters.end() && !it->second.empty())
-  {
-    targets.reserve(it->second.size());
-
-    const System *here = ship.GetSystem();
-    const Point  &p    = ship.Position();
-    for(const auto &target : it->second)
-    {
-      if(target->IsTargetable() && target->GetSystem() == here &&
-         !(target->IsHyperspacing() && target->Velocity().Length() > 10.) &&
-         p.Distance(target->Position()) < maxRange && (ship.IsYours() || !target->GetPersonality().IsMarked()) &&
-         (target->IsYours() || !ship.GetPersonality().IsMarked()))
-      {
-        targets.emplace_back(target);
-      }
-    }
-  }
-
+  // The index is built each step based on the current ships in the player's system.
+  // The list only lasts until the end of the step, so it does not need its own memory.
+  std::pmr::vector<Ship *> targets(&scratch);
+  shipIndex.Radius(ship, targetEnemies, maxRange, targets);
   return targets;
 }
 
@@ -2070,6 +2071,8 @@ void AI::MoveIndependent(Ship &ship, Command &command)
   // using a local wormhole rather than jumping. If this ship has chosen
   // to land, this decision will not be altered.
   SelectRoute(ship, ship.GetTargetSystem());
+  // Away from the player, the ship does not need to be flown to where it is going.
+  if(TravelInBackground(ship, !ship.GetTargetSystem())) return;
 
   if(ship.GetTargetSystem())
   {
@@ -2166,6 +2169,12 @@ void AI::MoveEscort(Ship &ship, Command &command)
       // the ship should land (refuel or wormhole) or jump.
       SelectRoute(ship, parent.GetSystem());
     }
+    // Away from the player, the ship does not need to be flown to where it lands or jumps from.
+    if((ship.GetTargetStellar() || (ship.GetTargetSystem() && ship.JumpsRemaining())) &&
+       TravelInBackground(ship, ship.GetTargetStellar()))
+    {
+      return;
+    }
 
     // Perform the action that this ship previously decided on.
     if(ship.GetTargetStellar())
@@ -2195,6 +2204,9 @@ void AI::MoveEscort(Ship &ship, Command &command)
   else if(parent.Commands().Has(Command::JUMP) && parent.GetTargetSystem() && !isStaying)
   {
     if(parent.GetTargetSystem() != ship.GetTargetSystem()) SelectRoute(ship, parent.GetTargetSystem());
+    // The parent waits for its escorts, so away from the player, they do not need to be
+    // flown to where they jump from.
+    if(ship.GetTargetSystem() && TravelInBackground(ship, false)) return;
 
     if(ship.GetTargetSystem())
     {
@@ -2236,6 +2248,7 @@ void AI::MoveEscort(Ship &ship, Command &command)
       ship.SetTargetStellar(parent.GetTargetStellar());
       if(parent.IsLanding())
       {
+        if(TravelInBackground(ship, true)) return;
         MoveToPlanet(ship, command);
         command |= Command::LAND;
       }
@@ -2375,7 +2388,9 @@ bool AI::ShouldDock(const Ship &ship, const Ship &parent, const System *playerSy
   // If a carried ship has repair abilities, avoid having it get stuck oscillating between
   // retreating and attacking when at exactly 50% health by adding hysteresis to the check.
   double minHealth = RETREAT_HEALTH + .25 + .25 * !ship.Commands().Has(Command::DEPLOY);
-  if(ship.Health() < minHealth && (!ship.IsYours() || Preferences::Has("Damaged fighters retreat"))) return true;
+  if(ship.Health() < minHealth &&
+     (!ship.IsYours() || Preferences::Current().Has(Preferences::Flag::DAMAGED_FIGHTERS_RETREAT)))
+    return true;
 
   // If a fighter is armed with only ammo-using weapons, but no longer has the ammunition
   // needed to use them, it should dock if the parent can supply that ammo.
@@ -2412,7 +2427,7 @@ bool AI::ShouldDock(const Ship &ship, const Ship &parent, const System *playerSy
 
   // NPC ships should always transfer cargo. Player ships should only
   // transfer cargo if the player has the AI preference set for it.
-  if(!ship.IsYours() || Preferences::Has("Fighters transfer cargo"))
+  if(!ship.IsYours() || Preferences::Current().Has(Preferences::Flag::FIGHTERS_TRANSFER_CARGO))
   {
     // If an out-of-combat carried ship is carrying a significant cargo
     // load and can transfer some of it to the parent, it should do so.
@@ -2430,6 +2445,40 @@ bool AI::ShouldDock(const Ship &ship, const Ship &parent, const System *playerSy
 }
 
 
+// Let a ship outside the player's system skip flying to the planet it is heading for,
+// or to where it can leave the system from. Returns true if it is now traveling there.
+bool AI::TravelInBackground(Ship &ship, bool isLanding) const
+{
+  const System *system = ship.GetSystem();
+  if(system == player.GetSystem()) return false;
+
+  Point destination;
+  Angle facing;
+  if(isLanding && ship.GetTargetStellar())
+  {
+    destination = ship.GetTargetStellar()->Position();
+    facing      = Angle(destination - ship.Position());
+  }
+  else if(!isLanding && ship.GetTargetSystem())
+  {
+    // Most systems can be left from anywhere, so there is nowhere to go.
+    const bool isJump =
+        ship.JumpNavigation().GetCheapestJumpType(ship.GetTargetSystem()).first == JumpType::JUMP_DRIVE;
+    const double departure = isJump ? system->JumpDepartureDistance() : system->HyperDepartureDistance();
+    if(ship.Position().LengthSquared() >= departure * departure + SAFETY_OFFSET) return false;
+
+    destination = ship.Position().Unit() * (departure + SAFETY_OFFSET);
+    facing      = Angle(ship.GetTargetSystem()->Position() - system->Position());
+  }
+  else {
+    return false;
+  }
+
+  if(ship.Position().Distance(destination) < MIN_BACKGROUND_TRAVEL) return false;
+  return ship.TravelInBackground(destination, facing);
+}
+
+
 double AI::TurnBackward(const Ship &ship) { return TurnToward(ship, -ship.Velocity()); }
 
 
@@ -3188,7 +3237,7 @@ void AI::DoSurveillance(Ship &ship, Command &command, std::shared_ptr<Ship> &tar
 }
 
 
-void AI::DoMining(Ship &ship, Command &command)
+void AI::DoMining(Ship &ship, Command &command, bool canSearch)
 {
   // This function is only called for ships that are in the player's system.
   // Update the radius that the ship is searching for asteroids at.
@@ -3203,7 +3252,7 @@ void AI::DoMining(Ship &ship, Command &command)
   double radius  = miningRadius[&ship] * pow(2., angle.Unit().X());
 
   std::shared_ptr<Minable> target = ship.GetTargetAsteroid();
-  if(!target || target->Velocity().Length() > ship.MaxVelocity())
+  if(canSearch && (!target || target->Velocity().Length() > ship.MaxVelocity()))
   {
     for(const std::shared_ptr<Minable> &minable : minables)
     {
@@ -3343,18 +3392,12 @@ bool AI::DoCloak(const Ship &ship, Command &command) const
   double              range        = MAX_RANGE;
   const Ship         *nearestEnemy = nullptr;
   // Find the nearest targetable, in-system enemy that could attack this ship.
-  const auto enemies = GetShipsList(ship, true);
-  for(const auto &foe : enemies)
+  std::pmr::vector<Ship *> enemies(&scratch);
+  shipIndex.Nearest(ship, true, 1, MAX_RANGE, enemies, [](const Ship &foe) { return !foe.IsDisabled(); });
+  if(!enemies.empty())
   {
-    if(!foe->IsDisabled())
-    {
-      double distance = ship.Position().Distance(foe->Position());
-      if(distance < range)
-      {
-        range        = distance;
-        nearestEnemy = foe;
-      }
-    }
+    nearestEnemy = enemies.front();
+    range        = ship.Position().Distance(nearestEnemy->Position());
   }
 
   // If this ship has started cloaking, it must get at least 40% repaired
@@ -3659,8 +3702,8 @@ void AI::AimTurrets(
     bool                        opportunistic,
     const std::optional<Point> &targetOverride) const
 {
-  // (Position, Velocity) pairs of the targets.
-  std::vector<std::pair<Point, Point>> targets;
+  // The positions and velocities of the targets.
+  turretSolver.Clear(ship.Velocity());
   if(!targetOverride)
   {
     // First, get the set of potential hostile ships.
@@ -3740,108 +3783,42 @@ void AI::AimTurrets(
       return;
     }
 
-    targets.reserve(targetBodies.size());
     for(auto body : targetBodies)
-      targets.emplace_back(body->Position(), body->Velocity());
+      turretSolver.Add(body->Position(), body->Velocity());
   }
   else {
-    targets.emplace_back(*targetOverride + ship.Position(), ship.Velocity());
+    turretSolver.Add(*targetOverride + ship.Position(), ship.Velocity());
   }
   // Each hardpoint should aim at the target that it is "closest" to hitting.
   for(const Hardpoint &hardpoint : ship.Weapons())
   {
     if(hardpoint.CanAim(ship))
     {
+      TurretSolver::Turret turret;
       // This is where this projectile fires from. Add some randomness
       // based on how skilled the pilot is.
-      Point start  = ship.Position() + ship.Facing().Rotate(hardpoint.GetPoint());
-      start       += ship.GetPersonality().Confusion();
-      // Get the turret's current facing, in absolute coordinates:
-      Angle aim = ship.Facing() + hardpoint.GetAngle();
+      turret.start  = ship.Position() + ship.Facing().Rotate(hardpoint.GetPoint());
+      turret.start += ship.GetPersonality().Confusion();
+      // Get the turret's current facing and its arc, in absolute coordinates:
+      const Angle facing       = ship.Facing();
+      turret.aim               = facing + hardpoint.GetAngle();
+      turret.minArc            = hardpoint.GetMinArc() + facing;
+      turret.maxArc            = hardpoint.GetMaxArc() + facing;
+      turret.isOmnidirectional = hardpoint.IsOmnidirectional();
+      turret.turnRate          = hardpoint.TurnRate(ship);
       // Get this projectile's average velocity.
-      const Weapon *weapon = hardpoint.GetWeapon();
-      double        vp     = weapon->WeightedVelocity() + .5 * weapon->RandomVelocity();
-      // Loop through each body this hardpoint could shoot at. Find the
-      // one that is the "best" in terms of how many frames it will take
-      // to aim at it and for a projectile to hit it.
-      double bestScore = std::numeric_limits<double>::infinity();
-      double bestAngle = 0.;
-      for(auto [p, v] : targets)
-      {
-        p -= start;
-
-        // Only take the ship's velocity into account if this weapon
-        // does not have its own acceleration.
-        if(!weapon->Acceleration()) v -= ship.Velocity();
-        // By the time this action is performed, the target will
-        // have moved forward one time step.
-        p += v;
-
-        double rendezvousTime = std::numeric_limits<double>::quiet_NaN();
-        double distance       = p.Length();
-        // Beam weapons hit instantaneously if they are in range.
-        bool isInstantaneous = weapon->TotalLifetime() == 1.;
-        if(isInstantaneous && distance < vp)
-        {
-          rendezvousTime = 0.;
-        }
-        else {
-          // Find out how long it would take for this projectile to reach the target.
-          if(!isInstantaneous) rendezvousTime = RendezvousTime(p, v, vp);
-
-          // If there is no intersection (i.e. the turret is not facing the target),
-          // consider this target "out-of-range" but still targetable.
-          if(std::isnan(rendezvousTime))
-            rendezvousTime = std::max(distance / (vp ? vp : 1.), 2 * weapon->TotalLifetime());
-
-          // Determine where the target will be at that point.
-          p += v * rendezvousTime;
-
-          // All bodies within weapons range have the same basic
-          // weight. Outside that range, give them lower priority.
-          rendezvousTime = std::max(0., rendezvousTime - weapon->TotalLifetime());
-        }
-
-        // Determine how much the turret must turn to face that std::vector.
-        double degrees      = 0.;
-        Angle  angleToPoint = Angle(p);
-        if(hardpoint.IsOmnidirectional())
-        {
-          degrees = (angleToPoint - aim).Degrees();
-        }
-        else {
-          // For turret with limited arc, determine the turn up to the nearest arc limit.
-          // Also reduce priority of target if it's not within the firing arc.
-          const Angle facing = ship.Facing();
-          const Angle minArc = hardpoint.GetMinArc() + facing;
-          const Angle maxArc = hardpoint.GetMaxArc() + facing;
-          if(!angleToPoint.IsInRange(minArc, maxArc))
-          {
-            // Decrease the priority of the target.
-            rendezvousTime += 2. * weapon->TotalLifetime();
-
-            // Point to the nearer edge of the arc.
-            const double minDegree = (minArc - angleToPoint).Degrees();
-            const double maxDegree = (maxArc - angleToPoint).Degrees();
-            if(fabs(minDegree) < fabs(maxDegree)) angleToPoint = minArc;
-            else angleToPoint = maxArc;
-          }
-          degrees = (angleToPoint - minArc).AbsDegrees() - (aim - minArc).AbsDegrees();
-        }
-        double turnTime = fabs(degrees) / hardpoint.TurnRate(ship);
-        // Always prefer targets that you are able to hit.
-        double score = turnTime + (180. / hardpoint.TurnRate(ship)) * rendezvousTime;
-        if(score < bestScore)
-        {
-          bestScore = score;
-          bestAngle = degrees;
-        }
-      }
-      if(bestAngle)
+      const Weapon *weapon   = hardpoint.GetWeapon();
+      turret.velocity        = weapon->WeightedVelocity() + .5 * weapon->RandomVelocity();
+      turret.lifetime        = weapon->TotalLifetime();
+      turret.hasAcceleration = weapon->Acceleration();
+      // Find the body this hardpoint could shoot at that is the "best" in terms of
+      // how many frames it will take to aim at it and for a projectile to hit it.
+      const TurretSolver::Result best = turretSolver.Aim(turret);
+      if(best.degrees)
       {
         // Get the index of this weapon.
         int index = &hardpoint - &ship.Weapons().front();
-        command.SetAim(index, bestAngle / hardpoint.TurnRate(ship));
+        command.SetAim(index, best.degrees / turret.turnRate);
       }
     }
   }
@@ -3862,9 +3839,9 @@ void AI::AutoFire(const Ship &ship, FireCommand &command, bool secondary, bool i
     beFrugal = (ship.Health() > GameData::GetGamerules().UniversalFrugalThreshold());
     if(beFrugal)
     {
-      auto ait = allyStrength.find(ship.GetGovernment());
-      auto eit = enemyStrength.find(ship.GetGovernment());
-      if(ait != allyStrength.end() && eit != enemyStrength.end() && ait->second < eit->second) beFrugal = false;
+      const int64_t allies  = strengths.Ally(ship.GetGovernment());
+      const int64_t enemies = strengths.Enemy(ship.GetGovernment());
+      if(allies && enemies && allies < enemies) beFrugal = false;
     }
   }
 
@@ -3926,6 +3903,28 @@ void AI::AutoFire(const Ship &ship, FireCommand &command, bool secondary, bool i
   {
     enemies.push_back(currentTarget.get());
   }
+  // Decide which of those ships may be fired upon at all, before checking
+  // whether each of the weapons could hit them.
+  std::vector<const Ship *> targets;
+  targets.reserve(enemies.size());
+  for(const Ship *target : enemies)
+  {
+    // NPCs shoot ships that they just plundered.
+    bool hasBoarded = !ship.IsYours() && Has(ship, target->weak_from_this(), ShipEvent::BOARD);
+    if(target->IsDisabled() && (disables || (plunders && !hasBoarded)) && !disabledOverride) continue;
+    // Merciful ships let fleeing ships go.
+    if(target->IsFleeing() && person.IsMerciful()) continue;
+    // Don't hit ships that cannot be hit without targeting
+    if(target != currentTarget.get() && !FighterHitHelper::IsValidTarget(target)) continue;
+
+    targets.push_back(target);
+  }
+  // Non-homing weapons check all of those targets at once for the ones that their
+  // projectiles could pass close enough to hit, before checking their masks.
+  turretSolver.Clear(ship.Velocity());
+  for(const Ship *target : targets)
+    turretSolver.Add(target->Position(), target->Velocity(), target->GetMask(step).Radius());
+  std::vector<int> inLineOfFire;
 
   int index = -1;
   for(const Hardpoint &hardpoint : ship.Weapons())
@@ -3937,7 +3936,7 @@ void AI::AutoFire(const Ship &ship, FireCommand &command, bool secondary, bool i
     // Skip weapons omitted by the "Automatic firing" preference.
     if(isFlagship)
     {
-      const Preferences::AutoFire autoFireMode = Preferences::GetAutoFire();
+      const Preferences::AutoFire autoFireMode = Preferences::Current().autoFire;
       if(autoFireMode == Preferences::AutoFire::GUNS_ONLY && hardpoint.IsTurret()) continue;
       if(autoFireMode == Preferences::AutoFire::TURRETS_ONLY && !hardpoint.IsTurret()) continue;
     }
@@ -4004,18 +4003,18 @@ void AI::AutoFire(const Ship &ship, FireCommand &command, bool secondary, bool i
       continue;
     }
     // For non-homing weapons:
-    for(const auto &target : enemies)
-    {
-      // NPCs shoot ships that they just plundered.
-      bool hasBoarded = !ship.IsYours() && Has(ship, target->weak_from_this(), ShipEvent::BOARD);
-      if(target->IsDisabled() && (disables || (plunders && !hasBoarded)) && !disabledOverride) continue;
-      // Merciful ships let fleeing ships go.
-      if(target->IsFleeing() && person.IsMerciful()) continue;
-      // Don't hit ships that cannot be hit without targeting
-      if(target != currentTarget.get() && !FighterHitHelper::IsValidTarget(target)) continue;
-
-      Point p = target->Position() - start;
-      Point v = target->Velocity();
+    TurretSolver::Turret turret;
+    turret.start           = start;
+    turret.aim             = ship.Facing() + hardpoint.GetAngle();
+    turret.velocity        = vp;
+    turret.lifetime        = lifetime;
+    turret.hasAcceleration = weapon->Acceleration();
+    turretSolver.InLineOfFire(turret, inLineOfFire);
+    for(int i : inLineOfFire)
+    {
+      const Ship *target = targets[i];
+      Point       p      = target->Position() - start;
+      Point       v      = target->Velocity();
       // Only take the ship's velocity into account if this weapon
       // does not have its own acceleration.
       if(!weapon->Acceleration()) v -= ship.Velocity();
@@ -4123,7 +4122,7 @@ bool AI::TargetMinable(Ship &ship) const
 {
   double scanRangeMetric = 10000. * ship.Attributes().Get("asteroid scan power");
   if(!scanRangeMetric) return false;
-  const bool findClosest       = Preferences::Has("Target asteroid based on");
+  const bool findClosest       = Preferences::Current().Has(Preferences::Flag::TARGET_ASTEROID_BASED_ON);
   auto       bestMinable       = ship.GetTargetAsteroid();
   double     bestScore         = findClosest ? std::numeric_limits<double>::max() : 0.;
   auto       GetDistanceMetric = [&ship](const Minable &minable) -> double
@@ -4242,7 +4241,7 @@ void AI::MovePlayer(Ship &ship, Command &activeCommands)
     }
 
     // Inform the player of any destinations in the system they are jumping to.
-    if(!destinations.empty() && Preferences::GetNotificationSetting() != Preferences::NotificationSetting::OFF)
+    if(!destinations.empty() && Preferences::Current().notificationSetting != Preferences::NotificationSetting::OFF)
     {
       std::string message  = "Note: you have ";
       message             += (missions == 1 ? "a mission that requires" : "missions that require");
@@ -4253,7 +4252,7 @@ void AI::MovePlayer(Ship &ship, Command &activeCommands)
       message += " in the system you are jumping to.";
       Messages::Add({message, GameData::MessageCategories().Get("info")});
 
-      if(Preferences::GetNotificationSetting() == Preferences::NotificationSetting::BOTH)
+      if(Preferences::Current().notificationSetting == Preferences::NotificationSetting::BOTH)
         UI::PlaySound(UI::UISound::FAILURE);
     }
     // If any destination was found, find the corresponding stellar object
@@ -4340,7 +4339,7 @@ void AI::MovePlayer(Ship &ship, Command &activeCommands)
     {
       if(shift) ship.SetTargetShip(std::shared_ptr<Ship>());
 
-      const auto boardingPriority = Preferences::GetBoardingPriority();
+      const auto boardingPriority = Preferences::Current().boardingPriority;
       auto       strategy         = [&]() noexcept -> std::function<double(const Ship &)>
       {
         Point current = ship.Position();
@@ -4631,12 +4630,14 @@ void AI::MovePlayer(Ship &ship, Command &activeCommands)
     TargetMinable(ship);
   }
 
-  const std::shared_ptr<const Ship> target = ship.GetTargetShip();
-  auto targetOverride = Preferences::Has("Aim turrets with mouse") ^ activeCommands.Has(Command::AIM_TURRET_HOLD)
-                            ? std::optional(mousePosition)
-                            : std::nullopt;
-  AimTurrets(ship, firingCommands, !Preferences::Has("Turrets focus fire"), targetOverride);
-  if(Preferences::GetAutoFire() != Preferences::AutoFire::OFF && !ship.IsBoarding() &&
+  const Preferences::Snapshot      &preferences = Preferences::Current();
+  const std::shared_ptr<const Ship> target      = ship.GetTargetShip();
+  auto targetOverride =
+      preferences.Has(Preferences::Flag::AIM_TURRETS_WITH_MOUSE) ^ activeCommands.Has(Command::AIM_TURRET_HOLD)
+          ? std::optional(mousePosition)
+          : std::nullopt;
+  AimTurrets(ship, firingCommands, !preferences.Has(Preferences::Flag::TURRETS_FOCUS_FIRE), targetOverride);
+  if(preferences.autoFire != Preferences::AutoFire::OFF && !ship.IsBoarding() &&
      !(autoPilot | activeCommands).Has(Command::LAND | Command::JUMP | Command::FLEET_JUMP | Command::BOARD) &&
      (!target || target->GetGovernment()->IsEnemy()))
   {
@@ -4695,8 +4696,8 @@ void AI::MovePlayer(Ship &ship, Command &activeCommands)
       command.SetTurn(TurnToward(ship, ship.GetTargetStellar()->Position() - ship.Position()));
   }
   else if(
-      (Preferences::GetAutoAim() == Preferences::AutoAim::ALWAYS_ON ||
-       (Preferences::GetAutoAim() == Preferences::AutoAim::WHEN_FIRING && isFiring)) &&
+      (Preferences::Current().autoAim == Preferences::AutoAim::ALWAYS_ON ||
+       (Preferences::Current().autoAim == Preferences::AutoAim::WHEN_FIRING && isFiring)) &&
       !command.Turn() && !ship.IsBoarding() &&
       ((target && target->GetSystem() == ship.GetSystem() && target->IsTargetable()) || ship.GetTargetAsteroid()) &&
       !autoPilot.Has(Command::LAND | Command::JUMP | Command::FLEET_JUMP | Command::BOARD))
@@ -4809,7 +4810,7 @@ void AI::MovePlayer(Ship &ship, Command &activeCommands)
   if(ship.HasBays() && HasDeployments(ship))
   {
     command |= Command::DEPLOY;
-    Deploy(ship, !Preferences::Has("Damaged fighters retreat"));
+    Deploy(ship, !Preferences::Current().Has(Preferences::Flag::DAMAGED_FIGHTERS_RETREAT));
   }
   if(isCloaking) command |= Command::CLOAK;
 
@@ -4863,43 +4864,19 @@ bool AI::Has(const Ship &ship, const Government *government, int type) const
 }
 
 
-void AI::UpdateStrengths(std::map<const Government *, int64_t> &strength, const System *playerSystem)
+void AI::UpdateStrengths(const System *playerSystem)
 {
   // Tally the strength of a government by the strength of its present and able ships.
+  // Only the ships that have arrived, left, or changed since the last step change the
+  // totals, and the strengths of enemies and allies are only recalculated if they did.
   governmentRosters.clear();
   for(const auto &it : ships)
   {
-    if(it->GetGovernment() && it->GetSystem() == playerSystem)
-    {
-      governmentRosters[it->GetGovernment()].emplace_back(it.get());
-      if(!it->IsDisabled() && !it->IsOverheated() && !it->IsIonized()) strength[it->GetGovernment()] += it->Strength();
-    }
-  }
-
-  // Strengths of enemies and allies are rebuilt every step.
-  enemyStrength.clear();
-  allyStrength.clear();
-  for(const auto &gov : strength)
-  {
-    std::set<const Government *> allies;
-    for(const auto &enemy : strength)
-    {
-      if(enemy.first->IsEnemy(gov.first))
-      {
-        // "Know your enemies."
-        enemyStrength[gov.first] += enemy.second;
-        for(const auto &ally : strength)
-        {
-          if(ally.first->IsEnemy(enemy.first) && !allies.contains(ally.first))
-          {
-            // "The enemy of my enemy is my friend."
-            allyStrength[gov.first] += ally.second;
-            allies.insert(ally.first);
-          }
-        }
-      }
-    }
+    const bool isPresent = it->GetGovernment() && it->GetSystem() == playerSystem;
+    if(isPresent) governmentRosters[it->GetGovernment()].emplace_back(it.get());
+    strengths.Update(*it, isPresent);
   }
+  strengths.Finish();
 
   // Ships with nearby allies consider their allies' strength as well as their own.
   for(const auto &it : ships)
@@ -4924,24 +4901,8 @@ void AI::UpdateStrengths(std::map<const Government *, int64_t> &strength, const
 }
 
 
-// Cache various lists of all targetable ships in the player's system for this Step.
-void AI::CacheShipLists()
-{
-  allyLists.clear();
-  enemyLists.clear();
-  for(const auto &git : governmentRosters)
-  {
-    allyLists.emplace(git.first, std::vector<Ship *>());
-    allyLists.at(git.first).reserve(ships.size());
-    enemyLists.emplace(git.first, std::vector<Ship *>());
-    enemyLists.at(git.first).reserve(ships.size());
-    for(const auto &oit : governmentRosters)
-    {
-      auto &list = git.first->IsEnemy(oit.first) ? enemyLists[git.first] : allyLists[git.first];
-      list.insert(list.end(), oit.second.begin(), oit.second.end());
-    }
-  }
-}
+// Index all ships in the player's system by location for this Step.
+void AI::CacheShipLists() { shipIndex.Build(governmentRosters); }
 
 
 void AI::RegisterDerivedConditions(ConditionsStore &conditions)
@@ -4950,27 +4911,24 @@ void AI::RegisterDerivedConditions(ConditionsStore &conditions)
   conditions["government strength: "].ProvidePrefixed(
       [this](const ConditionEntry &ce) -> int64_t
       {
-        const Government *gov      = GameData::Governments().Get(ce.NameWithoutPrefix());
-        int64_t           strength = 0;
-        for(const Ship *ship : governmentRosters[gov])
-          if(ship) strength += ship->Strength();
-        return strength;
+        const Government *gov = GameData::Governments().Get(ce.NameWithoutPrefix());
+        return strengths.Total(gov);
       });
   conditions["ally strength"].ProvideNamed(
-      [this](const ConditionEntry &ce) -> int64_t { return allyStrength[GameData::PlayerGovernment()]; });
+      [this](const ConditionEntry &ce) -> int64_t { return strengths.Ally(GameData::PlayerGovernment()); });
   conditions["enemy strength"].ProvideNamed(
-      [this](const ConditionEntry &ce) -> int64_t { return enemyStrength[GameData::PlayerGovernment()]; });
+      [this](const ConditionEntry &ce) -> int64_t { return strengths.Enemy(GameData::PlayerGovernment()); });
   conditions["ally strength: "].ProvidePrefixed(
       [this](const ConditionEntry &ce) -> int64_t
       {
         const Government *gov = GameData::Governments().Get(ce.NameWithoutPrefix());
-        return gov ? allyStrength[gov] : 0.;
+        return strengths.Ally(gov);
       });
   conditions["enemy strength: "].ProvidePrefixed(
       [this](const ConditionEntry &ce) -> int64_t
       {
         const Government *gov = GameData::Governments().Get(ce.NameWithoutPrefix());
-        return gov ? enemyStrength[gov] : 0.;
+        return strengths.Enemy(gov);
       });
 }
 
@@ -5123,7 +5081,12 @@ void AI::UpdateOrders(const Ship &ship)
 RoutePlan AI::GetRoutePlan(const Ship &ship, const System *targetSystem)
 {
   // Note: RecacheJumpRoutes will check and reset the value for us.
-  if(player.RecacheJumpRoutes()) routeCache.clear();
+  if(player.RecacheJumpRoutes() || routesVersion != GameData::RoutesVersion())
+  {
+    routeCache.clear();
+    routeTrees.clear();
+    routesVersion = GameData::RoutesVersion();
+  }
 
   size_t personalityHash = 0;
   Hasher::Hash(personalityHash, ship.GetGovernment());
@@ -5138,6 +5101,35 @@ RoutePlan AI::GetRoutePlan(const Ship &ship, const System *targetSystem)
   for(const auto &requirement : GameData::UniverseWormholeRequirements())
     if(shipAttributes.Get(requirement)) wormholeKeys.emplace_back(requirement);
 
+  // NPCs do not care about the player's map or about danger, so they can all follow
+  // the same tree of routes to the target, no matter which system they start from.
+  if(!ship.IsYours())
+  {
+    const System *from = ship.GetSystem();
+    if(!from || from == targetSystem || ship.IsRestrictedFrom(*from)) return RoutePlan();
+    // If this ship has no mode of hyperspace travel, and no local wormhole to use, it is stuck.
+    const ShipJumpNavigation &navigation = ship.JumpNavigation();
+    if(!navigation.HasHyperdrive() && !navigation.HasJumpDrive() &&
+       none_of(from->Objects().begin(), from->Objects().end(), [](const StellarObject &object)
+       { return object.HasSprite() && object.HasValidPlanet() && object.GetPlanet()->IsWormhole(); }))
+      return RoutePlan();
+
+    auto key = RouteCacheKey(navigation.CapabilityHash(), personalityHash, targetSystem, false, wormholeKeys);
+    auto it  = routeTrees.find(key);
+    if(it == routeTrees.end())
+    {
+      // Each tree covers the whole galaxy, so do not keep around too many of them.
+      if(routeTrees.size() >= MAX_ROUTE_TREES)
+      {
+        auto lastUse = [](const auto &entry) { return entry.second.second; };
+        routeTrees.erase(std::ranges::min_element(routeTrees, {}, lastUse));
+      }
+      it = routeTrees.emplace(key, std::make_pair(RouteTree(ship, *targetSystem), 0)).first;
+    }
+    it->second.second = ++routeTreeUses;
+    return RoutePlan(it->second.first, *from);
+  }
+
   auto key = RouteCacheKey(
       ship.JumpNavigation().Hash(),
       personalityHash,
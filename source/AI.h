@@ -15,17 +15,23 @@ this program. If not, see <https://www.gnu.org/licenses/>.
 
 #pragma once
 
+#include "AIScheduler.h"
 #include "Command.h"
 #include "FireCommand.h"
 #include "FormationPositioner.h"
+#include "GovernmentStrengths.h"
 #include "Point.h"
 #include "RoutePlan.h"
+#include "RouteTree.h"
+#include "ShipIndex.h"
+#include "TurretSolver.h"
 #include "orders/OrderSet.h"
 
 #include <cstdint>
 #include <list>
 #include <map>
 #include <memory>
+#include <memory_resource>
 #include <optional>
 #include <set>
 #include <unordered_map>
@@ -39,6 +45,7 @@ class Flotsam;
 class Government;
 class Minable;
 class PlayerInfo;
+class ScratchArena;
 class Ship;
 class ShipEvent;
 class StellarObject;
@@ -57,8 +64,14 @@ public:
   // Any object that can be a ship's target is in a list of this type:
   template <class Type>
   using List = std::list<std::shared_ptr<Type>>;
-  // Constructor, giving the AI access to the player and various object lists.
-  AI(PlayerInfo &player, const List<Ship> &ships, const List<Minable> &minables, const List<Flotsam> &flotsam);
+  // Constructor, giving the AI access to the player and various object lists, and to
+  // the memory for anything it only needs during a single step.
+  AI(
+      PlayerInfo          &player,
+      const List<Ship>    &ships,
+      const List<Minable> &minables,
+      const List<Flotsam> &flotsam,
+      ScratchArena        &scratch);
 
   // Fleet commands from the player.
   void IssueFormationChange(PlayerInfo &player);
@@ -92,6 +105,11 @@ public:
   // Find nearest landing location.
   static const StellarObject *FindLandingLocation(const Ship &ship, const bool refuel = true);
 
+  // Calculate how long it will take a projectile to reach a target given the
+  // target's relative position and velocity and the velocity of the
+  // projectile. If it cannot hit the target, this returns NaN.
+  static double RendezvousTime(const Point &p, const Point &v, double vp);
+
 
 private:
   class RouteCacheKey
@@ -137,14 +155,15 @@ private:
   // Check if a ship can pursue its target (i.e. beyond the "fence").
   bool CanPursue(const Ship &ship, const Ship &target) const;
   // Disabled or stranded ships coordinate with other ships to get assistance.
-  void AskForHelp(Ship &ship, bool &isStranded, const Ship *flagship);
+  // They only look for a new helper if they are allowed to ask this step.
+  void AskForHelp(Ship &ship, bool &isStranded, const Ship *flagship, bool canAsk);
   bool CanHelp(const Ship &ship, const Ship &helper, const bool needsFuel, const bool needsEnergy) const;
   bool HasHelper(const Ship &ship, const bool needsFuel, const bool needsEnergy);
   // Pick a new target for the given ship.
   std::shared_ptr<Ship> FindTarget(const Ship &ship) const;
   std::shared_ptr<Ship> FindNonHostileTarget(const Ship &ship) const;
   // Obtain a list of ships matching the desired hostility.
-  std::vector<Ship *> GetShipsList(const Ship &ship, bool targetEnemies, double maxRange = -1.) const;
+  std::pmr::vector<Ship *> GetShipsList(const Ship &ship, bool targetEnemies, double maxRange = -1.) const;
 
   bool        FollowOrders(Ship &ship, Command &command);
   void        MoveInFormation(Ship &ship, Command &command);
@@ -158,6 +177,9 @@ private:
   // If the ship is an escort it will only use routes known to the player.
   void SelectRoute(Ship &ship, const System *targetSystem);
   bool ShouldDock(const Ship &ship, const Ship &parent, const System *playerSystem) const;
+  // Let a ship outside the player's system skip flying to the planet it is heading for,
+  // or to where it can leave the system from. Returns true if it is now traveling there.
+  bool TravelInBackground(Ship &ship, bool isLanding) const;
 
   // Methods of moving from the current position to a desired position / orientation.
   static double TurnBackward(const Ship &ship);
@@ -189,7 +211,7 @@ private:
   void DoAppeasing(const std::shared_ptr<Ship> &ship, double *threshold) const;
   void DoSwarming(Ship &ship, Command &command, std::shared_ptr<Ship> &target);
   void DoSurveillance(Ship &ship, Command &command, std::shared_ptr<Ship> &target);
-  void DoMining(Ship &ship, Command &command);
+  void DoMining(Ship &ship, Command &command, bool canSearch);
   bool DoHarvesting(Ship &ship, Command &command) const;
   bool DoCloak(const Ship &ship, Command &command) const;
   void DoPatrol(Ship &ship, Command &command) const;
@@ -215,11 +237,6 @@ private:
   void AutoFire(const Ship &ship, FireCommand &command, bool secondary = true, bool isFlagship = false) const;
   void AutoFire(const Ship &ship, FireCommand &command, const Body &target) const;
 
-  // Calculate how long it will take a projectile to reach a target given the
-  // target's relative position and velocity and the velocity of the
-  // projectile. If it cannot hit the target, this returns NaN.
-  static double RendezvousTime(const Point &p, const Point &v, double vp);
-
   // True if found asteroid.
   bool TargetMinable(Ship &ship) const;
   // True if the ship performed the indicated event to the other ship.
@@ -230,7 +247,7 @@ private:
   bool Has(const Ship &ship, const Government *government, int type) const;
 
   // Functions to classify ships based on government and system.
-  void UpdateStrengths(std::map<const Government *, int64_t> &strength, const System *playerSystem);
+  void UpdateStrengths(const System *playerSystem);
   void CacheShipLists();
 
   /// Register autoconditions that use the current AI state (ships in the system, strengths, etc.)
@@ -251,10 +268,14 @@ private:
   const List<Ship>    &ships;
   const List<Minable> &minables;
   const List<Flotsam> &flotsam;
+  // This is reset by the engine at the start of each step.
+  ScratchArena &scratch;
 
   // The current step count for the AI, incremented once per frame.
   // Its value helps limit how often certain actions occur (such as changing targets).
   int step = 0;
+  // Which ships reconsider their targets and other slowly changing decisions this step.
+  AIScheduler scheduler;
 
   // Command applied by the player's "autopilot."
   Command autoPilot;
@@ -303,12 +324,19 @@ private:
 
   // Records that affect the combat behavior of various governments.
   std::map<const Ship *, int64_t>                   shipStrength;
-  std::map<const Government *, int64_t>             enemyStrength;
-  std::map<const Government *, int64_t>             allyStrength;
+  GovernmentStrengths                               strengths;
   std::map<const Government *, std::vector<Ship *>> governmentRosters;
-  std::map<const Government *, std::vector<Ship *>> enemyLists;
-  std::map<const Government *, std::vector<Ship *>> allyLists;
-
-  // Route planning cache:
-  std::unordered_map<RouteCacheKey, RoutePlan, RouteCacheKey::HashFunction> routeCache;
+  // The ships of the player's system, sorted by location.
+  ShipIndex shipIndex;
+  // The potential targets of the ship whose turrets are being aimed. This is
+  // only kept between steps so that its storage can be reused.
+  mutable TurretSolver turretSolver;
+
+  // Route planning cache. The player's ships plan from where they are, while NPCs
+  // share a tree of the routes to each destination, keyed without the current system.
+  // Each tree is stored with the number of tree lookups there had been when it was last used.
+  std::unordered_map<RouteCacheKey, RoutePlan, RouteCacheKey::HashFunction>                      routeCache;
+  std::unordered_map<RouteCacheKey, std::pair<RouteTree, uint64_t>, RouteCacheKey::HashFunction> routeTrees;
+  uint64_t                                                                                       routeTreeUses = 0;
+  unsigned                                                                                       routesVersion = 0;
 };
@@ -0,0 +1,115 @@
+/* AIScheduler.cpp
+Copyright (c) 2026 by RisingLeaf
+
+Endless Sky is free software: you can redistribute it and/or modify it under the
+terms of the GNU General Public License as published by the Free Software
+Foundation, either version 3 of the License, or (at your option) any later version.
+
+Endless Sky is distributed in the hope that it will be useful, but WITHOUT ANY
+WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS FOR A
+PARTICULAR PURPOSE. See the GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License along with
+this program. If not, see <https://www.gnu.org/licenses/>.
+*/
+
+#include "AIScheduler.h"
+
+#include "Ship.h"
+
+#include <algorithm>
+#include <tuple>
+#include <vector>
+
+using namespace std;
+
+namespace
+{
+  // A ship that has lost this much of its health since its last turn is woken up.
+  const double WAKE_DAMAGE = .1;
+
+  bool HasLiveTarget(const Ship &ship)
+  {
+    const shared_ptr<Ship> target = ship.GetTargetShip();
+    return target && !target->IsDestroyed() && target->IsTargetable();
+  }
+}
+
+
+// Decide which of the given ships get a strategic turn this step.
+void AIScheduler::Step(const list<shared_ptr<Ship>> &ships, int budget)
+{
+  ++stepCount;
+
+  // Ships that are woken up go first, and then the ones that have waited the longest.
+  vector<tuple<bool, int64_t, const Ship *, Record *>> waiting;
+  for(const auto &it : ships)
+  {
+    if(it->IsDestroyed() || !it->GetSystem()) continue;
+
+    Record &record = records[it.get()];
+    record.hasTurn = false;
+    record.wasSeen = true;
+    // A new ship gets a turn right away, so that it can pick a target.
+    if(record.phase < 0)
+    {
+      record.phase   = nextPhase;
+      nextPhase      = (nextPhase + 1) % PERIOD;
+      record.isWoken = true;
+    }
+    if((stepCount + record.phase) % PERIOD == 0) record.isDue = true;
+    if(it->Health() < record.health - WAKE_DAMAGE || (record.hasTarget && !HasLiveTarget(*it)))
+      record.isWoken = true;
+
+    if(record.isDue || record.isWoken) waiting.emplace_back(!record.isWoken, record.lastTurn, it.get(), &record);
+  }
+
+  const size_t count = budget > 0 ? min<size_t>(budget, waiting.size()) : waiting.size();
+  if(count < waiting.size()) partial_sort(waiting.begin(), waiting.begin() + count, waiting.end());
+  for(size_t i = 0; i < count; ++i)
+  {
+    const Ship &ship   = *get<2>(waiting[i]);
+    Record     &record = *get<3>(waiting[i]);
+    record.hasTurn     = true;
+    record.isDue       = false;
+    record.isWoken     = false;
+    record.lastTurn    = stepCount;
+    record.health      = ship.Health();
+    record.hasTarget   = HasLiveTarget(ship);
+  }
+
+  // Forget about any ships that no longer exist.
+  for(auto it = records.begin(); it != records.end();)
+  {
+    if(!it->second.wasSeen) it = records.erase(it);
+    else {
+      it->second.wasSeen = false;
+      ++it;
+    }
+  }
+}
+
+
+// Give the given ship a strategic turn as soon as possible.
+void AIScheduler::Wake(const Ship *ship)
+{
+  Record &record = records[ship];
+  record.isWoken = true;
+  // Keep the record until the next step, even if the ship is not seen before then.
+  record.wasSeen = true;
+}
+
+
+// Check whether the given ship has a strategic turn this step.
+bool AIScheduler::IsStrategicTurn(const Ship &ship) const
+{
+  const auto it = records.find(&ship);
+  return it != records.end() && it->second.hasTurn;
+}
+
+
+void AIScheduler::Clear()
+{
+  records.clear();
+  nextPhase = 0;
+}
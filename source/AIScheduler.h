@@ -0,0 +1,74 @@
+/* AIScheduler.h
+Copyright (c) 2026 by RisingLeaf
+
+Endless Sky is free software: you can redistribute it and/or modify it under the
+terms of the GNU General Public License as published by the Free Software
+Foundation, either version 3 of the License, or (at your option) any later version.
+
+Endless Sky is distributed in the hope that it will be useful, but WITHOUT ANY
+WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS FOR A
+PARTICULAR PURPOSE. See the GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License along with
+this program. If not, see <https://www.gnu.org/licenses/>.
+*/
+
+#pragma once
+
+#include <cstdint>
+#include <list>
+#include <map>
+#include <memory>
+
+class Ship;
+
+
+// The AIScheduler decides which ships should reconsider their slowly changing
+// "strategic" decisions, like which ship to target or who to ask for help, on a
+// given step. Steering and firing are still decided every step. Each ship gets a
+// strategic turn once every PERIOD steps, on a step that depends on when it was
+// first seen, so that the turns are spread out evenly. A ship is woken up early
+// if it takes damage or loses its target. Only a limited number of ships get a
+// turn on any one step; the rest wait for the next step, and the ones that have
+// waited the longest go first.
+class AIScheduler
+{
+public:
+  // How many steps it takes for every ship to get a strategic turn, if the budget allows.
+  static constexpr int PERIOD = 32;
+
+
+public:
+  // Decide which of the given ships get a strategic turn this step. A budget of zero means there is no limit.
+  void Step(const std::list<std::shared_ptr<Ship>> &ships, int budget);
+  // Give the given ship a strategic turn as soon as possible.
+  void Wake(const Ship *ship);
+  // Check whether the given ship has a strategic turn this step.
+  bool IsStrategicTurn(const Ship &ship) const;
+
+  void Clear();
+
+
+private:
+  class Record
+  {
+  public:
+    // Which of the PERIOD steps this ship's regular turns fall on, or -1 if it has not been seen yet.
+    int phase = -1;
+    // When this ship last had a strategic turn, and how healthy it was and whether it had a target then.
+    int64_t lastTurn  = 0;
+    double  health    = 1.;
+    bool    hasTarget = false;
+    // Whether this ship is waiting for a regular turn, or was woken up early.
+    bool isDue   = false;
+    bool isWoken = false;
+    bool hasTurn = false;
+    bool wasSeen = false;
+  };
+
+
+private:
+  int64_t                        stepCount = 0;
+  int                            nextPhase = 0;
+  std::map<const Ship *, Record> records;
+};
@@ -34,10 +34,11 @@ namespace
 
 AlertLabel::AlertLabel(
     const Point                 &position,
+    const Point                 &velocity,
     const Projectile            &projectile,
     const std::shared_ptr<Ship> &flagship,
     double                       zoom) :
-  position(position), zoom(zoom)
+  position(position), velocity(velocity), zoom(zoom)
 {
   bool isDangerous    = false;
   isTargetingFlagship = false;
@@ -58,16 +59,17 @@ AlertLabel::AlertLabel(
 }
 
 
-void AlertLabel::Draw() const
+void AlertLabel::Draw(double lag) const
 {
+  const Point  center   = (position - velocity * lag) * zoom;
   const double angle[3] = {330., 210., 90.};
   for(int i = 0; i < 3; i++)
   {
-    RingShader::Draw(position * zoom, radius, 1.2f, .16f, *color, 0.f, angle[i] + rotation);
+    RingShader::Draw(center, radius, 1.2f, .16f, *color, 0.f, angle[i] + rotation);
     if(isTargetingFlagship)
     {
       PointerShader::Draw(
-          position * zoom,
+          center,
           Angle(angle[i] + 30. + rotation).Unit(),
           7.5f,
           (i ? 10.f : 22.f) * zoom,
@@ -28,14 +28,21 @@ class Ship;
 class AlertLabel
 {
 public:
-  AlertLabel(const Point &position, const Projectile &projectile, const std::shared_ptr<Ship> &flagship, double zoom);
+  AlertLabel(
+      const Point                 &position,
+      const Point                 &velocity,
+      const Projectile            &projectile,
+      const std::shared_ptr<Ship> &flagship,
+      double                       zoom);
 
-  void Draw() const;
+  // Draw the label the given fraction of a step back along its velocity.
+  void Draw(double lag = 0.) const;
 
 
 private:
   double       rotation = 0.;
   Point        position;
+  Point        velocity;
   double       zoom                = 1.;
   bool         isTargetingFlagship = true;
   double       radius              = 15.;
@@ -118,7 +118,7 @@ void AsteroidField::Draw(DrawList &draw, const Point &center, double zoom) const
 
 
 // Check if the given projectile collides with any asteroids. This excludes minables.
-void AsteroidField::CollideAsteroids(const Projectile &projectile, std::vector<Collision> &result) const
+void AsteroidField::CollideAsteroids(const Projectile &projectile, std::pmr::vector<Collision> &result) const
 {
   // Check for collisions with ordinary asteroids, which are tiled.
   // Rather than tiling the collision set, tile the projectile.
@@ -149,14 +149,17 @@ void AsteroidField::CollideAsteroids(const Projectile &projectile, std::vector<C
 
 
 // Check if the given projectile collides with any minables.
-void AsteroidField::CollideMinables(const Projectile &projectile, std::vector<Collision> &result) const
+void AsteroidField::CollideMinables(const Projectile &projectile, std::pmr::vector<Collision> &result) const
 {
   minableCollisions.Line(projectile, result);
 }
 
 
 // Get a list of minables affected by an explosion with blast radius.
-void AsteroidField::MinablesCollisionsCircle(const Point &center, double radius, std::vector<Body *> &result) const
+void AsteroidField::MinablesCollisionsCircle(
+    const Point              &center,
+    double                    radius,
+    std::pmr::vector<Body *> &result) const
 {
   minableCollisions.Circle(center, radius, result);
 }
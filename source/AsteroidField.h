@@ -23,6 +23,7 @@ this program. If not, see <https://www.gnu.org/licenses/>.
 
 #include <list>
 #include <memory>
+#include <memory_resource>
 #include <string>
 #include <vector>
 
@@ -60,11 +61,11 @@ public:
   void Draw(DrawList &draw, const Point &center, double zoom) const;
 
   // Check if the given projectile collides with any asteroids. This excludes minables.
-  void CollideAsteroids(const Projectile &projectile, std::vector<Collision> &result) const;
+  void CollideAsteroids(const Projectile &projectile, std::pmr::vector<Collision> &result) const;
   // Check if the given projectile collides with any minables.
-  void CollideMinables(const Projectile &projectile, std::vector<Collision> &result) const;
+  void CollideMinables(const Projectile &projectile, std::pmr::vector<Collision> &result) const;
   // Get a list of minables affected by an explosion with blast radius.
-  void MinablesCollisionsCircle(const Point &center, double radius, std::vector<Body *> &result) const;
+  void MinablesCollisionsCircle(const Point &center, double radius, std::pmr::vector<Body *> &result) const;
 
   // Get the list of minable asteroids.
   const std::list<std::shared_ptr<Minable>> &Minables() const;
@@ -82,7 +83,6 @@ private:
     void Draw(DrawList &draw, const Point &center, double zoom) const;
 
   private:
-    Angle spin;
     Point size;
   };
 
@@ -74,6 +74,11 @@ Point Body::Center() const { return -rotatedCenter + position; }
 const Angle &Body::Facing() const { return angle; }
 
 
+// How far this body turned in its last step, so that it can be drawn turning
+// smoothly in between steps.
+const Angle &Body::Spin() const { return spin; }
+
+
 // Unit vector in the direction this body is facing. This represents the scale
 // and transform that should be applied to the sprite before drawing it.
 Point Body::Unit() const { return angle.Unit() * (.5 * Zoom()); }
@@ -58,6 +58,8 @@ public:
   Point        Center() const;
   const Angle &Facing() const;
   Point        Unit() const;
+  // How far this object turned in its last step.
+  const Angle &Spin() const;
 
   // Check if this object is marked for removal from the game.
   bool ShouldBeRemoved() const;
@@ -88,6 +90,8 @@ protected:
   Point position;
   Point velocity;
   Angle angle;
+  // How far this object turns in one step. Ships and projectiles set this on every step.
+  Angle spin;
   Point rotatedCenter;
 
   // The maximum distance at which the body is visible, and at which it becomes invisible again.
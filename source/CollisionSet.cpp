@@ -133,7 +133,7 @@ void CollisionSet::Finish()
 
 // Get all possible collisions for the given projectile. Collisions are not necessarily
 // sorted by distance.
-void CollisionSet::Line(const Projectile &projectile, std::vector<Collision> &result) const
+void CollisionSet::Line(const Projectile &projectile, std::pmr::vector<Collision> &result) const
 {
   // What objects the projectile hits depends on its government.
   const Government *pGov = projectile.GetGovernment();
@@ -148,11 +148,11 @@ void CollisionSet::Line(const Projectile &projectile, std::vector<Collision> &re
 // Get all possible collisions along a line. Collisions are not necessarily sorted by
 // distance.
 void CollisionSet::Line(
-    const Point            &from,
-    const Point            &to,
-    std::vector<Collision> &lineResult,
-    const Government       *pGov,
-    const Body             *target) const
+    const Point                 &from,
+    const Point                 &to,
+    std::pmr::vector<Collision> &lineResult,
+    const Government            *pGov,
+    const Body                  *target) const
 {
   const int x    = from.X();
   const int y    = from.Y();
@@ -296,7 +296,7 @@ void CollisionSet::Line(
 
 
 // Get all objects within the given range of the given point.
-void CollisionSet::Circle(const Point &center, double radius, std::vector<Body *> &result) const
+void CollisionSet::Circle(const Point &center, double radius, std::pmr::vector<Body *> &result) const
 {
   Ring(center, 0., radius, result);
 }
@@ -304,7 +304,11 @@ void CollisionSet::Circle(const Point &center, double radius, std::vector<Body *
 
 // Get all objects touching a ring with a given inner and outer range
 // centered at the given point.
-void CollisionSet::Ring(const Point &center, double inner, double outer, std::vector<Body *> &circleResult) const
+void CollisionSet::Ring(
+    const Point              &center,
+    double                    inner,
+    double                    outer,
+    std::pmr::vector<Body *> &circleResult) const
 {
   // Calculate the range of (x, y) grid coordinates this ring covers.
   const int minX = static_cast<int>(center.X() - outer) >> SHIFT;
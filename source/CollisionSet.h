@@ -18,6 +18,7 @@ this program. If not, see <https://www.gnu.org/licenses/>.
 #include "Collision.h"
 #include "CollisionType.h"
 
+#include <memory_resource>
 #include <vector>
 
 class Body;
@@ -46,22 +47,22 @@ public:
 
   // Get all possible collisions for the given projectile. Collisions are not necessarily
   // sorted by distance.
-  void Line(const Projectile &projectile, std::vector<Collision> &result) const;
+  void Line(const Projectile &projectile, std::pmr::vector<Collision> &result) const;
 
   // Get all possible collisions along a line. Collisions are not necessarily sorted by
   // distance.
   void Line(
-      const Point            &from,
-      const Point            &to,
-      std::vector<Collision> &result,
-      const Government       *pGov   = nullptr,
-      const Body             *target = nullptr) const;
+      const Point                 &from,
+      const Point                 &to,
+      std::pmr::vector<Collision> &result,
+      const Government            *pGov   = nullptr,
+      const Body                  *target = nullptr) const;
 
   // Get all objects within the given range of the given point.
-  void Circle(const Point &center, double radius, std::vector<Body *> &result) const;
+  void Circle(const Point &center, double radius, std::pmr::vector<Body *> &result) const;
   // Get all objects touching a ring with a given inner and outer range
   // centered at the given point.
-  void Ring(const Point &center, double inner, double outer, std::vector<Body *> &result) const;
+  void Ring(const Point &center, double inner, double outer, std::pmr::vector<Body *> &result) const;
 
   // Get all objects within this collision set.
   const std::vector<Body *> &All() const;
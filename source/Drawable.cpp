@@ -231,10 +231,7 @@ void Drawable::SetStep(int step) const
     frame = 0.f;
     return;
   }
-  float lastFrame = frames - 1.f;
-  // This is the number of frames per full cycle. If rewinding, a full cycle
-  // includes the first and last frames once and every other frame twice.
-  float cycle = (rewind ? 2.f * lastFrame : frames) + delay;
+  Animation animation{frameRate, frameOffset, 0.f, static_cast<float>(delay), repeat, rewind};
 
   // If this is the very first step, fill in some values that we could not set
   // until we knew the sprite's frame count and the starting step.
@@ -242,7 +239,7 @@ void Drawable::SetStep(int step) const
   {
     randomize = false;
     // The random offset can be a fractional frame.
-    frameOffset += static_cast<float>(Random::Real()) * cycle;
+    frameOffset += static_cast<float>(Random::Real()) * animation.Cycle(frames);
   }
   else if(startAtZero)
   {
@@ -251,9 +248,44 @@ void Drawable::SetStep(int step) const
     frameOffset -= frameRate * step;
   }
 
+  animation.frameOffset = frameOffset;
+  frame                 = animation.Frame(step, frames);
+}
+
+
+// Get the animation parameters of a copy of this sprite that is first drawn at the given step.
+Drawable::Animation Drawable::GetAnimation(int step) const
+{
+  // The copy is given the actual step rather than the paused one, so the time
+  // this animation was paused for is part of its offset.
+  Animation animation{frameRate, frameOffset - frameRate * pause, 0.f, static_cast<float>(delay), repeat, rewind};
+  if(randomize) animation.randomStart = static_cast<float>(Random::Real());
+  else if(startAtZero) animation.frameOffset = frameOffset - frameRate * step;
+  return animation;
+}
+
+
+// Get the number of frames per full cycle of a sprite with the given frame count.
+float Drawable::Animation::Cycle(float frames) const
+{
+  // If rewinding, a full cycle includes the first and last frames once and
+  // every other frame twice.
+  return (rewind ? 2.f * (frames - 1.f) : frames) + delay;
+}
+
+
+// Get the frame at the given step, for a sprite with the given frame count.
+float Drawable::Animation::Frame(int step, float frames) const
+{
+  // If the sprite only has one frame, no need to animate anything.
+  if(frames <= 1.f) return 0.f;
+
+  float lastFrame = frames - 1.f;
+  float cycle     = Cycle(frames);
+
   // Figure out what fraction of the way in between frames we are. Avoid any
   // possible floating-point glitches that might result in a negative frame.
-  frame = max(0.f, frameRate * step + frameOffset);
+  float frame = max(0.f, frameRate * step + frameOffset + randomStart * cycle);
   // If repeating, wrap the frame index by the total cycle time.
   if(repeat) frame = fmod(frame, cycle);
 
@@ -278,4 +310,5 @@ void Drawable::SetStep(int step) const
     // be less than 0, clamp it to 0.
     frame = max(0.f, lastFrame * 2.f - frame);
   }
+  return frame;
 }
@@ -30,6 +30,27 @@ class Sprite;
 // that can be animated.
 class Drawable
 {
+public:
+  // The parameters that decide which frame of an animation is shown at a given
+  // step, once its start frame is known. Copies of a sprite that are only drawn,
+  // never collided with, store these instead of the whole Drawable.
+  struct Animation
+  {
+    float frameRate   = 0.f;
+    float frameOffset = 0.f;
+    // A random start frame, as a fraction of one full cycle.
+    float randomStart = 0.f;
+    float delay       = 0.f;
+    bool  repeat      = true;
+    bool  rewind      = false;
+
+    // Get the number of frames per full cycle of a sprite with the given frame count.
+    float Cycle(float frames) const;
+    // Get the frame at the given step, for a sprite with the given frame count.
+    float Frame(int step, float frames) const;
+  };
+
+
 public:
   // Constructors.
   Drawable() = default;
@@ -75,6 +96,9 @@ protected:
   // Set what animation step we're on. This affects future calls to Body::GetMask()
   // and Drawable::GetFrame().
   void SetStep(int step) const;
+  // Get the animation parameters of a copy of this sprite that is first drawn at
+  // the given step. Unlike SetStep(), this does not pick a start frame for this object.
+  Animation GetAnimation(int step) const;
 
 
 protected:
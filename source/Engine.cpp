@@ -227,13 +227,15 @@ namespace
 
 Engine::Engine(PlayerInfo &player) :
   player(player),
-  ai(player, ships, asteroids.Minables(), flotsam),
+  antiMissiles(256u, 32u),
+  tractorBeams(256u, 32u),
+  ai(player, ships, asteroids.Minables(), flotsam, scratch),
   ammoDisplay(player),
   minimap(player),
   shipCollisions(256u, 32u, CollisionType::SHIP)
 {
   zoom.base     = Preferences::ViewZoom();
-  zoom.modifier = Preferences::Has("Landing zoom") ? 2. : 1.;
+  zoom.modifier = Preferences::Current().Has(Preferences::Flag::LANDING_ZOOM) ? 2. : 1.;
 
   if(!player.IsLoaded() || !player.GetSystem()) return;
 
@@ -473,12 +475,19 @@ void Engine::Wait()
 // Begin the next step of calculations.
 void Engine::Step(bool isActive)
 {
+  const Preferences::Snapshot &preferences = Preferences::Current();
+
   events.swap(eventQueue);
   eventQueue.clear();
+  isStepDrawn        = false;
+  scratchAllocations = scratch.Allocations();
+  scratchBytes       = scratch.BytesUsed();
 
   // Process any outstanding sprites that need to be uploaded to the GPU.
   queue.ProcessSyncTasks();
   asyncQueue.ProcessSyncTasks();
+  // The calculation thread is idle, so any reloaded sprite textures can be swapped in now.
+  SpriteLoadManager::UpdateResidency(asyncQueue);
 
   // A recently triggered event may have caused new objects to appear in the current system.
   // Ensure that they are loaded.
@@ -491,6 +500,18 @@ void Engine::Step(bool isActive)
   // The calculation thread was paused by MainPanel before calling this function, so it is safe to access things.
   const std::shared_ptr<Ship> flagship = player.FlagshipPtr();
   const StellarObject        *object   = player.GetStellarObject();
+
+  // After each jump, prepare the sprites for the systems the player may jump to next.
+  if(flagship && player.GetSystem() && player.GetSystem() != prefetchedSystem)
+  {
+    prefetchedSystem = player.GetSystem();
+    const ShipJumpNavigation       &navigation = flagship->JumpNavigation();
+    const std::set<const System *> &links      = navigation.HasJumpDrive()
+                                                     ? prefetchedSystem->JumpNeighbors(navigation.JumpRange())
+                                                     : prefetchedSystem->Links();
+    SpriteLoadManager::Prefetch(asyncQueue, links);
+  }
+
   if(object)
   {
     camera.SnapTo(object->Position());
@@ -557,7 +578,7 @@ void Engine::Step(bool isActive)
     {
       if(!nextZoom.base) nextZoom.base = zoom.base;
       // Update the current zoom modifier if the flagship is landing or taking off.
-      nextZoom.modifier = Preferences::Has("Landing zoom") ? 1. + pow(1. - flagship->Zoom(), 2) : 1.;
+      nextZoom.modifier = preferences.Has(Preferences::Flag::LANDING_ZOOM) ? 1. + pow(1. - flagship->Zoom(), 2) : 1.;
     }
 
     // Step the background to account for the current velocity and zoom.
@@ -566,7 +587,7 @@ void Engine::Step(bool isActive)
 
   outlines.clear();
   const Color &cloakColor = *GameData::Colors().Get("cloak highlight");
-  if(Preferences::Has("Cloaked ship outlines"))
+  if(preferences.Has(Preferences::Flag::CLOAKED_SHIP_OUTLINES))
   {
     for(const auto &ship : player.Ships())
     {
@@ -575,6 +596,7 @@ void Engine::Step(bool isActive)
       outlines.emplace_back(
           ship->GetSprite(),
           (ship->Position() - camera.Center()) * zoom,
+          (ship->Velocity() - camera.Velocity()) * zoom,
           ship->Unit() * zoom,
           ship->GetFrame(),
           Color::Multiply(ship->Cloaking(), cloakColor));
@@ -582,11 +604,12 @@ void Engine::Step(bool isActive)
   }
 
   // Add the flagship outline last to distinguish the flagship from other ships.
-  if(flagship && !flagship->IsDestroyed() && Preferences::Has("Highlight player's flagship"))
+  if(flagship && !flagship->IsDestroyed() && preferences.Has(Preferences::Flag::HIGHLIGHT_FLAGSHIP))
   {
     outlines.emplace_back(
         flagship->GetSprite(),
         (flagship->Center() - camera.Center()) * zoom,
+        (flagship->Velocity() - camera.Velocity()) * zoom,
         flagship->Unit() * zoom * flagship->Scale(),
         flagship->GetFrame(),
         *GameData::Colors().Get("flagship highlight"));
@@ -686,7 +709,7 @@ void Engine::Step(bool isActive)
     // Create the status overlays.
     CreateStatusOverlays();
     // Create missile overlays.
-    if(Preferences::Has("Show missile overlays"))
+    if(preferences.Has(Preferences::Flag::SHOW_MISSILE_OVERLAYS))
     {
       for(const Projectile &projectile : projectiles)
       {
@@ -694,19 +717,20 @@ void Engine::Step(bool isActive)
         if(projectile.MissileStrength() && projectile.GetGovernment()->IsEnemy() &&
            (pos.Length() < std::max(Screen::Width(), Screen::Height()) * .5 / zoom))
         {
-          missileLabels.emplace_back(AlertLabel(pos, projectile, flagship, zoom));
+          missileLabels.emplace_back(
+              AlertLabel(pos, projectile.Velocity() - camera.Velocity(), projectile, flagship, zoom));
         }
       }
     }
     // Create overlays for flagship turrets with blindspots.
-    if(flagship && Preferences::GetTurretOverlays() != Preferences::TurretOverlays::OFF)
+    if(flagship && preferences.turretOverlays != Preferences::TurretOverlays::OFF)
     {
       for(const Hardpoint &hardpoint : flagship->Weapons())
       {
         if(!hardpoint.GetBaseAttributes().blindspots.empty())
         {
           bool isBlind = hardpoint.IsBlind();
-          if(Preferences::GetTurretOverlays() == Preferences::TurretOverlays::BLINDSPOTS_ONLY && !isBlind) continue;
+          if(preferences.turretOverlays == Preferences::TurretOverlays::BLINDSPOTS_ONLY && !isBlind) continue;
           // TODO: once Apple Clang adds support for C++20 aggregate initialization,
           // this can be removed.
 #ifdef __APPLE__
@@ -717,6 +741,7 @@ void Engine::Step(bool isActive)
               (flagship->Position() - camera.Center() +
                flagship->Zoom() * flagship->Facing().Rotate(hardpoint.GetPoint())) *
                   static_cast<double>(zoom),
+              (flagship->Velocity() - camera.Velocity()) * static_cast<double>(zoom),
               (flagship->Facing() + hardpoint.GetAngle()).Unit(),
               flagship->Zoom() * static_cast<double>(zoom),
               isBlind
@@ -729,7 +754,7 @@ void Engine::Step(bool isActive)
     }
     // Update the planet label positions.
     for(PlanetLabel &label : labels)
-      label.Update(camera.Center(), zoom, labels, *player.GetSystem());
+      label.Update(camera.Center(), camera.Velocity(), zoom, labels, *player.GetSystem());
   }
 
   if(flagship && flagship->IsOverheated()) Messages::Add(*GameData::Messages().Get("overheated"));
@@ -739,7 +764,7 @@ void Engine::Step(bool isActive)
   if(flagship && flagship->Hull())
   {
     Point shipFacingUnit(0., -1.);
-    if(Preferences::Has("Rotate flagship in HUD")) shipFacingUnit = flagship->Facing().Unit();
+    if(preferences.Has(Preferences::Flag::ROTATE_FLAGSHIP_IN_HUD)) shipFacingUnit = flagship->Facing().Unit();
 
     info.SetSprite(
         "player sprite",
@@ -762,7 +787,7 @@ void Engine::Step(bool isActive)
     {
       --nukeAlarmTime;
     }
-    else if(nukeAlert && Preferences::PlayAudioAlert())
+    else if(nukeAlert && preferences.PlayAudioAlert())
     {
       nukeAlarmTime = 300;
       Audio::Play(Audio::Get("nuke alarm"), SoundCategory::ALERT);
@@ -773,7 +798,7 @@ void Engine::Step(bool isActive)
       {
         if(uiStep / 12 % 2) info.SetCondition("nuke alert");
       }
-      else if(alarmTime && uiStep / 20 % 2 && Preferences::DisplayVisualAlert())
+      else if(alarmTime && uiStep / 20 % 2 && preferences.DisplayVisualAlert())
       {
         info.SetCondition("red alert");
       }
@@ -813,6 +838,7 @@ void Engine::Step(bool isActive)
 
     targets.push_back(
         {object->Position() - camera.Center(),
+         object->Velocity() - camera.Velocity(),
          object->Facing(),
          object->Radius(),
          GetPlanetTargetPointerColor(*object->GetPlanet()),
@@ -898,6 +924,7 @@ void Engine::Step(bool isActive)
       double size = (target->Width() + target->Height()) * .35;
       targets.push_back(
           {target->Position() - camera.Center(),
+           target->Velocity() - camera.Velocity(),
            Angle(45.) + target->Facing(),
            size,
            GetShipTargetPointerColor(targetType),
@@ -997,16 +1024,18 @@ void Engine::Step(bool isActive)
       }
     }
   }
-  if(!Preferences::Has("Ship outlines in HUD")) info.SetCondition("fast hud sprites");
+  if(!preferences.Has(Preferences::Flag::SHIP_OUTLINES_IN_HUD)) info.SetCondition("fast hud sprites");
   if(target && target->IsTargetable() && target->GetSystem() == currentSystem &&
      (flagship->CargoScanFraction() || flagship->OutfitScanFraction()))
   {
     double     width         = std::max(target->Width(), target->Height());
     Point      pos           = target->Position() - camera.Center();
+    Point      velocity      = target->Velocity() - camera.Velocity();
     const bool outfitInRange = pos.LengthSquared() <= (flagship->Attributes().Get("outfit scan power") * 10'000);
     const Status::Type outfitOverlayType = outfitInRange ? Status::Type::SCAN : Status::Type::SCAN_OUT_OF_RANGE;
     statuses.emplace_back(
         pos,
+        velocity,
         flagship->OutfitScanFraction(),
         0.,
         0.,
@@ -1018,6 +1047,7 @@ void Engine::Step(bool isActive)
     const Status::Type cargoOverlayType = cargoInRange ? Status::Type::SCAN : Status::Type::SCAN_OUT_OF_RANGE;
     statuses.emplace_back(
         pos,
+        velocity,
         0.,
         flagship->CargoScanFraction(),
         0.,
@@ -1075,6 +1105,7 @@ void Engine::Step(bool isActive)
       double size = (ship->Width() + ship->Height()) * .35;
       targets.push_back(
           {ship->Position() - camera.Center(),
+           ship->Velocity() - camera.Velocity(),
            Angle(45.) + ship->Facing(),
            size,
            *GameData::Colors().Get("ship target pointer player"),
@@ -1083,7 +1114,7 @@ void Engine::Step(bool isActive)
   }
 
   // Draw crosshairs on any minables in range of the flagship's scanners.
-  bool shouldShowAsteroidOverlay = Preferences::Has("Show asteroid scanner overlay");
+  bool shouldShowAsteroidOverlay = preferences.Has(Preferences::Flag::SHOW_ASTEROID_SCANNER_OVERLAY);
   // Decide before looping whether or not to catalog asteroids. This
   // results in cataloging in-range asteroids roughly 3 times a second.
   bool shouldCatalogAsteroids = (!isAsteroidCatalogComplete && !Random::Int(20));
@@ -1113,7 +1144,13 @@ void Engine::Step(bool isActive)
 
         if(!shouldShowAsteroidOverlay || !inRange || flagship->GetTargetAsteroid() == minable) continue;
 
-        targets.push_back({offset, minable->Facing(), .8 * minable->Radius(), GetMinablePointerColor(false), 3});
+        targets.push_back(
+            {offset,
+             minable->Velocity() - camera.Velocity(),
+             minable->Facing(),
+             .8 * minable->Radius(),
+             GetMinablePointerColor(false),
+             3});
       }
       if(shouldCatalogAsteroids && scanComplete) isAsteroidCatalogComplete = true;
     }
@@ -1123,6 +1160,7 @@ void Engine::Step(bool isActive)
   {
     targets.push_back(
         {targetAsteroidPtr->Position() - camera.Center(),
+         targetAsteroidPtr->Velocity() - camera.Velocity(),
          targetAsteroidPtr->Facing(),
          .8 * targetAsteroidPtr->Radius(),
          GetMinablePointerColor(true),
@@ -1140,10 +1178,23 @@ void Engine::Go()
 }
 
 
+// Check whether the calculations of the current step are done, so that
+// Wait() would not block.
+bool Engine::IsCalculationDone() const { return queue.IsDone(); }
+
+
 // Whether the flow of time is paused.
 bool Engine::IsPaused() const { return timePaused; }
 
 
+// How many allocations the last step made for data that it only needed during
+// that step, and how much memory they used.
+std::size_t Engine::ScratchAllocations() const { return scratchAllocations; }
+
+
+std::size_t Engine::ScratchBytes() const { return scratchBytes; }
+
+
 // Give a command on behalf of the player, used for integration tests.
 void Engine::GiveCommand(const Command &command) { activeCommands.Set(command); }
 
@@ -1153,15 +1204,32 @@ void Engine::GiveCommand(const Command &command) { activeCommands.Set(command);
 std::list<ShipEvent> &Engine::Events() { return events; }
 
 
+// Set how much of the time until the next step has passed, from 0 to 1.
+void Engine::SetDrawProgress(double progress) { drawProgress = std::clamp(progress, 0., 1.); }
+
+
 // Draw a frame.
 void Engine::Draw() const
 {
-  ++uiStep;
+  // Frames drawn in between steps do not advance the UI.
+  if(!isStepDrawn)
+  {
+    isStepDrawn = true;
+    ++uiStep;
+  }
+  const Preferences::Snapshot &preferences = Preferences::Current();
+
+  // The draw lists hold where everything was at the last step. Draw it as it
+  // was the given fraction of a step earlier, going by its velocity, so that
+  // frames drawn in between two steps move it smoothly from where it was in
+  // the step before. The same goes for the overlays and labels drawn on top
+  // of them. While time is paused, nothing moves.
+  const float lag = timePaused ? 0.f : static_cast<float>(1. - drawProgress);
 
   Point  motionBlur = camera.Velocity();
-  double baseBlur   = Preferences::Has("Render motion blur") ? 1. : 0.;
+  double baseBlur   = preferences.Has(Preferences::Flag::RENDER_MOTION_BLUR) ? 1. : 0.;
 
-  Preferences::ExtendedJumpEffects jumpEffectState = Preferences::GetExtendedJumpEffects();
+  Preferences::ExtendedJumpEffects jumpEffectState = preferences.extendedJumpEffects;
   if(jumpEffectState != Preferences::ExtendedJumpEffects::OFF)
   {
     motionBlur *=
@@ -1172,18 +1240,21 @@ void Engine::Draw() const
     motionBlur *= baseBlur;
   }
 
-  GameData::Background().Draw(motionBlur, player.Flagship() ? player.Flagship()->GetSystem() : player.GetSystem());
+  GameData::Background().Draw(
+      motionBlur,
+      player.Flagship() ? player.Flagship()->GetSystem() : player.GetSystem(),
+      lag);
 
   static const Set<Color> &colors = GameData::Colors();
   const Interface         *hud    = GameData::Interfaces().Get("hud");
 
   // Draw any active planet labels.
-  if(Preferences::Has("Show planet labels"))
+  if(preferences.Has(Preferences::Flag::SHOW_PLANET_LABELS))
     for(const PlanetLabel &label : labels)
-      label.Draw();
+      label.Draw(lag);
 
-  draw[currentDrawBuffer].Draw();
-  batchDraw[currentDrawBuffer].Draw();
+  draw[currentDrawBuffer].Draw(lag);
+  batchDraw[currentDrawBuffer].Draw(lag);
 
   for(const auto &it : statuses)
   {
@@ -1204,7 +1275,7 @@ void Engine::Draw() const
         *colors.Get("overlay friendly disabled"),
         *colors.Get("overlay hostile disabled"),
         *colors.Get("overlay neutral disabled")};
-    Point  pos        = it.position * zoom;
+    Point  pos        = (it.position - it.velocity * lag) * zoom;
     double radius     = it.radius * zoom;
     int    colorIndex = static_cast<int>(it.type);
     if(it.outer > 0.)
@@ -1220,13 +1291,14 @@ void Engine::Draw() const
 
   // Draw labels on missiles
   for(const AlertLabel &label : missileLabels)
-    label.Draw();
+    label.Draw(lag);
 
   for(const auto &outline : outlines)
   {
     if(!outline.sprite) continue;
     Point size(outline.sprite->Width(), outline.sprite->Height());
-    OutlineShader::Draw(outline.sprite, outline.position, size, outline.color, outline.unit, outline.frame);
+    Point position = outline.position - outline.velocity * lag;
+    OutlineShader::Draw(outline.sprite, position, size, outline.color, outline.unit, outline.frame);
   }
 
   // Draw turret overlays.
@@ -1238,7 +1310,7 @@ void Engine::Draw() const
     for(const TurretOverlay &it : turretOverlays)
     {
       PointerShader::Add(
-          it.position,
+          it.position - it.velocity * lag,
           it.angle,
           8 * it.scale,
           24 * it.scale,
@@ -1294,13 +1366,14 @@ void Engine::Draw() const
   // Draw crosshairs around anything that is targeted.
   for(const Target &target : targets)
   {
-    Angle a = target.angle;
+    Point center = (target.center - target.velocity * lag) * zoom;
+    Angle a      = target.angle;
     Angle da(360. / target.count);
 
     PointerShader::Bind();
     for(int i = 0; i < target.count; ++i)
     {
-      PointerShader::Add(target.center * zoom, a.Unit(), 12.f, 14.f, -target.radius * zoom, target.color);
+      PointerShader::Add(center, a.Unit(), 12.f, 14.f, -target.radius * zoom, target.color);
       a += da;
     }
     PointerShader::Unbind();
@@ -1362,8 +1435,8 @@ void Engine::Click(const Point &from, const Point &to, bool hasShift, bool hasCo
   const Interface *hud         = GameData::Interfaces().Get("hud");
   Point            radarCenter = hud->GetPoint("radar");
   double           radarRadius = hud->GetValue("radar radius");
-  if(Preferences::Has("Clickable radar display") && (from - radarCenter).Length() <= radarRadius) isRadarClick = true;
-  else isRadarClick = false;
+  isRadarClick = Preferences::Current().Has(Preferences::Flag::CLICKABLE_RADAR_DISPLAY) &&
+                 (from - radarCenter).Length() <= radarRadius;
 
   clickPoint = isRadarClick ? from - radarCenter : from;
   uiClickBox = Rectangle::WithCorners(from, to);
@@ -1390,7 +1463,8 @@ void Engine::RightOrMiddleClick(const Point &point, MouseButton button)
   const Interface *hud         = GameData::Interfaces().Get("hud");
   Point            radarCenter = hud->GetPoint("radar");
   double           radarRadius = hud->GetValue("radar radius");
-  if(Preferences::Has("Clickable radar display") && (point - radarCenter).Length() <= radarRadius)
+  if(Preferences::Current().Has(Preferences::Flag::CLICKABLE_RADAR_DISPLAY) &&
+     (point - radarCenter).Length() <= radarRadius)
   {
     double radarScale = hud->GetValue("radar scale");
     clickPoint        = (point - radarCenter) / radarScale;
@@ -1559,6 +1633,7 @@ void Engine::EnterSystem()
 
   projectiles.clear();
   visuals.clear();
+  activeVisuals.Clear();
   flotsam.clear();
   // Cancel any projectiles, visuals, or flotsam created by ships this step.
   newProjectiles.clear();
@@ -1595,6 +1670,9 @@ void Engine::CalculateStep()
   // as soon as the calculation thread is finished.
   const double zoom = nextZoom ? nextZoom : this->zoom;
 
+  // Nothing from the last step's scratch memory is still in use.
+  scratch.Reset();
+
   // Clear the list of objects to draw.
   draw[currentCalcBuffer].Clear(step, zoom);
   batchDraw[currentCalcBuffer].Clear(step, zoom);
@@ -1628,7 +1706,7 @@ void Engine::CalculateStep()
     newCamera.MoveTo(flagship->Center(), hyperspacePercentage);
   }
   draw[currentCalcBuffer].SetCenter(newCamera.Center(), newCamera.Velocity());
-  batchDraw[currentCalcBuffer].SetCenter(newCamera.Center());
+  batchDraw[currentCalcBuffer].SetCenter(newCamera.Center(), newCamera.Velocity());
   radar[currentCalcBuffer].SetCenter(newCamera.Center());
 
   // Populate the radar.
@@ -1691,9 +1769,10 @@ void Engine::CalculateStep()
   // Draw the projectiles.
   for(const Projectile &projectile : projectiles)
     batchDraw[currentCalcBuffer].Add(projectile, projectile.Clip());
-  // Draw the visuals.
-  for(const Visual &visual : visuals)
-    batchDraw[currentCalcBuffer].AddVisual(visual);
+  // Draw the visuals. Any that were created since the last step are recorded
+  // here, after which only their records are kept.
+  activeVisuals.Add(visuals, step);
+  batchDraw[currentCalcBuffer].AddVisuals(activeVisuals);
 }
 
 
@@ -1785,7 +1864,7 @@ void Engine::CalculateUnpaused(const Ship *flagship, const System *playerSystem)
         wormholeEntry                  ? SystemEntry::WORMHOLE
         : flagship->IsUsingJumpDrive() ? SystemEntry::JUMP
                                        : SystemEntry::HYPERDRIVE);
-    doFlash      = Preferences::Has("Show hyperspace flash");
+    doFlash      = Preferences::Current().Has(Preferences::Flag::SHOW_HYPERSPACE_FLASH);
     playerSystem = flagship->GetSystem();
     player.SetSystem(*playerSystem);
     EnterSystem();
@@ -1812,10 +1891,9 @@ void Engine::CalculateUnpaused(const Ship *flagship, const System *playerSystem)
     weather.Step(newVisuals, flagship ? flagship->Position() : camera.Center());
   Prune(activeWeather);
 
-  // Move the visuals.
-  for(Visual &visual : visuals)
-    visual.Move();
-  Prune(visuals);
+  // Visuals are not moved; where they are follows from the step. Only the
+  // ones that have expired need to be removed.
+  activeVisuals.Prune(step);
 
   // Perform various minor actions.
   SpawnFleets();
@@ -1841,23 +1919,25 @@ void Engine::CalculateUnpaused(const Ship *flagship, const System *playerSystem)
   FillCollisionSets();
 
   // Perform collision detection.
+  antiMissiles.Finish();
   for(Projectile &projectile : projectiles)
     DoCollisions(projectile);
   // Now that collision detection is done, clear the cache of ships with anti-
   // missile systems ready to fire.
-  hasAntiMissile.clear();
+  antiMissiles.Clear();
 
   // Damage ships from any active weather events.
   for(Weather &weather : activeWeather)
     DoWeather(weather);
 
   // Check for flotsam collection (collisions with ships).
+  tractorBeams.Finish();
   for(const std::shared_ptr<Flotsam> &it : flotsam)
     DoCollection(*it);
 
   // Now that flotsam collection is done, clear the cache of ships with
   // tractor beam systems ready to fire.
-  hasTractorBeam.clear();
+  tractorBeams.Clear();
 
   // Check for ship scanning.
   for(const std::shared_ptr<Ship> &it : ships)
@@ -1965,8 +2045,8 @@ void Engine::MoveShip(const std::shared_ptr<Ship> &ship)
 
   // Anti-missile and tractor beam systems are fired separately from normal weaponry.
   // Track which ships have at least one such system ready to fire.
-  if(ship->HasAntiMissile()) hasAntiMissile.push_back(ship.get());
-  if(ship->HasTractorBeam()) hasTractorBeam.push_back(ship.get());
+  if(ship->HasAntiMissile()) antiMissiles.Add(ship.get(), ship->AntiMissileRange());
+  if(ship->HasTractorBeam()) tractorBeams.Add(ship.get(), ship->TractorBeamRange());
 }
 
 
@@ -2342,7 +2422,7 @@ void Engine::HandleMouseInput(Command &activeCommands)
   // XOR mouse hold and mouse toggle. If mouse toggle is OFF, then mouse hold
   // will temporarily turn ON mouse control. If mouse toggle is ON, then mouse
   // hold will temporarily turn OFF mouse control.
-  isMouseTurningEnabled = isMouseHoldEnabled ^ Preferences::Has("Control ship with mouse");
+  isMouseTurningEnabled = isMouseHoldEnabled ^ Preferences::Current().Has(Preferences::Flag::CONTROL_SHIP_WITH_MOUSE);
   if(!isMouseTurningEnabled) return;
   activeCommands.Set(Command::MOUSE_TURNING_HOLD);
 
@@ -2359,9 +2439,9 @@ void Engine::DoCollisions(Projectile &projectile)
   // The asteroids can collide with projectiles, the same as any other
   // object. If the asteroid turns out to be closer than the ship, it
   // shields the ship (unless the projectile has a blast radius).
-  std::vector<Collision> collisions;
-  const Government      *gov    = projectile.GetGovernment();
-  const Weapon          &weapon = projectile.GetWeapon();
+  std::pmr::vector<Collision> collisions(&scratch);
+  const Government           *gov    = projectile.GetGovernment();
+  const Weapon               &weapon = projectile.GetWeapon();
 
   if(projectile.ShouldExplode())
   {
@@ -2391,8 +2471,8 @@ void Engine::DoCollisions(Projectile &projectile)
     double triggerRadius = weapon.TriggerRadius();
     if(triggerRadius)
     {
-      std::vector<Body *> inRadius;
-      inRadius.reserve(std::min(static_cast<std::vector<Body *>::size_type>(triggerRadius), ships.size()));
+      std::pmr::vector<Body *> inRadius(&scratch);
+      inRadius.reserve(std::min(static_cast<std::size_t>(triggerRadius), ships.size()));
       shipCollisions.Circle(projectile.Position(), triggerRadius, inRadius);
       for(const Body *body : inRadius)
       {
@@ -2448,9 +2528,9 @@ void Engine::DoCollisions(Projectile &projectile)
     {
       // Even friendly ships can be hit by the blast, unless it is a
       // "safe" weapon.
-      Point               hitPos = projectile.Position() + range * projectile.Velocity();
-      bool                isSafe = weapon.IsSafe();
-      std::vector<Body *> blastCollisions;
+      Point                    hitPos = projectile.Position() + range * projectile.Velocity();
+      bool                     isSafe = weapon.IsSafe();
+      std::pmr::vector<Body *> blastCollisions(&scratch);
       blastCollisions.reserve(32);
       shipCollisions.Circle(hitPos, blastRadius, blastCollisions);
       for(Body *body : blastCollisions)
@@ -2493,7 +2573,10 @@ void Engine::DoCollisions(Projectile &projectile)
   // If the projectile is still alive, give the anti-missile systems a chance to shoot it down.
   if(!projectile.IsDead() && projectile.MissileStrength())
   {
-    for(Ship *ship : hasAntiMissile)
+    // Only the ships that are close enough need to be given a chance.
+    std::pmr::vector<Ship *> defenders(&scratch);
+    antiMissiles.Reaching(projectile.Position(), defenders);
+    for(Ship *ship : defenders)
     {
       if(ship == projectile.Target() || gov->IsEnemy(ship->GetGovernment()))
       {
@@ -2522,10 +2605,10 @@ void Engine::DoWeather(Weather &weather)
     // Get all ship bodies that are touching a ring defined by the hazard's min
     // and max ranges at the hazard's origin. Any ship touching this ring takes
     // hazard damage.
-    std::vector<Body *> affectedShips;
+    std::pmr::vector<Body *> affectedShips(&scratch);
     if(hazard->SystemWide())
     {
-      affectedShips = shipCollisions.All();
+      affectedShips.assign(shipCollisions.All().begin(), shipCollisions.All().end());
     }
     else {
       affectedShips.reserve(ships.size());
@@ -2544,8 +2627,8 @@ void Engine::DoWeather(Weather &weather)
 void Engine::DoCollection(Flotsam &flotsam)
 {
   // Check if any ship can pick up this flotsam. Cloaked ships without "cloaked pickup" cannot act.
-  Ship               *collector = nullptr;
-  std::vector<Body *> pickupShips;
+  Ship                    *collector = nullptr;
+  std::pmr::vector<Body *> pickupShips(&scratch);
   pickupShips.reserve(16);
   shipCollisions.Circle(flotsam.Position(), 5., pickupShips);
   for(Body *body : pickupShips)
@@ -2567,7 +2650,10 @@ void Engine::DoCollection(Flotsam &flotsam)
     // Also determine the average velocity of the ships pulling on this flotsam.
     Point avgShipVelocity;
     int   count = 0;
-    for(Ship *ship : hasTractorBeam)
+    // Only the ships that are close enough need to be given a chance.
+    std::pmr::vector<Ship *> pullers(&scratch);
+    tractorBeams.Reaching(flotsam.Position(), pullers);
+    for(Ship *ship : pullers)
     {
       Point shipPull = ship->FireTractorBeam(flotsam, visuals);
       if(shipPull)
@@ -2604,7 +2690,7 @@ void Engine::DoCollection(Flotsam &flotsam)
   bool collectorIsFlagship = collector == player.Flagship();
   if(collector->IsYours())
   {
-    const auto flotsamSetting = Preferences::GetFlotsamCollection();
+    const auto flotsamSetting = Preferences::Current().flotsamCollection;
     if(flotsamSetting == Preferences::FlotsamCollection::OFF) return;
     if(collectorIsFlagship && flotsamSetting == Preferences::FlotsamCollection::ESCORT) return;
     if(!collectorIsFlagship && flotsamSetting == Preferences::FlotsamCollection::FLAGSHIP) return;
@@ -2616,7 +2702,7 @@ void Engine::DoCollection(Flotsam &flotsam)
   // If the collector is not one of the player's ships, we can bail out now.
   if(!collector->IsYours()) return;
 
-  if(!collectorIsFlagship && !Preferences::Has("Extra fleet status messages")) return;
+  if(!collectorIsFlagship && !Preferences::Current().Has(Preferences::Flag::EXTRA_FLEET_STATUS_MESSAGES)) return;
 
   // One of your ships picked up this flotsam. Describe who it was.
   std::string name =
@@ -2714,7 +2800,7 @@ void Engine::FillRadar()
   }
 
   // Add viewport brackets.
-  if(!Preferences::Has("Disable viewport on radar"))
+  if(!Preferences::Current().Has(Preferences::Flag::DISABLE_VIEWPORT_ON_RADAR))
   {
     radar[currentCalcBuffer].AddViewportBoundary(Screen::TopLeft() / zoom);
     radar[currentCalcBuffer].AddViewportBoundary(Screen::TopRight() / zoom);
@@ -2753,7 +2839,7 @@ void Engine::FillRadar()
   }
   else if(hasHostiles && !hadHostiles)
   {
-    if(Preferences::PlayAudioAlert()) Audio::Play(Audio::Get("alarm"), SoundCategory::ALERT);
+    if(Preferences::Current().PlayAudioAlert()) Audio::Play(Audio::Get("alarm"), SoundCategory::ALERT);
     alarmTime   = 300;
     hadHostiles = true;
   }
@@ -2787,7 +2873,7 @@ void Engine::DrawShipSprites(const Ship &ship)
   bool           hasFighters  = ship.PositionFighters();
   double         cloak        = ship.Cloaking();
   bool           drawCloaked  = (cloak && ship.IsYours());
-  bool           fancyCloak   = Preferences::Has("Cloaked ship outlines");
+  bool           fancyCloak   = Preferences::Current().Has(Preferences::Flag::CLOAKED_SHIP_OUTLINES);
   const Swizzle *cloakSwizzle = GameData::Swizzles().Get(fancyCloak ? "cloak fancy base" : "cloak fast");
   auto          &itemsToDraw  = draw[currentCalcBuffer];
   auto           drawObject   = [&itemsToDraw, cloak, drawCloaked, fancyCloak, cloakSwizzle](const Body &body) -> void
@@ -3017,6 +3103,7 @@ void Engine::EmplaceStatusOverlay(
 
   statuses.emplace_back(
       it->Position() - camera.Center(),
+      it->Velocity() - camera.Velocity(),
       it->Shields(),
       it->Hull(),
       std::min(it->Hull(), it->DisabledHull()),
@@ -33,7 +33,10 @@ this program. If not, see <https://www.gnu.org/licenses/>.
 #include "Projectile.h"
 #include "Radar.h"
 #include "Rectangle.h"
+#include "ScratchArena.h"
+#include "ShipRangeIndex.h"
 #include "TaskQueue.h"
+#include "VisualList.h"
 #include "shader/BatchDrawList.h"
 #include "shader/DrawList.h"
 
@@ -53,6 +56,7 @@ class Ship;
 class ShipEvent;
 class Sprite;
 class Swizzle;
+class System;
 class Visual;
 class Weather;
 
@@ -82,8 +86,15 @@ public:
   void Step(bool isActive);
   // Begin the next step of calculations.
   void Go();
+  // Check whether the calculations of the current step are done, so that
+  // Wait() would not block.
+  bool IsCalculationDone() const;
   // Whether the player has the game paused.
   bool IsPaused() const;
+  // How many allocations the last step made for data that it only needed during
+  // that step, and how much memory they used.
+  std::size_t ScratchAllocations() const;
+  std::size_t ScratchBytes() const;
 
   // Give a command on behalf of the player, used for integration tests.
   void GiveCommand(const Command &command);
@@ -92,6 +103,10 @@ public:
   // MainPanel::Step will clear this list.
   std::list<ShipEvent> &Events();
 
+  // Set how much of the time until the next step has passed, from 0 to 1.
+  // Objects are then drawn that far between where they were in the last two
+  // steps, so frames can be drawn more often than the game steps forward.
+  void SetDrawProgress(double progress);
   // Draw a frame.
   void Draw() const;
 
@@ -110,13 +125,20 @@ private:
   class Outline
   {
   public:
-    Outline(const Sprite *sprite, const Point &position, const Point &unit, const float frame, const Color &color) :
-      sprite(sprite), position(position), unit(unit), frame(frame), color(color)
+    Outline(
+        const Sprite *sprite,
+        const Point  &position,
+        const Point  &velocity,
+        const Point  &unit,
+        const float   frame,
+        const Color  &color) :
+      sprite(sprite), position(position), velocity(velocity), unit(unit), frame(frame), color(color)
     {
     }
 
     const Sprite *sprite;
     const Point   position;
+    const Point   velocity;
     const Point   unit;
     const float   frame;
     const Color   color;
@@ -126,6 +148,7 @@ private:
   {
   public:
     Point        center;
+    Point        velocity;
     Angle        angle;
     double       radius;
     const Color &color;
@@ -149,6 +172,7 @@ private:
   public:
     constexpr Status(
         const Point &position,
+        const Point &velocity,
         double       outer,
         double       inner,
         double       disabled,
@@ -157,6 +181,7 @@ private:
         float        alpha,
         double       angle = 0.) :
       position(position),
+      velocity(velocity),
       outer(outer),
       inner(inner),
       disabled(disabled),
@@ -168,6 +193,7 @@ private:
     }
 
     Point  position;
+    Point  velocity;
     double outer;
     double inner;
     double disabled;
@@ -181,6 +207,7 @@ private:
   {
   public:
     Point  position;
+    Point  velocity;
     Point  angle;
     double scale;
     bool   isBlind;
@@ -246,6 +273,8 @@ private:
   std::list<std::shared_ptr<Flotsam>> flotsam;
   std::vector<Visual>                 visuals;
   AsteroidField                       asteroids;
+  // The visuals that have been drawn at least once, kept as records of where they were created.
+  VisualList activeVisuals;
 
   // New objects created within the latest step:
   std::list<std::shared_ptr<Ship>>    newShips;
@@ -254,14 +283,22 @@ private:
   std::vector<Visual>                 newVisuals;
 
   // Track which ships currently have anti-missiles or
-  // tractor beams ready to fire.
-  std::vector<Ship *> hasAntiMissile;
-  std::vector<Ship *> hasTractorBeam;
+  // tractor beams ready to fire, and where they can reach.
+  ShipRangeIndex antiMissiles;
+  ShipRangeIndex tractorBeams;
+
+  // The memory for anything that is only needed during a single step. It is reset at
+  // the start of each step, so nothing allocated from it may be kept past the end of one.
+  ScratchArena scratch;
+  std::size_t  scratchAllocations = 0;
+  std::size_t  scratchBytes       = 0;
 
   AI ai;
 
   TaskQueue queue;
   TaskQueue asyncQueue;
+  // The system whose neighbors have had their sprites prefetched.
+  const System *prefetchedSystem = nullptr;
 
   // ES uses a technique called double buffering to calculate the next frame and render the current one simultaneously.
   // To facilitate this, it uses two buffers for each list of things to draw - one for the next frame's calculations and
@@ -272,6 +309,8 @@ private:
   DrawList      draw[2];
   BatchDrawList batchDraw[2];
   Radar         radar[2];
+  // How much of the time until the next step has passed when drawing a frame.
+  double drawProgress = 1.;
 
   bool wasActive             = false;
   bool isMouseHoldEnabled    = false;
@@ -303,8 +342,10 @@ private:
 
   int step = 0;
   // Count steps for UI elements separately, because they shouldn't be affected by pausing.
-  mutable int uiStep     = 0;
-  bool        timePaused = false;
+  // They are counted when a step is first drawn, so frames drawn in between steps do not count.
+  mutable int  uiStep      = 0;
+  mutable bool isStepDrawn = true;
+  bool         timePaused  = false;
 
   std::list<ShipEvent> eventQueue;
   std::list<ShipEvent> events;
@@ -476,6 +476,9 @@ std::pair<Point, double> Fleet::ChooseCenter(const System &system)
 }
 
 
+const WeightedList<Variant> &Fleet::Variants() const { return variants; }
+
+
 std::vector<std::shared_ptr<Ship>> Fleet::Instantiate(const std::vector<const Ship *> &ships) const
 {
   std::vector<std::shared_ptr<Ship>> placed;
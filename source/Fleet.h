@@ -74,6 +74,9 @@ public:
 
   int64_t Strength() const;
 
+  // The variants of ships that this fleet may spawn.
+  const WeightedList<Variant> &Variants() const;
+
 
 private:
   static std::pair<Point, double>    ChooseCenter(const System &system);
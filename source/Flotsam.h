@@ -86,7 +86,6 @@ public:
 
 
 private:
-  Angle  spin;
   int    lifetime = 0;
   double drag     = 0.999;
 
@@ -41,13 +41,13 @@ void FormationPositioner::Step()
   // from the lead ship as soon as they happen.
   CalculateDirection();
 
-  // Calculate the set of positions for the participating ships. This calculation
-  // can be performed once every 20 game-steps, because the positions are
-  // relatively stable and slower changes don't impact the formation a lot.
+  // Check for ships that left the formation once every 20 game-steps. Ships
+  // that leave are not in the way of the others, so the formation can wait a
+  // little before closing the gaps that they leave behind.
   constexpr int POSITIONS_INTERVAL = 20;
   if(positionsTimer == 0)
   {
-    CalculatePositions();
+    RemoveInactive();
     positionsTimer = POSITIONS_INTERVAL;
   }
   else {
@@ -58,78 +58,45 @@ void FormationPositioner::Step()
 
 Point FormationPositioner::Position(const Ship *ship)
 {
-  Point relPos;
-
-  auto it = shipPositions.find(ship);
-  if(it != shipPositions.end())
+  auto it = participants.find(ship);
+  if(it == participants.end())
   {
-    // Retrieve the ships currently known coordinate in the formation.
-    auto &status = it->second;
-
-    // Register that this ship was seen.
-    if(status.second != tickTock) status.second = tickTock;
-
-    // Return the cached position that we have for the ship.
-    relPos = status.first;
+    // Give the ship the first free slot in the formation.
+    it                     = participants.emplace(ship, Participant()).first;
+    it->second.ship        = ship->weak_from_this();
+    it->second.slot        = shipsInFormation.size();
+    shipsInFormation.push_back(ship);
+    GenerateSlots(shipsInFormation.size());
   }
-  else {
-    // Add the ship to the set of coordinates. We add it with a default
-    // coordinate of Point(0,0), it will gets its proper coordinate in
-    // the next generate round.
-    shipPositions[ship] = std::make_pair(relPos, tickTock);
-
-    // Add the ship to the ring.
-    shipsInFormation.push_back(ship->weak_from_this());
 
-    // Trigger immediate re-generation of the formation positions (to
-    // ensure that this new ship also gets a valid position).
-    positionsTimer = 0;
-  }
+  // Register that this ship was seen.
+  it->second.wasSeen = tickTock;
 
+  Point relPos = slots[it->second.slot];
+  if(flippedY) relPos.Set(-relPos.X(), relPos.Y());
+  if(flippedX) relPos.Set(relPos.X(), -relPos.Y());
   return formationLead->Position() + direction.Rotate(relPos);
 }
 
 
-// Re-generate the list of (relative) positions for the ships in the formation.
-void FormationPositioner::CalculatePositions()
+// Check which ships are no longer participating in the formation, and remove them from it.
+void FormationPositioner::RemoveInactive()
 {
-  // Run the position iterator for the ships in the formation.
-  auto itPos = pattern->begin(centerBodyRadius);
-
-  // Run the iterator.
   size_t shipIndex = 0;
   while(shipIndex < shipsInFormation.size())
   {
     // If the ship is no longer valid or not or no longer part of this
-    // formation, then we need to remove it.
-    auto ship       = shipsInFormation[shipIndex].lock();
-    bool removeShip = !ship || !IsActiveInFormation(ship.get());
-
-    // Lookup the ship in the positions map.
-    auto itCoor = shipPositions.end();
-    if(ship) itCoor = shipPositions.find(ship.get());
-
-    // If the ship is not in the overall table or if it was not
-    // active since the last iteration, then we also remove it.
-    removeShip |= itCoor == shipPositions.end() || itCoor->second.second != tickTock;
-
-    // Perform removes if we need to.
+    // formation, or if it was not active since the last check, then
+    // we need to remove it.
+    auto it         = participants.find(shipsInFormation[shipIndex]);
+    auto ship       = it->second.ship.lock();
+    bool removeShip = !ship || it->second.wasSeen != tickTock || !IsActiveInFormation(ship.get());
     if(removeShip)
     {
-      // Remove the ship from the ring.
+      participants.erase(it);
       Remove(shipIndex);
-      // And remove the ship from the shipsPositions map.
-      if(itCoor != shipPositions.end()) shipPositions.erase(itCoor);
-    }
-    else {
-      // Calculate the new coordinate for the current ship.
-      Point &shipRelPos = itCoor->second.first;
-      shipRelPos        = *itPos;
-      if(flippedY) shipRelPos.Set(-shipRelPos.X(), shipRelPos.Y());
-      if(flippedX) shipRelPos.Set(shipRelPos.X(), -shipRelPos.Y());
-      ++itPos;
-      ++shipIndex;
     }
+    else ++shipIndex;
   }
 
   // Switch marker to detect stale/missing ships in the next iteration.
@@ -137,6 +104,21 @@ void FormationPositioner::CalculatePositions()
 }
 
 
+// Make sure that there are positions for at least the given number of ships.
+void FormationPositioner::GenerateSlots(size_t count)
+{
+  if(count <= slots.size()) return;
+
+  // The pattern positions can only be iterated from the start, so generate
+  // more than is needed right now to not have to do this for every new ship.
+  count = std::max<size_t>({count, 2 * slots.size(), 8});
+  slots.clear();
+  slots.reserve(count);
+  for(auto itPos = pattern->begin(centerBodyRadius); slots.size() < count; ++itPos)
+    slots.push_back(*itPos);
+}
+
+
 void FormationPositioner::CalculateDirection()
 {
   // Any direction is fine, just keep initial direction.
@@ -170,16 +152,8 @@ void FormationPositioner::CalculateDirection()
   {
     direction = desiredDir;
     deltaDir  = Angle(0.);
-    if(pattern->FlippableY())
-    {
-      flippedY       = !flippedY;
-      positionsTimer = 0;
-    }
-    if(pattern->FlippableX())
-    {
-      flippedX       = !flippedX;
-      positionsTimer = 0;
-    }
+    if(pattern->FlippableY()) flippedY = !flippedY;
+    if(pattern->FlippableX()) flippedX = !flippedX;
   }
   else {
     // Turn max 1/4th degree per frame. The game runs at 60fps, so a turn of 180 degrees will take
@@ -229,6 +203,10 @@ void FormationPositioner::Remove(unsigned int index)
   // Move the last element to the current position and remove the last
   // element; this will let last ship take the position of the ship that
   // we will remove.
-  if(index < shipsInFormation.size() - 1) shipsInFormation[index].swap(shipsInFormation.back());
+  if(index < shipsInFormation.size() - 1)
+  {
+    shipsInFormation[index]                       = shipsInFormation.back();
+    participants.at(shipsInFormation[index]).slot = index;
+  }
   shipsInFormation.pop_back();
 }
@@ -17,8 +17,10 @@ this program. If not, see <https://www.gnu.org/licenses/>.
 
 #include "Angle.h"
 
-#include <map>
+#include "Point.h"
+
 #include <memory>
+#include <unordered_map>
 #include <vector>
 
 class Body;
@@ -27,7 +29,11 @@ class Ship;
 
 
 // Represents an active formation for a set of spaceships. Assigns each ship
-// to a position (Point) in the formation.
+// to a position (Point) in the formation. The positions that the pattern gives
+// are generated once and kept, and each ship holds on to its slot until it
+// leaves the formation, so that ships joining or leaving only move the ships
+// that are affected. Mirroring and turning of the formation are applied when a
+// position is looked up.
 class FormationPositioner
 {
 public:
@@ -43,8 +49,12 @@ public:
 
 
 private:
-  // Re-generate the list of (relative) positions for the ships in the formation.
-  void CalculatePositions();
+  // Check which ships are no longer participating in the formation, and
+  // remove them from it.
+  void RemoveInactive();
+
+  // Make sure that there are positions for at least the given number of ships.
+  void GenerateSlots(size_t count);
 
   // Calculate the direction the formation is facing.
   void CalculateDirection();
@@ -59,14 +69,26 @@ private:
 
 
 private:
-  // Lists of ships on the rings. Used when (re)generating positions for the ring.
-  // The actual positions are stored in shipPositions.
-  std::vector<std::weak_ptr<const Ship>> shipsInFormation;
-  // Lookup/cache of the ship coordinates in the formation, its ring-section and
-  // an indicator if it was seen since last generate loop.
-  std::map<const Ship *, std::pair<Point, bool>> shipPositions;
-
-  // Timer that controls the (re)generation of ship positions.
+  // The slot that a ship was given in the formation, and an indicator if it
+  // was seen since the last check for inactive ships.
+  class Participant
+  {
+  public:
+    std::weak_ptr<const Ship> ship;
+    unsigned int              slot    = 0;
+    bool                      wasSeen = false;
+  };
+
+
+private:
+  // The ships in the order of the slots they were given.
+  std::vector<const Ship *> shipsInFormation;
+  // Lookup of the slot and status of each ship in the formation.
+  std::unordered_map<const Ship *, Participant> participants;
+  // The (relative, unmirrored) positions that the pattern gives, in order.
+  std::vector<Point> slots;
+
+  // Timer that controls the checks for ships that left the formation.
   int positionsTimer = 0;
 
   // The scaling factor as we currently have for this formation for the ship or
@@ -72,6 +72,37 @@ void FrameTimer::Wait()
 }
 
 
+// Check, without waiting, whether the next frame should begin. If it should,
+// the timer moves on to the frame after it.
+bool FrameTimer::IsDue() { return IsDue(std::chrono::steady_clock::now()); }
+
+
+bool FrameTimer::IsDue(std::chrono::steady_clock::time_point now)
+{
+  if(now < next) return false;
+
+  // This is only checked once for every frame that is drawn, so a frame can
+  // become due up to one drawn frame before it is noticed. Keep that lag, so
+  // that the frame after it comes that much sooner, but don't try to catch up
+  // on any frames that were missed entirely.
+  if(now - next >= step) next = now;
+
+  Step();
+  return true;
+}
+
+
+// Find out how much of the time until the next frame has passed, from 0 to 1.
+double FrameTimer::Progress() const
+{
+  std::chrono::steady_clock::time_point now = std::chrono::steady_clock::now();
+  if(now >= next) return 1.;
+
+  const double remaining = std::chrono::duration<double>(next - now) / std::chrono::duration<double>(step);
+  return remaining < 1. ? 1. - remaining : 0.;
+}
+
+
 // Find out how long it has been since this timer was created, in seconds.
 double FrameTimer::Time() const
 {
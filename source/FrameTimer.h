@@ -35,6 +35,14 @@ public:
 
   // Wait until the next frame should begin.
   void Wait();
+  // Check, without waiting, whether the next frame should begin. If it should,
+  // the timer moves on to the frame after it. This is meant to be checked once
+  // for every frame that is drawn, so a frame that is late by less than one of
+  // its own steps is caught up on, unlike with Wait().
+  bool IsDue();
+  bool IsDue(std::chrono::steady_clock::time_point now);
+  // Find out how much of the time until the next frame has passed, from 0 to 1.
+  double Progress() const;
   // Find out how long it has been since this timer was created, in seconds.
   double Time() const;
 
@@ -104,6 +104,7 @@ namespace
   MaskManager maskManager;
 
   const Government                                    *playerGovernment = nullptr;
+  unsigned                                             routesVersion    = 0;
   std::map<const System *, std::map<std::string, int>> purchases;
 
   ConditionsStore globalConditions;
@@ -287,6 +288,7 @@ void GameData::Revert()
   objects.wormholes.Revert(defaultWormholes);
   objects.persons.Revert(defaultPersons);
   objects.substitutions.Revert(defaultSubstitutions);
+  ++routesVersion;
 
   activeGamerules = objects.gamerulesPresets.Get("Default");
 
@@ -426,15 +428,35 @@ void GameData::AddPurchase(const System &system, const std::string &commodity, i
 
 
 // Apply the given change to the universe.
-void GameData::Change(const DataNode &node, PlayerInfo &player) { objects.Change(node, player); }
+void GameData::Change(const DataNode &node, PlayerInfo &player)
+{
+  objects.Change(node, player);
+  // A government's attitudes toward others, or its travel restrictions, may have changed.
+  if(node.Token(0) == "government")
+  {
+    politics.UpdateHostility();
+    ++routesVersion;
+  }
+}
 
 
 // Update the neighbor lists and other information for all the systems.
 // This must be done any time that a change creates or moves a system.
-void GameData::UpdateSystems() { objects.UpdateSystems(); }
+void GameData::UpdateSystems()
+{
+  objects.UpdateSystems();
+  ++routesVersion;
+}
+
+
+void GameData::RecomputeWormholeRequirements()
+{
+  objects.RecomputeWormholeRequirements();
+  ++routesVersion;
+}
 
 
-void GameData::RecomputeWormholeRequirements() { objects.RecomputeWormholeRequirements(); }
+unsigned GameData::RoutesVersion() { return routesVersion; }
 
 
 void GameData::AddJumpRange(double neighborDistance) { objects.neighborDistances.insert(neighborDistance); }
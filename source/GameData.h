@@ -121,6 +121,9 @@ public:
   // This must be done any time that a change creates or moves a system.
   static void UpdateSystems();
   static void RecomputeWormholeRequirements();
+  // A count that changes whenever systems, links, wormholes, or governments change,
+  // so that cached routes through the galaxy know when they must be found again.
+  static unsigned RoutesVersion();
   static void AddJumpRange(double neighborDistance);
 
   // Re-activate any special persons that were created previously but that are
@@ -15,11 +15,13 @@ this program. If not, see <https://www.gnu.org/licenses/>.
 
 #include "GameWindow.h"
 
+#include "Files.h"
 #include "Logger.h"
 #include "Screen.h"
 
 #include <SDL3/SDL.h>
 
+#include <cmath>
 #include <sstream>
 #include <string>
 
@@ -71,7 +73,7 @@ std::string GameWindow::SDLVersions()
 }
 
 
-bool GameWindow::Init(bool headless)
+bool GameWindow::Init(bool headless, bool offscreen)
 {
 #ifdef _WIN32
 #elif defined(__linux__)
@@ -171,6 +173,9 @@ bool GameWindow::Init(bool headless)
     width  = windowWidth;
     height = windowHeight;
     Screen::SetRaw(width, height, true);
+    // Frames drawn offscreen don't need a window surface. The pipeline cache is left alone,
+    // since it is likely to be for another device than the one rendering offscreen.
+    if(offscreen) Instance = graphics_layer::Init(width, height, true);
     return true;
   }
 
@@ -183,6 +188,7 @@ bool GameWindow::Init(bool headless)
 #endif
 
   Instance = graphics_layer::Init(width, height);
+  Instance->LoadPipelineCache(Files::Config() / "pipeline cache.bin");
 
   return true;
 }
@@ -202,6 +208,20 @@ void GameWindow::Quit()
 }
 
 
+GraphicsTypes::RenderState GameWindow::ScreenState()
+{
+  GraphicsTypes::RenderState state;
+  state.DepthTest                = false;
+  state.Blending.BlendingEnabled = true;
+  state.Blending.SRCAlpha        = GraphicsTypes::BlendFactor::FACTOR_ONE;
+  state.Blending.DSTAlpha        = GraphicsTypes::BlendFactor::FACTOR_ONE_MINUS_SRC_ALPHA;
+  state.Blending.SRCColor        = GraphicsTypes::BlendFactor::FACTOR_ONE;
+  state.Blending.DSTColor        = GraphicsTypes::BlendFactor::FACTOR_ONE_MINUS_SRC_ALPHA;
+  state.ClearColor               = GraphicsTypes::Color{0.f, 0.f, 0.f, 0.f};
+  return state;
+}
+
+
 void GameWindow::Step() {}
 
 
@@ -255,6 +275,16 @@ int GameWindow::DrawWidth() { return drawWidth; }
 int GameWindow::DrawHeight() { return drawHeight; }
 
 
+// The refresh rate of the display the main window is on. If it is not known,
+// assume the display keeps up with the game's step rate.
+int GameWindow::RefreshRate()
+{
+  const SDL_DisplayMode *mode = mainWindow ? SDL_GetCurrentDisplayMode(SDL_GetDisplayForWindow(mainWindow)) : nullptr;
+  if(!mode || mode->refresh_rate < 60.f) return 60;
+  return static_cast<int>(std::lround(mode->refresh_rate));
+}
+
+
 bool GameWindow::IsMaximized() { return SDL_GetWindowFlags(mainWindow) & SDL_WINDOW_MAXIMIZED; }
 
 
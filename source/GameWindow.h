@@ -29,8 +29,13 @@ public:
   static struct SDL_Window               *GetWindow();
   static GraphicsTypes::GraphicsInstance *GetInstance();
   static std::string                      SDLVersions();
-  static bool                             Init(bool headless);
-  static void                             Quit();
+  // A headless window is never shown. If it is offscreen, it is still drawn to, so that
+  // rendering can be measured on machines without a display.
+  static bool Init(bool headless, bool offscreen = false);
+  static void Quit();
+
+  // The render state everything is drawn to the screen with.
+  static GraphicsTypes::RenderState ScreenState();
 
   // Paint the next frame in the main window.
   static void Step();
@@ -49,6 +54,9 @@ public:
   static int DrawWidth();
   static int DrawHeight();
 
+  // The refresh rate of the display the main window is on, in frames per second.
+  static int RefreshRate();
+
   static bool IsMaximized();
   static bool IsFullscreen();
   static void ToggleFullscreen();
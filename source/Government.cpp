@@ -675,6 +675,10 @@ const Swizzle *Government::GetSwizzle() const { return swizzle; }
 const Color &Government::GetColor() const { return *color; }
 
 
+// Get the number that identifies this government in dense lookup tables.
+unsigned Government::Index() const { return id; }
+
+
 // Get the government's initial disposition toward other governments or
 // toward the player.
 double Government::AttitudeToward(const Government *other) const
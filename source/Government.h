@@ -94,6 +94,8 @@ public:
   const Swizzle *GetSwizzle() const;
   // Get the color to use for displaying this government on the map.
   const Color &GetColor() const;
+  // Get the number that identifies this government in dense lookup tables.
+  unsigned Index() const;
 
   // Get the government's initial disposition toward other governments or
   // toward the player.
@@ -0,0 +1,165 @@
+/* GovernmentStrengths.cpp
+Copyright (c) 2026 by RisingLeaf
+
+Endless Sky is free software: you can redistribute it and/or modify it under the
+terms of the GNU General Public License as published by the Free Software
+Foundation, either version 3 of the License, or (at your option) any later version.
+
+Endless Sky is distributed in the hope that it will be useful, but WITHOUT ANY
+WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS FOR A
+PARTICULAR PURPOSE. See the GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License along with
+this program. If not, see <https://www.gnu.org/licenses/>.
+*/
+
+#include "GovernmentStrengths.h"
+
+#include "GameData.h"
+#include "Government.h"
+#include "Politics.h"
+#include "Ship.h"
+
+using namespace std;
+
+namespace
+{
+  int64_t Get(const vector<int64_t> &values, const Government *government)
+  {
+    if(!government || government->Index() >= values.size()) return 0;
+    return values[government->Index()];
+  }
+}
+
+
+// Update the totals for the given ship, which may or may not be in the player's system.
+void GovernmentStrengths::Update(const Ship &ship, bool isPresent)
+{
+  Contribution current;
+  if(isPresent && ship.GetGovernment())
+  {
+    current.government = ship.GetGovernment();
+    current.strength   = ship.Strength();
+    current.isAble     = !ship.IsDisabled() && !ship.IsOverheated() && !ship.IsIonized();
+  }
+
+  Contribution &previous = contributions[&ship];
+  if(previous.government != current.government || previous.strength != current.strength ||
+     previous.isAble != current.isAble)
+  {
+    Apply(previous, -1);
+    Apply(current, 1);
+    previous   = current;
+    hasChanged = true;
+  }
+  previous.wasSeen = true;
+}
+
+
+// Remove any ships that were not updated since the last call to this, and recalculate
+// the ally and enemy strengths if anything has changed.
+void GovernmentStrengths::Finish()
+{
+  for(auto it = contributions.begin(); it != contributions.end();)
+  {
+    if(!it->second.wasSeen)
+    {
+      Apply(it->second, -1);
+      hasChanged = hasChanged || it->second.government;
+      it         = contributions.erase(it);
+    }
+    else {
+      it->second.wasSeen = false;
+      ++it;
+    }
+  }
+
+  // The alliances also change if any governments become or stop being enemies.
+  const unsigned version = GameData::GetPolitics().HostilityVersion();
+  if(hasChanged || version != hostilityVersion) UpdateAlliances();
+  hasChanged       = false;
+  hostilityVersion = version;
+}
+
+
+void GovernmentStrengths::Clear()
+{
+  contributions.clear();
+  governments.clear();
+  total.clear();
+  able.clear();
+  ableCount.clear();
+  ally.clear();
+  enemy.clear();
+  hasChanged = false;
+}
+
+
+// The strength of all of the given government's ships that are present, including disabled ones.
+int64_t GovernmentStrengths::Total(const Government *government) const { return Get(total, government); }
+
+
+int64_t GovernmentStrengths::Ally(const Government *government) const { return Get(ally, government); }
+
+
+int64_t GovernmentStrengths::Enemy(const Government *government) const { return Get(enemy, government); }
+
+
+// Add or remove a ship's contribution to the totals.
+void GovernmentStrengths::Apply(const Contribution &contribution, int sign)
+{
+  if(!contribution.government) return;
+
+  const unsigned index = contribution.government->Index();
+  if(index >= governments.size())
+  {
+    governments.resize(index + 1, nullptr);
+    total.resize(index + 1, 0);
+    able.resize(index + 1, 0);
+    ableCount.resize(index + 1, 0);
+    ally.resize(index + 1, 0);
+    enemy.resize(index + 1, 0);
+  }
+  governments[index]  = contribution.government;
+  total[index]       += sign * contribution.strength;
+  if(contribution.isAble)
+  {
+    able[index]      += sign * contribution.strength;
+    ableCount[index] += sign;
+  }
+}
+
+
+// Recalculate the strengths of the allies and enemies of each present government.
+void GovernmentStrengths::UpdateAlliances()
+{
+  // Only governments with ships that are able to fight are considered.
+  vector<unsigned> present;
+  for(unsigned i = 0; i < ableCount.size(); ++i)
+    if(ableCount[i]) present.push_back(i);
+
+  ally.assign(governments.size(), 0);
+  enemy.assign(governments.size(), 0);
+  vector<char> isAlly(governments.size(), false);
+  for(unsigned gov : present)
+  {
+    for(unsigned other : present)
+      isAlly[other] = false;
+    for(unsigned foe : present)
+    {
+      if(!governments[foe]->IsEnemy(governments[gov])) continue;
+
+      // "Know your enemies."
+      enemy[gov] += able[foe];
+      for(unsigned friendly : present)
+      {
+        if(governments[friendly]->IsEnemy(governments[foe]) && !isAlly[friendly])
+        {
+          // "The enemy of my enemy is my friend."
+          ally[gov]        += able[friendly];
+          isAlly[friendly]  = true;
+        }
+      }
+    }
+  }
+}
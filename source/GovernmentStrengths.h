@@ -0,0 +1,82 @@
+/* GovernmentStrengths.h
+Copyright (c) 2026 by RisingLeaf
+
+Endless Sky is free software: you can redistribute it and/or modify it under the
+terms of the GNU General Public License as published by the Free Software
+Foundation, either version 3 of the License, or (at your option) any later version.
+
+Endless Sky is distributed in the hope that it will be useful, but WITHOUT ANY
+WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS FOR A
+PARTICULAR PURPOSE. See the GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License along with
+this program. If not, see <https://www.gnu.org/licenses/>.
+*/
+
+#pragma once
+
+#include <cstdint>
+#include <unordered_map>
+#include <vector>
+
+class Government;
+class Ship;
+
+
+// GovernmentStrengths keeps a running total of the strength of each government's
+// ships in the player's system, and of the strength of each government's allies
+// and enemies there. Every ship remembers what it last added to the totals, and
+// only a change to that (because the ship arrived, left, was destroyed, changed
+// government, was disabled, or had its outfits changed) updates them. The totals
+// are stored by Government::Index(), so that looking one up does not take any
+// searching.
+class GovernmentStrengths
+{
+public:
+  // Update the totals for the given ship, which may or may not be in the player's system.
+  void Update(const Ship &ship, bool isPresent);
+  // Remove any ships that were not updated since the last call to this, and recalculate
+  // the ally and enemy strengths if anything has changed.
+  void Finish();
+  void Clear();
+
+  // The strength of all of the given government's ships that are present, including disabled ones.
+  int64_t Total(const Government *government) const;
+  // The strength of all the governments that are the allies or the enemies of the given government,
+  // counting only the ships that are able to fight.
+  int64_t Ally(const Government *government) const;
+  int64_t Enemy(const Government *government) const;
+
+
+private:
+  // What a ship adds to the totals.
+  class Contribution
+  {
+  public:
+    const Government *government = nullptr;
+    int64_t           strength   = 0;
+    bool              isAble     = false;
+    bool              wasSeen    = false;
+  };
+
+
+private:
+  // Add or remove a ship's contribution to the totals.
+  void Apply(const Contribution &contribution, int sign);
+  // Recalculate the strengths of the allies and enemies of each present government.
+  void UpdateAlliances();
+
+
+private:
+  std::unordered_map<const Ship *, Contribution> contributions;
+  // All of these are indexed by Government::Index().
+  std::vector<const Government *> governments;
+  std::vector<int64_t>            total;
+  std::vector<int64_t>            able;
+  std::vector<unsigned>           ableCount;
+  std::vector<int64_t>            ally;
+  std::vector<int64_t>            enemy;
+
+  bool     hasChanged       = false;
+  unsigned hostilityVersion = 0;
+};
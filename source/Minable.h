@@ -130,9 +130,6 @@ private:
   double orbitScale;
   // Rotation of the orbit - that is, the angle of periapsis - in radians.
   double rotation;
-  // Rate of spin of the object.
-  Angle spin;
-
   // Cache the current orbital radius. It can be calculated from theta and the
   // parameters above, but this avoids having to calculate every radius twice.
   double radius;
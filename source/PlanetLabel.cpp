@@ -77,21 +77,25 @@ PlanetLabel::PlanetLabel(const std::vector<PlanetLabel> &labels, const System &s
 
 void PlanetLabel::Update(
     const Point                    &center,
+    const Point                    &centerVelocity,
     const double                    zoom,
     const std::vector<PlanetLabel> &labels,
     const System                   &system)
 {
   drawCenter = center;
   position   = (object->Position() - center) * zoom;
+  velocity   = (object->Velocity() - centerVelocity) * zoom;
   radius     = object->Radius() * zoom;
   UpdateData(labels, system);
 }
 
 
-void PlanetLabel::Draw() const
+void PlanetLabel::Draw(double lag) const
 {
+  const Point center = position - velocity * lag;
+
   // Don't draw if too far away from the center of the screen.
-  const double offset              = position.Length() - radius;
+  const double offset              = center.Length() - radius;
   const double objectDistanceAlpha = object->DistanceAlpha(drawCenter);
   if(offset >= 600. || objectDistanceAlpha == 0.) return;
 
@@ -101,22 +105,22 @@ void PlanetLabel::Draw() const
   // The angle of the outer ring should be reduced by just enough that the
   // circumference is reduced by GAP pixels.
   const double outerAngle = innerAngle - 360. * GAP / (2. * PI * radius);
-  RingShader::Draw(position, radius + INNER_SPACE, 2.3f, .9f, labelColor, 0.f, innerAngle);
-  RingShader::Draw(position, radius + INNER_SPACE + GAP, 1.3f, .6f, labelColor, 0.f, outerAngle);
+  RingShader::Draw(center, radius + INNER_SPACE, 2.3f, .9f, labelColor, 0.f, innerAngle);
+  RingShader::Draw(center, radius + INNER_SPACE + GAP, 1.3f, .6f, labelColor, 0.f, outerAngle);
 
   const double barbRadius = radius + 25.;
   Angle        barbAngle(innerAngle + 36.);
   for(int i = 0; i < hostility; ++i)
   {
     barbAngle += Angle(800. / barbRadius);
-    PointerShader::Draw(position, barbAngle.Unit(), 15.f, 15.f, barbRadius, labelColor);
+    PointerShader::Draw(center, barbAngle.Unit(), 15.f, 15.f, barbRadius, labelColor);
   }
 
   // Draw planet name label, if any.
   if(!name.empty())
   {
     const Point unit = Angle(innerAngle).Unit();
-    const Point from = position + unit * (radius + INNER_SPACE + LINE_GAP);
+    const Point from = center + unit * (radius + INNER_SPACE + LINE_GAP);
     const Point to   = from + unit * LINE_LENGTH;
     LineShader::Draw(from, to, 1.3f, labelColor);
 
@@ -31,9 +31,15 @@ class PlanetLabel
 public:
   PlanetLabel(const std::vector<PlanetLabel> &labels, const System &system, const StellarObject &object);
 
-  void Update(const Point &center, double zoom, const std::vector<PlanetLabel> &labels, const System &system);
+  void Update(
+      const Point                    &center,
+      const Point                    &centerVelocity,
+      double                          zoom,
+      const std::vector<PlanetLabel> &labels,
+      const System                   &system);
 
-  void Draw() const;
+  // Draw the label the given fraction of a step back along its velocity.
+  void Draw(double lag = 0.) const;
 
 
 private:
@@ -55,8 +61,9 @@ private:
   Rectangle box;
   Point     zoomOffset;
 
-  // Position and radius for drawing label.
+  // Position, velocity and radius for drawing label.
   Point  position;
+  Point  velocity;
   double radius = 0.;
 
   std::string name;
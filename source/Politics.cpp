@@ -69,6 +69,8 @@ void Politics::Reset()
   // were already checked for when you first landed).
   for(const auto &it : GameData::Governments())
     fined.insert(&it.second);
+
+  UpdateHostility();
 }
 
 
@@ -76,26 +78,47 @@ bool Politics::IsEnemy(const Government *first, const Government *second) const
 {
   if(!first || !second) return false;
 
-  if(first == second) return false;
+  const unsigned row    = first->Index();
+  const unsigned column = second->Index();
+  // Governments that were created after the table was built are looked up the slow way.
+  if(row >= governmentCount || column >= governmentCount) return CalculateIsEnemy(first, second);
+  return (hostility[row * rowWords + column / 64] >> (column % 64)) & 1;
+}
 
-  // Just for simplicity, if one of the governments is the player, make sure
-  // it is the first one.
-  if(second->IsPlayer()) swap(first, second);
-  if(first->IsPlayer())
-  {
-    if(bribed.contains(second)) return false;
-    if(provoked.contains(second)) return true;
 
-    auto it = reputationWith.find(second);
-    return it != reputationWith.end() && it->second < 0.;
-  }
+// Recalculate which governments are enemies, after their attitudes have changed.
+void Politics::UpdateHostility()
+{
+  unsigned count = 0;
+  for(const auto &it : GameData::Governments())
+    count = max(count, it.second.Index() + 1);
 
-  // Neither government is the player, so the question of enemies depends only
-  // on the attitude matrix.
-  return first->AttitudeToward(second) < 0. || second->AttitudeToward(first) < 0.;
+  // Only reallocate the table if the number of governments has changed, because it
+  // may be read from the calculation thread.
+  ++version;
+  if(count != governmentCount)
+  {
+    governmentCount = count;
+    rowWords        = (count + 63) / 64;
+    hostility.assign(static_cast<size_t>(count) * rowWords, 0);
+  }
+  for(const auto &first : GameData::Governments())
+  {
+    uint64_t *row = hostility.data() + first.second.Index() * rowWords;
+    for(const auto &second : GameData::Governments())
+    {
+      const unsigned column = second.second.Index();
+      const uint64_t bit    = uint64_t{1} << (column % 64);
+      if(CalculateIsEnemy(&first.second, &second.second)) row[column / 64] |= bit;
+      else row[column / 64] &= ~bit;
+    }
+  }
 }
 
 
+unsigned Politics::HostilityVersion() const { return version; }
+
+
 // Commit the given "offense" against the given government (which may not
 // actually consider it to be an offense). This may result in temporary
 // hostilities (if the even type is PROVOKE), or a permanent change to your
@@ -122,6 +145,7 @@ void Politics::Offend(const Government *gov, int eventType, int count)
         // your bribe is canceled out.
         bribed.erase(other);
         provoked.insert(other);
+        UpdatePlayerHostility(other);
       }
     }
     if(count && abs(weight) >= .05)
@@ -146,6 +170,7 @@ void Politics::Bribe(const Government *gov)
   bribed.insert(gov);
   provoked.erase(gov);
   fined.insert(gov);
+  UpdatePlayerHostility(gov);
 }
 
 
@@ -370,6 +395,7 @@ void Politics::SetReputation(const Government *gov, double value)
   value               = min(value, gov->ReputationMax());
   value               = max(value, gov->ReputationMin());
   reputationWith[gov] = value;
+  UpdatePlayerHostility(gov);
 }
 
 
@@ -380,4 +406,56 @@ void Politics::ResetDaily()
   bribed.clear();
   bribedPlanets.clear();
   fined.clear();
+  UpdatePlayerHostility();
+}
+
+
+bool Politics::CalculateIsEnemy(const Government *first, const Government *second) const
+{
+  if(!first || !second) return false;
+
+  if(first == second) return false;
+
+  // Just for simplicity, if one of the governments is the player, make sure
+  // it is the first one.
+  if(second->IsPlayer()) swap(first, second);
+  if(first->IsPlayer())
+  {
+    if(bribed.contains(second)) return false;
+    if(provoked.contains(second)) return true;
+
+    auto it = reputationWith.find(second);
+    return it != reputationWith.end() && it->second < 0.;
+  }
+
+  // Neither government is the player, so the question of enemies depends only
+  // on the attitude matrix.
+  return first->AttitudeToward(second) < 0. || second->AttitudeToward(first) < 0.;
+}
+
+
+void Politics::UpdatePlayerHostility(const Government *gov)
+{
+  const Government *player = GameData::PlayerGovernment();
+  if(!gov || !player) return;
+
+  const unsigned first  = player->Index();
+  const unsigned second = gov->Index();
+  if(first >= governmentCount || second >= governmentCount) return;
+
+  const bool isEnemy = CalculateIsEnemy(player, gov);
+  if(isEnemy != IsEnemy(player, gov) || isEnemy != IsEnemy(gov, player)) ++version;
+  for(auto [row, column] : {make_pair(first, second), make_pair(second, first)})
+  {
+    const uint64_t bit = uint64_t{1} << (column % 64);
+    if(isEnemy) hostility[row * rowWords + column / 64] |= bit;
+    else hostility[row * rowWords + column / 64] &= ~bit;
+  }
+}
+
+
+void Politics::UpdatePlayerHostility()
+{
+  for(const auto &it : GameData::Governments())
+    UpdatePlayerHostility(&it.second);
 }
@@ -15,9 +15,11 @@ this program. If not, see <https://www.gnu.org/licenses/>.
 
 #pragma once
 
+#include <cstdint>
 #include <map>
 #include <set>
 #include <string>
+#include <vector>
 
 class Conversation;
 class Government;
@@ -37,6 +39,11 @@ public:
   void Reset();
 
   bool IsEnemy(const Government *first, const Government *second) const;
+  // Recalculate which governments are enemies, after their attitudes have changed.
+  void UpdateHostility();
+  // A count that changes whenever any two governments become or stop being enemies,
+  // so that anything derived from their hostility knows when to recalculate it.
+  unsigned HostilityVersion() const;
 
   // Commit the given "offense" against the given government (which may not
   // actually consider it to be an offense). This may result in temporary
@@ -73,6 +80,14 @@ public:
   void ResetDaily();
 
 
+private:
+  // Determine whether the given governments are enemies, without the hostility table.
+  bool CalculateIsEnemy(const Government *first, const Government *second) const;
+  // Update the hostility between the player and the given government, or all governments.
+  void UpdatePlayerHostility(const Government *gov);
+  void UpdatePlayerHostility();
+
+
 private:
   // attitude[target][other] stores how much an action toward the given target
   // government will affect your reputation with the given other government.
@@ -85,4 +100,12 @@ private:
   std::map<const Planet *, bool>       bribedPlanets;
   std::set<const Planet *>             dominatedPlanets;
   std::set<const Government *>         fined;
+
+  // A bit matrix, indexed by Government::Index(), of which governments are enemies.
+  // This is checked for every possible collision and AI target, so it is only
+  // recalculated when attitudes, reputations, provocations or bribes change.
+  std::vector<uint64_t> hostility;
+  unsigned              governmentCount = 0;
+  unsigned              rowWords        = 0;
+  unsigned              version         = 0;
 };
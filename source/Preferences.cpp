@@ -31,6 +31,8 @@ this program. If not, see <https://www.gnu.org/licenses/>.
 #endif
 
 #include <algorithm>
+#include <array>
+#include <atomic>
 #include <cstddef>
 #include <map>
 
@@ -46,6 +48,41 @@ namespace
   const string EXPEND_AMMO    = "Escorts expend ammo";
   const string FRUGAL_ESCORTS = "Escorts use ammo frugally";
 
+  // The name of each preference in a snapshot, in the order of Preferences::Flag.
+  const array<string, static_cast<size_t>(Preferences::Flag::COUNT)> FLAG_NAMES = {
+      "Render motion blur",
+      "Cloaked ship outlines",
+      "Highlight player's flagship",
+      "Show missile overlays",
+      "Rotate flagship in HUD",
+      "Ship outlines in HUD",
+      "Show asteroid scanner overlay",
+      "Show planet labels",
+      "Show hyperspace flash",
+      "Landing zoom",
+      "Clickable radar display",
+      "Control ship with mouse",
+      "Extra fleet status messages",
+      "Disable viewport on radar",
+      EXPEND_AMMO,
+      FRUGAL_ESCORTS,
+      "Turrets focus fire",
+      "Damaged fighters retreat",
+      "Fighters transfer cargo",
+      "Repair fighters in",
+      "Target asteroid based on",
+      "Aim turrets with mouse",
+      "Fixed starfield zoom",
+      "Draw starfield",
+      "Draw background haze",
+  };
+
+  // Snapshots are published round-robin. The calculation thread of one frame
+  // may still be reading the previous snapshot while the next one is written,
+  // so three of them are needed to never overwrite one that is in use.
+  array<Preferences::Snapshot, 3> snapshots;
+  atomic<size_t>                  snapshotIndex = 0;
+
   const vector<string> DATEFMT_OPTIONS = {"dd/mm/yyyy", "mm/dd/yyyy", "yyyy-mm-dd"};
   int                  dateFormatIndex = 0;
 
@@ -169,6 +206,14 @@ namespace
   const vector<string> LARGE_GRAPHICS_REDUCTION_SETTINGS = {"off", "largest only", "all"};
   int                  largeGraphicsReductionIndex       = 0;
 
+  const vector<string> TEXTURE_BUDGET_SETTINGS = {"unlimited", "512 MB", "1 GB", "2 GB", "4 GB"};
+  const size_t         TEXTURE_BUDGET_SIZES[]  = {0, 512ull << 20, 1ull << 30, 2ull << 30, 4ull << 30};
+  int                  textureBudgetIndex      = 0;
+
+  const vector<string> AI_BUDGET_SETTINGS = {"unlimited", "8", "16", "32", "64"};
+  const int            AI_BUDGETS[]       = {0, 8, 16, 32, 64};
+  int                  aiBudgetIndex      = 3;
+
   const string BLOCK_SCREEN_SAVER = "Block screen saver";
 
   int previousSaveCount = 3;
@@ -188,6 +233,7 @@ void Preferences::Load()
   // These settings should be on by default. There is no need to specify
   // values for settings that are off by default.
   settings["Render motion blur"]            = true;
+  settings["Interpolate frames"]            = true;
   settings["Cloaked ship outlines"]         = true;
   settings[FRUGAL_ESCORTS]                  = true;
   settings[EXPEND_AMMO]                     = true;
@@ -252,6 +298,10 @@ void Preferences::Load()
       flagshipSpacePriorityIndex = clamp<int>(node.Value(1), 0, FLAGSHIP_SPACE_PRIORITY_SETTINGS.size() - 1);
     else if(key == "Reduce large graphics")
       largeGraphicsReductionIndex = clamp<int>(node.Value(1), 0, LARGE_GRAPHICS_REDUCTION_SETTINGS.size() - 1);
+    else if(key == "Texture memory budget")
+      textureBudgetIndex = clamp<int>(node.Value(1), 0, TEXTURE_BUDGET_SETTINGS.size() - 1);
+    else if(key == "AI decisions per step")
+      aiBudgetIndex = clamp<int>(node.Value(1), 0, AI_BUDGET_SETTINGS.size() - 1);
     else if(key == "previous saves" && hasValue) previousSaveCount = max<int>(3, node.Value(1));
     else if(key == "alt-mouse turning") settings["Control ship with mouse"] = (!hasValue || node.Value(1));
     else if(key == "notification settings")
@@ -291,6 +341,8 @@ void Preferences::Load()
     if(!it->second) flotsamIndex = static_cast<int>(FlotsamCollection::ESCORT);
     settings.erase(it);
   }
+
+  PublishSnapshot();
 }
 
 
@@ -325,6 +377,8 @@ void Preferences::Save()
   out.Write("Show mini-map", minimapDisplayIndex);
   out.Write("Prioritize flagship use", flagshipSpacePriorityIndex);
   out.Write("Reduce large graphics", largeGraphicsReductionIndex);
+  out.Write("Texture memory budget", textureBudgetIndex);
+  out.Write("AI decisions per step", aiBudgetIndex);
   out.Write("previous saves", previousSaveCount);
 #ifdef _WIN32
   if(WinVersion::SupportsDarkTheme()) out.Write("Title bar theme", titleBarThemeIndex);
@@ -346,6 +400,43 @@ bool Preferences::Has(const string &name)
 void Preferences::Set(const string &name, bool on) { settings[name] = on; }
 
 
+void Preferences::PublishSnapshot()
+{
+  const size_t next     = (snapshotIndex.load(memory_order_relaxed) + 1) % snapshots.size();
+  Snapshot    &snapshot = snapshots[next];
+  for(size_t i = 0; i < FLAG_NAMES.size(); ++i)
+    snapshot.flags[i] = Has(FLAG_NAMES[i]);
+
+  snapshot.turretOverlays      = GetTurretOverlays();
+  snapshot.autoAim             = GetAutoAim();
+  snapshot.autoFire            = GetAutoFire();
+  snapshot.backgroundParallax  = GetBackgroundParallax();
+  snapshot.extendedJumpEffects = GetExtendedJumpEffects();
+  snapshot.boardingPriority    = GetBoardingPriority();
+  snapshot.flotsamCollection   = GetFlotsamCollection();
+  snapshot.alertIndicator      = GetAlertIndicator();
+  snapshot.notificationSetting = GetNotificationSetting();
+  snapshot.aiDecisionBudget    = AIDecisionBudget();
+
+  snapshotIndex.store(next, memory_order_release);
+}
+
+
+const Preferences::Snapshot &Preferences::Current() { return snapshots[snapshotIndex.load(memory_order_acquire)]; }
+
+
+bool Preferences::Snapshot::PlayAudioAlert() const
+{
+  return alertIndicator == AlertIndicator::AUDIO || alertIndicator == AlertIndicator::BOTH;
+}
+
+
+bool Preferences::Snapshot::DisplayVisualAlert() const
+{
+  return alertIndicator == AlertIndicator::VISUAL || alertIndicator == AlertIndicator::BOTH;
+}
+
+
 void Preferences::ToggleAmmoUsage()
 {
   bool expend = Has(EXPEND_AMMO);
@@ -725,6 +816,30 @@ const string &Preferences::LargeGraphicsReductionSetting()
 }
 
 
+void Preferences::ToggleTextureBudget()
+{
+  if(++textureBudgetIndex >= static_cast<int>(TEXTURE_BUDGET_SETTINGS.size())) textureBudgetIndex = 0;
+}
+
+
+size_t Preferences::TextureBudget() { return TEXTURE_BUDGET_SIZES[textureBudgetIndex]; }
+
+
+const string &Preferences::TextureBudgetSetting() { return TEXTURE_BUDGET_SETTINGS[textureBudgetIndex]; }
+
+
+void Preferences::ToggleAIDecisionBudget()
+{
+  if(++aiBudgetIndex >= static_cast<int>(AI_BUDGET_SETTINGS.size())) aiBudgetIndex = 0;
+}
+
+
+int Preferences::AIDecisionBudget() { return AI_BUDGETS[aiBudgetIndex]; }
+
+
+const string &Preferences::AIDecisionBudgetSetting() { return AI_BUDGET_SETTINGS[aiBudgetIndex]; }
+
+
 void Preferences::ToggleBlockScreenSaver()
 {
   GameWindow::ToggleBlockScreenSaver();
@@ -15,6 +15,8 @@ this program. If not, see <https://www.gnu.org/licenses/>.
 
 #pragma once
 
+#include <bitset>
+#include <cstddef>
 #include <cstdint>
 #include <string>
 #include <vector>
@@ -167,6 +169,60 @@ public:
   };
 #endif
 
+  /// The on / off preferences that are read while simulating or drawing a frame.
+  enum class Flag : int_fast8_t
+  {
+    RENDER_MOTION_BLUR = 0,
+    CLOAKED_SHIP_OUTLINES,
+    HIGHLIGHT_FLAGSHIP,
+    SHOW_MISSILE_OVERLAYS,
+    ROTATE_FLAGSHIP_IN_HUD,
+    SHIP_OUTLINES_IN_HUD,
+    SHOW_ASTEROID_SCANNER_OVERLAY,
+    SHOW_PLANET_LABELS,
+    SHOW_HYPERSPACE_FLASH,
+    LANDING_ZOOM,
+    CLICKABLE_RADAR_DISPLAY,
+    CONTROL_SHIP_WITH_MOUSE,
+    EXTRA_FLEET_STATUS_MESSAGES,
+    DISABLE_VIEWPORT_ON_RADAR,
+    ESCORTS_EXPEND_AMMO,
+    ESCORTS_USE_AMMO_FRUGALLY,
+    TURRETS_FOCUS_FIRE,
+    DAMAGED_FIGHTERS_RETREAT,
+    FIGHTERS_TRANSFER_CARGO,
+    REPAIR_FIGHTERS_IN,
+    TARGET_ASTEROID_BASED_ON,
+    AIM_TURRETS_WITH_MOUSE,
+    FIXED_STARFIELD_ZOOM,
+    DRAW_STARFIELD,
+    DRAW_BACKGROUND_HAZE,
+    COUNT
+  };
+
+  /// An immutable copy of the preferences that the engine, the AI and the
+  /// shaders read every frame. Reading it needs neither a string lookup nor a
+  /// lock, and it can't change while the calculation thread is reading it.
+  struct Snapshot
+  {
+    bool Has(Flag flag) const { return flags[static_cast<size_t>(flag)]; }
+    bool PlayAudioAlert() const;
+    bool DisplayVisualAlert() const;
+
+    std::bitset<static_cast<size_t>(Flag::COUNT)> flags;
+
+    TurretOverlays      turretOverlays      = TurretOverlays::OFF;
+    AutoAim             autoAim             = AutoAim::OFF;
+    AutoFire            autoFire            = AutoFire::OFF;
+    BackgroundParallax  backgroundParallax  = BackgroundParallax::OFF;
+    ExtendedJumpEffects extendedJumpEffects = ExtendedJumpEffects::OFF;
+    BoardingPriority    boardingPriority    = BoardingPriority::PROXIMITY;
+    FlotsamCollection   flotsamCollection   = FlotsamCollection::OFF;
+    AlertIndicator      alertIndicator      = AlertIndicator::NONE;
+    NotificationSetting notificationSetting = NotificationSetting::OFF;
+    int                 aiDecisionBudget    = 0;
+  };
+
 
 public:
   static void Load();
@@ -175,6 +231,13 @@ public:
   static bool Has(const std::string &name);
   static void Set(const std::string &name, bool on = true);
 
+  /// Copy the current preferences into a new snapshot. This is done by the main
+  /// thread once per frame, so any changes made during a frame apply from the next one.
+  static void PublishSnapshot();
+  /// The most recently published snapshot. It may be read from any thread, but
+  /// only stays valid until the frame after next, so don't hold on to it.
+  static const Snapshot &Current();
+
   /// Toggle the ammo usage preferences, cycling between "never," "frugally," and "always."
   static void        ToggleAmmoUsage();
   static std::string AmmoUsage();
@@ -276,6 +339,18 @@ public:
   static LargeGraphicsReduction GetLargeGraphicsReduction();
   static const std::string     &LargeGraphicsReductionSetting();
 
+  // The memory that the textures of ship, outfit, and effect sprites may take up
+  // before the least recently drawn ones are reduced, in bytes. Zero means no limit.
+  static void               ToggleTextureBudget();
+  static size_t             TextureBudget();
+  static const std::string &TextureBudgetSetting();
+
+  // How many AI ships may reconsider their targets and other strategic decisions
+  // on a single step. Zero means no limit.
+  static void               ToggleAIDecisionBudget();
+  static int                AIDecisionBudget();
+  static const std::string &AIDecisionBudgetSetting();
+
   static void ToggleBlockScreenSaver();
 
   static int GetPreviousSaveCount();
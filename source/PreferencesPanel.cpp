@@ -63,6 +63,8 @@ namespace
   const std::string VSYNC_SETTING             = "VSync";
   const std::string CAMERA_ACCELERATION       = "Camera acceleration";
   const std::string LARGE_GRAPHICS_REDUCTION  = "Reduce large graphics";
+  const std::string TEXTURE_BUDGET            = "Texture memory budget";
+  const std::string AI_DECISION_BUDGET        = "AI decisions per step";
   const std::string CLOAK_OUTLINE             = "Cloaked ship outlines";
   const std::string STATUS_OVERLAYS_ALL       = "Show status overlays";
   const std::string STATUS_OVERLAYS_FLAGSHIP  = "   Show flagship overlay";
@@ -728,7 +730,10 @@ void PreferencesPanel::DrawSettings()
       "\t",
       "Performance",
       "Show CPU / GPU load",
+      "Interpolate frames",
       LARGE_GRAPHICS_REDUCTION,
+      TEXTURE_BUDGET,
+      AI_DECISION_BUDGET,
       "Defer loading images",
       SHIP_OUTLINES,
       HUD_SHIP_OUTLINES,
@@ -873,6 +878,16 @@ void PreferencesPanel::DrawSettings()
       text = Preferences::LargeGraphicsReductionSetting();
       isOn = text != "off";
     }
+    else if(setting == TEXTURE_BUDGET)
+    {
+      text = Preferences::TextureBudgetSetting();
+      isOn = text != "unlimited";
+    }
+    else if(setting == AI_DECISION_BUDGET)
+    {
+      text = Preferences::AIDecisionBudgetSetting();
+      isOn = text != "unlimited";
+    }
     else if(setting == STATUS_OVERLAYS_FLAGSHIP)
     {
       text = Preferences::StatusOverlaysSetting(Preferences::OverlayType::FLAGSHIP);
@@ -1359,6 +1374,14 @@ void PreferencesPanel::HandleSettingsString(const std::string &str, Point cursor
   {
     Preferences::ToggleLargeGraphicsReduction();
   }
+  else if(str == TEXTURE_BUDGET)
+  {
+    Preferences::ToggleTextureBudget();
+  }
+  else if(str == AI_DECISION_BUDGET)
+  {
+    Preferences::ToggleAIDecisionBudget();
+  }
   else if(str == STATUS_OVERLAYS_ALL)
   {
     Preferences::CycleStatusOverlays(Preferences::OverlayType::ALL);
@@ -284,7 +284,8 @@ void Projectile::Move(vector<Visual> &visuals, vector<Projectile> &projectiles)
       }
     }
 
-    if(turn) angle += Angle(turn);
+    spin   = Angle(turn);
+    angle += spin;
   }
 
   if(accel)
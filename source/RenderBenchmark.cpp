@@ -0,0 +1,100 @@
+/* RenderBenchmark.cpp
+Copyright (c) 2026 by RisingLeaf
+
+Endless Sky is free software: you can redistribute it and/or modify it under the
+terms of the GNU General Public License as published by the Free Software
+Foundation, either version 3 of the License, or (at your option) any later version.
+
+Endless Sky is distributed in the hope that it will be useful, but WITHOUT ANY
+WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS FOR A
+PARTICULAR PURPOSE. See the GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License along with
+this program. If not, see <https://www.gnu.org/licenses/>.
+*/
+
+#include "RenderBenchmark.h"
+
+#include "Files.h"
+#include "Logger.h"
+#include "image/ImageBuffer.h"
+#include "risingleaf_shared/graphics/graphics_toplevel_defines.h"
+#include "text/Format.h"
+
+#include <algorithm>
+#include <cstdint>
+#include <cstring>
+#include <string>
+#include <vector>
+
+
+RenderBenchmark::RenderBenchmark(const std::filesystem::path &dumpDirectory, int dumpInterval) :
+  dumpDirectory(dumpDirectory), dumpInterval(std::max(1, dumpInterval))
+{
+  if(!dumpDirectory.empty()) Files::CreateFolder(dumpDirectory);
+}
+
+
+void RenderBenchmark::Add(const GraphicsTypes::GraphicsInstance &instance)
+{
+  ++frames;
+
+  const GraphicsTypes::FrameStatistics statistics = instance.GetFrameStatistics();
+  drawCalls += statistics.DrawCalls;
+  commands += statistics.Commands;
+  submitTime += statistics.SubmitTime;
+  maxSubmit = std::max(maxSubmit, statistics.SubmitTime);
+  if(statistics.GpuTime >= 0.)
+  {
+    ++gpuFrames;
+    gpuTime += statistics.GpuTime;
+    maxGpu = std::max(maxGpu, statistics.GpuTime);
+  }
+
+  if(dumpDirectory.empty() || frames % dumpInterval) return;
+
+  std::vector<uint8_t> pixels;
+  uint32_t             width  = 0;
+  uint32_t             height = 0;
+  if(!instance.ReadFrame(pixels, width, height))
+  {
+    Logger::Log("This graphics backend can't read back frames; no images will be saved.", Logger::Level::WARNING);
+    dumpDirectory.clear();
+    return;
+  }
+
+  ImageBuffer image;
+  image.Allocate(width, height);
+  memcpy(image.Pixels(), pixels.data(), pixels.size());
+
+  // Pad the frame number, so that the images sort in the order they were drawn.
+  std::string name = std::to_string(frames);
+  name.insert(0, name.size() < 6 ? 6 - name.size() : 0, '0');
+  const std::filesystem::path path = dumpDirectory / ("frame " + name + ".png");
+  if(image.Write(path)) ++dumped;
+  else Logger::Log("Unable to save \"" + path.string() + "\".", Logger::Level::WARNING);
+}
+
+
+void RenderBenchmark::Print(std::ostream &out) const
+{
+  if(!frames)
+  {
+    out << "No frames were drawn." << std::endl;
+    return;
+  }
+
+  out << "Frames drawn: " << frames << std::endl;
+  out << "Draw calls per frame: " << Format::Number(static_cast<double>(drawCalls) / frames, 1) << std::endl;
+  out << "Commands per frame: " << Format::Number(static_cast<double>(commands) / frames, 1) << std::endl;
+  out << "CPU submit time: " << Format::Number(submitTime / frames, 3) << " ms average, "
+      << Format::Number(maxSubmit, 3) << " ms worst" << std::endl;
+  if(gpuFrames)
+  {
+    out << "GPU time: " << Format::Number(gpuTime / gpuFrames, 3) << " ms average, " << Format::Number(maxGpu, 3)
+        << " ms worst" << std::endl;
+  }
+  else out << "GPU time: not available" << std::endl;
+  if(!dumpDirectory.empty())
+    out << "Images saved: " << dumped << " in \"" << dumpDirectory.string() << "\"" << std::endl;
+}
@@ -0,0 +1,59 @@
+/* RenderBenchmark.h
+Copyright (c) 2026 by RisingLeaf
+
+Endless Sky is free software: you can redistribute it and/or modify it under the
+terms of the GNU General Public License as published by the Free Software
+Foundation, either version 3 of the License, or (at your option) any later version.
+
+Endless Sky is distributed in the hope that it will be useful, but WITHOUT ANY
+WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS FOR A
+PARTICULAR PURPOSE. See the GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License along with
+this program. If not, see <https://www.gnu.org/licenses/>.
+*/
+
+#pragma once
+
+#include <cstddef>
+#include <filesystem>
+#include <ostream>
+
+namespace GraphicsTypes
+{
+  class GraphicsInstance;
+}
+
+
+// A render benchmark replays an integration test, drawing every step of it, and
+// collects how long the frames took to record and to render. Some of the frames
+// can be saved as images, to compare them against the output of an earlier build.
+class RenderBenchmark
+{
+public:
+  // If a directory is given, every frame whose number is a multiple of the
+  // interval is saved to it.
+  explicit RenderBenchmark(const std::filesystem::path &dumpDirectory = {}, int dumpInterval = 60);
+
+  // Add the frame that the given instance has just drawn.
+  void Add(const GraphicsTypes::GraphicsInstance &instance);
+
+  // Print the totals and averages over all frames.
+  void Print(std::ostream &out) const;
+
+
+private:
+  std::filesystem::path dumpDirectory;
+  int                   dumpInterval;
+
+  int    frames     = 0;
+  int    dumped     = 0;
+  size_t drawCalls  = 0;
+  size_t commands   = 0;
+  double submitTime = 0.;
+  double maxSubmit  = 0.;
+  // The GPU time is not known for every frame.
+  int    gpuFrames = 0;
+  double gpuTime   = 0.;
+  double maxGpu    = 0.;
+};
@@ -49,6 +49,7 @@ void RenderBuffer::Init()
   info.AddTexture("tex");
 
   shader.Create(*GameData::Shaders().Find("renderBuffer"));
+  shader.WarmUp(GraphicsTypes::PrimitiveType::TRIANGLE_STRIP);
 
   constexpr float vertexData[] = {-0.5f, -0.5f, -0.5f, 0.5f, 0.5f, -0.5f, 0.5f, 0.5f};
 
@@ -16,6 +16,9 @@ this program. If not, see <https://www.gnu.org/licenses/>.
 #include "RoutePlan.h"
 
 #include "DistanceMap.h"
+#include "RouteTree.h"
+
+#include <algorithm>
 
 
 // RoutePlan is a wrapper on DistanceMap that uses destination
@@ -31,6 +34,30 @@ RoutePlan::RoutePlan(const Ship &ship, const System &destination, const PlayerIn
 }
 
 
+// Follow the given tree of routes from the given system to its destination.
+RoutePlan::RoutePlan(const RouteTree &tree, const System &from)
+{
+  if(&from == tree.Destination() || !tree.HasRoute(from)) return;
+
+  hasRoute = true;
+
+  // The tree knows what it takes to get from each system to the destination, so
+  // the fuel and days to get to each step are what is left over once there.
+  const RouteEdge &start = tree.Next(from);
+  for(const System *system = &from; system != tree.Destination();)
+  {
+    const System *next = tree.Next(*system).prev;
+    RouteEdge     edge(system);
+    edge.fuel = start.fuel - tree.Next(*next).fuel;
+    edge.days = start.days - tree.Next(*next).days;
+    plan.emplace_back(next, edge);
+    system = next;
+  }
+  // The plan starts with the destination.
+  reverse(plan.begin(), plan.end());
+}
+
+
 void RoutePlan::Init(const DistanceMap &distance)
 {
   auto it = distance.route.find(distance.destination);
@@ -21,6 +21,7 @@ this program. If not, see <https://www.gnu.org/licenses/>.
 
 class DistanceMap;
 class PlayerInfo;
+class RouteTree;
 class Ship;
 class System;
 
@@ -33,6 +34,8 @@ public:
   RoutePlan() = default;
   RoutePlan(const System &center, const System &destination, const PlayerInfo *player = nullptr);
   RoutePlan(const Ship &ship, const System &destination, const PlayerInfo *player = nullptr);
+  // Follow the given tree of routes from the given system to its destination.
+  RoutePlan(const RouteTree &tree, const System &from);
 
   // Find out if the destination is reachable.
   bool HasRoute() const;
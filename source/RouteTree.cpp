@@ -0,0 +1,105 @@
+/* RouteTree.cpp
+Copyright (c) 2026 by RisingLeaf
+
+Endless Sky is free software: you can redistribute it and/or modify it under the
+terms of the GNU General Public License as published by the Free Software
+Foundation, either version 3 of the License, or (at your option) any later version.
+
+Endless Sky is distributed in the hope that it will be useful, but WITHOUT ANY
+WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS FOR A
+PARTICULAR PURPOSE. See the GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License along with
+this program. If not, see <https://www.gnu.org/licenses/>.
+*/
+
+#include "RouteTree.h"
+
+#include "GameData.h"
+#include "Planet.h"
+#include "Set.h"
+#include "Ship.h"
+#include "ShipJumpNavigation.h"
+#include "StellarObject.h"
+#include "System.h"
+#include "Wormhole.h"
+
+#include <queue>
+#include <utility>
+#include <vector>
+
+using namespace std;
+
+
+RouteTree::RouteTree(const Ship &ship, const System &destination) : destination(&destination)
+{
+  const ShipJumpNavigation &navigation = ship.JumpNavigation();
+  const double              jumpRange  = navigation.JumpRange();
+  // First, find every system that each system can be reached from, and the fuel it takes.
+  // These are the same links that DistanceMap follows, only pointing the other way.
+  unordered_map<const System *, vector<pair<const System *, double>>> sources;
+  for(const auto &it : GameData::Systems())
+  {
+    const System &from = it.second;
+    if(!from.IsValid()) continue;
+
+    // Wormholes cost no fuel.
+    for(const StellarObject &object : from.Objects())
+    {
+      if(!object.HasSprite() || !object.HasValidPlanet() || !object.GetPlanet()->IsWormhole()) continue;
+
+      const Planet &planet = *object.GetPlanet();
+      const System &to     = planet.GetWormhole()->WormholeDestination(from);
+      if(!planet.IsAccessible(&ship) || ship.IsRestrictedFrom(planet)) continue;
+      sources[&to].emplace_back(&from, 0.);
+    }
+    // JumpNeighbors also includes normal hyperspace links.
+    for(const System *to : (jumpRange > 0. ? from.JumpNeighbors(jumpRange) : from.Links()))
+      if(!ship.IsRestrictedFrom(*to)) sources[to].emplace_back(&from, navigation.GetCheapestJumpType(&from, to).second);
+  }
+
+  // Then search outward from the destination. Each queued edge's 'prev' is the system
+  // it leads out of, and its fuel and days are what it takes to get from there to the
+  // destination.
+  route[&destination] = RouteEdge();
+  priority_queue<RouteEdge> edgesTodo;
+  edgesTodo.emplace(&destination);
+  while(!edgesTodo.empty())
+  {
+    const RouteEdge edge = edgesTodo.top();
+    edgesTodo.pop();
+
+    // Skip any edge that a better route to the same system was found after.
+    const System *current = edge.prev;
+    if(edge < route[current]) continue;
+
+    const auto it = sources.find(current);
+    if(it == sources.end()) continue;
+    for(const auto &[from, fuelCost] : it->second)
+    {
+      RouteEdge nextEdge  = edge;
+      nextEdge.prev       = current;
+      nextEdge.fuel      += fuelCost;
+      ++nextEdge.days;
+
+      // Find out whether we already have a better path from this system.
+      const auto found = route.find(from);
+      if(found != route.end() && !(found->second < nextEdge)) continue;
+
+      route[from]   = nextEdge;
+      nextEdge.prev = from;
+      edgesTodo.emplace(nextEdge);
+    }
+  }
+}
+
+
+const System *RouteTree::Destination() const { return destination; }
+
+
+// Find out if the destination can be reached from the given system.
+bool RouteTree::HasRoute(const System &from) const { return route.contains(&from); }
+
+
+// Get the edge leading out of the given system toward the destination.
+const RouteEdge &RouteTree::Next(const System &from) const { return route.at(&from); }
@@ -0,0 +1,50 @@
+/* RouteTree.h
+Copyright (c) 2026 by RisingLeaf
+
+Endless Sky is free software: you can redistribute it and/or modify it under the
+terms of the GNU General Public License as published by the Free Software
+Foundation, either version 3 of the License, or (at your option) any later version.
+
+Endless Sky is distributed in the hope that it will be useful, but WITHOUT ANY
+WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS FOR A
+PARTICULAR PURPOSE. See the GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License along with
+this program. If not, see <https://www.gnu.org/licenses/>.
+*/
+
+#pragma once
+
+#include "RouteEdge.h"
+
+#include <unordered_map>
+
+class Ship;
+class System;
+
+
+// A RouteTree holds the best routes from every system to a single destination,
+// for any ship with the same travel capabilities and restrictions as the one it
+// was made for. Unlike a DistanceMap, which branches out from where a ship is,
+// it is found by searching backwards from the destination, so every NPC that is
+// heading to the same system can share it. It uses the same rules as DistanceMap,
+// except that it does not take the player's knowledge of the map into account.
+class RouteTree
+{
+public:
+  RouteTree() = default;
+  RouteTree(const Ship &ship, const System &destination);
+
+  const System *Destination() const;
+  // Find out if the destination can be reached from the given system.
+  bool HasRoute(const System &from) const;
+  // Get the edge leading out of the given system toward the destination. Its 'prev'
+  // is the next system along the route, and its fuel and days are what it takes to
+  // get from the given system to the destination.
+  const RouteEdge &Next(const System &from) const;
+
+
+private:
+  const System                                 *destination = nullptr;
+  std::unordered_map<const System *, RouteEdge> route;
+};
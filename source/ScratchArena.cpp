@@ -0,0 +1,99 @@
+/* ScratchArena.cpp
+Copyright (c) 2026 by RisingLeaf
+
+Endless Sky is free software: you can redistribute it and/or modify it under the
+terms of the GNU General Public License as published by the Free Software
+Foundation, either version 3 of the License, or (at your option) any later version.
+
+Endless Sky is distributed in the hope that it will be useful, but WITHOUT ANY
+WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS FOR A
+PARTICULAR PURPOSE. See the GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License along with
+this program. If not, see <https://www.gnu.org/licenses/>.
+*/
+
+#include "ScratchArena.h"
+
+#include <algorithm>
+
+using namespace std;
+
+namespace
+{
+  // The smallest block that the arena allocates.
+  const size_t MIN_BLOCK_SIZE = 64 * 1024;
+}
+
+
+// Make all of the memory available again. Nothing that was allocated since the
+// last reset may be used after this.
+void ScratchArena::Reset()
+{
+  // If the last step needed more than one block, replace them all with a single
+  // block that is big enough for all of it.
+  if(blocks.size() > 1)
+  {
+    const size_t size = Capacity();
+    blocks.clear();
+    blocks.push_back(Block{make_unique_for_overwrite<byte[]>(size), size});
+  }
+  current     = 0;
+  offset      = 0;
+  allocations = 0;
+  bytesUsed   = 0;
+}
+
+
+size_t ScratchArena::Allocations() const { return allocations; }
+
+
+size_t ScratchArena::BytesUsed() const { return bytesUsed; }
+
+
+// The total size of all the blocks.
+size_t ScratchArena::Capacity() const
+{
+  size_t capacity = 0;
+  for(const Block &block : blocks)
+    capacity += block.size;
+  return capacity;
+}
+
+
+void *ScratchArena::do_allocate(size_t bytes, size_t alignment)
+{
+  ++allocations;
+  bytesUsed += bytes;
+
+  // Use the first block (starting from the current one) that has room left.
+  for(; current < blocks.size(); ++current, offset = 0)
+  {
+    Block &block = blocks[current];
+    void  *start = block.data.get() + offset;
+    size_t space = block.size - offset;
+    if(align(alignment, bytes, start, space))
+    {
+      offset = block.size - space + bytes;
+      return start;
+    }
+  }
+
+  // Otherwise, add a block that is at least twice as big as the last one.
+  const size_t size = max({MIN_BLOCK_SIZE, bytes + alignment, blocks.empty() ? 0 : 2 * blocks.back().size});
+  blocks.push_back(Block{make_unique_for_overwrite<byte[]>(size), size});
+  current = blocks.size() - 1;
+
+  void  *start = blocks.back().data.get();
+  size_t space = size;
+  align(alignment, bytes, start, space);
+  offset = size - space + bytes;
+  return start;
+}
+
+
+// Memory is only ever given back all at once, by resetting the arena.
+void ScratchArena::do_deallocate(void *, size_t, size_t) {}
+
+
+bool ScratchArena::do_is_equal(const pmr::memory_resource &other) const noexcept { return this == &other; }
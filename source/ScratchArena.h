@@ -0,0 +1,71 @@
+/* ScratchArena.h
+Copyright (c) 2026 by RisingLeaf
+
+Endless Sky is free software: you can redistribute it and/or modify it under the
+terms of the GNU General Public License as published by the Free Software
+Foundation, either version 3 of the License, or (at your option) any later version.
+
+Endless Sky is distributed in the hope that it will be useful, but WITHOUT ANY
+WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS FOR A
+PARTICULAR PURPOSE. See the GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License along with
+this program. If not, see <https://www.gnu.org/licenses/>.
+*/
+
+#pragma once
+
+#include <cstddef>
+#include <memory>
+#include <memory_resource>
+#include <vector>
+
+
+// A ScratchArena provides the memory for containers that only need to live for
+// a single step, like the results of collision checks and of searches for nearby
+// ships. It can be given to any std::pmr container. Memory is handed out from
+// large blocks and never freed on its own; instead, the whole arena is reset at
+// the start of each step. The blocks are kept for the next step, so once the
+// arena has grown big enough for a busy step, no more memory is allocated.
+class ScratchArena : public std::pmr::memory_resource
+{
+public:
+  ScratchArena() = default;
+  ScratchArena(const ScratchArena &)            = delete;
+  ScratchArena &operator=(const ScratchArena &) = delete;
+
+  // Make all of the memory available again. Nothing that was allocated since the
+  // last reset may be used after this.
+  void Reset();
+
+  // How many allocations were made since the last reset, and how many bytes they used.
+  std::size_t Allocations() const;
+  std::size_t BytesUsed() const;
+  // The total size of all the blocks.
+  std::size_t Capacity() const;
+
+
+private:
+  void *do_allocate(std::size_t bytes, std::size_t alignment) override;
+  void  do_deallocate(void *pointer, std::size_t bytes, std::size_t alignment) override;
+  bool  do_is_equal(const std::pmr::memory_resource &other) const noexcept override;
+
+
+private:
+  class Block
+  {
+  public:
+    std::unique_ptr<std::byte[]> data;
+    std::size_t                  size = 0;
+  };
+
+
+private:
+  std::vector<Block> blocks;
+  // The block that is being filled, and how much of it has been used.
+  std::size_t current = 0;
+  std::size_t offset  = 0;
+
+  std::size_t allocations = 0;
+  std::size_t bytesUsed   = 0;
+};
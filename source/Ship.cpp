@@ -57,10 +57,9 @@ this program. If not, see <https://www.gnu.org/licenses/>.
 
 namespace
 {
-  const std::string              FIGHTER_REPAIR = "Repair fighters in";
-  const std::vector<std::string> BAY_SIDE       = {"inside", "over", "under"};
-  const std::vector<std::string> BAY_FACING     = {"forward", "left", "right", "back"};
-  const std::vector<Angle>       BAY_ANGLE      = {Angle(0.), Angle(-90.), Angle(90.), Angle(180.)};
+  const std::vector<std::string> BAY_SIDE   = {"inside", "over", "under"};
+  const std::vector<std::string> BAY_FACING = {"forward", "left", "right", "back"};
+  const std::vector<Angle>       BAY_ANGLE  = {Angle(0.), Angle(-90.), Angle(90.), Angle(180.)};
 
   const std::vector<std::string> ENGINE_SIDE     = {"under", "over"};
   const std::vector<std::string> STEERING_FACING = {"none", "left", "right"};
@@ -1392,6 +1391,7 @@ void Ship::Place(Point position, Point velocity, Angle angle, bool isDeparting)
   jettisoned.clear();
   jettisonedFromBay.clear();
   hyperspaceCount = 0;
+  travelSteps     = 0;
   forget          = 1;
   targetShip.reset();
   shipToAssist.reset();
@@ -1543,6 +1543,8 @@ const FireCommand &Ship::FiringCommands() const noexcept { return firingCommands
 // should be deleted.
 void Ship::Move(std::vector<Visual> &visuals, std::list<std::shared_ptr<Flotsam>> &flotsam)
 {
+  // Only steering counts as turning, so that jumps in the facing are not drawn as a turn.
+  spin = Angle();
   // Do nothing with ships that are being forgotten.
   if(StepFlags()) return;
 
@@ -1575,13 +1577,19 @@ void Ship::Move(std::vector<Visual> &visuals, std::list<std::shared_ptr<Flotsam>
     // If we landed, we're done.
     if(DoLandingLogic()) return;
 
-    // Move the turrets.
-    if(!isDisabled) armament.Aim(*this, firingCommands);
+    // A ship that is traveling outside the player's system is flown normally again as
+    // soon as it is in the player's system, or if it cannot keep up with the costs.
+    if(travelSteps && (!forget || isDisabled || energy < travelEnergy || fuel < travelFuel)) travelSteps = 0;
+    if(travelSteps) DoBackgroundTravel();
+    else {
+      // Move the turrets. Outside the player's system, there is nothing to aim at.
+      if(!isDisabled && !forget) armament.Aim(*this, firingCommands);
 
-    DoInitializeMovement();
-    StepPilot();
-    DoMovement(isUsingAfterburner);
-    StepTargeting();
+      DoInitializeMovement();
+      StepPilot();
+      DoMovement(isUsingAfterburner);
+      StepTargeting();
+    }
   }
 
   // Move the ship.
@@ -1595,6 +1603,61 @@ void Ship::Move(std::vector<Visual> &visuals, std::list<std::shared_ptr<Flotsam>
 }
 
 
+// Have this ship, which must be outside the player's system, travel to the given
+// point without being flown there step by step.
+bool Ship::TravelInBackground(const Point &destination, const Angle &facing)
+{
+  if(!forget || isDisabled || IsDestroyed() || hyperspaceCount || landingPlanet || zoom != 1.f || pilotError)
+    return false;
+  // Thrusters and steering that cost shields or hull are too dangerous to skip over.
+  if(attributes.GetIndexed(Outfit::INTERNAL_ATTR("thrusting shields")) ||
+     attributes.GetIndexed(Outfit::INTERNAL_ATTR("thrusting hull")) ||
+     attributes.GetIndexed(Outfit::INTERNAL_ATTR("turning shields")) ||
+     attributes.GetIndexed(Outfit::INTERNAL_ATTR("turning hull")))
+  {
+    return false;
+  }
+
+  const double speed        = MaxVelocity();
+  const double acceleration = Acceleration();
+  const double turnRate     = TurnRate();
+  if(!attributes.GetIndexed(Outfit::INTERNAL_ATTR("thrust")) || speed <= 0. || acceleration <= 0. || turnRate <= 0.)
+    return false;
+
+  // The ship turns toward its destination, speeds up, turns around to slow down,
+  // and then turns to face the given direction. If the trip is too short for it
+  // to reach its top speed, it starts slowing down halfway there.
+  const Point  offset   = destination - position;
+  const double distance = offset.Length();
+  const Angle  heading(offset);
+  const double degrees   = fabs((heading - angle).Degrees()) + 180. + fabs((facing - heading).Degrees());
+  const double turning   = degrees / turnRate;
+  const double thrusting = 2. * std::min(speed, sqrt(distance * acceleration)) / acceleration;
+  const double cruising  = std::max(0., distance / speed - speed / acceleration);
+  travelSteps            = std::max(1, static_cast<int>(ceil(turning + thrusting + cruising)));
+
+  // Spread what the thrusters and steering would use evenly over the trip.
+  travelEnergy = (thrusting * attributes.GetIndexed(Outfit::INTERNAL_ATTR("thrusting energy")) +
+                  turning * attributes.GetIndexed(Outfit::INTERNAL_ATTR("turning energy"))) /
+                 travelSteps;
+  travelFuel = (thrusting * attributes.GetIndexed(Outfit::INTERNAL_ATTR("thrusting fuel")) +
+                turning * attributes.GetIndexed(Outfit::INTERNAL_ATTR("turning fuel"))) /
+               travelSteps;
+  travelHeat = (thrusting * attributes.GetIndexed(Outfit::INTERNAL_ATTR("thrusting heat")) +
+                turning * attributes.GetIndexed(Outfit::INTERNAL_ATTR("turning heat"))) /
+               travelSteps;
+  travelDestination = destination;
+  travelFacing      = facing;
+
+  // Face the way it is going, in case the player arrives before it does.
+  Turn(heading - angle);
+  return true;
+}
+
+
+bool Ship::IsTravelingInBackground() const { return travelSteps; }
+
+
 // Launch any ships that are ready to launch.
 void Ship::Launch(std::list<std::shared_ptr<Ship>> &ships, std::vector<Visual> &visuals)
 {
@@ -2066,6 +2129,13 @@ bool Ship::HasAntiMissile() const { return antiMissileRange; }
 bool Ship::HasTractorBeam() const { return tractorBeamRange; }
 
 
+// The longest range of any anti-missile or tractor beam systems that are ready to fire.
+double Ship::AntiMissileRange() const { return antiMissileRange; }
+
+
+double Ship::TractorBeamRange() const { return tractorBeamRange; }
+
+
 // Fire an anti-missile.
 bool Ship::FireAntiMissile(const Projectile &projectile, std::vector<Visual> &visuals)
 {
@@ -2100,7 +2170,7 @@ Point Ship::FireTractorBeam(const Flotsam &flotsam, std::vector<Visual> &visuals
   if(!CanPickUp(flotsam)) return pullVector;
   if(IsYours())
   {
-    const auto flotsamSetting = Preferences::GetFlotsamCollection();
+    const auto flotsamSetting = Preferences::Current().flotsamCollection;
     if(flotsamSetting == Preferences::FlotsamCollection::OFF) return pullVector;
     if(!GetParent() && flotsamSetting == Preferences::FlotsamCollection::ESCORT) return pullVector;
     if(GetParent() && flotsamSetting == Preferences::FlotsamCollection::FLAGSHIP) return pullVector;
@@ -2108,8 +2178,9 @@ Point Ship::FireTractorBeam(const Flotsam &flotsam, std::vector<Visual> &visuals
 
   double jamChance = CalculateJamChance(scrambling);
 
-  bool                          opportunisticEscorts = !Preferences::Has("Turrets focus fire");
-  const std::vector<Hardpoint> &hardpoints           = armament.Get();
+  bool opportunisticEscorts = !Preferences::Current().Has(Preferences::Flag::TURRETS_FOCUS_FIRE);
+
+  const std::vector<Hardpoint> &hardpoints = armament.Get();
   for(unsigned i = 0; i < hardpoints.size(); ++i)
   {
     const Weapon *weapon = hardpoints[i].GetWeapon();
@@ -3118,7 +3189,7 @@ bool Ship::Carry(const std::shared_ptr<Ship> &ship)
 
   // NPC ships should always transfer cargo. Player ships should only
   // transfer cargo if they set the AI preference.
-  const bool shouldTransferCargo = !IsYours() || Preferences::Has("Fighters transfer cargo");
+  const bool shouldTransferCargo = !IsYours() || Preferences::Current().Has(Preferences::Flag::FIGHTERS_TRANSFER_CARGO);
 
   for(Bay &bay : bays)
   {
@@ -3746,7 +3817,7 @@ void Ship::DoGeneration()
       std::sort(
           carried.begin(),
           carried.end(),
-          (isYours && Preferences::Has(FIGHTER_REPAIR))
+          (isYours && Preferences::Current().Has(Preferences::Flag::REPAIR_FIGHTERS_IN))
               // Players may use a parallel strategy, to launch fighters in waves.
               ? [](const std::pair<double, Ship *> &lhs, const std::pair<double, Ship *> &rhs)
               { return lhs.first > rhs.first; }
@@ -4401,7 +4472,7 @@ void Ship::StepPilot()
       {
         Messages::Add(*GameData::Messages().Get("undercrewed flagship"));
       }
-      else if(Preferences::Has("Extra fleet status messages"))
+      else if(Preferences::Current().Has(Preferences::Flag::EXTRA_FLEET_STATUS_MESSAGES))
       {
         Messages::Add(
             {"The " + givenName + " is moving erratically because there are not enough crew to pilot it.",
@@ -4474,7 +4545,8 @@ void Ship::DoMovement(bool &isUsingAfterburner)
         slowness   += scale * attributes.GetIndexed(Outfit::INTERNAL_ATTR("turning slowing"));
         disruption += scale * attributes.GetIndexed(Outfit::INTERNAL_ATTR("turning disruption"));
 
-        Turn(commands.Turn() * TurnRate() * slowMultiplier);
+        spin = Angle(commands.Turn() * TurnRate() * slowMultiplier);
+        Turn(spin);
       }
     }
     double thrustCommand = commands.Has(Command::FORWARD) - commands.Has(Command::BACK);
@@ -4649,6 +4721,25 @@ void Ship::DoMovement(bool &isUsingAfterburner)
 }
 
 
+// Move a ship that is traveling outside the player's system one step closer to its destination.
+void Ship::DoBackgroundTravel()
+{
+  energy -= travelEnergy;
+  fuel   -= travelFuel;
+  heat   += travelHeat;
+
+  if(--travelSteps)
+  {
+    velocity = (travelDestination - position) / (travelSteps + 1);
+    return;
+  }
+  // It has arrived, and has stopped and turned the way it wants to face.
+  position = travelDestination;
+  velocity = Point();
+  Turn(travelFacing - angle);
+}
+
+
 void Ship::StepTargeting()
 {
   // Boarding:
@@ -4688,7 +4779,8 @@ void Ship::StepTargeting()
       facing         += TurnRate() * turn;
       bool stillLeft  = target->Unit().Cross(facing.Unit()) < 0.;
       if(left != stillLeft) turn = 0.;
-      angle += TurnRate() * turn;
+      spin   = Angle(TurnRate() * turn);
+      angle += spin;
 
       velocity += dv.Unit() * .1;
       position += dp.Unit() * .5;
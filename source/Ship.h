@@ -249,6 +249,14 @@ public:
   // Move this ship. A ship may create effects as it moves, in particular if
   // it is in the process of blowing up.
   void Move(std::vector<Visual> &visuals, std::list<std::shared_ptr<Flotsam>> &flotsam);
+  // Have this ship, which must be outside the player's system, travel to the given
+  // point without being flown there step by step. It moves in a straight line, and
+  // how long that takes and how much energy, fuel, and heat its thrusters and
+  // steering would use on the way are worked out when it sets off. It arrives
+  // stopped and facing in the given direction. Once it is back in the player's
+  // system, it is flown normally again. Returns false if it cannot travel this way.
+  bool TravelInBackground(const Point &destination, const Angle &facing);
+  bool IsTravelingInBackground() const;
 
   // Launch any ships that are ready to launch.
   void Launch(std::list<std::shared_ptr<Ship>> &ships, std::vector<Visual> &visuals);
@@ -270,6 +278,9 @@ public:
   // Return true if any anti-missile or tractor beam systems are ready to fire.
   bool HasAntiMissile() const;
   bool HasTractorBeam() const;
+  // The longest range of any anti-missile or tractor beam systems that are ready to fire.
+  double AntiMissileRange() const;
+  double TractorBeamRange() const;
   // Fire an anti-missile at the given missile. Returns true if the missile was killed.
   bool FireAntiMissile(const Projectile &projectile, std::vector<Visual> &visuals);
   // Fire tractor beams at the given flotsam. Returns a Point representing the net
@@ -588,6 +599,7 @@ private:
   void DoInitializeMovement();
   void StepPilot();
   void DoMovement(bool &isUsingAfterburner);
+  void DoBackgroundTravel();
   void StepTargeting();
   void DoEngineVisuals(std::vector<Visual> &visuals, bool isUsingAfterburner);
 
@@ -754,6 +766,15 @@ private:
   double             hyperspaceFuelCost = 0.;
   Point              hyperspaceOffset;
 
+  // A ship outside the player's system may travel somewhere without being flown there.
+  // The costs are how much it uses on each step of the way.
+  Point  travelDestination;
+  Angle  travelFacing;
+  int    travelSteps  = 0;
+  double travelEnergy = 0.;
+  double travelFuel   = 0.;
+  double travelHeat   = 0.;
+
   // The hull may spring a "leak" (venting atmosphere, flames, blood, etc.)
   // when the ship is dying.
   class Leak
@@ -0,0 +1,239 @@
+/* ShipIndex.cpp
+Copyright (c) 2026 by RisingLeaf
+
+Endless Sky is free software: you can redistribute it and/or modify it under the
+terms of the GNU General Public License as published by the Free Software
+Foundation, either version 3 of the License, or (at your option) any later version.
+
+Endless Sky is distributed in the hope that it will be useful, but WITHOUT ANY
+WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS FOR A
+PARTICULAR PURPOSE. See the GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License along with
+this program. If not, see <https://www.gnu.org/licenses/>.
+*/
+
+#include "ShipIndex.h"
+
+#include "Government.h"
+#include "Personality.h"
+#include "Point.h"
+#include "Ship.h"
+
+#include <algorithm>
+#include <limits>
+#include <numeric>
+#include <tuple>
+
+using namespace std;
+
+
+ShipIndex::ShipIndex(unsigned cellSize, unsigned cellCount)
+{
+  // Right shift amount to convert from (x, y) location to grid (x, y).
+  SHIFT = 0u;
+  while(cellSize >>= 1u)
+    ++SHIFT;
+  CELL_SIZE = (1u << SHIFT);
+
+  // Number of grid rows and columns.
+  CELLS = 1u;
+  while(cellCount >>= 1u)
+    CELLS <<= 1;
+  WRAP_MASK = CELLS - 1u;
+
+  counts.resize(CELLS * CELLS + 2u, 0u);
+}
+
+
+// Call the given function for each entry in the cell with the given grid coordinates.
+template <class Function>
+void ShipIndex::ForEachInCell(int x, int y, Function &&function) const
+{
+  const unsigned index = (y & WRAP_MASK) * CELLS + (x & WRAP_MASK);
+  for(auto it = sorted.begin() + counts[index], end = sorted.begin() + counts[index + 1]; it != end; ++it)
+  {
+    // Skip ships that were put in this same grid cell only because
+    // of the cell coordinates wrapping around.
+    if(it->x == x && it->y == y) function(*it);
+  }
+}
+
+
+// Rebuild the index from the ships of each government.
+void ShipIndex::Build(const map<const Government *, vector<Ship *>> &rosters)
+{
+  teams.clear();
+  entries.clear();
+  maxSpeed = 0.;
+  // The counts vector starts with two sentinel slots that will be used in the
+  // course of performing the radix sort.
+  counts.assign(CELLS * CELLS + 2u, 0u);
+
+  for(const auto &it : rosters)
+  {
+    const unsigned team = teams.size();
+    teams.emplace(it.first, team);
+  }
+  const size_t size = teams.size();
+  isEnemy.assign(size * size, false);
+  for(const auto &[gov, team] : teams)
+    for(const auto &[otherGov, otherTeam] : teams)
+      isEnemy[team * size + otherTeam] = gov->IsEnemy(otherGov);
+
+  for(const auto &[gov, roster] : rosters)
+  {
+    const unsigned team = teams[gov];
+    for(Ship *ship : roster)
+    {
+      const int x = static_cast<int>(ship->Position().X()) >> SHIFT;
+      const int y = static_cast<int>(ship->Position().Y()) >> SHIFT;
+      entries.emplace_back(ship, entries.size(), team, x, y);
+      ++counts[(y & WRAP_MASK) * CELLS + (x & WRAP_MASK) + 2];
+      maxSpeed = max(maxSpeed, ship->Velocity().Length());
+    }
+  }
+
+  // Sort the entries by grid cell, in the same way as a CollisionSet.
+  partial_sum(counts.begin(), counts.end(), counts.begin());
+  sorted.resize(entries.size());
+  for(const Entry &entry : entries)
+    sorted[counts[(entry.y & WRAP_MASK) * CELLS + (entry.x & WRAP_MASK) + 1]++] = entry;
+}
+
+
+// Get all ships within the given range that the given ship can target and that are
+// (or are not) its enemies.
+void ShipIndex::Radius(const Ship &ship, bool targetEnemies, double maxRange, pmr::vector<Ship *> &result) const
+{
+  unsigned team;
+  if(!FindTeam(ship, team)) return;
+
+  const Point &center = ship.Position();
+  // If the range covers more grid cells than there are ships, it is faster to just check every ship.
+  const double across = maxRange < 0. ? numeric_limits<double>::infinity() : 2. * maxRange / CELL_SIZE + 1.;
+  if(across * across > entries.size())
+  {
+    if(maxRange < 0.) maxRange = numeric_limits<double>::infinity();
+    for(const Entry &entry : entries)
+      if(Matches(ship, team, targetEnemies, entry) && center.Distance(entry.ship->Position()) < maxRange)
+        result.push_back(entry.ship);
+    return;
+  }
+
+  // Anything found is kept in the same memory as the results.
+  pmr::vector<pair<unsigned, Ship *>> found(result.get_allocator());
+  const int                           minX = static_cast<int>(center.X() - maxRange) >> SHIFT;
+  const int                           minY = static_cast<int>(center.Y() - maxRange) >> SHIFT;
+  const int                           maxX = static_cast<int>(center.X() + maxRange) >> SHIFT;
+  const int                           maxY = static_cast<int>(center.Y() + maxRange) >> SHIFT;
+  for(int y = minY; y <= maxY; ++y)
+    for(int x = minX; x <= maxX; ++x)
+      ForEachInCell(
+          x,
+          y,
+          [&](const Entry &entry)
+          {
+            if(Matches(ship, team, targetEnemies, entry) && center.Distance(entry.ship->Position()) < maxRange)
+              found.emplace_back(entry.order, entry.ship);
+          });
+
+  // Return the ships in roster order, so that the choice between two equally good
+  // targets does not depend on where they are in the grid.
+  sort(found.begin(), found.end());
+  for(const auto &it : found)
+    result.push_back(it.second);
+}
+
+
+// Get up to the given number of such ships that also pass the given filter,
+// starting with the nearest one.
+void ShipIndex::Nearest(
+    const Ship                         &ship,
+    bool                                targetEnemies,
+    size_t                              count,
+    double                              maxRange,
+    pmr::vector<Ship *>                &result,
+    const function<bool(const Ship &)> &filter) const
+{
+  unsigned team;
+  if(!count || !FindTeam(ship, team)) return;
+  if(maxRange < 0.) maxRange = numeric_limits<double>::infinity();
+
+  const Point                                 &center = ship.Position();
+  pmr::vector<tuple<double, unsigned, Ship *>> found(result.get_allocator());
+  auto Consider = [&](const Entry &entry) -> void
+  {
+    if(!Matches(ship, team, targetEnemies, entry)) return;
+    const double distance = center.Distance(entry.ship->Position());
+    if(distance < maxRange && (!filter || filter(*entry.ship))) found.emplace_back(distance, entry.order, entry.ship);
+  };
+
+  // Search outward from the ship's own grid cell, one ring of cells at a time.
+  const int x = static_cast<int>(center.X()) >> SHIFT;
+  const int y = static_cast<int>(center.Y()) >> SHIFT;
+  for(int ring = 0;; ++ring)
+  {
+    // Once the rings cover more grid cells than there are ships, just check every ship.
+    const size_t across = 2 * ring + 1;
+    if(across * across > entries.size())
+    {
+      found.clear();
+      for(const Entry &entry : entries)
+        Consider(entry);
+      break;
+    }
+
+    if(!ring) ForEachInCell(x, y, Consider);
+    for(int i = -ring; ring && i <= ring; ++i)
+    {
+      ForEachInCell(x + i, y - ring, Consider);
+      ForEachInCell(x + i, y + ring, Consider);
+      if(i != -ring && i != ring)
+      {
+        ForEachInCell(x - ring, y + i, Consider);
+        ForEachInCell(x + ring, y + i, Consider);
+      }
+    }
+
+    // Any ship in a cell that has not been searched yet is at least this far away.
+    const double reach = static_cast<double>(ring) * CELL_SIZE;
+    if(reach >= maxRange) break;
+    if(found.size() >= count)
+    {
+      nth_element(found.begin(), found.begin() + (count - 1), found.end());
+      if(get<0>(found[count - 1]) <= reach) break;
+    }
+  }
+
+  sort(found.begin(), found.end());
+  for(size_t i = 0; i < found.size() && i < count; ++i)
+    result.push_back(get<2>(found[i]));
+}
+
+
+// Get the speed of the fastest ship in the index.
+double ShipIndex::MaxSpeed() const { return maxSpeed; }
+
+
+bool ShipIndex::FindTeam(const Ship &ship, unsigned &team) const
+{
+  const auto it = teams.find(ship.GetGovernment());
+  if(it == teams.end()) return false;
+
+  team = it->second;
+  return true;
+}
+
+
+// Check whether a ship of the given team should consider the given entry.
+bool ShipIndex::Matches(const Ship &ship, unsigned team, bool targetEnemies, const Entry &entry) const
+{
+  if(static_cast<bool>(isEnemy[team * teams.size() + entry.team]) != targetEnemies) return false;
+
+  const Ship &target = *entry.ship;
+  return target.IsTargetable() && target.GetSystem() == ship.GetSystem() &&
+         !(target.IsHyperspacing() && target.Velocity().Length() > 10.) &&
+         (ship.IsYours() || !target.GetPersonality().IsMarked()) &&
+         (target.IsYours() || !ship.GetPersonality().IsMarked());
+}
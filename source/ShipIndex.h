@@ -0,0 +1,102 @@
+/* ShipIndex.h
+Copyright (c) 2026 by RisingLeaf
+
+Endless Sky is free software: you can redistribute it and/or modify it under the
+terms of the GNU General Public License as published by the Free Software
+Foundation, either version 3 of the License, or (at your option) any later version.
+
+Endless Sky is distributed in the hope that it will be useful, but WITHOUT ANY
+WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS FOR A
+PARTICULAR PURPOSE. See the GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License along with
+this program. If not, see <https://www.gnu.org/licenses/>.
+*/
+
+#pragma once
+
+#include <cstddef>
+#include <functional>
+#include <map>
+#include <memory_resource>
+#include <vector>
+
+class Government;
+class Ship;
+
+
+// A ShipIndex sorts the ships in the player's system into a grid, partitioned by
+// government, so that the AI can find the hostile or friendly ships near a given
+// ship without having to check every ship in the system. It is rebuilt every step.
+class ShipIndex
+{
+public:
+  // The cell size and cell count should both be powers of two; otherwise, they
+  // are rounded down to a power of two.
+  ShipIndex(unsigned cellSize, unsigned cellCount);
+
+  // Rebuild the index from the ships of each government.
+  void Build(const std::map<const Government *, std::vector<Ship *>> &rosters);
+
+  // Get all ships within the given range that the given ship can target and that are
+  // (or are not) its enemies. A negative range means there is no limit. The ships are
+  // returned in the order of the government rosters.
+  void Radius(const Ship &ship, bool targetEnemies, double maxRange, std::pmr::vector<Ship *> &result) const;
+  // Get up to the given number of such ships that also pass the given filter,
+  // starting with the nearest one.
+  void Nearest(
+      const Ship                              &ship,
+      bool                                     targetEnemies,
+      std::size_t                              count,
+      double                                   maxRange,
+      std::pmr::vector<Ship *>                &result,
+      const std::function<bool(const Ship &)> &filter = {}) const;
+  // Get the speed of the fastest ship in the index.
+  double MaxSpeed() const;
+
+
+private:
+  class Entry
+  {
+  public:
+    Entry() = default;
+    Entry(Ship *ship, unsigned order, unsigned team, int x, int y) : ship(ship), order(order), team(team), x(x), y(y) {}
+
+    Ship    *ship;
+    // The position of this ship in the government rosters.
+    unsigned order;
+    unsigned team;
+    int      x;
+    int      y;
+  };
+
+
+private:
+  // Find the team of the given ship, returning false if it has none.
+  bool FindTeam(const Ship &ship, unsigned &team) const;
+  // Check whether a ship of the given team should consider the given entry.
+  bool Matches(const Ship &ship, unsigned team, bool targetEnemies, const Entry &entry) const;
+  // Call the given function for each entry in the cell with the given grid coordinates.
+  template <class Function>
+  void ForEachInCell(int x, int y, Function &&function) const;
+
+
+private:
+  // The size of individual cells of the grid.
+  unsigned CELL_SIZE;
+  unsigned SHIFT;
+  // The number of grid cells in each direction.
+  unsigned CELLS;
+  unsigned WRAP_MASK;
+
+  // Each government with ships in the system forms a team. The hostility between
+  // any two teams is looked up once per step.
+  std::map<const Government *, unsigned> teams;
+  std::vector<char>                      isEnemy;
+  // All entries, in roster order, and sorted by grid cell.
+  std::vector<Entry> entries;
+  std::vector<Entry> sorted;
+  // counts[index] is where a certain grid cell begins in the sorted entries.
+  std::vector<unsigned> counts;
+  double                maxSpeed = 0.;
+};
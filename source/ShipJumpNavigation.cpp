@@ -155,12 +155,19 @@ bool ShipJumpNavigation::HasJumpDrive() const { return hasJumpDrive; }
 
 
 size_t ShipJumpNavigation::Hash() const
+{
+  size_t hash = CapabilityHash();
+  Hasher::Hash(hash, currentSystem);
+  return hash;
+}
+
+
+// The same, but without the system the ship is in, for routes that can start anywhere.
+size_t ShipJumpNavigation::CapabilityHash() const
 {
   // Include in the hash only that information that can influence pathfinding.
   size_t hash = 0;
 
-  Hasher::Hash(hash, currentSystem);
-
   // Whether the hyperdrive is a scram drive doesn't change pathfinding.
   Hasher::Hash(hash, hasHyperdrive);
   Hasher::Hash(hash, hasJumpDrive);
@@ -64,6 +64,8 @@ public:
 
   // Create a hash of the capabilities of this ship, for use in caching pathfinding.
   std::size_t Hash() const;
+  // The same, but without the system the ship is in, for routes that can start anywhere.
+  std::size_t CapabilityHash() const;
 
 
 private:
@@ -0,0 +1,117 @@
+/* ShipRangeIndex.cpp
+Copyright (c) 2026 by RisingLeaf
+
+Endless Sky is free software: you can redistribute it and/or modify it under the
+terms of the GNU General Public License as published by the Free Software
+Foundation, either version 3 of the License, or (at your option) any later version.
+
+Endless Sky is distributed in the hope that it will be useful, but WITHOUT ANY
+WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS FOR A
+PARTICULAR PURPOSE. See the GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License along with
+this program. If not, see <https://www.gnu.org/licenses/>.
+*/
+
+#include "ShipRangeIndex.h"
+
+#include "Point.h"
+#include "Ship.h"
+
+#include <algorithm>
+#include <numeric>
+#include <utility>
+
+using namespace std;
+
+
+ShipRangeIndex::ShipRangeIndex(unsigned cellSize, unsigned cellCount)
+{
+  // Right shift amount to convert from (x, y) location to grid (x, y).
+  SHIFT = 0u;
+  while(cellSize >>= 1u)
+    ++SHIFT;
+  CELL_SIZE = (1u << SHIFT);
+
+  // Number of grid rows and columns.
+  CELLS = 1u;
+  while(cellCount >>= 1u)
+    CELLS <<= 1;
+  WRAP_MASK = CELLS - 1u;
+
+  counts.resize(CELLS * CELLS + 2u, 0u);
+}
+
+
+// Remove all ships from the index.
+void ShipRangeIndex::Clear()
+{
+  entries.clear();
+  sorted.clear();
+  maxRange = 0.;
+  // The counts vector starts with two sentinel slots that will be used in the
+  // course of performing the radix sort.
+  counts.assign(CELLS * CELLS + 2u, 0u);
+}
+
+
+// Add a ship that can reach anything within the given range of it.
+void ShipRangeIndex::Add(Ship *ship, double range)
+{
+  const int x = static_cast<int>(ship->Position().X()) >> SHIFT;
+  const int y = static_cast<int>(ship->Position().Y()) >> SHIFT;
+  entries.emplace_back(ship, entries.size(), range, x, y);
+  ++counts[(y & WRAP_MASK) * CELLS + (x & WRAP_MASK) + 2];
+  maxRange = max(maxRange, range);
+}
+
+
+// Finish adding ships (and organize them into the final lookup table).
+void ShipRangeIndex::Finish()
+{
+  // Sort the entries by grid cell, in the same way as a CollisionSet.
+  partial_sum(counts.begin(), counts.end(), counts.begin());
+  sorted.resize(entries.size());
+  for(const Entry &entry : entries)
+    sorted[counts[(entry.y & WRAP_MASK) * CELLS + (entry.x & WRAP_MASK) + 1]++] = entry;
+}
+
+
+// Get all ships that can reach the given point, in the order they were added.
+void ShipRangeIndex::Reaching(const Point &point, pmr::vector<Ship *> &result) const
+{
+  // If the longest range covers more grid cells than there are ships, it is faster
+  // to just check every ship.
+  const double across = 2. * maxRange / CELL_SIZE + 1.;
+  if(across * across > entries.size())
+  {
+    for(const Entry &entry : entries)
+      if(point.Distance(entry.ship->Position()) <= entry.range) result.push_back(entry.ship);
+    return;
+  }
+
+  // Anything found is kept in the same memory as the results.
+  pmr::vector<pair<unsigned, Ship *>> found(result.get_allocator());
+  const int                           minX = static_cast<int>(point.X() - maxRange) >> SHIFT;
+  const int                           minY = static_cast<int>(point.Y() - maxRange) >> SHIFT;
+  const int                           maxX = static_cast<int>(point.X() + maxRange) >> SHIFT;
+  const int                           maxY = static_cast<int>(point.Y() + maxRange) >> SHIFT;
+  for(int y = minY; y <= maxY; ++y)
+    for(int x = minX; x <= maxX; ++x)
+    {
+      const unsigned index = (y & WRAP_MASK) * CELLS + (x & WRAP_MASK);
+      for(auto it = sorted.begin() + counts[index], end = sorted.begin() + counts[index + 1]; it != end; ++it)
+      {
+        // Skip ships that were put in this same grid cell only because
+        // of the cell coordinates wrapping around.
+        if(it->x == x && it->y == y && point.Distance(it->ship->Position()) <= it->range)
+          found.emplace_back(it->order, it->ship);
+      }
+    }
+
+  // Return the ships in the order they were added, so that which ship gets to act
+  // first does not depend on where they are in the grid.
+  sort(found.begin(), found.end());
+  for(const auto &it : found)
+    result.push_back(it.second);
+}
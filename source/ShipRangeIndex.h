@@ -0,0 +1,79 @@
+/* ShipRangeIndex.h
+Copyright (c) 2026 by RisingLeaf
+
+Endless Sky is free software: you can redistribute it and/or modify it under the
+terms of the GNU General Public License as published by the Free Software
+Foundation, either version 3 of the License, or (at your option) any later version.
+
+Endless Sky is distributed in the hope that it will be useful, but WITHOUT ANY
+WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS FOR A
+PARTICULAR PURPOSE. See the GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License along with
+this program. If not, see <https://www.gnu.org/licenses/>.
+*/
+
+#pragma once
+
+#include <memory_resource>
+#include <vector>
+
+class Point;
+class Ship;
+
+
+// A ShipRangeIndex sorts ships that each have a certain reach, such as the range
+// of their anti-missile or tractor beam systems, into a grid, so that finding the
+// ships that can reach a given point does not take checking every one of them.
+// It is rebuilt every step.
+class ShipRangeIndex
+{
+public:
+  // The cell size and cell count should both be powers of two; otherwise, they
+  // are rounded down to a power of two.
+  ShipRangeIndex(unsigned cellSize, unsigned cellCount);
+
+  // Remove all ships from the index.
+  void Clear();
+  // Add a ship that can reach anything within the given range of it.
+  void Add(Ship *ship, double range);
+  // Finish adding ships (and organize them into the final lookup table).
+  void Finish();
+
+  // Get all ships that can reach the given point, in the order they were added.
+  void Reaching(const Point &point, std::pmr::vector<Ship *> &result) const;
+
+
+private:
+  class Entry
+  {
+  public:
+    Entry() = default;
+    Entry(Ship *ship, unsigned order, double range, int x, int y) :
+      ship(ship), order(order), range(range), x(x), y(y) {}
+
+    Ship    *ship;
+    // The position of this ship in the order they were added.
+    unsigned order;
+    double   range;
+    int      x;
+    int      y;
+  };
+
+
+private:
+  // The size of individual cells of the grid.
+  unsigned CELL_SIZE;
+  unsigned SHIFT;
+  // The number of grid cells in each direction.
+  unsigned CELLS;
+  unsigned WRAP_MASK;
+
+  // The longest range of any ship in the index.
+  double maxRange = 0.;
+  // All entries, in the order they were added, and sorted by grid cell.
+  std::vector<Entry> entries;
+  std::vector<Entry> sorted;
+  // counts[index] is where a certain grid cell begins in the sorted entries.
+  std::vector<unsigned> counts;
+};
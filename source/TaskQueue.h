@@ -68,9 +68,6 @@ public:
 
   // Waits for all of this queue's task to finish. Ignores any sync tasks to be processed.
   void Wait();
-
-
-private:
   // Whether there are any outstanding async tasks left in this queue.
   bool IsDone() const;
 
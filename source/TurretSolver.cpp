@@ -0,0 +1,297 @@
+/* TurretSolver.cpp
+Copyright (c) 2026 by RisingLeaf
+
+Endless Sky is free software: you can redistribute it and/or modify it under the
+terms of the GNU General Public License as published by the Free Software
+Foundation, either version 3 of the License, or (at your option) any later version.
+
+Endless Sky is distributed in the hope that it will be useful, but WITHOUT ANY
+WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS FOR A
+PARTICULAR PURPOSE. See the GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License along with
+this program. If not, see <https://www.gnu.org/licenses/>.
+*/
+
+#include "TurretSolver.h"
+
+#include "AI.h"
+
+#include <algorithm>
+#include <cmath>
+
+using namespace std;
+
+
+// Remove all targets, and set the velocity of the ship the turrets are on.
+void TurretSolver::Clear(const Point &shipVelocity)
+{
+  this->shipVelocity = shipVelocity;
+  count               = 0;
+  x.clear();
+  y.clear();
+  vx.clear();
+  vy.clear();
+  radius.clear();
+}
+
+
+void TurretSolver::Add(const Point &position, const Point &velocity, double radius)
+{
+  // Grow the arrays by a whole group of lanes at a time. The unused lanes stay zero.
+  if(count == x.size())
+  {
+    x.resize(count + LANES);
+    y.resize(count + LANES);
+    vx.resize(count + LANES);
+    vy.resize(count + LANES);
+    this->radius.resize(count + LANES);
+  }
+  x[count]  = position.X();
+  y[count]  = position.Y();
+  vx[count] = velocity.X();
+  vy[count] = velocity.Y();
+
+  this->radius[count] = radius;
+  ++count;
+}
+
+
+bool TurretSolver::IsEmpty() const { return !count; }
+
+
+// Find the best target for the given turret.
+TurretSolver::Result TurretSolver::Aim(const Turret &turret) const
+{
+  // These are all the same operations as in AimEach(), in the same order, so that
+  // both give exactly the same results. Every condition is computed as a mask, and
+  // every choice between two values is a select, so that the loop has no branches
+  // and the compiler can compute several targets at once. That includes the cases
+  // where AI::RendezvousTime() returns NaN: they are tracked by the "isValid" mask
+  // instead of by a NaN that would have to be tested for. Nothing that could raise
+  // a floating point exception is computed for only one side of a select, because
+  // the compiler would then have to move it into a branch.
+  const double startX          = turret.start.X();
+  const double startY          = turret.start.Y();
+  const double shipX           = turret.hasAcceleration ? 0. : shipVelocity.X();
+  const double shipY           = turret.hasAcceleration ? 0. : shipVelocity.Y();
+  const double vp              = turret.velocity;
+  const double lifetime        = turret.lifetime;
+  const bool   isInstantaneous = lifetime == 1.;
+  const double missTime        = 2. * lifetime;
+  const double speed           = vp ? vp : 1.;
+  const double timeWeight      = 180. / turret.turnRate;
+  // Only beams hit instantaneously, so no target is within range of other weapons.
+  const double hitRange = isInstantaneous ? vp : -1.;
+
+  // The intercepts are found for one block of targets at a time. Because they are
+  // stored in local arrays, the compiler knows that they can't overlap the targets,
+  // and doesn't need to check that at run time before it can vectorize the loop.
+  double interceptX[BLOCK];
+  double interceptY[BLOCK];
+  double interceptTime[BLOCK];
+  Result result;
+  for(size_t first = 0; first < count; first += BLOCK)
+  {
+    // Every lane of the last group is computed, even if some of them are unused, so that
+    // the compiler knows that the loop needs no scalar iterations after the vector ones.
+    const size_t        targets = min(BLOCK, count - first);
+    const size_t        lanes   = (targets + LANES - 1) / LANES * LANES;
+    const double *const tx      = x.data() + first;
+    const double *const ty      = y.data() + first;
+    const double *const tvxs    = vx.data() + first;
+    const double *const tvys    = vy.data() + first;
+    for(size_t i = 0; i < lanes; ++i)
+    {
+      // The target's position relative to the turret by the time it fires.
+      const double tvx      = tvxs[i] - shipX;
+      const double tvy      = tvys[i] - shipY;
+      const double px       = (tx[i] - startX) + tvx;
+      const double py       = (ty[i] - startY) + tvy;
+      const double distance = sqrt(px * px + py * py);
+
+      // Find how long the projectile will take to reach the target, as in AI::RendezvousTime().
+      const double a            = (tvx * tvx + tvy * tvy) - vp * vp;
+      const double b            = 2. * (px * tvx + py * tvy);
+      const double c            = px * px + py * py;
+      const double discriminant = b * b - 4. * a * c;
+      const bool   canReach     = !(discriminant < 0.) & !isInstantaneous;
+      const double root         = sqrt(discriminant < 0. ? 0. : discriminant);
+      const double r1           = (-b + root) / (2. * a);
+      const double r2           = (-b - root) / (2. * a);
+      const bool   isR1Positive = r1 >= 0.;
+      const bool   isR2Positive = r2 >= 0.;
+      const double lower        = r2 < r1 ? r2 : r1;
+      const double higher       = r1 < r2 ? r2 : r1;
+      const double solution     = (isR1Positive & isR2Positive) ? lower : higher;
+      // A degenerate equation can give a NaN root, which is not a solution either.
+      const bool isValid = canReach & (isR1Positive | isR2Positive) & (solution == solution);
+      // If there is no intersection, consider the target out of range but still targetable.
+      const double outOfRange = distance / speed;
+      const double missed     = outOfRange < missTime ? missTime : outOfRange;
+      // Beam weapons hit instantaneously if they are in range. Other weapons aim
+      // where the target will be, and treat every target in range the same.
+      // A hit takes no time, so the target moves by zero steps, and the beam's lifetime
+      // of 1 makes the remaining time zero, with no separate results for a hit.
+      const bool   isHit     = distance < hitRange;
+      const double time      = isValid ? solution : isHit ? 0. : missed;
+      const double remaining = time - lifetime;
+      interceptX[i]          = px + tvx * time;
+      interceptY[i]          = py + tvy * time;
+      interceptTime[i]       = 0. < remaining ? remaining : 0.;
+    }
+
+    for(size_t i = 0; i < targets; ++i)
+    {
+      // Turning never makes a target's score lower than the projectile's travel time
+      // alone, so there's no need to find the angles to targets that can't be better.
+      if(timeWeight * interceptTime[i] >= result.score) continue;
+      Score(turret, Point(interceptX[i], interceptY[i]), interceptTime[i], first + i, result);
+    }
+  }
+  return result;
+}
+
+
+// Find the best target by checking each target in turn.
+TurretSolver::Result TurretSolver::AimEach(const Turret &turret) const
+{
+  Result result;
+  for(size_t i = 0; i < count; ++i)
+  {
+    Point p = Point(x[i], y[i]) - turret.start;
+    Point v = Point(vx[i], vy[i]);
+    // Only take the ship's velocity into account if this weapon
+    // does not have its own acceleration.
+    if(!turret.hasAcceleration) v -= shipVelocity;
+    // By the time this action is performed, the target will
+    // have moved forward one time step.
+    p += v;
+
+    double rendezvousTime = numeric_limits<double>::quiet_NaN();
+    double distance       = p.Length();
+    // Beam weapons hit instantaneously if they are in range.
+    bool isInstantaneous = turret.lifetime == 1.;
+    if(isInstantaneous && distance < turret.velocity)
+    {
+      rendezvousTime = 0.;
+    }
+    else {
+      // Find out how long it would take for this projectile to reach the target.
+      if(!isInstantaneous) rendezvousTime = AI::RendezvousTime(p, v, turret.velocity);
+
+      // If there is no intersection (i.e. the turret is not facing the target),
+      // consider this target "out-of-range" but still targetable.
+      if(std::isnan(rendezvousTime))
+        rendezvousTime = max(distance / (turret.velocity ? turret.velocity : 1.), 2 * turret.lifetime);
+
+      // Determine where the target will be at that point.
+      p += v * rendezvousTime;
+
+      // All bodies within weapons range have the same basic
+      // weight. Outside that range, give them lower priority.
+      rendezvousTime = max(0., rendezvousTime - turret.lifetime);
+    }
+    Score(turret, p, rendezvousTime, i, result);
+  }
+  return result;
+}
+
+
+// Find the targets that a projectile fired from the turret in the direction it is
+// facing now passes within the radius of.
+void TurretSolver::InLineOfFire(const Turret &turret, vector<int> &indices) const
+{
+  indices.clear();
+
+  // This is the same test as the first part of Mask::Collide(), but for every target at
+  // once. It is written without branches for the same reason as in Aim(). The radius is
+  // widened a little, so that rounding differences can't leave out a target that the
+  // exact test would have hit.
+  const double startX   = turret.start.X();
+  const double startY   = turret.start.Y();
+  const double shipX    = turret.hasAcceleration ? 0. : shipVelocity.X();
+  const double shipY    = turret.hasAcceleration ? 0. : shipVelocity.Y();
+  const Point  aim      = turret.aim.Unit() * turret.velocity;
+  const double aimX     = aim.X();
+  const double aimY     = aim.Y();
+  const double lifetime = turret.lifetime;
+  const double margin   = 1.;
+
+  double isInLine[BLOCK];
+  for(size_t first = 0; first < count; first += BLOCK)
+  {
+    const size_t        targets = min(BLOCK, count - first);
+    const size_t        lanes   = (targets + LANES - 1) / LANES * LANES;
+    const double *const tx      = x.data() + first;
+    const double *const ty      = y.data() + first;
+    const double *const tvxs    = vx.data() + first;
+    const double *const tvys    = vy.data() + first;
+    const double *const radii   = radius.data() + first;
+    for(size_t i = 0; i < lanes; ++i)
+    {
+      // The target's position relative to the turret by the time it fires.
+      const double tvx = tvxs[i] - shipX;
+      const double tvy = tvys[i] - shipY;
+      const double px  = (tx[i] - startX) + tvx;
+      const double py  = (ty[i] - startY) + tvy;
+      // The path of the projectile over its lifetime, relative to the target.
+      const double pathX = (aimX - tvx) * lifetime;
+      const double pathY = (aimY - tvy) * lifetime;
+
+      // Find the point along that path that is closest to the target. If the path has
+      // no length, every point along it is the same, so any nonzero divisor will do.
+      // The fraction of the path is clamped to [0, 1] with arithmetic rather than with
+      // selects, because the compiler would turn the selects into branches.
+      const double length   = pathX * pathX + pathY * pathY;
+      const double divisor  = length < 1e-9 ? 1e-9 : length;
+      const double along    = (px * pathX + py * pathY) / divisor;
+      const double clamped  = .5 * (fabs(along) - fabs(along - 1.) + 1.);
+      const double dx       = pathX * clamped - px;
+      const double dy       = pathY * clamped - py;
+      const double reach    = radii[i] + margin;
+      isInLine[i]           = dx * dx + dy * dy <= reach * reach ? 1. : 0.;
+    }
+
+    for(size_t i = 0; i < targets; ++i)
+      if(isInLine[i]) indices.push_back(first + i);
+  }
+}
+
+
+// Score aiming the turret at the given intercept point, and keep it if it is the best so far.
+void TurretSolver::Score(const Turret &turret, const Point &intercept, double time, int target, Result &result)
+{
+  // Determine how much the turret must turn to face that point.
+  double degrees      = 0.;
+  Angle  angleToPoint = Angle(intercept);
+  if(turret.isOmnidirectional)
+  {
+    degrees = (angleToPoint - turret.aim).Degrees();
+  }
+  else {
+    // For turret with limited arc, determine the turn up to the nearest arc limit.
+    // Also reduce priority of target if it's not within the firing arc.
+    if(!angleToPoint.IsInRange(turret.minArc, turret.maxArc))
+    {
+      // Decrease the priority of the target.
+      time += 2. * turret.lifetime;
+
+      // Point to the nearer edge of the arc.
+      const double minDegree = (turret.minArc - angleToPoint).Degrees();
+      const double maxDegree = (turret.maxArc - angleToPoint).Degrees();
+      if(fabs(minDegree) < fabs(maxDegree)) angleToPoint = turret.minArc;
+      else angleToPoint = turret.maxArc;
+    }
+    degrees = (angleToPoint - turret.minArc).AbsDegrees() - (turret.aim - turret.minArc).AbsDegrees();
+  }
+  double turnTime = fabs(degrees) / turret.turnRate;
+  // Always prefer targets that you are able to hit.
+  double score = turnTime + (180. / turret.turnRate) * time;
+  if(score < result.score)
+  {
+    result.target  = target;
+    result.score   = score;
+    result.degrees = degrees;
+  }
+}
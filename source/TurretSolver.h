@@ -0,0 +1,109 @@
+/* TurretSolver.h
+Copyright (c) 2026 by RisingLeaf
+
+Endless Sky is free software: you can redistribute it and/or modify it under the
+terms of the GNU General Public License as published by the Free Software
+Foundation, either version 3 of the License, or (at your option) any later version.
+
+Endless Sky is distributed in the hope that it will be useful, but WITHOUT ANY
+WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS FOR A
+PARTICULAR PURPOSE. See the GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License along with
+this program. If not, see <https://www.gnu.org/licenses/>.
+*/
+
+#pragma once
+
+#include "Angle.h"
+#include "Point.h"
+
+#include <cstddef>
+#include <limits>
+#include <vector>
+
+
+// A TurretSolver finds which of a ship's potential targets each of its turrets
+// should aim at, and which of them each of its weapons could hit if it fired now.
+// The targets are stored as separate arrays of coordinates, so that one weapon can
+// be checked against every target in a single loop that the compiler is able to vectorize.
+class TurretSolver
+{
+public:
+  // Everything about a turret and its weapon that affects where it should aim.
+  class Turret
+  {
+  public:
+    // Where the projectiles are fired from, in absolute coordinates.
+    Point start;
+    // The current facing of the turret, and the limits of its arc, in absolute angles.
+    Angle aim;
+    Angle minArc;
+    Angle maxArc;
+    bool  isOmnidirectional = true;
+    // How many degrees the turret can turn per step.
+    double turnRate = 1.;
+    // The average velocity and total lifetime of the projectiles.
+    double velocity = 0.;
+    double lifetime = 0.;
+    // Projectiles with their own acceleration do not inherit the ship's velocity.
+    bool hasAcceleration = false;
+  };
+
+  // The target that a turret should aim at.
+  class Result
+  {
+  public:
+    // The index of the target, or -1 if there are no targets.
+    int target = -1;
+    // How "far" the turret is from hitting that target, counting both the time to turn
+    // toward it and the time for a projectile to reach it. Lower is better.
+    double score = std::numeric_limits<double>::infinity();
+    // How many degrees the turret has to turn to face that target.
+    double degrees = 0.;
+  };
+
+
+public:
+  // Remove all targets, and set the velocity of the ship the turrets are on.
+  void Clear(const Point &shipVelocity);
+  // Add a target. The radius is only needed by InLineOfFire().
+  void Add(const Point &position, const Point &velocity, double radius = 0.);
+  bool IsEmpty() const;
+
+  // Find the best target for the given turret.
+  Result Aim(const Turret &turret) const;
+  // Find the best target by checking each target in turn, with the same math as
+  // was used before the solver existed. This is much slower than Aim(), and is
+  // only kept as a reference to test it against.
+  Result AimEach(const Turret &turret) const;
+
+  // Find the targets that a projectile fired from the turret in the direction it is
+  // facing now passes within the radius of, at any point in its lifetime. Only those
+  // targets need an exact collision check. A few targets that pass just outside their
+  // radius may be included, but no target inside it is left out. The indices of the
+  // targets are stored in the order they were added.
+  void InLineOfFire(const Turret &turret, std::vector<int> &indices) const;
+
+
+private:
+  // How many targets Aim() finds the intercepts of at a time.
+  static constexpr size_t BLOCK = 64;
+  // The arrays of targets are padded to a multiple of this many, which is at least
+  // as many doubles as fit in a vector register.
+  static constexpr size_t LANES = 4;
+
+  // Score aiming the turret at the given intercept point, and keep it if it is the best so far.
+  static void Score(const Turret &turret, const Point &intercept, double time, int target, Result &result);
+
+
+private:
+  Point shipVelocity;
+  size_t count = 0;
+  // The positions and velocities of the targets.
+  std::vector<double> x;
+  std::vector<double> y;
+  std::vector<double> vx;
+  std::vector<double> vy;
+  std::vector<double> radius;
+};
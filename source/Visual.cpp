@@ -19,6 +19,15 @@ this program. If not, see <https://www.gnu.org/licenses/>.
 #include "Random.h"
 #include "audio/Audio.h"
 
+#include <algorithm>
+
+namespace
+{
+  // Flags of the animation in a record.
+  constexpr int32_t REPEAT = 1;
+  constexpr int32_t REWIND = 2;
+} // namespace
+
 
 // Generate a visual based on the given Effect.
 Visual::Visual(const Effect &effect, Point pos, Point vel, Angle facing, Point hitVelocity, double inheritedZoom) :
@@ -48,15 +57,60 @@ Visual::Visual(const Effect &effect, Point pos, Point vel, Angle facing, Point h
 }
 
 
-// Step the effect forward.
-void Visual::Move()
+// Get the record of this visual, if it is first drawn at the given step.
+Visual::Record Visual::GetRecord(int step) const
 {
-  if(lifetime-- <= 0)
-  {
-    MarkForRemoval();
-  }
-  else {
-    position += velocity;
-    angle    += spin;
-  }
+  const Animation animation = GetAnimation(step);
+
+  Record record;
+  record.x         = position.X();
+  record.y         = position.Y();
+  record.vx        = velocity.X();
+  record.vy        = velocity.Y();
+  record.facing    = angle.Degrees();
+  record.spin      = spin.Degrees();
+  record.width     = .5 * Zoom() * Width();
+  record.height    = .5 * Zoom() * Height();
+  record.spawnStep = step;
+  record.lifetime  = lifetime;
+  record.alpha     = alpha;
+
+  record.distanceInvisible = distanceInvisible;
+  record.distanceVisible   = distanceVisible;
+
+  record.frameRate   = animation.frameRate;
+  record.frameOffset = animation.frameOffset;
+  record.randomStart = animation.randomStart;
+  record.delay       = animation.delay;
+  record.flags       = (animation.repeat ? REPEAT : 0) | (animation.rewind ? REWIND : 0);
+  return record;
+}
+
+
+// Check whether this visual is still shown at the given step. A visual that
+// is created with a lifetime of zero is still drawn once.
+bool Visual::Record::IsAlive(int step) const { return step - spawnStep <= lifetime; }
+
+
+Point Visual::Record::Position(int step) const { return Point(x, y) + Point(vx, vy) * (step - spawnStep); }
+
+
+Angle Visual::Record::Facing(int step) const { return Angle(facing + static_cast<double>(spin) * (step - spawnStep)); }
+
+
+// Get the alpha at the given step, the same way as Body::Alpha().
+double Visual::Record::Alpha(int step, const Point &drawCenter) const
+{
+  if(!distanceInvisible) return alpha;
+  const double distance = (drawCenter - Position(step)).Length();
+  return alpha * std::clamp<double>((distance - distanceInvisible) / (distanceVisible - distanceInvisible), 0., 1.);
+}
+
+
+// Get the sprite frame at the given step, for a sprite with the given frame count.
+float Visual::Record::Frame(int step, float frames) const
+{
+  const Drawable::Animation animation{
+      frameRate, frameOffset, randomStart, delay, (flags & REPEAT) != 0, (flags & REWIND) != 0};
+  return animation.Frame(step, frames);
 }
@@ -20,6 +20,8 @@ this program. If not, see <https://www.gnu.org/licenses/>.
 #include "Angle.h"
 #include "Point.h"
 
+#include <cstdint>
+
 class Effect;
 
 
@@ -27,6 +29,50 @@ class Effect;
 // Effect to allow it to be much more lightweight.
 class Visual : public Body
 {
+public:
+  // A visual moves in a straight line and turns at a constant rate, so where it
+  // is at any later step follows from where it was created. A record holds all
+  // that is needed to draw it for the rest of its lifetime, in a layout that the
+  // shader that draws visuals on the GPU reads as well.
+  struct Record
+  {
+    // The position and velocity at the step it was created.
+    float x;
+    float y;
+    float vx;
+    float vy;
+    // The facing at the step it was created, and how much it turns per step, in degrees.
+    float facing;
+    float spin;
+    // Half the width and height of the sprite, in world coordinates.
+    float width;
+    float height;
+
+    int32_t spawnStep;
+    int32_t lifetime;
+    float   alpha;
+    // The distances from the view center at which it becomes invisible, and fully visible again.
+    float distanceInvisible;
+    float distanceVisible;
+
+    // The Drawable::Animation of the sprite.
+    float   frameRate;
+    float   frameOffset;
+    float   randomStart;
+    float   delay;
+    int32_t flags;
+
+    // Check whether this visual is still shown at the given step.
+    bool  IsAlive(int step) const;
+    Point Position(int step) const;
+    Angle Facing(int step) const;
+    // Get the alpha at the given step, the same way as Body::Alpha().
+    double Alpha(int step, const Point &drawCenter) const;
+    // Get the sprite frame at the given step, for a sprite with the given frame count.
+    float Frame(int step, float frames) const;
+  };
+
+
 public:
   Visual() = default;
   Visual(
@@ -43,13 +89,15 @@ public:
   // const Point &Velocity() const;
   // const Angle &Facing() const;
   // Point Unit() const;
+  // const Angle &Spin() const;
   // double Zoom() const;
 
-  // Step the effect forward.
-  void Move();
+  // Get the record of this visual, if it is first drawn at the given step.
+  Record GetRecord(int step) const;
 
 
 private:
-  Angle spin;
-  int   lifetime = 0;
+  int lifetime = 0;
 };
+
+static_assert(sizeof(Visual::Record) == 18 * sizeof(float), "The shader expects records of 18 values.");
@@ -0,0 +1,56 @@
+/* VisualList.cpp
+Copyright (c) 2026 by RisingLeaf
+
+Endless Sky is free software: you can redistribute it and/or modify it under the
+terms of the GNU General Public License as published by the Free Software
+Foundation, either version 3 of the License, or (at your option) any later version.
+
+Endless Sky is distributed in the hope that it will be useful, but WITHOUT ANY
+WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS FOR A
+PARTICULAR PURPOSE. See the GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License along with
+this program. If not, see <https://www.gnu.org/licenses/>.
+*/
+
+#include "VisualList.h"
+
+using namespace std;
+
+
+// Add the given visuals, which are first drawn at the given step, and clear them.
+void VisualList::Add(vector<Visual> &visuals, int step)
+{
+  for(const Visual &visual : visuals)
+  {
+    // Visuals that can't be seen are never drawn, so there is no need to keep them.
+    if(!visual.HasSprite() || !visual.Zoom()) continue;
+    records[visual.GetSprite()].push_back(visual.GetRecord(step));
+  }
+  visuals.clear();
+}
+
+
+// Remove the visuals that are no longer shown at the given step.
+void VisualList::Prune(int step)
+{
+  for(auto it = records.begin(); it != records.end();)
+  {
+    erase_if(it->second, [step](const Visual::Record &record) { return !record.IsAlive(step); });
+    if(it->second.empty()) it = records.erase(it);
+    else ++it;
+  }
+}
+
+
+void VisualList::Clear()
+{
+  records.clear();
+  ++generation;
+}
+
+
+const map<const Sprite *, vector<Visual::Record>> &VisualList::Records() const { return records; }
+
+
+int VisualList::Generation() const { return generation; }
@@ -0,0 +1,49 @@
+/* VisualList.h
+Copyright (c) 2026 by RisingLeaf
+
+Endless Sky is free software: you can redistribute it and/or modify it under the
+terms of the GNU General Public License as published by the Free Software
+Foundation, either version 3 of the License, or (at your option) any later version.
+
+Endless Sky is distributed in the hope that it will be useful, but WITHOUT ANY
+WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS FOR A
+PARTICULAR PURPOSE. See the GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License along with
+this program. If not, see <https://www.gnu.org/licenses/>.
+*/
+
+#pragma once
+
+#include "Visual.h"
+
+#include <map>
+#include <vector>
+
+class Sprite;
+
+
+// The visuals in the current system, stored as records grouped by their sprite.
+// Since a record describes its visual for the rest of its lifetime, the visuals
+// don't have to be moved every step; they only have to be removed once they
+// have expired. This way, they can also be handed to the GPU as they are.
+class VisualList
+{
+public:
+  // Add the given visuals, which are first drawn at the given step, and clear them.
+  void Add(std::vector<Visual> &visuals, int step);
+  // Remove the visuals that are no longer shown at the given step.
+  void Prune(int step);
+  void Clear();
+
+  // The records of each sprite, in the order of the steps they were first drawn at.
+  const std::map<const Sprite *, std::vector<Visual::Record>> &Records() const;
+  // This changes whenever the list is cleared, so copies of its records can tell
+  // whether they are still from the same list.
+  int Generation() const;
+
+
+private:
+  std::map<const Sprite *, std::vector<Visual::Record>> records;
+  int                                                   generation = 0;
+};
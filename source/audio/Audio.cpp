@@ -20,6 +20,7 @@ this program. If not, see <https://www.gnu.org/licenses/>.
 #include "../Point.h"
 #include "Music.h"
 #include "Sound.h"
+#include "SoundBank.h"
 #include "player/AudioPlayer.h"
 #include "player/MusicPlayer.h"
 #include "supplier/effect/Fade.h"
@@ -28,12 +29,17 @@ this program. If not, see <https://www.gnu.org/licenses/>.
 #include <AL/alc.h>
 
 #include <algorithm>
+#include <array>
+#include <atomic>
+#include <chrono>
 #include <cmath>
+#include <condition_variable>
 #include <map>
 #include <memory>
 #include <mutex>
 #include <stdexcept>
 #include <thread>
+#include <utility>
 #include <vector>
 
 
@@ -53,6 +59,67 @@ namespace
     SoundCategory category = SoundCategory::MASTER;
   };
 
+  // A single request to play a sound, as recorded by Audio::Play().
+  struct PlayRequest
+  {
+    const Sound  *sound = nullptr;
+    Point         position;
+    SoundCategory category = SoundCategory::MASTER;
+  };
+
+  // A bounded, lock-free queue of play requests. Any number of threads may
+  // push requests into it, but only the audio thread pops them. If the queue
+  // is full, new requests are dropped rather than blocking the caller.
+  class PlayRequestQueue
+  {
+  public:
+    PlayRequestQueue();
+
+    bool Push(const PlayRequest &request);
+    bool Pop(PlayRequest &request);
+
+
+  private:
+    static constexpr size_t CAPACITY = 2048;
+    static_assert(!(CAPACITY & (CAPACITY - 1)), "The capacity must be a power of two.");
+
+    struct Cell
+    {
+      std::atomic<size_t> sequence;
+      PlayRequest         request;
+    };
+
+    std::array<Cell, CAPACITY>      cells;
+    alignas(64) std::atomic<size_t> head = 0;
+    alignas(64) size_t              tail = 0;
+  };
+
+  // A sound that is playing or wants to play. If there are not enough sources
+  // for all of them, the least important sounds become "virtual" voices: they
+  // keep track of how far along they would be, without being audible, so they
+  // can pick up from the right point if they get a source again in time.
+  struct Voice
+  {
+    const Sound *sound = nullptr;
+    QueueEntry   entry;
+    // How far into the sound this voice is, in samples.
+    size_t elapsed = 0;
+  };
+
+  // A voice competing for a source in the current step.
+  struct Candidate
+  {
+    Voice voice;
+    // The player of a looping sound that already has a source.
+    std::shared_ptr<AudioPlayer> player;
+    double                       score = 0.;
+  };
+
+  // How important a sound category is when there are not enough sources.
+  double Priority(SoundCategory category);
+  // Rate how important it is for the given sounds to be heard.
+  double Score(const QueueEntry &entry);
+
   void Move(const AudioPlayer &player, QueueEntry entry)
   {
     Point angle = entry.sum / entry.weight;
@@ -62,11 +129,19 @@ namespace
     player.Move(angle.X() * scale, angle.Y() * scale, -scale);
   }
 
-  // Thread entry point for loading the sound files.
+  // Thread entry point for building the sound bank.
   void Load();
+  // Point every sound at its samples in the sound bank.
+  void AssignSamples();
+  // Thread entry point for the audio thread, which owns all OpenAL sources.
+  void Mix();
+  // Handle all the requests made since the last game step. Audio thread only.
+  void StepPlayers(bool isFastForward);
+  // Start or cross-fade to the given music track. Audio thread only.
+  void StartMusic(const std::string &name);
 
 
-  // Mutex to make sure different threads don't modify the audio at the same time.
+  // Mutex to make sure the loading thread and the other threads don't modify the sound list at the same time.
   std::mutex audioMutex;
 
   // OpenAL settings.
@@ -74,29 +149,66 @@ namespace
   ALCcontext *context       = nullptr;
   bool        isInitialized = false;
 
-  // We keep track of the volume levels requested, and the volume levels
-  // currently set in OpenAL.
-  std::map<SoundCategory, double> volume{{SoundCategory::MASTER, .125}};
-  std::map<SoundCategory, double> cachedVolume;
+  constexpr size_t CATEGORY_COUNT = static_cast<size_t>(SoundCategory::ALERT) + 1;
+
+  // The volume level requested for one category. Every category but the
+  // master volume starts at full volume.
+  struct VolumeLevel
+  {
+    std::atomic<double> level = 1.;
+  };
 
-  // This queue keeps track of sounds that have been requested to play. Each
-  // added sound is "deferred" until the next audio position update to make
-  // sure that all sounds from a given frame start at the same time.
+  // We keep track of the volume levels requested, and the volume levels
+  // currently set in OpenAL. The requested levels may be changed by the main
+  // thread at any time; the cached levels belong to the audio thread.
+  std::array<VolumeLevel, CATEGORY_COUNT> volume = {VolumeLevel{.125}};
+  std::array<double, CATEGORY_COUNT>      cachedVolume;
+
+  // Every thread pushes its play requests into this queue. The audio thread
+  // drains it once per game step and coalesces the requests per sound, so
+  // that all sounds from a given frame start at the same time.
+  PlayRequestQueue                    requests;
   std::map<const Sound *, QueueEntry> soundQueue;
-  std::map<const Sound *, QueueEntry> deferred;
-  std::thread::id                     mainThreadID;
+
+  // The maximum number of sound effects that have a source at the same time.
+  // Music does not count towards this limit.
+  constexpr size_t MAX_VOICES = 32;
+  // The number of samples each sound advances by in one game step.
+  constexpr size_t SAMPLES_PER_STEP = AudioSupplier::SAMPLE_RATE / 60;
+  // The sounds that are playing without a source, and the sounds competing for
+  // a source in the current step. Audio thread only.
+  std::vector<Voice>     virtualVoices;
+  std::vector<Candidate> candidates;
 
   // Sound resources that have been loaded from files.
   std::map<std::string, Sound> sounds;
+  // Every sound file in the game data and plugins, by sound name, and the
+  // memory-mapped bank holding their samples.
+  std::map<std::string, std::filesystem::path> soundFiles;
+  SoundBank                                    bank;
 
-  /// The active audio sources
+  /// The active audio sources. These are only ever touched by the audio thread.
   std::vector<std::shared_ptr<AudioPlayer>> players;
   /// The looping players for reuse. Looping sources always have the Fade effect.
   std::map<const Sound *, std::shared_ptr<AudioPlayer>> loopingPlayers;
 
-  // Queue and thread for loading sound files in the background.
+  // Queue and thread for building the sound bank in the background, if it is
+  // out of date. The queue is only cleared once the new bank is ready to use.
   std::map<std::string, std::filesystem::path> loadQueue;
   std::thread                                  loadThread;
+  size_t                                       loadedSounds     = 0;
+  bool                                         interruptLoading = false;
+
+  // The audio thread wakes up whenever the main thread finishes a step, or
+  // periodically to keep streaming sources fed even if the game stalls.
+  std::thread             mixThread;
+  std::mutex              mixMutex;
+  std::condition_variable mixCondition;
+  bool                    mixDone = false;
+  // The number of steps that the audio thread has not processed yet.
+  std::atomic<int>  pendingSteps = 0;
+  std::atomic<bool> fastForward  = false;
+  constexpr auto    MIX_INTERVAL = std::chrono::milliseconds(10);
 
   // The current position of the "listener," i.e. the center of the screen.
   Point listener;
@@ -104,10 +216,13 @@ namespace
   // The active music player, if there is one. This player is also present in 'player'.
   // In the current implementation, the supplier of the music source is always a Fade.
   std::shared_ptr<AudioPlayer> musicPlayer;
-  std::string                  currentTrack;
+  // The track most recently requested by the main thread, and whether the
+  // audio thread has yet to start playing it. Guarded by mixMutex.
+  std::string requestedTrack;
+  bool        trackChanged = false;
 
   // The number of Pause vs Resume requests received.
-  int pauseChangeCount = 0;
+  std::atomic<int> pauseChangeCount = 0;
   // If we paused the audio multiple times, only resume it after the same number of Resume() calls.
   // We start with -2, so when MenuPanel and PlanetPanel opens up the first time, it doesn't pause the loading sounds.
   int pauseCount = -2;
@@ -125,20 +240,24 @@ void Audio::Init(const std::vector<std::filesystem::path> &sources)
 
   // If we don't make it to this point, no audio will be played.
   isInitialized = true;
-  mainThreadID  = std::this_thread::get_id();
 
   // The listener is looking "into" the screen. This orientation vector is
   // used to determine what sounds should be in the right or left speaker.
   ALfloat zero[3]        = {0., 0., 0.};
   ALfloat orientation[6] = {0., 0., -1., 0., 1., 0.};
 
-  alListenerf(AL_GAIN, volume[SoundCategory::MASTER]);
+  alListenerf(AL_GAIN, Volume(SoundCategory::MASTER));
   alListenerfv(AL_POSITION, zero);
   alListenerfv(AL_VELOCITY, zero);
   alListenerfv(AL_ORIENTATION, orientation);
   alDistanceModel(AL_INVERSE_DISTANCE_CLAMPED);
   alDopplerFactor(0.);
 
+  // From now on, only the audio thread talks to OpenAL.
+  for(size_t i = 0; i < CATEGORY_COUNT; ++i)
+    cachedVolume[i] = volume[i].level;
+  mixThread = std::thread(&Mix);
+
   LoadSounds(sources);
 }
 
@@ -158,12 +277,23 @@ void Audio::LoadSounds(const std::vector<std::filesystem::path> &sources)
         // folder, without the ".wav" or "~.wav" suffix.
         std::string name = (path.parent_path() / path.stem()).lexically_relative(root).generic_string();
         if(name.ends_with('~')) name.resize(name.length() - 1);
-        loadQueue[name] = path;
+        soundFiles[name] = path;
       }
     }
   }
-  // Begin loading the files.
-  if(!loadQueue.empty()) loadThread = std::thread(&Load);
+
+  // If the sound bank is up to date, the sounds can be used right away.
+  // Otherwise, rebuild it in the background.
+  std::vector<std::filesystem::path> files;
+  files.reserve(soundFiles.size());
+  for(const auto &[name, path] : soundFiles)
+    files.emplace_back(path);
+  if(bank.Open(Files::Config() / "sounds.bank", files)) AssignSamples();
+  else if(!soundFiles.empty())
+  {
+    loadQueue  = soundFiles;
+    loadThread = std::thread(&Load);
+  }
 }
 
 
@@ -188,23 +318,20 @@ double Audio::GetProgress()
 
   if(loadQueue.empty()) return 1.;
 
-  double done  = sounds.size();
-  double total = done + loadQueue.size();
-  return done / total;
+  // Mapping the new bank counts as the last step.
+  return loadedSounds / (loadQueue.size() + 1.);
 }
 
 
 // Get the volume.
-double Audio::Volume(SoundCategory category)
-{
-  if(!volume.contains(category)) volume[category] = 1.;
-
-  return volume[category];
-}
+double Audio::Volume(SoundCategory category) { return volume[static_cast<size_t>(category)].level; }
 
 
 // Set the volume (to a value between 0 and 1).
-void Audio::SetVolume(double level, SoundCategory category) { volume[category] = std::clamp(level, 0., 1.); }
+void Audio::SetVolume(double level, SoundCategory category)
+{
+  volume[static_cast<size_t>(category)].level = std::clamp(level, 0., 1.);
+}
 
 
 // Get a pointer to the named sound. The name is the path relative to the
@@ -216,18 +343,14 @@ const Sound *Audio::Get(const std::string &name)
 }
 
 
-// Set the listener's position, and also update any sounds that have been
-// added but deferred because they were added from a thread other than the
-// main one (the one that called Init()).
+// Set the listener's position. This is called by the main thread while the
+// calculation thread is paused, so any sounds requested in the same step
+// are positioned relative to the same listener.
 void Audio::Update(const Point &listenerPosition)
 {
   if(!isInitialized) return;
 
   listener = listenerPosition;
-
-  for(const auto &it : deferred)
-    soundQueue[it.first].Add(it.second);
-  deferred.clear();
 }
 
 
@@ -239,18 +362,11 @@ void Audio::Play(const Sound *sound, SoundCategory category) { Play(sound, liste
 // "listener". This will make it softer and change the left / right balance.
 void Audio::Play(const Sound *sound, const Point &position, SoundCategory category)
 {
-  if(!isInitialized || !sound || sound->Buffer().empty() || !volume[SoundCategory::MASTER]) return;
+  if(!isInitialized || !sound || sound->Buffer().empty() || !Volume(SoundCategory::MASTER)) return;
 
-  // Place sounds from the main thread directly into the queue. They are from
-  // the UI, and the Engine may not be running right now to call Update().
-  if(std::this_thread::get_id() == mainThreadID)
-  {
-    soundQueue[sound].Add(position - listener, category);
-  }
-  else {
-    std::unique_lock<std::mutex> lock(audioMutex);
-    deferred[sound].Add(position - listener, category);
-  }
+  // This never blocks. If the audio thread has fallen so far behind that the
+  // queue is full, the sound is simply dropped.
+  requests.Push({sound, position - listener, category});
 }
 
 
@@ -259,35 +375,24 @@ void Audio::PlayMusic(const std::string &name)
 {
   if(!isInitialized) return;
 
+  // Music is always requested by the main thread; the audio thread picks up
+  // the change the next time it wakes up.
+  std::lock_guard<std::mutex> lock(mixMutex);
   // Skip changing music if the requested music is already playing.
-  if(name == currentTrack) return;
+  if(name == requestedTrack) return;
 
-  // Don't worry about thread safety here, since music will always be started
-  // by the main thread.
-  currentTrack = name;
-  if(musicPlayer && !musicPlayer->IsFinished())
-  {
-    reinterpret_cast<Fade *>(musicPlayer->Supplier())->AddSource(Music::CreateSupplier(name, true));
-  }
-  else {
-    Fade *fade = new Fade();
-    fade->AddSource(Music::CreateSupplier(name, true));
-    musicPlayer = std::shared_ptr<AudioPlayer>(new MusicPlayer(std::unique_ptr<AudioSupplier>{fade}));
-    musicPlayer->Init();
-    musicPlayer->SetVolume(Volume(SoundCategory::MUSIC));
-    musicPlayer->Play();
-    players.emplace_back(musicPlayer);
-  }
+  requestedTrack = name;
+  trackChanged   = true;
 }
 
 
 // Pause all active playback streams. Doesn't cause new streams to be paused, and doesn't pause the music source.
-void Audio::Pause() { pauseChangeCount++; }
+void Audio::Pause() { ++pauseChangeCount; }
 
 
 // Resumes all paused sound sources. If Pause() was called multiple times,
 // you have to call Resume() the same number of times to resume the sound sources.
-void Audio::Resume() { pauseChangeCount--; }
+void Audio::Resume() { --pauseChangeCount; }
 
 
 /// Begin playing all the sounds that have been added since the last time
@@ -297,97 +402,10 @@ void Audio::Step(bool isFastForward)
 {
   if(!isInitialized) return;
 
-  for(const auto &[category, expected] : volume)
-  {
-    if(cachedVolume[category] != expected)
-    {
-      cachedVolume[category] = expected;
-      if(category == SoundCategory::MASTER)
-      {
-        alListenerf(AL_GAIN, expected);
-      }
-      else {
-        for(const auto &player : players)
-          if(player->Category() == category) player->SetVolume(expected);
-      }
-    }
-  }
-
-  if(pauseChangeCount > 0)
-  {
-    bool wasPaused  = pauseCount;
-    pauseCount     += pauseChangeCount;
-    if(pauseCount && !wasPaused)
-      for(const auto &player : players)
-        player->Pause();
-  }
-  else if(pauseChangeCount < 0)
-  {
-    // Check that the game is not paused after this request. Also don't allow the pause count to go into negatives.
-    if(pauseCount && (pauseCount += pauseChangeCount) <= 0)
-    {
-      pauseCount = 0;
-      for(const auto &player : players)
-        player->Play();
-    }
-  }
-  pauseChangeCount = 0;
-
-  // For each sound that is looping, see if it is going to continue. For other
-  // sounds, check if they are done playing.
-  for(auto it = loopingPlayers.begin(); it != loopingPlayers.end();)
-  {
-    const auto &[sound, player] = *it;
-    auto queueIt                = soundQueue.find(sound);
-    if(queueIt != soundQueue.end())
-    {
-      Move(*player, queueIt->second);
-      soundQueue.erase(queueIt);
-      ++it;
-    }
-    else {
-      reinterpret_cast<Fade *>(player->Supplier())->AddSource({}, 3); // fast fade
-      it = loopingPlayers.erase(it);
-    }
-  }
-
-  // Queue up the new buffers in every player, and remove the finished ones.
-  for(const auto &player : players)
-  {
-    player->Supplier()->Set3x(isFastForward);
-    player->Update();
-  }
-
-  erase_if(players, [](const auto &player) { return player->IsFinished(); });
-
-  // Now, what is left in the queue is sounds that want to play, and that do
-  // not correspond to an existing source.
-  for(const auto &[sound, entry] : soundQueue)
-  {
-    std::unique_ptr<AudioSupplier> supplier = sound->CreateSupplier();
-    supplier->Set3x(isFastForward);
-    std::shared_ptr<AudioPlayer> player;
-    if(sound->IsLooping())
-    {
-      std::unique_ptr<Fade> fade = std::make_unique<Fade>();
-      fade->AddSource(std::move(supplier));
-      player = make_shared<AudioPlayer>(entry.category, std::move(fade));
-      loopingPlayers.emplace(sound, player);
-    }
-    else {
-      player = make_shared<AudioPlayer>(entry.category, std::move(supplier));
-    }
-
-    player->Init();
-    player->SetVolume(Volume(entry.category));
-    Move(*player, entry);
-    player->Play();
-
-    players.emplace_back(player);
-  }
-  soundQueue.clear();
-
-  if(musicPlayer && musicPlayer->IsFinished()) musicPlayer.reset();
+  // The actual work is done by the audio thread, so this never waits on OpenAL.
+  fastForward = isFastForward;
+  ++pendingSteps;
+  mixCondition.notify_one();
 }
 
 
@@ -397,7 +415,7 @@ void Audio::Quit()
   // First, check if sounds are still being loaded in a separate thread, and
   // if so interrupt that thread and wait for it to quit.
   std::unique_lock<std::mutex> lock(audioMutex);
-  if(!loadQueue.empty()) loadQueue.clear();
+  interruptLoading = true;
   if(loadThread.joinable())
   {
     lock.unlock();
@@ -405,13 +423,24 @@ void Audio::Quit()
     lock.lock();
   }
 
+  // Stop the audio thread. After this, it is safe to touch the players here.
+  {
+    std::lock_guard<std::mutex> mixLock(mixMutex);
+    mixDone = true;
+  }
+  mixCondition.notify_one();
+  if(mixThread.joinable()) mixThread.join();
+
   // Now, stop and delete any OpenAL sources that are playing.
+  candidates.clear();
+  virtualVoices.clear();
   players.clear();
   loopingPlayers.clear();
   musicPlayer.reset();
 
   // Free the memory buffers for all the sound resources.
   sounds.clear();
+  bank.Close();
 
   // Close the connection to the OpenAL library.
   if(context)
@@ -448,35 +477,316 @@ namespace
     category  = other.category;
   }
 
-  // Thread entry point for loading sounds.
-  void Load()
+
+  double Priority(SoundCategory category)
+  {
+    switch(category)
+    {
+    case SoundCategory::UI:
+    case SoundCategory::ALERT:
+    case SoundCategory::JUMP: return 4.;
+    case SoundCategory::EXPLOSION: return 2.;
+    case SoundCategory::ENGINE:
+    case SoundCategory::AFTERBURNER:
+    case SoundCategory::ENVIRONMENT: return .5;
+    default: return 1.;
+    }
+  }
+
+
+  // The weight of an entry already grows with the number of sources that were
+  // merged into it, and shrinks with their distance from the listener.
+  double Score(const QueueEntry &entry)
+  {
+    return entry.weight * cachedVolume[static_cast<size_t>(entry.category)] * Priority(entry.category);
+  }
+
+
+  PlayRequestQueue::PlayRequestQueue()
+  {
+    for(size_t i = 0; i < CAPACITY; ++i)
+      cells[i].sequence.store(i, std::memory_order_relaxed);
+  }
+
+
+  // Add a request to the queue. This may be called from any thread.
+  bool PlayRequestQueue::Push(const PlayRequest &request)
   {
-    std::string           name;
-    std::filesystem::path path;
-    Sound                *sound;
+    size_t position = head.load(std::memory_order_relaxed);
     while(true)
+    {
+      Cell     &cell       = cells[position & (CAPACITY - 1)];
+      size_t    sequence   = cell.sequence.load(std::memory_order_acquire);
+      ptrdiff_t difference = static_cast<ptrdiff_t>(sequence) - static_cast<ptrdiff_t>(position);
+      if(!difference)
+      {
+        // This cell is free; try to claim it.
+        if(head.compare_exchange_weak(position, position + 1, std::memory_order_relaxed))
+        {
+          cell.request = request;
+          cell.sequence.store(position + 1, std::memory_order_release);
+          return true;
+        }
+      }
+      else if(difference < 0) return false;
+      else position = head.load(std::memory_order_relaxed);
+    }
+  }
+
+
+  // Take the oldest request out of the queue. Only the audio thread may call this.
+  bool PlayRequestQueue::Pop(PlayRequest &request)
+  {
+    Cell &cell = cells[tail & (CAPACITY - 1)];
+    if(cell.sequence.load(std::memory_order_acquire) != tail + 1) return false;
+
+    request = cell.request;
+    cell.sequence.store(tail + CAPACITY, std::memory_order_release);
+    ++tail;
+    return true;
+  }
+
+
+  // Thread entry point for the audio thread.
+  void Mix()
+  {
+    std::unique_lock<std::mutex> lock(mixMutex);
+    while(!mixDone)
+    {
+      mixCondition.wait_for(lock, MIX_INTERVAL, [] { return mixDone || pendingSteps; });
+      if(mixDone) break;
+
+      std::string track;
+      bool        changeTrack = std::exchange(trackChanged, false);
+      if(changeTrack) track = requestedTrack;
+      lock.unlock();
+
+      if(changeTrack) StartMusic(track);
+      // Even if the game has not stepped, keep the streaming sources fed.
+      if(pendingSteps.exchange(0)) StepPlayers(fastForward);
+      else
+        for(const auto &player : players)
+          player->Update();
+
+      lock.lock();
+    }
+  }
+
+
+  void StepPlayers(bool isFastForward)
+  {
+    for(size_t i = 0; i < CATEGORY_COUNT; ++i)
+    {
+      double expected = volume[i].level;
+      if(cachedVolume[i] != expected)
+      {
+        cachedVolume[i]        = expected;
+        SoundCategory category = static_cast<SoundCategory>(i);
+        if(category == SoundCategory::MASTER)
+        {
+          alListenerf(AL_GAIN, expected);
+        }
+        else {
+          for(const auto &player : players)
+            if(player->Category() == category) player->SetVolume(expected);
+        }
+      }
+    }
+
+    int pauseChange = pauseChangeCount.exchange(0);
+    if(pauseChange > 0)
+    {
+      bool wasPaused  = pauseCount;
+      pauseCount     += pauseChange;
+      if(pauseCount && !wasPaused)
+        for(const auto &player : players)
+          player->Pause();
+    }
+    else if(pauseChange < 0)
+    {
+      // Check that the game is not paused after this request. Also don't allow the pause count to go into negatives.
+      if(pauseCount && (pauseCount += pauseChange) <= 0)
+      {
+        pauseCount = 0;
+        for(const auto &player : players)
+          player->Play();
+      }
+    }
+
+    // Coalesce all the requests made since the last step.
+    PlayRequest request;
+    while(requests.Pop(request))
+      soundQueue[request.sound].Add(request.position, request.category);
+
+    // Advance the virtual voices by one step. Looping ones continue as long as
+    // they are requested, and the others until they would have ended.
+    for(Voice &voice : virtualVoices)
+    {
+      size_t length  = voice.sound->Buffer().size();
+      voice.elapsed += SAMPLES_PER_STEP;
+      if(voice.sound->IsLooping())
+      {
+        voice.elapsed %= length;
+        auto queueIt   = soundQueue.find(voice.sound);
+        if(queueIt != soundQueue.end())
+        {
+          voice.entry = queueIt->second;
+          soundQueue.erase(queueIt);
+        }
+        else voice.sound = nullptr;
+      }
+      else if(voice.elapsed >= length) voice.sound = nullptr;
+    }
+    erase_if(virtualVoices, [](const Voice &voice) { return !voice.sound; });
+
+    // Every sound that could use a source this step competes for one: the
+    // looping sounds that are playing, the virtual voices and the new sounds.
+    candidates.clear();
+    for(auto it = loopingPlayers.begin(); it != loopingPlayers.end();)
+    {
+      const auto &[sound, player] = *it;
+      auto queueIt                = soundQueue.find(sound);
+      if(queueIt != soundQueue.end())
+      {
+        Move(*player, queueIt->second);
+        candidates.push_back({{sound, queueIt->second, 0}, player, Score(queueIt->second)});
+        soundQueue.erase(queueIt);
+        ++it;
+      }
+      else {
+        reinterpret_cast<Fade *>(player->Supplier())->AddSource({}, 3); // fast fade
+        it = loopingPlayers.erase(it);
+      }
+    }
+    for(const Voice &voice : virtualVoices)
+      candidates.push_back({voice, nullptr, Score(voice.entry)});
+    virtualVoices.clear();
+    // Now, what is left in the queue is sounds that want to play, and that do
+    // not correspond to an existing source.
+    for(const auto &[sound, entry] : soundQueue)
+      candidates.push_back({{sound, entry, 0}, nullptr, Score(entry)});
+    soundQueue.clear();
+
+    // Queue up the new buffers in every player, and remove the finished ones.
+    for(const auto &player : players)
+    {
+      player->Supplier()->Set3x(isFastForward);
+      player->Update();
+    }
+
+    erase_if(players, [](const auto &player) { return player->IsFinished(); });
+
+    // Sounds that are playing once keep their source until they are done, so
+    // the other candidates have to make do with the remaining sources.
+    size_t busyVoices = 0;
+    for(const auto &player : players)
+      busyVoices += player->Category() != SoundCategory::MUSIC;
+    // The looping sounds are among the candidates, so they do not count as busy.
+    const size_t looping    = loopingPlayers.size();
+    busyVoices              = busyVoices > looping ? busyVoices - looping : 0;
+    size_t       freeVoices = MAX_VOICES > busyVoices ? MAX_VOICES - busyVoices : 0;
+    std::ranges::sort(candidates, [](const Candidate &a, const Candidate &b) { return a.score > b.score; });
+
+    for(size_t i = 0; i < candidates.size(); ++i)
+    {
+      const Candidate &candidate = candidates[i];
+      const Voice     &voice     = candidate.voice;
+      if(i >= freeVoices)
+      {
+        // This sound is not important enough for a source right now.
+        if(candidate.player)
+        {
+          reinterpret_cast<Fade *>(candidate.player->Supplier())->AddSource({}, 3); // fast fade
+          loopingPlayers.erase(voice.sound);
+        }
+        virtualVoices.push_back(voice);
+        continue;
+      }
+      // Looping sounds that are already playing keep their source.
+      if(candidate.player) continue;
+
+      std::unique_ptr<AudioSupplier> supplier = voice.sound->CreateSupplier(voice.elapsed);
+      supplier->Set3x(isFastForward);
+      std::shared_ptr<AudioPlayer> player;
+      if(voice.sound->IsLooping())
+      {
+        std::unique_ptr<Fade> fade = std::make_unique<Fade>();
+        fade->AddSource(std::move(supplier));
+        player = make_shared<AudioPlayer>(voice.entry.category, std::move(fade));
+        loopingPlayers.emplace(voice.sound, player);
+      }
+      else {
+        player = make_shared<AudioPlayer>(voice.entry.category, std::move(supplier));
+      }
+
+      player->Init();
+      player->SetVolume(cachedVolume[static_cast<size_t>(voice.entry.category)]);
+      Move(*player, voice.entry);
+      player->Play();
+
+      players.emplace_back(player);
+    }
+
+    if(musicPlayer && musicPlayer->IsFinished()) musicPlayer.reset();
+  }
+
+
+  void StartMusic(const std::string &name)
+  {
+    if(musicPlayer && !musicPlayer->IsFinished())
+    {
+      reinterpret_cast<Fade *>(musicPlayer->Supplier())->AddSource(Music::CreateSupplier(name, true));
+    }
+    else {
+      Fade *fade = new Fade();
+      fade->AddSource(Music::CreateSupplier(name, true));
+      musicPlayer = std::shared_ptr<AudioPlayer>(new MusicPlayer(std::unique_ptr<AudioSupplier>{fade}));
+      musicPlayer->Init();
+      musicPlayer->SetVolume(cachedVolume[static_cast<size_t>(SoundCategory::MUSIC)]);
+      musicPlayer->Play();
+      players.emplace_back(musicPlayer);
+    }
+  }
+
+
+  // Thread entry point for building the sound bank.
+  void Load()
+  {
+    bank.Create(Files::Config() / "sounds.bank");
+    // Nothing but this thread modifies the queue until it is cleared below.
+    for(const auto &[name, path] : loadQueue)
     {
       {
         std::unique_lock<std::mutex> lock(audioMutex);
-        // If this is not the first time through, remove the previous item
-        // in the queue. This is a signal that it has been loaded, so we
-        // must not remove it until after loading the file.
-        if(!path.empty() && !loadQueue.empty()) loadQueue.erase(loadQueue.begin());
-        if(loadQueue.empty()) return;
-        name = loadQueue.begin()->first;
-        path = loadQueue.begin()->second;
-
-        // @3x sounds should be merged with their regular variant here.
-        if(name.ends_with("@3x")) name.resize(name.size() - 3);
-
-        // Since we need to unlock the mutex below, create the map entry to
-        // avoid a race condition when accessing sounds' size.
-        sound = &sounds[name];
+        if(interruptLoading) return;
       }
 
-      // Unlock the mutex for the time-intensive part of the loop.
-      if(!sound->Load(path, name))
+      // The mutex is not locked for the time-intensive part of the loop.
+      if(!bank.Append(path))
         Logger::Log("Unable to load sound \"" + name + "\" from path: " + path.string(), Logger::Level::WARNING);
+
+      std::unique_lock<std::mutex> lock(audioMutex);
+      ++loadedSounds;
+    }
+    bank.Finish();
+    AssignSamples();
+
+    std::unique_lock<std::mutex> lock(audioMutex);
+    loadQueue.clear();
+  }
+
+
+  void AssignSamples()
+  {
+    std::unique_lock<std::mutex> lock(audioMutex);
+    for(const auto &[fileName, path] : soundFiles)
+    {
+      // @3x sounds should be merged with their regular variant here.
+      std::string name = fileName;
+      if(name.ends_with("@3x")) name.resize(name.size() - 3);
+
+      // Empty sounds were already reported when building the bank.
+      sounds[name].Load(path, name, bank.Samples(path));
     }
   }
 } // namespace
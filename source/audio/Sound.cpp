@@ -15,155 +15,37 @@ this program. If not, see <https://www.gnu.org/licenses/>.
 
 #include "Sound.h"
 
-#include "../Files.h"
-#include "../Logger.h"
 #include "supplier/WavSupplier.h"
 
-#include <cstdint>
-#include <iostream>
 
-
-namespace
-{
-  // Read a WAV header, and return the size of the data, in bytes. If the file
-  // is an unsupported format (anything but little-endian 16-bit PCM at 44100 HZ),
-  // this will return 0.
-  uint32_t ReadHeader(std::shared_ptr<std::iostream> &in, uint32_t frequency);
-  uint32_t Read4(const std::shared_ptr<std::iostream> &in);
-  uint16_t Read2(const std::shared_ptr<std::iostream> &in);
-} // namespace
-
-
-bool Sound::Load(const std::filesystem::path &path, const std::string &name)
+bool Sound::Load(
+    const std::filesystem::path             &path,
+    const std::string                       &name,
+    std::span<const AudioSupplier::sample_t> samples)
 {
   if(path.extension() != ".wav") return false;
   this->name = name;
 
   isLooped    = path.stem().string().ends_with('~');
   bool isFast = isLooped ? path.stem().string().ends_with("@3x~") : path.stem().string().ends_with("@3x");
-  std::vector<AudioSupplier::sample_t> &buf = isFast ? buffer3x : buffer;
-
-  std::shared_ptr<std::iostream> in = Files::Open(path);
-  if(!in) return false;
-  uint32_t bytes = ReadHeader(in, AudioSupplier::SAMPLE_RATE);
-  if(!bytes)
-  {
-    Logger::Log(
-        "WAV file uses an unsupported format. Only 44100Hz little-endian 16-bit PCM is supported.",
-        Logger::Level::WARNING);
-    return false;
-  }
-
-  // Read 16-bit mono from the file.
-  std::vector<char> data(bytes);
-  in->read(data.data(), bytes);
-
-  // Store 16-bit stereo buffer.
-  buf.resize(2 * data.size() / sizeof(AudioSupplier::sample_t));
-  for(size_t i = 0; i < buf.size() / 2; ++i)
-  {
-    buf[2 * i]     = reinterpret_cast<AudioSupplier::sample_t *>(data.data())[i];
-    buf[2 * i + 1] = reinterpret_cast<AudioSupplier::sample_t *>(data.data())[i];
-  }
-  return true;
+  (isFast ? buffer3x : buffer) = samples;
+  return !samples.empty();
 }
 
 
 const std::string &Sound::Name() const { return name; }
 
 
-const std::vector<AudioSupplier::sample_t> &Sound::Buffer() const { return buffer.empty() ? buffer3x : buffer; }
+std::span<const AudioSupplier::sample_t> Sound::Buffer() const { return buffer.empty() ? buffer3x : buffer; }
 
 
-const std::vector<AudioSupplier::sample_t> &Sound::Buffer3x() const { return buffer3x.empty() ? buffer : buffer3x; }
+std::span<const AudioSupplier::sample_t> Sound::Buffer3x() const { return buffer3x.empty() ? buffer : buffer3x; }
 
 
 bool Sound::IsLooping() const { return isLooped; }
 
 
-std::unique_ptr<AudioSupplier> Sound::CreateSupplier() const
+std::unique_ptr<AudioSupplier> Sound::CreateSupplier(size_t startSample) const
 {
-  return std::unique_ptr<AudioSupplier>{new WavSupplier{*this, false, IsLooping()}};
+  return std::unique_ptr<AudioSupplier>{new WavSupplier{*this, false, IsLooping(), startSample}};
 }
-
-
-namespace
-{
-  // Read a WAV header, and return the size of the data, in bytes. If the file
-  // is an unsupported format (anything but little-endian 16-bit PCM at 44100 HZ),
-  // this will return 0.
-  uint32_t ReadHeader(std::shared_ptr<std::iostream> &in, uint32_t frequency)
-  {
-    uint32_t chunkID = Read4(in);
-    if(chunkID != 0x46464952) // "RIFF" in big endian.
-      return 0;
-
-    // Ignore the "chunk size".
-    Read4(in);
-    uint32_t format = Read4(in);
-    if(format != 0x45564157) // "WAVE"
-      return 0;
-
-    bool foundHeader = false;
-    while(true)
-    {
-      uint32_t subchunkID   = Read4(in);
-      uint32_t subchunkSize = Read4(in);
-
-      if(subchunkID == 0x20746d66) // "fmt "
-      {
-        foundHeader = true;
-        if(subchunkSize < 16) return 0;
-
-        uint16_t audioFormat   = Read2(in);
-        uint16_t numChannels   = Read2(in);
-        uint32_t fileFrequency = Read4(in);
-        uint32_t byteRate      = Read4(in);
-        uint32_t blockAlign    = Read2(in);
-        uint32_t bitsPerSample = Read2(in);
-
-        // Skip any further bytes in this chunk.
-        if(subchunkSize > 16) in->seekg(subchunkSize - 16, std::ios::cur);
-
-        if(audioFormat != 1) return 0;
-        if(numChannels != 1) return 0;
-        if(bitsPerSample != 16) return 0;
-        if(fileFrequency != frequency) return 0;
-        if(byteRate != frequency * numChannels * bitsPerSample / 8) return 0;
-        if(blockAlign != numChannels * bitsPerSample / 8) return 0;
-      }
-      else if(subchunkID == 0x61746164) // "data"
-      {
-        if(!foundHeader) return 0;
-        return subchunkSize;
-      }
-      else {
-        in->seekg(subchunkSize, std::ios::cur);
-      }
-    }
-  }
-
-
-  uint32_t Read4(const std::shared_ptr<std::iostream> &in)
-  {
-    unsigned char data[4];
-    in->read(reinterpret_cast<char *>(data), 4);
-    if(in->gcount() != 4) return 0;
-    uint32_t result = 0;
-    for(int i = 0; i < 4; ++i)
-      result |= static_cast<uint32_t>(data[i]) << (i * 8);
-    return result;
-  }
-
-
-  uint16_t Read2(const std::shared_ptr<std::iostream> &in)
-  {
-    unsigned char data[2];
-    in->read(reinterpret_cast<char *>(data), 2);
-    if(in->gcount() != 2) return 0;
-    uint16_t result = 0;
-    for(int i = 0; i < 2; ++i)
-      result |= static_cast<uint16_t>(data[i]) << (i * 8);
-    return result;
-  }
-} // namespace
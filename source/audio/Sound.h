@@ -19,28 +19,36 @@ this program. If not, see <https://www.gnu.org/licenses/>.
 
 #include <filesystem>
 #include <memory>
+#include <span>
 #include <string>
 
 
 // This is a sound that can be played. The sound's file name will determine
-// whether it is looping (ends in '~') or not.
+// whether it is looping (ends in '~') or not. The samples themselves are owned
+// by the sound bank; a sound only refers to them.
 class Sound
 {
 public:
-  bool Load(const std::filesystem::path &path, const std::string &name);
+  // Set the mono samples for the given file of this sound. The file name
+  // determines whether these are the regular or the 3x samples.
+  bool Load(
+      const std::filesystem::path             &path,
+      const std::string                       &name,
+      std::span<const AudioSupplier::sample_t> samples);
 
   const std::string &Name() const;
 
-  const std::vector<AudioSupplier::sample_t> &Buffer() const;
-  const std::vector<AudioSupplier::sample_t> &Buffer3x() const;
-  bool                                        IsLooping() const;
+  std::span<const AudioSupplier::sample_t> Buffer() const;
+  std::span<const AudioSupplier::sample_t> Buffer3x() const;
+  bool                                     IsLooping() const;
 
-  std::unique_ptr<AudioSupplier> CreateSupplier() const;
+  // Create a supplier that plays this sound, starting the given number of samples in.
+  std::unique_ptr<AudioSupplier> CreateSupplier(size_t startSample = 0) const;
 
 
 private:
-  std::string                          name;
-  std::vector<AudioSupplier::sample_t> buffer;
-  std::vector<AudioSupplier::sample_t> buffer3x;
-  bool                                 isLooped = false;
+  std::string                              name;
+  std::span<const AudioSupplier::sample_t> buffer;
+  std::span<const AudioSupplier::sample_t> buffer3x;
+  bool                                     isLooped = false;
 };
@@ -0,0 +1,414 @@
+/* SoundBank.cpp
+Copyright (c) 2026 by RisingLeaf
+
+Endless Sky is free software: you can redistribute it and/or modify it under the
+terms of the GNU General Public License as published by the Free Software
+Foundation, either version 3 of the License, or (at your option) any later version.
+
+Endless Sky is distributed in the hope that it will be useful, but WITHOUT ANY
+WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS FOR A
+PARTICULAR PURPOSE. See the GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License along with
+this program. If not, see <https://www.gnu.org/licenses/>.
+*/
+
+#include "SoundBank.h"
+
+#include "../Files.h"
+#include "../Logger.h"
+
+#include <cstring>
+#include <iostream>
+#include <memory>
+
+#ifdef _WIN32
+#define STRICT
+#define WIN32_LEAN_AND_MEAN
+#include <windows.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+
+namespace
+{
+  // The header at the start of every bank. The index of the sounds is stored
+  // after all the sample data, at the given offset.
+  struct Header
+  {
+    char     magic[4] = {'E', 'S', 'S', 'B'};
+    uint32_t version  = 1;
+    uint64_t index    = 0;
+    uint64_t count    = 0;
+  };
+
+  // Get the modification time of a sound file. Files inside a zipped plugin
+  // use the timestamp of the zip file itself.
+  int64_t Timestamp(std::filesystem::path file);
+
+  // Read a WAV header, and return the size of the data, in bytes. If the file
+  // is an unsupported format (anything but little-endian 16-bit PCM at 44100 HZ),
+  // this will return 0.
+  uint32_t ReadHeader(std::shared_ptr<std::iostream> &in, uint32_t frequency);
+  uint32_t Read4(const std::shared_ptr<std::iostream> &in);
+  uint16_t Read2(const std::shared_ptr<std::iostream> &in);
+
+  template<class Type>
+  bool ReadValue(const unsigned char *data, size_t size, size_t &offset, Type &value)
+  {
+    if(offset + sizeof(Type) > size) return false;
+    std::memcpy(&value, data + offset, sizeof(Type));
+    offset += sizeof(Type);
+    return true;
+  }
+
+  template<class Type>
+  void WriteValue(std::ofstream &out, const Type &value)
+  {
+    out.write(reinterpret_cast<const char *>(&value), sizeof(Type));
+  }
+
+  // A new bank is written next to the old one, and only replaces it once it is complete.
+  std::filesystem::path TemporaryPath(const std::filesystem::path &path)
+  {
+    std::filesystem::path temporary = path;
+    temporary += ".tmp";
+    return temporary;
+  }
+} // namespace
+
+
+SoundBank::~SoundBank() { Close(); }
+
+
+// Map the bank stored at the given path, if it contains exactly the given
+// sound files and none of them changed since it was written.
+bool SoundBank::Open(const std::filesystem::path &path, const std::vector<std::filesystem::path> &files)
+{
+  Close();
+  this->path = path;
+  bool isValid = Files::Exists(path) && Map() && ReadIndex() && entries.size() == files.size();
+  for(auto it = files.begin(); isValid && it != files.end(); ++it)
+  {
+    auto entry = entries.find(it->generic_string());
+    isValid    = entry != entries.end() && entry->second.timestamp == Timestamp(*it);
+  }
+  if(!isValid) Close();
+  return isValid;
+}
+
+
+// Start writing a new bank to the given path. If the file can't be written,
+// the appended sounds are kept in memory instead.
+void SoundBank::Create(const std::filesystem::path &path)
+{
+  Close();
+  this->path = path;
+  // The old bank may still be mapped, possibly by another instance of the game, so it
+  // is never written to in place. Truncating it would crash anything reading from it,
+  // and a crash while writing would leave behind a bank that is only partly written.
+  out.open(TemporaryPath(path), std::ios::out | std::ios::binary | std::ios::trunc);
+  if(out.is_open()) WriteValue(out, Header{});
+  else Logger::Log("Unable to write the sound bank to " + path.string() + ".", Logger::Level::WARNING);
+  written = sizeof(Header);
+}
+
+
+// Decode the given WAV file and append its samples to the bank being written.
+bool SoundBank::Append(const std::filesystem::path &file)
+{
+  // Even if the file can't be decoded, it gets an (empty) entry, so that the
+  // bank is still recognized as up to date the next time.
+  Entry &entry    = entries[file.generic_string()];
+  entry.timestamp = Timestamp(file);
+  entry.offset    = out.is_open() ? written : memory.size() * sizeof(AudioSupplier::sample_t);
+
+  std::shared_ptr<std::iostream> in = Files::Open(file);
+  if(!in) return false;
+  uint32_t bytes = ReadHeader(in, AudioSupplier::SAMPLE_RATE);
+  if(!bytes)
+  {
+    Logger::Log(
+        "WAV file uses an unsupported format. Only 44100Hz little-endian 16-bit mono PCM is supported.",
+        Logger::Level::WARNING);
+    return false;
+  }
+
+  // The samples are stored exactly as they are in the file: 16-bit mono.
+  std::vector<AudioSupplier::sample_t> samples(bytes / sizeof(AudioSupplier::sample_t));
+  in->read(reinterpret_cast<char *>(samples.data()), samples.size() * sizeof(AudioSupplier::sample_t));
+  samples.resize(in->gcount() / sizeof(AudioSupplier::sample_t));
+
+  entry.count = samples.size();
+  if(out.is_open())
+  {
+    out.write(reinterpret_cast<const char *>(samples.data()), samples.size() * sizeof(AudioSupplier::sample_t));
+    written += samples.size() * sizeof(AudioSupplier::sample_t);
+  }
+  else {
+    memory.insert(memory.end(), samples.begin(), samples.end());
+  }
+  return true;
+}
+
+
+// Finish writing the bank, and map it.
+void SoundBank::Finish()
+{
+  // If the bank could not be created, its samples are already in memory.
+  if(!out.is_open()) return;
+
+  Header header;
+  header.index = written;
+  header.count = entries.size();
+  for(const auto &[file, entry] : entries)
+  {
+    WriteValue(out, static_cast<uint32_t>(file.size()));
+    out.write(file.data(), file.size());
+    WriteValue(out, entry.timestamp);
+    WriteValue(out, entry.offset);
+    WriteValue(out, entry.count);
+  }
+  out.seekp(0);
+  WriteValue(out, header);
+  out.flush();
+  out.close();
+  bool isWritten = !out.fail();
+
+  // Replace the old bank with the new one. Anything that still has the old one mapped
+  // keeps reading the old file, which is only deleted once it is unmapped.
+  std::error_code error;
+  if(isWritten) std::filesystem::rename(TemporaryPath(path), path, error);
+  if(!isWritten || error)
+  {
+    Logger::Log("Unable to write the sound bank to " + path.string() + ".", Logger::Level::WARNING);
+    std::filesystem::remove(TemporaryPath(path), error);
+    isWritten = false;
+  }
+
+  // If writing or mapping the new bank failed for some reason, read it into memory instead.
+  std::map<std::string, Entry> index = std::move(entries);
+  if(isWritten && Map() && ReadIndex()) return;
+
+  Close();
+  for(const auto &[file, entry] : index)
+    Append(file);
+}
+
+
+// Unmap the bank. Any samples returned from it become invalid.
+void SoundBank::Close()
+{
+  // A bank that was never finished is of no use.
+  if(out.is_open())
+  {
+    out.close();
+    std::error_code error;
+    std::filesystem::remove(TemporaryPath(path), error);
+  }
+  out.clear();
+  entries.clear();
+  memory.clear();
+  memory.shrink_to_fit();
+  written = 0;
+
+  if(!data) return;
+#ifdef _WIN32
+  UnmapViewOfFile(data);
+  CloseHandle(mappingHandle);
+  CloseHandle(fileHandle);
+  mappingHandle = nullptr;
+  fileHandle    = nullptr;
+#else
+  munmap(const_cast<unsigned char *>(data), size);
+#endif
+  data = nullptr;
+  size = 0;
+}
+
+
+// Get the mono samples of the given sound file, or an empty span if it is not in this bank.
+std::span<const AudioSupplier::sample_t> SoundBank::Samples(const std::filesystem::path &file) const
+{
+  auto it = entries.find(file.generic_string());
+  if(it == entries.end() || !it->second.count) return {};
+
+  const unsigned char *base = data ? data : reinterpret_cast<const unsigned char *>(memory.data());
+  return {reinterpret_cast<const AudioSupplier::sample_t *>(base + it->second.offset), it->second.count};
+}
+
+
+// Map the file at the current path into memory.
+bool SoundBank::Map()
+{
+#ifdef _WIN32
+  fileHandle = CreateFileW(
+      path.c_str(), GENERIC_READ, FILE_SHARE_READ, nullptr, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, nullptr);
+  if(fileHandle == INVALID_HANDLE_VALUE)
+  {
+    fileHandle = nullptr;
+    return false;
+  }
+  LARGE_INTEGER fileSize;
+  if(!GetFileSizeEx(fileHandle, &fileSize) || !fileSize.QuadPart)
+  {
+    CloseHandle(fileHandle);
+    fileHandle = nullptr;
+    return false;
+  }
+  mappingHandle = CreateFileMappingW(fileHandle, nullptr, PAGE_READONLY, 0, 0, nullptr);
+  if(mappingHandle) data = static_cast<const unsigned char *>(MapViewOfFile(mappingHandle, FILE_MAP_READ, 0, 0, 0));
+  if(!data)
+  {
+    if(mappingHandle) CloseHandle(mappingHandle);
+    CloseHandle(fileHandle);
+    mappingHandle = nullptr;
+    fileHandle    = nullptr;
+    return false;
+  }
+  size = fileSize.QuadPart;
+#else
+  int file = open(path.c_str(), O_RDONLY);
+  if(file < 0) return false;
+  struct stat status;
+  if(fstat(file, &status) || !status.st_size)
+  {
+    close(file);
+    return false;
+  }
+  void *mapped = mmap(nullptr, status.st_size, PROT_READ, MAP_PRIVATE, file, 0);
+  // The mapping stays valid after the file descriptor is closed.
+  close(file);
+  if(mapped == MAP_FAILED) return false;
+  data = static_cast<const unsigned char *>(mapped);
+  size = status.st_size;
+#endif
+  return true;
+}
+
+
+// Read the index of the mapped file. Returns false if it is not a valid bank.
+bool SoundBank::ReadIndex()
+{
+  entries.clear();
+
+  Header header;
+  size_t offset = 0;
+  if(!ReadValue(data, size, offset, header) || std::memcmp(header.magic, Header{}.magic, sizeof(header.magic)) ||
+     header.version != Header{}.version)
+    return false;
+
+  offset = header.index;
+  for(uint64_t i = 0; i < header.count; ++i)
+  {
+    uint32_t length = 0;
+    if(!ReadValue(data, size, offset, length) || offset + length > size) return false;
+    std::string file(reinterpret_cast<const char *>(data + offset), length);
+    offset += length;
+
+    Entry entry;
+    if(!ReadValue(data, size, offset, entry.timestamp) || !ReadValue(data, size, offset, entry.offset) ||
+       !ReadValue(data, size, offset, entry.count))
+      return false;
+    if(entry.offset + entry.count * sizeof(AudioSupplier::sample_t) > header.index) return false;
+    entries[file] = entry;
+  }
+  return true;
+}
+
+
+namespace
+{
+  // Get the modification time of a sound file. Files inside a zipped plugin
+  // use the timestamp of the zip file itself.
+  int64_t Timestamp(std::filesystem::path file)
+  {
+    while(!Files::Exists(file) && file.has_relative_path())
+      file = file.parent_path();
+    if(!Files::Exists(file)) return 0;
+    return Files::Timestamp(file).time_since_epoch().count();
+  }
+
+
+  // Read a WAV header, and return the size of the data, in bytes. If the file
+  // is an unsupported format (anything but little-endian 16-bit PCM at 44100 HZ),
+  // this will return 0.
+  uint32_t ReadHeader(std::shared_ptr<std::iostream> &in, uint32_t frequency)
+  {
+    uint32_t chunkID = Read4(in);
+    if(chunkID != 0x46464952) // "RIFF" in big endian.
+      return 0;
+
+    // Ignore the "chunk size".
+    Read4(in);
+    uint32_t format = Read4(in);
+    if(format != 0x45564157) // "WAVE"
+      return 0;
+
+    bool foundHeader = false;
+    while(true)
+    {
+      uint32_t subchunkID   = Read4(in);
+      uint32_t subchunkSize = Read4(in);
+
+      if(subchunkID == 0x20746d66) // "fmt "
+      {
+        foundHeader = true;
+        if(subchunkSize < 16) return 0;
+
+        uint16_t audioFormat   = Read2(in);
+        uint16_t numChannels   = Read2(in);
+        uint32_t fileFrequency = Read4(in);
+        uint32_t byteRate      = Read4(in);
+        uint32_t blockAlign    = Read2(in);
+        uint32_t bitsPerSample = Read2(in);
+
+        // Skip any further bytes in this chunk.
+        if(subchunkSize > 16) in->seekg(subchunkSize - 16, std::ios::cur);
+
+        if(audioFormat != 1) return 0;
+        if(numChannels != 1) return 0;
+        if(bitsPerSample != 16) return 0;
+        if(fileFrequency != frequency) return 0;
+        if(byteRate != frequency * numChannels * bitsPerSample / 8) return 0;
+        if(blockAlign != numChannels * bitsPerSample / 8) return 0;
+      }
+      else if(subchunkID == 0x61746164) // "data"
+      {
+        if(!foundHeader) return 0;
+        return subchunkSize;
+      }
+      else {
+        in->seekg(subchunkSize, std::ios::cur);
+      }
+    }
+  }
+
+
+  uint32_t Read4(const std::shared_ptr<std::iostream> &in)
+  {
+    unsigned char data[4];
+    in->read(reinterpret_cast<char *>(data), 4);
+    if(in->gcount() != 4) return 0;
+    uint32_t result = 0;
+    for(int i = 0; i < 4; ++i)
+      result |= static_cast<uint32_t>(data[i]) << (i * 8);
+    return result;
+  }
+
+
+  uint16_t Read2(const std::shared_ptr<std::iostream> &in)
+  {
+    unsigned char data[2];
+    in->read(reinterpret_cast<char *>(data), 2);
+    if(in->gcount() != 2) return 0;
+    uint16_t result = 0;
+    for(int i = 0; i < 2; ++i)
+      result |= static_cast<uint16_t>(data[i]) << (i * 8);
+    return result;
+  }
+} // namespace
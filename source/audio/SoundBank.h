@@ -0,0 +1,95 @@
+/* SoundBank.h
+Copyright (c) 2026 by RisingLeaf
+
+Endless Sky is free software: you can redistribute it and/or modify it under the
+terms of the GNU General Public License as published by the Free Software
+Foundation, either version 3 of the License, or (at your option) any later version.
+
+Endless Sky is distributed in the hope that it will be useful, but WITHOUT ANY
+WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS FOR A
+PARTICULAR PURPOSE. See the GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License along with
+this program. If not, see <https://www.gnu.org/licenses/>.
+*/
+
+#pragma once
+
+#include "supplier/AudioSupplier.h"
+
+#include <cstddef>
+#include <cstdint>
+#include <filesystem>
+#include <fstream>
+#include <map>
+#include <span>
+#include <string>
+#include <vector>
+
+
+// A sound bank is a single file holding the decoded samples of every sound
+// effect. Rather than reading all the sounds into memory at startup, the bank
+// is memory-mapped, so only the sounds that are actually played get paged in,
+// and the operating system is free to drop them again under memory pressure.
+// The bank is rebuilt whenever a sound file is added, removed or modified.
+class SoundBank
+{
+public:
+  SoundBank() = default;
+  ~SoundBank();
+
+  SoundBank(const SoundBank &)            = delete;
+  SoundBank &operator=(const SoundBank &) = delete;
+
+  // Map the bank stored at the given path, if it contains exactly the given
+  // sound files and none of them changed since it was written.
+  bool Open(const std::filesystem::path &path, const std::vector<std::filesystem::path> &files);
+
+  // Start writing a new bank to the given path. If the file can't be written,
+  // the appended sounds are kept in memory instead.
+  void Create(const std::filesystem::path &path);
+  // Decode the given WAV file and append its samples to the bank being written.
+  bool Append(const std::filesystem::path &file);
+  // Finish writing the bank, replace the old one with it, and map it.
+  void Finish();
+
+  // Unmap the bank. Any samples returned from it become invalid.
+  void Close();
+
+  // Get the mono samples of the given sound file, or an empty span if it is not in this bank.
+  std::span<const AudioSupplier::sample_t> Samples(const std::filesystem::path &file) const;
+
+
+private:
+  // Map the file at the current path into memory.
+  bool Map();
+  // Read the index of the mapped file. Returns false if it is not a valid bank.
+  bool ReadIndex();
+
+
+private:
+  struct Entry
+  {
+    int64_t  timestamp = 0;
+    uint64_t offset    = 0;
+    uint64_t count     = 0;
+  };
+
+  // The index of the bank, by the generic path string of each sound file.
+  std::map<std::string, Entry> entries;
+
+  // The mapped file.
+  const unsigned char *data = nullptr;
+  size_t               size = 0;
+#ifdef _WIN32
+  void *fileHandle    = nullptr;
+  void *mappingHandle = nullptr;
+#endif
+
+  // The bank currently being written, if any.
+  std::filesystem::path path;
+  std::ofstream         out;
+  uint64_t              written = 0;
+  // If the bank can't be written to disk, the samples are kept here instead.
+  std::vector<AudioSupplier::sample_t> memory;
+};
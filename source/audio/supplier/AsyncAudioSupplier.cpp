@@ -15,13 +15,13 @@ this program. If not, see <https://www.gnu.org/licenses/>.
 
 #include "AsyncAudioSupplier.h"
 
-#include <cmath>
+#include <algorithm>
 #include <thread>
 #include <utility>
 
 
 AsyncAudioSupplier::AsyncAudioSupplier(std::shared_ptr<std::iostream> data, bool looping) :
-  looping(looping), data(std::move(data))
+  looping(looping), data(std::move(data)), ring(RING_CHUNKS * OUTPUT_CHUNK)
 {
 }
 
@@ -31,7 +31,7 @@ AsyncAudioSupplier::~AsyncAudioSupplier()
   // Tell the decoding thread to stop.
   {
     std::lock_guard<std::mutex> lock(bufferMutex);
-    done = true;
+    stopRequested = true;
   }
   bufferCondition.notify_all();
   if(audioThread.joinable()) audioThread.join();
@@ -40,61 +40,78 @@ AsyncAudioSupplier::~AsyncAudioSupplier()
 
 size_t AsyncAudioSupplier::MaxChunks() const
 {
-  if(done && buffer.size() < OUTPUT_CHUNK) return 0;
+  if(finished.load(std::memory_order_acquire) && !AvailableChunks()) return 0;
 
   return std::max(static_cast<size_t>(2), AvailableChunks());
 }
 
 
-size_t AsyncAudioSupplier::AvailableChunks() const { return buffer.size() / OUTPUT_CHUNK; }
+size_t AsyncAudioSupplier::AvailableChunks() const
+{
+  return writtenChunks.load(std::memory_order_acquire) - releasedChunks.load(std::memory_order_relaxed) - holdsChunk;
+}
 
 
-std::vector<AudioSupplier::sample_t> AsyncAudioSupplier::NextDataChunk()
+std::span<const AudioSupplier::sample_t> AsyncAudioSupplier::NextDataChunk()
 {
-  if(AvailableChunks())
+  // The chunk handed out last time can now be overwritten by the decoder.
+  if(holdsChunk)
   {
-    std::lock_guard<std::mutex> lock(bufferMutex);
-
-    std::vector<sample_t> temp{buffer.begin(), buffer.begin() + OUTPUT_CHUNK};
-    buffer.erase(buffer.begin(), buffer.begin() + OUTPUT_CHUNK);
+    holdsChunk = false;
+    {
+      std::lock_guard<std::mutex> lock(bufferMutex);
+      releasedChunks.fetch_add(1, std::memory_order_release);
+    }
     bufferCondition.notify_all();
-    return temp;
-  }
-  else {
-    return std::vector<sample_t>(OUTPUT_CHUNK);
   }
+
+  if(!AvailableChunks()) return Silence();
+
+  holdsChunk   = true;
+  size_t index = releasedChunks.load(std::memory_order_relaxed) % RING_CHUNKS;
+  return std::span<const sample_t>(ring).subspan(index * OUTPUT_CHUNK, OUTPUT_CHUNK);
 }
 
 
-void AsyncAudioSupplier::StartAudioThread() { audioThread = std::thread(&AsyncAudioSupplier::Decode, this); }
+void AsyncAudioSupplier::StartAudioThread() { audioThread = std::thread(&AsyncAudioSupplier::RunDecoder, this); }
 
 
-void AsyncAudioSupplier::AwaitBufferSpace()
+std::span<AudioSupplier::sample_t> AsyncAudioSupplier::AwaitBufferSpace()
 {
   std::unique_lock<std::mutex> lock(bufferMutex);
-  while(!done && buffer.size() > (BUFFER_CHUNK_SIZE - 1) * OUTPUT_CHUNK)
+  while(!stopRequested && writtenChunks - releasedChunks >= RING_CHUNKS)
     bufferCondition.wait(lock);
+  if(stopRequested) return {};
+
+  size_t index = writtenChunks.load(std::memory_order_relaxed) % RING_CHUNKS;
+  return std::span<sample_t>(ring).subspan(index * OUTPUT_CHUNK + writeOffset, OUTPUT_CHUNK - writeOffset);
 }
 
 
-void AsyncAudioSupplier::AddBufferData(std::vector<sample_t> &samples)
+void AsyncAudioSupplier::CommitSamples(size_t count)
 {
-  std::lock_guard<std::mutex> lock(bufferMutex);
-  buffer.insert(buffer.end(), samples.begin(), samples.end());
-  samples.clear();
-  if(done) PadBuffer();
+  writeOffset += count;
+  if(writeOffset < OUTPUT_CHUNK) return;
+
+  writeOffset = 0;
+  writtenChunks.fetch_add(1, std::memory_order_release);
 }
 
 
 void AsyncAudioSupplier::PadBuffer()
 {
-  buffer.resize(OUTPUT_CHUNK * ceil(static_cast<double>(buffer.size()) / static_cast<double>(OUTPUT_CHUNK)));
+  // If a chunk is partially written, it is guaranteed to have space in the ring.
+  if(!writeOffset) return;
+
+  size_t index = writtenChunks.load(std::memory_order_relaxed) % RING_CHUNKS;
+  std::fill(ring.begin() + index * OUTPUT_CHUNK + writeOffset, ring.begin() + (index + 1) * OUTPUT_CHUNK, 0);
+  CommitSamples(OUTPUT_CHUNK - writeOffset);
 }
 
 
 size_t AsyncAudioSupplier::ReadInput(char *output, size_t bytesToRead)
 {
-  if(done) return 0;
+  if(inputExhausted || stopRequested) return 0;
   // Read a chunk of data from the file.
   data->read(output, bytesToRead);
   size_t read = data->gcount();
@@ -106,7 +123,15 @@ size_t AsyncAudioSupplier::ReadInput(char *output, size_t bytesToRead)
   }
   else if(data->eof())
   {
-    done = true;
+    inputExhausted = true;
   }
   return read;
 }
+
+
+void AsyncAudioSupplier::RunDecoder()
+{
+  Decode();
+  // All the chunks written by the decoder are visible to whoever sees this flag.
+  finished.store(true, std::memory_order_release);
+}
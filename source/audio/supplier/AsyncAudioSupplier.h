@@ -17,13 +17,17 @@ this program. If not, see <https://www.gnu.org/licenses/>.
 
 #include "AudioSupplier.h"
 
+#include <atomic>
 #include <condition_variable>
 #include <iostream>
 #include <memory>
+#include <mutex>
 #include <thread>
 
 
 /// Generic implementation for async suppliers that stream data decoded on another thread.
+/// The decoding thread writes its samples directly into a preallocated ring of output chunks,
+/// which the audio thread then hands out without copying them.
 class AsyncAudioSupplier : public AudioSupplier
 {
 public:
@@ -31,9 +35,9 @@ public:
   ~AsyncAudioSupplier() override;
 
   // Inherited pure virtual methods
-  size_t                MaxChunks() const override;
-  size_t                AvailableChunks() const override;
-  std::vector<sample_t> NextDataChunk() override;
+  size_t                    MaxChunks() const override;
+  size_t                    AvailableChunks() const override;
+  std::span<const sample_t> NextDataChunk() override;
 
 
 protected:
@@ -41,31 +45,54 @@ protected:
   /// This is the entry point for the decoding thread.
   virtual void Decode() = 0;
 
-  void AwaitBufferSpace();
-  /// Adds data to the output buffer, then clears the given sample vector.
-  /// If the supplier is done, pads the output buffer to a full chunk with silence.
-  void AddBufferData(std::vector<sample_t> &samples);
-  /// Pads the buffer to a full output chunk with silence.
+  /// Waits until there is space in the ring, then returns the unwritten part of the chunk being filled.
+  /// The decoder writes its samples into that span, then calls CommitSamples().
+  /// Returns an empty span if the supplier is being destroyed, in which case the decoder should stop.
+  /// Space is still handed out after the input is exhausted, so the decoder can flush what it buffered.
+  std::span<sample_t> AwaitBufferSpace();
+  /// Marks the given number of samples at the start of the last AwaitBufferSpace() span as written.
+  void CommitSamples(size_t count);
+  /// Pads the chunk being filled with silence, so that all the decoded data is available.
+  /// Decoders call this once they have written their last samples.
   void PadBuffer();
 
   /// Reads file input. Returns the number of bytes read.
   /// The returned byte count is only less than the requested number if the end of the input was reached.
-  /// If the supplier is looping, the next call will still read data. Otherwise, "done" is set to true.
+  /// If the supplier is looping, the next call will still read data. Otherwise, "inputExhausted" is set to true.
   size_t ReadInput(char *output, size_t bytesToRead);
 
 
+private:
+  /// Runs the decoder, then marks the supplier as finished.
+  void RunDecoder();
+
+
 protected:
-  bool       done = false;
-  const bool looping;
+  /// Set when the supplier is being destroyed. The decoder must return from Decode() as soon as it can.
+  std::atomic<bool> stopRequested = false;
+  /// Set when there is no more input to decode, either because the end of the input was reached
+  /// or because the input is invalid. Data the decoder has already read can still be written.
+  std::atomic<bool> inputExhausted = false;
+  const bool        looping;
 
   std::shared_ptr<std::iostream> data;
 
 
 private:
-  /// The number of chunks to queue up in the buffer.
-  static constexpr size_t BUFFER_CHUNK_SIZE = 3;
-  /// The decoded data.
-  std::vector<sample_t> buffer;
+  /// The number of chunks in the ring.
+  static constexpr size_t RING_CHUNKS = 4;
+  /// The decoded data, as RING_CHUNKS consecutive output chunks.
+  std::vector<sample_t> ring;
+  /// The total number of chunks completed by the decoder, and released by the audio thread.
+  /// Only the decoder writes to the first, and only the audio thread to the second.
+  std::atomic<size_t> writtenChunks  = 0;
+  std::atomic<size_t> releasedChunks = 0;
+  /// The number of samples already written to the chunk being filled. Decoder only.
+  size_t writeOffset = 0;
+  /// Whether the audio thread is still using the oldest written chunk. Audio thread only.
+  bool holdsChunk = false;
+  /// Set once Decode() has returned, so no more chunks will be written.
+  std::atomic<bool> finished = false;
 
   // Sync management
   std::thread             audioThread;
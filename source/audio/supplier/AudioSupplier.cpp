@@ -15,6 +15,8 @@ this program. If not, see <https://www.gnu.org/licenses/>.
 
 #include "AudioSupplier.h"
 
+#include <algorithm>
+
 
 ALuint AudioSupplier::CreateBuffer()
 {
@@ -37,14 +39,15 @@ void AudioSupplier::NextChunk(ALuint buffer, bool spatial)
 {
   if(AvailableChunks())
   {
-    std::vector<sample_t> samples = NextDataChunk();
+    std::span<const sample_t> samples = NextDataChunk();
     // Spatial audio is mono, but we get stereo data by default.
     // (This difference is due to a limitation in OpenAL.)
     if(spatial)
     {
-      for(size_t i = 0; i < samples.size() / 2; ++i)
-        samples[i] = (static_cast<int>(samples[2 * i]) + static_cast<int>(samples[2 * i + 1])) / 2;
-      samples.resize(samples.size() / 2);
+      monoChunk.resize(samples.size() / 2);
+      for(size_t i = 0; i < monoChunk.size(); ++i)
+        monoChunk[i] = (static_cast<int>(samples[2 * i]) + static_cast<int>(samples[2 * i + 1])) / 2;
+      samples = monoChunk;
     }
     alBufferData(
         buffer,
@@ -61,6 +64,12 @@ void AudioSupplier::NextChunk(ALuint buffer, bool spatial)
 
 void AudioSupplier::SetSilence(ALuint buffer, size_t samples)
 {
-  std::vector<sample_t> data(samples);
-  alBufferData(buffer, FORMAT, data.data(), sizeof(sample_t) * samples, SAMPLE_RATE);
+  alBufferData(buffer, FORMAT, Silence().data(), sizeof(sample_t) * std::min(samples, OUTPUT_CHUNK), SAMPLE_RATE);
+}
+
+
+std::span<const AudioSupplier::sample_t> AudioSupplier::Silence()
+{
+  static const std::vector<sample_t> silence(OUTPUT_CHUNK);
+  return silence;
 }
@@ -19,6 +19,7 @@ this program. If not, see <https://www.gnu.org/licenses/>.
 
 #include <cstddef>
 #include <cstdint>
+#include <span>
 #include <vector>
 
 
@@ -47,7 +48,8 @@ public:
   virtual size_t AvailableChunks() const = 0;
   /// Gets the next, fixed-size chunk of audio samples. If there is no available chunk, a silence chunk is returned.
   /// This returns the raw samples that would be put into an OpenAL buffer via a NextChunk() call.
-  virtual std::vector<sample_t> NextDataChunk() = 0;
+  /// The samples are owned by the supplier, and stay valid until the next call to this function.
+  virtual std::span<const sample_t> NextDataChunk() = 0;
 
   /// Configures 3x audio playback.
   virtual void Set3x(bool is3x);
@@ -60,6 +62,8 @@ public:
 protected:
   /// Sets the buffer to silence for the given number of samples.
   static void SetSilence(ALuint buffer, size_t samples);
+  /// A full output chunk of silence.
+  static std::span<const sample_t> Silence();
 
 
 public:
@@ -86,4 +90,9 @@ protected:
 
   /// The index of the first sample to be processed
   size_t currentSample = 0;
+
+
+private:
+  /// Scratch space for down-mixing a chunk for spatial playback, so that no allocation is needed per chunk.
+  std::vector<sample_t> monoChunk;
 };
@@ -17,6 +17,7 @@ this program. If not, see <https://www.gnu.org/licenses/>.
 
 #include "../../Logger.h"
 
+#include <algorithm>
 #include <utility>
 
 
@@ -29,16 +30,26 @@ FlacSupplier::FlacSupplier(std::shared_ptr<std::iostream> data, bool looping) :
 
 FLAC__StreamDecoderWriteStatus FlacSupplier::write_callback(const FLAC__Frame *frame, const FLAC__int32 *const buffer[])
 {
+  // Don't play a stream in a format that the output chunks can't hold.
+  if(isInvalid) return FLAC__STREAM_DECODER_WRITE_STATUS_ABORT;
+
   const size_t channels  = frame->header.channels;
   const size_t blocksize = frame->header.blocksize;
 
-  AwaitBufferSpace();
-  static std::vector<sample_t> samples;
-  for(size_t i = 0; i < blocksize; ++i)
-    for(size_t ch = 0; ch < channels; ++ch)
-      samples.push_back(static_cast<sample_t>(buffer[ch][i]));
-
-  AddBufferData(samples);
+  // Interleave the samples straight into the output chunks.
+  for(size_t i = 0; i < blocksize;)
+  {
+    std::span<sample_t> output = AwaitBufferSpace();
+    // The supplier is being destroyed, so the rest of the stream is not needed.
+    if(output.empty()) return FLAC__STREAM_DECODER_WRITE_STATUS_ABORT;
+    size_t frames = std::min(blocksize - i, output.size() / channels);
+
+    for(size_t j = 0; j < frames; ++j)
+      for(size_t ch = 0; ch < channels; ++ch)
+        output[j * channels + ch] = static_cast<sample_t>(buffer[ch][i + j]);
+    CommitSamples(frames * channels);
+    i += frames;
+  }
   /// Allow looping back to the beginning of the file on the next read.
   return FLAC__STREAM_DECODER_WRITE_STATUS_CONTINUE;
 }
@@ -52,7 +63,7 @@ void FlacSupplier::metadata_callback(const FLAC__StreamMetadata *metadata)
         "FLAC channel count should be two, but is " + std::to_string(metadata->data.stream_info.channels) +
             ". The audio may be corrupt.",
         Logger::Level::WARNING);
-    done = true;
+    isInvalid = true;
   }
   if(metadata->data.stream_info.bits_per_sample != 16)
   {
@@ -60,7 +71,7 @@ void FlacSupplier::metadata_callback(const FLAC__StreamMetadata *metadata)
         "FLAC should use 16-bit samples, but is " + std::to_string(metadata->data.stream_info.bits_per_sample) +
             "-bit instead. The audio may be corrupt.",
         Logger::Level::WARNING);
-    done = true;
+    isInvalid = true;
   }
   if(metadata->data.stream_info.sample_rate != SAMPLE_RATE)
   {
@@ -68,16 +79,16 @@ void FlacSupplier::metadata_callback(const FLAC__StreamMetadata *metadata)
         "FLAC should use " + std::to_string(SAMPLE_RATE) + " sample rate, but is " +
             std::to_string(metadata->data.stream_info.sample_rate) + ". The audio may be corrupt.",
         Logger::Level::WARNING);
-    done = true;
+    isInvalid = true;
   }
+  if(isInvalid) inputExhausted = true;
 }
 
 
 void FlacSupplier::error_callback(FLAC__StreamDecoderErrorStatus status)
 {
   Logger::Log("FLAC error " + std::string(FLAC__StreamDecoderErrorStatusString[status]), Logger::Level::WARNING);
-  done = true;
-  PadBuffer();
+  inputExhausted = true;
 }
 
 
@@ -88,7 +99,9 @@ FLAC__StreamDecoderReadStatus FlacSupplier::read_callback(FLAC__byte buffer[], s
   *bytes                = readBytes;
   if(readBytes != requestedBytes) lastReadWasEof = true;
 
-  return done ? FLAC__STREAM_DECODER_READ_STATUS_END_OF_STREAM : FLAC__STREAM_DECODER_READ_STATUS_CONTINUE;
+  // The bytes read by this call are still decoded, even if it reached the end of the stream.
+  return inputExhausted || stopRequested ? FLAC__STREAM_DECODER_READ_STATUS_END_OF_STREAM
+                                         : FLAC__STREAM_DECODER_READ_STATUS_CONTINUE;
 }
 
 
@@ -110,7 +123,7 @@ FLAC__StreamDecoderLengthStatus FlacSupplier::length_callback(FLAC__uint64 *stre
 }
 
 
-bool FlacSupplier::eof_callback() { return done || lastReadWasEof; }
+bool FlacSupplier::eof_callback() { return inputExhausted || stopRequested || lastReadWasEof; }
 
 
 void FlacSupplier::Decode()
@@ -121,6 +134,8 @@ void FlacSupplier::Decode()
     lastReadWasEof = false;
     process_until_end_of_stream();
     reset();
-  } while(!done && lastReadWasEof);
+  } while(!inputExhausted && !stopRequested && lastReadWasEof);
   finish();
+  // Commit the last, partially filled chunk.
+  PadBuffer();
 }
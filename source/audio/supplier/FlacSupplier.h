@@ -52,4 +52,6 @@ private:
 private:
   /// If the last read reached the end of the file, we may have to loop back by resetting the decoder.
   bool lastReadWasEof = false;
+  /// Whether the stream info describes a format that can't be played.
+  bool isInvalid = false;
 };
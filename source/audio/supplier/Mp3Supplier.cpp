@@ -18,9 +18,6 @@ this program. If not, see <https://www.gnu.org/licenses/>.
 #define MA_IMPLEMENTATION
 #include <miniaudio.h>
 
-#include <array>
-#include <cmath>
-#include <cstring>
 #include <utility>
 
 
@@ -33,44 +30,32 @@ Mp3Supplier::Mp3Supplier(std::shared_ptr<std::iostream> data, bool looping) :
 
 void Mp3Supplier::Decode()
 {
-  std::vector<sample_t> samples;
-  ma_decoder            decoder;
+  ma_decoder decoder;
 
   ma_decoder_config config = ma_decoder_config_init(
       ma_format_s16, // match sample_t if int16_t
-      0,             // auto channels
+      2,             // always stereo, so frames can be decoded straight into the output chunks
       0              // auto sample rate
   );
 
   if(ma_decoder_init(OnRead, nullptr, this, &config, &decoder) != MA_SUCCESS) return;
 
-  constexpr ma_uint64   framesPerChunk = 4096;
-  std::vector<ma_int16> pcmBuffer(framesPerChunk * 2); // 2 = max stereo
-
   while(true)
   {
-    AwaitBufferSpace();
+    std::span<sample_t> output = AwaitBufferSpace();
 
-    if(done)
-    {
-      PadBuffer();
-      break;
-    }
+    // The supplier is being destroyed.
+    if(output.empty()) break;
 
     ma_uint64 framesRead = 0;
-    ma_result result     = ma_decoder_read_pcm_frames(&decoder, pcmBuffer.data(), framesPerChunk, &framesRead);
+    ma_result result     = ma_decoder_read_pcm_frames(&decoder, output.data(), output.size() / 2, &framesRead);
+    CommitSamples(framesRead * 2);
 
     if(result == MA_AT_END || framesRead == 0)
     {
-      AddBufferData(samples);
+      PadBuffer();
       break;
     }
-
-    size_t totalSamples = framesRead * decoder.outputChannels;
-    samples.insert(samples.end(), pcmBuffer.begin(), pcmBuffer.begin() + totalSamples);
-
-    AddBufferData(samples);
-    samples.clear();
   }
 
   ma_decoder_uninit(&decoder);
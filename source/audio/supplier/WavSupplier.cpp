@@ -21,9 +21,11 @@ this program. If not, see <https://www.gnu.org/licenses/>.
 #include <cmath>
 
 
-WavSupplier::WavSupplier(const Sound &sound, bool is3x, bool looping) :
-  AudioSupplier(is3x, looping), sound(sound), wasStarted(false)
+WavSupplier::WavSupplier(const Sound &sound, bool is3x, bool looping, size_t startSample) :
+  AudioSupplier(is3x, looping), sound(sound), wasStarted(startSample > 0), chunk(OUTPUT_CHUNK)
 {
+  // A sound that starts part of the way in counts as started, so that it ends when the buffer wraps around.
+  currentSample = startSample;
 }
 
 
@@ -31,21 +33,23 @@ size_t WavSupplier::MaxChunks() const
 {
   if(isLooping) return 2;
   else if(wasStarted && !currentSample) return 0;
-  else
-    return ceil(((is3x ? sound.Buffer3x() : sound.Buffer()).size() - currentSample) / static_cast<float>(OUTPUT_CHUNK));
+
+  // The sound is mono, but each output chunk is stereo.
+  size_t remaining = (is3x ? sound.Buffer3x() : sound.Buffer()).size() - currentSample;
+  return ceil(2 * remaining / static_cast<float>(OUTPUT_CHUNK));
 }
 
 
 size_t WavSupplier::AvailableChunks() const { return MaxChunks(); }
 
 
-std::vector<AudioSupplier::sample_t> WavSupplier::NextDataChunk()
+std::span<const AudioSupplier::sample_t> WavSupplier::NextDataChunk()
 {
-  std::vector<sample_t> samples(OUTPUT_CHUNK);
   // If we are at the beginning of the buffer and it was already played, this is a loop.
-  if(!currentSample && wasStarted && !isLooping) return samples;
+  if(!currentSample && wasStarted && !isLooping) return Silence();
 
-  size_t currentSampleCount = 0;
+  std::span<sample_t> samples            = chunk;
+  size_t              currentSampleCount = 0;
   do
   {
     // If restarting the buffer, check 3x status.
@@ -54,11 +58,18 @@ std::vector<AudioSupplier::sample_t> WavSupplier::NextDataChunk()
       is3x       = nextPlaybackIs3x;
       wasStarted = true;
     }
-    const std::vector<sample_t> &input = is3x ? sound.Buffer3x() : sound.Buffer();
-    size_t readChunk                   = std::min(input.size() - currentSample, samples.size() - currentSampleCount);
-    std::copy_n(input.begin() + currentSample, readChunk, samples.begin() + currentSampleCount);
-    currentSampleCount += readChunk;
+    std::span<const sample_t> input = is3x ? sound.Buffer3x() : sound.Buffer();
+    size_t readChunk                = std::min(input.size() - currentSample, (samples.size() - currentSampleCount) / 2);
+    // Duplicate the mono input into both stereo channels.
+    for(size_t i = 0; i < readChunk; ++i)
+    {
+      samples[currentSampleCount + 2 * i]     = input[currentSample + i];
+      samples[currentSampleCount + 2 * i + 1] = input[currentSample + i];
+    }
+    currentSampleCount += 2 * readChunk;
     currentSample       = (currentSample + readChunk) % input.size();
   } while(currentSampleCount < samples.size() && isLooping);
+  // The chunk is reused, so clear out anything left over from the last one.
+  std::fill(samples.begin() + currentSampleCount, samples.end(), 0);
   return samples;
 }
@@ -24,15 +24,18 @@ class Sound;
 class WavSupplier : public AudioSupplier
 {
 public:
-  WavSupplier(const Sound &sound, bool is3x, bool looping = false);
+  /// Plays the given sound, starting the given number of samples in.
+  WavSupplier(const Sound &sound, bool is3x, bool looping = false, size_t startSample = 0);
 
   // Inherited pure virtual methods
-  size_t                MaxChunks() const override;
-  size_t                AvailableChunks() const override;
-  std::vector<sample_t> NextDataChunk() override;
+  size_t                    MaxChunks() const override;
+  size_t                    AvailableChunks() const override;
+  std::span<const sample_t> NextDataChunk() override;
 
 
 private:
   const Sound &sound;
   bool         wasStarted;
+  /// The chunk most recently handed out by NextDataChunk().
+  std::vector<sample_t> chunk;
 };
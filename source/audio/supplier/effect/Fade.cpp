@@ -15,6 +15,11 @@ this program. If not, see <https://www.gnu.org/licenses/>.
 
 #include "Fade.h"
 
+#include <algorithm>
+
+
+Fade::Fade() : mixed(OUTPUT_CHUNK) {}
+
 
 void Fade::AddSource(std::unique_ptr<AudioSupplier> source, size_t fadePerFrame)
 {
@@ -55,13 +60,16 @@ size_t Fade::AvailableChunks() const
 }
 
 
-std::vector<AudioSupplier::sample_t> Fade::NextDataChunk()
+std::span<const AudioSupplier::sample_t> Fade::NextDataChunk()
 {
-  std::vector<sample_t> result;
+  // The previous chunk is no longer needed.
+  finishedSource.reset();
+
+  std::span<const sample_t> result;
   if(!primarySource && fadeProgress.empty())
   {
     // With no input sources, output silence.
-    result = std::vector<sample_t>(OUTPUT_CHUNK);
+    result = Silence();
   }
   else if(primarySource && fadeProgress.empty())
   {
@@ -71,42 +79,41 @@ std::vector<AudioSupplier::sample_t> Fade::NextDataChunk()
   else // fade sources
   {
     // Generate the faded background.
-    std::vector<sample_t> faded = std::get<0>(fadeProgress[0])->NextDataChunk();
+    std::span<const sample_t> background = std::get<0>(fadeProgress[0])->NextDataChunk();
+    std::ranges::copy(background, mixed.begin());
     for(size_t i = 1; i < fadeProgress.size(); ++i)
     {
-      std::vector<sample_t> other        = std::get<0>(fadeProgress[i])->NextDataChunk();
+      std::span<const sample_t> other    = std::get<0>(fadeProgress[i])->NextDataChunk();
       auto &[source, fade, fadePerFrame] = fadeProgress[i - 1];
-      CrossFade(faded, other, fade, fadePerFrame);
-      faded = std::move(other);
+      CrossFade(mixed, other, fade, fadePerFrame);
     }
 
     // Get the foreground data.
-    if(primarySource) result = primarySource->NextDataChunk();
-    else result.resize(OUTPUT_CHUNK); // silence
+    std::span<const sample_t> foreground = primarySource ? primarySource->NextDataChunk() : Silence();
 
     // The final blend.
     auto &[source, fade, fadePerFrame] = fadeProgress.back();
-    CrossFade(faded, result, fade, fadePerFrame);
+    CrossFade(mixed, foreground, fade, fadePerFrame);
+    result = mixed;
   }
 
   // Clean up the finished sources.
-  if(primarySource && !primarySource->MaxChunks()) primarySource.reset();
+  if(primarySource && !primarySource->MaxChunks()) finishedSource = std::move(primarySource);
   erase_if(fadeProgress, [](const auto &faded) { return !std::get<1>(faded) || !std::get<0>(faded)->MaxChunks(); });
 
   return result;
 }
 
 
-void Fade::CrossFade(
-    const std::vector<sample_t> &fadeOut,
-    std::vector<sample_t>       &fadeIn,
-    size_t                      &fade,
-    size_t                       fadePerFrame)
+void Fade::CrossFade(std::span<sample_t> fadeOut, std::span<const sample_t> fadeIn, size_t &fade, size_t fadePerFrame)
 {
-  for(size_t i = 0; i < fadeIn.size() && fade; ++i)
+  size_t i = 0;
+  for(; i < fadeIn.size() && fade; ++i)
   {
-    fadeIn[i] = (fadeOut[i] * fade + (fadeIn[i] * (MAX_FADE - fade))) / MAX_FADE;
+    fadeOut[i] = (fadeOut[i] * fade + (fadeIn[i] * (MAX_FADE - fade))) / MAX_FADE;
     if(fade > fadePerFrame) fade -= fadePerFrame;
     else fade = 0;
   }
+  // Once the fade is complete, only the faded-in source is left.
+  std::copy(fadeIn.begin() + i, fadeIn.end(), fadeOut.begin() + i);
 }
@@ -34,7 +34,7 @@ public:
   static constexpr size_t MAX_FADE = 65'536;
 
 public:
-  Fade() = default;
+  Fade();
 
   // Adds a new primary source, and fades out the previous primary source at the specified rate.
   void AddSource(std::unique_ptr<AudioSupplier> source, size_t fadePerFrame = 1);
@@ -42,15 +42,15 @@ public:
   void Set3x(bool is3x) override;
 
   // Inherited pure virtual methods
-  size_t                MaxChunks() const override;
-  size_t                AvailableChunks() const override;
-  std::vector<sample_t> NextDataChunk() override;
+  size_t                    MaxChunks() const override;
+  size_t                    AvailableChunks() const override;
+  std::span<const sample_t> NextDataChunk() override;
 
 
 private:
-  /// Cross-fades two sources. The faded result is stored in the fadeIn input.
+  /// Cross-fades two sources. The faded result is stored in the fadeOut input.
   static void
-  CrossFade(const std::vector<sample_t> &fadeOut, std::vector<sample_t> &fadeIn, size_t &fade, size_t fadePerFrame);
+  CrossFade(std::span<sample_t> fadeOut, std::span<const sample_t> fadeIn, size_t &fade, size_t fadePerFrame);
 
 
 private:
@@ -58,4 +58,8 @@ private:
   std::vector<std::tuple<std::unique_ptr<AudioSupplier>, size_t, size_t>> fadeProgress;
   /// The primary source; this one is not faded out by itself, but can be cross-faded with the other sources.
   std::unique_ptr<AudioSupplier> primarySource;
+  /// A finished primary source is kept alive until the next chunk, since the last chunk may still refer to its data.
+  std::unique_ptr<AudioSupplier> finishedSource;
+  /// The output chunk, if it had to be mixed from several sources.
+  std::vector<sample_t> mixed;
 };
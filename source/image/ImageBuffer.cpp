@@ -24,6 +24,7 @@ this program. If not, see <https://www.gnu.org/licenses/>.
 #include <png.h>
 
 #include <cmath>
+#include <fstream>
 #include <iostream>
 #include <memory>
 #include <set>
@@ -46,6 +47,7 @@ namespace
   const std::set<std::string> IMAGE_SEQUENCE_EXTENSIONS = AVIF_EXTENSIONS;
 
   bool ReadPNG(const std::filesystem::path &path, ImageBuffer &buffer, int frame, bool onlyDimensions);
+  bool WritePNG(const std::filesystem::path &path, const ImageBuffer &buffer, int frame);
   bool ReadJPG(const std::filesystem::path &path, ImageBuffer &buffer, int frame, bool onlyDimensions);
   int  ReadAVIF(
        const std::filesystem::path &path,
@@ -168,6 +170,14 @@ int ImageBuffer::Read(const ImageFileData &data, int frame, bool onlyDimensions)
 }
 
 
+bool ImageBuffer::Write(const std::filesystem::path &path, int frame) const
+{
+  if(!pixels || frame < 0 || frame >= frames) return false;
+
+  return WritePNG(path, *this, frame);
+}
+
+
 namespace
 {
   void ReadPNGInput(png_structp pngStruct, png_bytep outBytes, png_size_t byteCountToRead)
@@ -279,6 +289,63 @@ namespace
   }
 
 
+  void WritePNGOutput(png_structp pngStruct, png_bytep bytes, png_size_t byteCount)
+  {
+    static_cast<std::ostream *>(png_get_io_ptr(pngStruct))->write(reinterpret_cast<const char *>(bytes), byteCount);
+  }
+
+
+  void FlushPNGOutput(png_structp pngStruct) { static_cast<std::ostream *>(png_get_io_ptr(pngStruct))->flush(); }
+
+
+  bool WritePNG(const std::filesystem::path &path, const ImageBuffer &buffer, int frame)
+  {
+    // Files::Open() writes text files, which would mangle the image on some platforms.
+    std::ofstream file(path, std::ios::out | std::ios::binary);
+    if(!file) return false;
+
+    png_struct *png = png_create_write_struct(PNG_LIBPNG_VER_STRING, nullptr, nullptr, nullptr);
+    if(!png) return false;
+
+    png_info *info = png_create_info_struct(png);
+    if(!info)
+    {
+      png_destroy_write_struct(&png, nullptr);
+      return false;
+    }
+
+    if(setjmp(png_jmpbuf(png)))
+    {
+      png_destroy_write_struct(&png, &info);
+      return false;
+    }
+
+    png_set_write_fn(png, &file, WritePNGOutput, FlushPNGOutput);
+    png_set_IHDR(
+        png,
+        info,
+        buffer.Width(),
+        buffer.Height(),
+        8,
+        PNG_COLOR_TYPE_RGB_ALPHA,
+        PNG_INTERLACE_NONE,
+        PNG_COMPRESSION_TYPE_DEFAULT,
+        PNG_FILTER_TYPE_DEFAULT);
+    png_write_info(png, info);
+
+    std::vector<png_byte *> rows(buffer.Height(), nullptr);
+    for(int y = 0; y < buffer.Height(); ++y)
+      rows[y] = const_cast<png_byte *>(reinterpret_cast<const png_byte *>(buffer.Begin(y, frame)));
+
+    png_write_image(png, &rows.front());
+    png_write_end(png, nullptr);
+
+    png_destroy_write_struct(&png, &info);
+
+    return file.good();
+  }
+
+
   bool ReadJPG(const std::filesystem::path &path, ImageBuffer &buffer, int frame, bool onlyDimensions)
   {
     std::string data = Files::Read(path);
@@ -16,6 +16,7 @@ this program. If not, see <https://www.gnu.org/licenses/>.
 #pragma once
 
 #include <cstdint>
+#include <filesystem>
 #include <set>
 #include <string>
 #include <vector>
@@ -71,6 +72,8 @@ public:
   // If the file is an image sequence, it overwrites the preconfigured
   // frame count with the number of frames found in the file.
   int Read(const ImageFileData &data, int frame = 0, bool onlyDimensions = false);
+  // Write a frame to a PNG file. Return false if that fails.
+  bool Write(const std::filesystem::path &path, int frame = 0) const;
 
 
 private:
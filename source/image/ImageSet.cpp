@@ -184,6 +184,23 @@ void ImageSet::Load() noexcept(false)
 {
   assert(framePaths[0].empty() && "should call ValidateFrames before calling Load");
 
+  // Check whether we need to generate collision masks.
+  Read(IsMasked(name), false);
+
+  // Warn about a "high-profile" image that will be blurry due to rendering at 50% scale.
+  bool willBlur = (buffer[0].Width() & 1) || (buffer[0].Height() & 1);
+  if(willBlur && (name.starts_with("ship/") || name.starts_with("outfit/") || name.starts_with("thumbnail/")))
+  {
+    Logger::Log(
+        "Image \"" + name + "\" will be blurry since width and/or height are not even (" +
+            std::to_string(buffer[0].Width()) + "x" + std::to_string(buffer[0].Height()) + ").",
+        Logger::Level::WARNING);
+  }
+}
+
+
+void ImageSet::Read(bool makeMasks, bool reduced) noexcept(false)
+{
   // Determine how many frames there will be, total. The image buffers will
   // not actually be allocated until the first image is loaded (at which point
   // the sprite's dimensions will be known).
@@ -201,9 +218,6 @@ void ImageSet::Load() noexcept(false)
     swizzleMaskFrames = 1;
   }
 
-  // Check whether we need to generate collision masks.
-  bool makeMasks = IsMasked(name);
-
   const auto UpdateFrameCount = [&]()
   {
     buffer[1].Clear(frames);
@@ -255,18 +269,21 @@ void ImageSet::Load() noexcept(false)
   };
   // Now, load the mask and 2x sprites, if they exist. Because the number of 1x frames
   // is definitive, don't load any frames beyond the size of the 1x list.
-  LoadSprites(paths[1], buffer[1], "@2x");
-  LoadSprites(paths[2], buffer[2], "mask");
-  LoadSprites(paths[3], buffer[3], "@2x mask");
-
-  // Warn about a "high-profile" image that will be blurry due to rendering at 50% scale.
-  bool willBlur = (buffer[0].Width() & 1) || (buffer[0].Height() & 1);
-  if(willBlur && (name.starts_with("ship/") || name.starts_with("outfit/") || name.starts_with("thumbnail/")))
+  // A reduced sprite skips its 2x frames, or shrinks its 1x frames if there are no 2x frames.
+  isReduced = reduced;
+  if(!reduced)
   {
-    Logger::Log(
-        "Image \"" + name + "\" will be blurry since width and/or height are not even (" +
-            std::to_string(buffer[0].Width()) + "x" + std::to_string(buffer[0].Height()) + ").",
-        Logger::Level::WARNING);
+    LoadSprites(paths[1], buffer[1], "@2x");
+    LoadSprites(paths[2], buffer[2], "mask");
+    LoadSprites(paths[3], buffer[3], "@2x mask");
+  }
+  else {
+    LoadSprites(paths[2], buffer[2], "mask");
+    if(paths[1].empty())
+    {
+      if(buffer[0].Pixels()) buffer[0].ShrinkToHalfSize();
+      if(buffer[2].Pixels()) buffer[2].ShrinkToHalfSize();
+    }
   }
 }
 
@@ -309,4 +326,22 @@ void ImageSet::Upload(Sprite *sprite, bool enableUpload)
 
   GameData::GetMaskManager().SetMasks(sprite, std::move(masks));
   masks.clear();
+  sprite->SetReduced(false);
+}
+
+
+void ImageSet::LoadTextures(bool reduced) noexcept(false)
+{
+  assert(framePaths[0].empty() && "should call ValidateFrames before calling LoadTextures");
+
+  Read(false, reduced);
+}
+
+
+void ImageSet::UploadTextures(Sprite *sprite)
+{
+  // The collision masks of the sprite are left as they are.
+  sprite->AddFrames(buffer[0], buffer[1], noReduction);
+  sprite->AddSwizzleMaskFrames(buffer[2], buffer[3], noReduction);
+  sprite->SetReduced(isReduced);
 }
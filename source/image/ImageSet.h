@@ -68,6 +68,18 @@ public:
   // the paths are saved in case the sprite needs to be loaded again.
   void Upload(Sprite *sprite, bool enableUpload);
 
+  // Load the frames of a sprite that is already loaded, without creating any masks, so that
+  // its textures can be replaced. A reduced sprite uses only its 1x frames, or its 1x frames
+  // at half size if it has no 2x frames.
+  void LoadTextures(bool reduced) noexcept(false);
+  // Upload the frames from LoadTextures() into the given sprite, which should not be in use yet.
+  void UploadTextures(Sprite *sprite);
+
+
+private:
+  // Read the frames of this image set, optionally creating collision masks.
+  void Read(bool makeMasks, bool reduced) noexcept(false);
+
 
 private:
   // Name of the sprite that will be initialized with these images.
@@ -80,4 +92,5 @@ private:
   ImageBuffer       buffer[4];
   std::vector<Mask> masks;
   bool              noReduction = false;
+  bool              isReduced   = false;
 };
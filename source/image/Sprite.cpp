@@ -21,11 +21,13 @@ this program. If not, see <https://www.gnu.org/licenses/>.
 #include "../Preferences.h"
 #include "../Screen.h"
 #include "ImageBuffer.h"
+#include "SpriteLoadManager.h"
 
 
 namespace
 {
-  void AddBuffer(
+  // Upload the given buffer, returning the memory its texture takes up.
+  size_t AddBuffer(
       ImageBuffer                   &buffer,
       graphics_layer::TextureHandle &target,
       const bool                     noReduction,
@@ -51,9 +53,12 @@ namespace
         GraphicsTypes::ImageFormat::RGBA,
         GraphicsTypes::TextureTarget::READ);
     target.CreateMipMaps();
+    // The mipmaps add another third to the size of the full texture.
+    const size_t memory = static_cast<size_t>(buffer.Width()) * buffer.Height() * buffer.Frames() * 4 * 4 / 3;
 
     // Free the ImageBuffer memory.
     buffer.Clear();
+    return memory;
   }
 } // namespace
 
@@ -88,11 +93,11 @@ void Sprite::AddFrames(ImageBuffer &buffer1x, ImageBuffer &buffer2x, bool noRedu
   // Only use the 2x resolution image if it is provided.
   if(buffer2x.Pixels())
   {
-    AddBuffer(buffer2x, texture, noReduction, name);
+    memory += AddBuffer(buffer2x, texture, noReduction, name);
     buffer1x.Clear();
   }
   else {
-    AddBuffer(buffer1x, texture, noReduction, name);
+    memory += AddBuffer(buffer1x, texture, noReduction, name);
   }
 }
 
@@ -112,11 +117,11 @@ void Sprite::AddSwizzleMaskFrames(ImageBuffer &buffer1x, ImageBuffer &buffer2x,
   // Only use the 2x resolution image if it is provided.
   if(buffer2x.Pixels())
   {
-    AddBuffer(buffer2x, swizzleMask, noReduction, name + "-sw");
+    memory += AddBuffer(buffer2x, swizzleMask, noReduction, name + "-sw");
     buffer1x.Clear();
   }
   else {
-    AddBuffer(buffer1x, swizzleMask, noReduction, name + "-sw");
+    memory += AddBuffer(buffer1x, swizzleMask, noReduction, name + "-sw");
   }
 }
 
@@ -130,12 +135,39 @@ void Sprite::Unload()
   texture     = graphics_layer::TextureHandle();
   swizzleMask = graphics_layer::TextureHandle();
 
-  width  = 0.f;
-  height = 0.f;
-  frames = 0;
+  width     = 0.f;
+  height    = 0.f;
+  frames    = 0;
+  memory    = 0;
+  isReduced = false;
 }
 
 
+// Exchange the textures of this sprite with those of the given one.
+void Sprite::SwapTextures(Sprite &other)
+{
+  std::swap(texture, other.texture);
+  std::swap(swizzleMask, other.swizzleMask);
+  std::swap(memory, other.memory);
+  std::swap(isReduced, other.isReduced);
+}
+
+
+bool Sprite::IsReduced() const { return isReduced; }
+
+
+void Sprite::SetReduced(bool reduced) { isReduced = reduced; }
+
+
+size_t Sprite::Memory() const { return memory; }
+
+
+int Sprite::LastUse() const { return lastUse; }
+
+
+void Sprite::MarkUsed() const { lastUse = SpriteLoadManager::Frame(); }
+
+
 // Get the width, in pixels, of the 1x image.
 float Sprite::Width() const { return width; }
 
@@ -151,7 +183,11 @@ int Sprite::Frames() const { return frames; }
 int Sprite::SwizzleMaskFrames() const { return swizzleMaskFrames; }
 
 // Get the texture index, based on whether the screen is high DPI or not.
-const graphics_layer::TextureHandle &Sprite::Texture() const { return texture; }
+const graphics_layer::TextureHandle &Sprite::Texture() const
+{
+  MarkUsed();
+  return texture;
+}
 
 
 // Get the offset of the center from the top left corner; this is for easy
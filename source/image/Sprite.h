@@ -17,6 +17,8 @@ this program. If not, see <https://www.gnu.org/licenses/>.
 
 #include "../Point.h"
 
+#include <atomic>
+#include <cstddef>
 #include <string>
 
 #include "graphics/graphics_layer.h"
@@ -51,6 +53,18 @@ public:
   bool IsLoaded() const;
   // Free up all textures loaded for this sprite.
   void Unload();
+  // Exchange the textures of this sprite with those of the given one, which must have
+  // been created from the same images. The dimensions of this sprite are not changed.
+  void SwapTextures(Sprite &other);
+  // Whether this sprite currently uses reduced textures to save memory.
+  bool IsReduced() const;
+  void SetReduced(bool reduced);
+  // The memory taken up by the textures of this sprite, in bytes.
+  size_t Memory() const;
+  // The frame of the SpriteLoadManager in which the texture of this sprite was last asked for.
+  int LastUse() const;
+  // Mark this sprite as being used in the current frame.
+  void MarkUsed() const;
 
   // Image dimensions, in pixels.
   float Width() const;
@@ -76,7 +90,11 @@ private:
 
   graphics_layer::TextureHandle texture     = {};
   graphics_layer::TextureHandle swizzleMask = {};
-  bool                          isLoaded       = false;
+  bool                          isLoaded    = false;
+  bool                          isReduced   = false;
+  size_t                        memory      = 0;
+  // This is updated by both the main and the calculation thread.
+  mutable std::atomic<int> lastUse = 0;
 
   float width             = 0.f;
   float height            = 0.f;
@@ -15,16 +15,27 @@ this program. If not, see <https://www.gnu.org/licenses/>.
 
 #include "SpriteLoadManager.h"
 
+#include "../Fleet.h"
+#include "../Outfit.h"
+#include "../Planet.h"
 #include "../Preferences.h"
+#include "../RandomEvent.h"
+#include "../Ship.h"
+#include "../StellarObject.h"
+#include "../System.h"
 #include "../TaskQueue.h"
+#include "../Variant.h"
 #include "ImageSet.h"
 #include "Sprite.h"
 #include "SpriteSet.h"
 
+#include <algorithm>
 #include <atomic>
+#include <deque>
 #include <map>
 #include <queue>
 #include <set>
+#include <vector>
 
 using namespace std;
 
@@ -64,6 +75,29 @@ namespace
   bool recheckThumbnails     = false;
   bool recheckStellarObjects = false;
 
+  // The root folders of the sprites that always stay loaded, but whose textures may be
+  // reduced when they exceed the memory budget and haven't been drawn in a while.
+  const set<string> STREAMED_FOLDERS = {"ship", "outfit", "effect", "projectile"};
+  // How often the memory budget is checked, in frames. A reduced sprite gets its full
+  // textures back if it was drawn within the last RESTORE_FRAMES, but a full sprite
+  // is only reduced once it has gone undrawn for much longer, so that sprites that
+  // are drawn on and off don't keep switching between their textures.
+  const int CHECK_INTERVAL = 60;
+  const int RESTORE_FRAMES = 120;
+  const int REDUCE_FRAMES  = 1800;
+  // Replaced textures may still be referred to by draw lists that were filled
+  // in the previous frames, so they are only freed after this many frames.
+  const int RETIRE_FRAMES = 3;
+
+  atomic<int>                                currentFrame = 0;
+  map<Sprite *, shared_ptr<ImageSet>>        streamed;
+  set<const Sprite *>                        reloading;
+  vector<pair<Sprite *, unique_ptr<Sprite>>> reloaded;
+  deque<pair<int, unique_ptr<Sprite>>>       retired;
+  // The sprites of the ships that may be encountered after the next jump. These are
+  // never reduced until the player has arrived in another system.
+  set<const Sprite *> prefetched;
+
   // Determine whether the given path or name is for a sprite whose loading
   // should be deferred until needed.
   bool IsDeferredFolder(const filesystem::path &path)
@@ -142,6 +176,8 @@ void SpriteLoadManager::Init(TaskQueue &queue, map<string, shared_ptr<ImageSet>>
     imageSet->ValidateFrames();
     // Keep track of which images should use deferred loading.
     if(IsDeferredFolder(name)) deferred[SpriteSet::Get(name)] = imageSet;
+    else if(STREAMED_FOLDERS.contains(filesystem::path(name).begin()->string()))
+      streamed[SpriteSet::Modify(name)] = imageSet;
     lock_guard lock(imageQueueMutex);
     imageQueue.push(std::move(imageSet));
     ++totalSprites;
@@ -235,6 +271,97 @@ void SpriteLoadManager::CullOldImages(TaskQueue &queue)
 }
 
 
+void SpriteLoadManager::UpdateResidency(TaskQueue &queue)
+{
+  if(preventSpriteUpload) return;
+  const int frame = ++currentFrame;
+
+  // Free the replaced textures that no draw list can refer to anymore.
+  while(!retired.empty() && frame - retired.front().first > RETIRE_FRAMES)
+    retired.pop_front();
+  // Swap in the textures that have finished loading. This can only be done while no
+  // draw list is being filled, because the calculation thread reads the textures.
+  for(auto &[sprite, replacement] : reloaded)
+  {
+    sprite->SwapTextures(*replacement);
+    reloading.erase(sprite);
+    retired.emplace_back(frame, std::move(replacement));
+  }
+  reloaded.clear();
+
+  // Wait until all sprites have been loaded for the first time.
+  if(frame % CHECK_INTERVAL || spritesLoaded < totalSprites) return;
+
+  // Sprites that are being drawn always get their full textures back.
+  size_t           total = 0;
+  vector<Sprite *> unused;
+  for(const auto &[sprite, image] : streamed)
+  {
+    total += sprite->Memory();
+    if(!sprite->Memory() || reloading.contains(sprite)) continue;
+
+    const bool isPrefetched = prefetched.contains(sprite);
+    const int  unusedFrames = frame - sprite->LastUse();
+    if(sprite->IsReduced() && (isPrefetched || unusedFrames < RESTORE_FRAMES))
+      ReloadTextures(queue, sprite, image, false);
+    else if(!sprite->IsReduced() && !isPrefetched && unusedFrames >= REDUCE_FRAMES) unused.push_back(sprite);
+  }
+  const size_t budget = Preferences::TextureBudget();
+  if(!budget || total <= budget) return;
+
+  // Reduce the sprites that have gone undrawn the longest, until the rest fit in the budget.
+  sort(unused.begin(), unused.end(), [](const Sprite *a, const Sprite *b) { return a->LastUse() < b->LastUse(); });
+  for(Sprite *sprite : unused)
+  {
+    if(total <= budget) break;
+    // A reduced texture has a quarter of the pixels of the full one.
+    total -= sprite->Memory() * 3 / 4;
+    ReloadTextures(queue, sprite, streamed[sprite], true);
+  }
+}
+
+
+int SpriteLoadManager::Frame() { return currentFrame; }
+
+
+void SpriteLoadManager::Prefetch(TaskQueue &queue, const set<const System *> &systems)
+{
+  // The sprites prefetched for the previous jump are no longer pinned, but the ones that
+  // haven't been drawn since then get the usual time before they may be reduced again.
+  for(const Sprite *sprite : prefetched)
+    sprite->MarkUsed();
+  prefetched.clear();
+
+  // Pinned sprites are restored by the next call to UpdateResidency() if they are reduced.
+  auto PinShip = [&queue](const Ship *ship) -> void
+  {
+    if(ship->HasSprite()) prefetched.insert(ship->GetSprite());
+    LoadDeferred(queue, ship->Thumbnail());
+  };
+
+  for(const System *system : systems)
+  {
+    for(const RandomEvent<Fleet> &fleet : system->Fleets())
+      for(const Variant &variant : fleet.Get()->Variants())
+        for(const Ship *ship : variant.Ships())
+          PinShip(ship);
+
+    for(const StellarObject &object : system->Objects())
+    {
+      if(!object.HasValidPlanet()) continue;
+
+      const Planet &planet = *object.GetPlanet();
+      if(planet.HasShipyard())
+        for(const Ship *ship : planet.ShipyardStock())
+          PinShip(ship);
+      if(planet.HasOutfitter())
+        for(const Outfit *outfit : planet.OutfitterStock())
+          LoadDeferred(queue, outfit->Thumbnail());
+    }
+  }
+}
+
+
 void SpriteLoadManager::SetRecheckThumbnails() { recheckThumbnails = true; }
 
 
@@ -328,3 +455,20 @@ void SpriteLoadManager::LoadScene(TaskQueue &queue, const Sprite *sprite, const
 
   LoadSprite(queue, image);
 }
+
+
+void SpriteLoadManager::ReloadTextures(
+    TaskQueue &queue, Sprite *sprite, const shared_ptr<ImageSet> &image, bool reduced)
+{
+  reloading.insert(sprite);
+  // The new textures are uploaded into a separate sprite, and only swapped into
+  // the real one by UpdateResidency().
+  queue.Run(
+      [image, reduced] { image->LoadTextures(reduced); },
+      [image, sprite]
+      {
+        auto replacement = make_unique<Sprite>(sprite->Name());
+        image->UploadTextures(replacement.get());
+        reloaded.emplace_back(sprite, std::move(replacement));
+      });
+}
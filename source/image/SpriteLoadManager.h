@@ -17,6 +17,7 @@ this program. If not, see <https://www.gnu.org/licenses/>.
 
 #include <map>
 #include <memory>
+#include <set>
 #include <string>
 
 class ImageSet;
@@ -47,6 +48,17 @@ public:
   // Cull old stellar objects and thumbnails that haven't been seen in a while.
   static void CullOldImages(TaskQueue &queue);
 
+  // The sprites of ships, outfits, and effects stay loaded, but are reduced to their 1x or
+  // half size textures while they are not drawn and their textures exceed the memory budget.
+  // This should be called once per frame while the calculation thread is not running.
+  static void UpdateResidency(TaskQueue &queue);
+  // The frame of the last call to UpdateResidency(), for tracking when each sprite was used.
+  static int Frame();
+  // Make sure that the ships and outfits that may be encountered in the given systems
+  // are fully loaded by the time the player gets there. Their sprites are kept in full
+  // until this is called again after the next jump.
+  static void Prefetch(TaskQueue &queue, const std::set<const System *> &systems);
+
   // Changes can be made by missions or events that cause new assets to appear.
   // When this happens, a class can signal to the SpriteLoadManager than a panel
   // needs to re-request that sprites be loaded.
@@ -66,4 +78,6 @@ private:
   static void LoadThumbnail(TaskQueue &queue, const Sprite *sprite, const std::shared_ptr<ImageSet> &image);
   // Load a starting scenario, conversation, or logbook scene.
   static void LoadScene(TaskQueue &queue, const Sprite *sprite, const std::shared_ptr<ImageSet> &image);
+  // Reload a sprite that is kept loaded, with either its full or its reduced textures.
+  static void ReloadTextures(TaskQueue &queue, Sprite *sprite, const std::shared_ptr<ImageSet> &image, bool reduced);
 };
@@ -46,7 +46,7 @@ Sprite *SpriteSet::Modify(const std::string &name)
   std::lock_guard<std::mutex> guard(modifyMutex);
 
   auto it = sprites.find(name);
-  if(it == sprites.end()) it = sprites.emplace(name, Sprite(name)).first;
+  if(it == sprites.end()) it = sprites.try_emplace(name, name).first;
   return &it->second;
 }
 
@@ -36,6 +36,7 @@ this program. If not, see <https://www.gnu.org/licenses/>.
 #include "Plugins.h"
 #include "Preferences.h"
 #include "PrintData.h"
+#include "RenderBenchmark.h"
 #include "Screen.h"
 #include "TaskQueue.h"
 #include "UI.h"
@@ -89,7 +90,10 @@ void GameLoop(
     TaskQueue          &queue,
     const Conversation &conversation,
     const std::string  &testToRun,
-    bool                debugMode);
+    bool                debugMode,
+    RenderBenchmark    *benchmark);
+bool         StartFrame(UI &panels);
+void         FinishFrame();
 Conversation LoadConversation(const PlayerInfo &player);
 void         PrintTestsTable();
 
@@ -110,7 +114,9 @@ int main(int argc, char *argv[])
   bool         printTests  = false;
   bool         printData   = false;
   bool         noTestMute  = false;
+  bool         benchmark   = false;
   std::string  testToRunName;
+  std::string  dumpDirectory;
 
   // Whether the game has encountered errors while loading.
   bool hasErrors = false;
@@ -163,6 +169,15 @@ int main(int argc, char *argv[])
     {
       noTestMute = true;
     }
+    else if(arg == "--render-benchmark" && *++it)
+    {
+      testToRunName = *it;
+      benchmark     = true;
+    }
+    else if(arg == "--dump-frames" && *++it)
+    {
+      dumpDirectory = *it;
+    }
   }
   printData = PrintData::IsPrintDataArgument(argv);
   Files::Init(argv);
@@ -187,7 +202,7 @@ int main(int argc, char *argv[])
         player,
         isConsoleOnly,
         debugMode,
-        isConsoleOnly || checkAssets || (isTesting && !debugMode));
+        isConsoleOnly || checkAssets || (isTesting && !debugMode && !benchmark));
 
     // If we are not using the UI, or performing some automated task, we should load
     // all data now.
@@ -247,7 +262,8 @@ int main(int argc, char *argv[])
     for(const DataNode &node : globalConditions)
       if(node.Token(0) == "conditions") GameData::GlobalConditions().Load(node);
 
-    if(!GameWindow::Init(isTesting && !debugMode)) return 1;
+    // Render benchmarks draw offscreen, so that they can run without a display.
+    if(!GameWindow::Init(isTesting && !debugMode, benchmark)) return 1;
 
     GameData::LoadSettings();
 
@@ -255,7 +271,7 @@ int main(int argc, char *argv[])
     TimerResolutionGuard windowsTimerGuard;
 #endif
 
-    if(!isTesting || debugMode)
+    if(!isTesting || debugMode || benchmark)
     {
       GameData::LoadShaders();
 
@@ -269,7 +285,13 @@ int main(int argc, char *argv[])
 
     CustomEvents::Init();
     // This is the main loop where all the action begins.
-    GameLoop(player, queue, conversation, testToRunName, debugMode);
+    if(benchmark)
+    {
+      RenderBenchmark renderBenchmark(dumpDirectory);
+      GameLoop(player, queue, conversation, testToRunName, debugMode, &renderBenchmark);
+      renderBenchmark.Print(std::cout);
+    }
+    else GameLoop(player, queue, conversation, testToRunName, debugMode, nullptr);
   }
   catch(Test::known_failure_tag)
   {
@@ -302,7 +324,8 @@ void GameLoop(
     TaskQueue          &queue,
     const Conversation &conversation,
     const std::string  &testToRunName,
-    bool                debugMode)
+    bool                debugMode,
+    RenderBenchmark    *benchmark)
 {
   // gamePanels is used for the main panel where you fly your spaceship.
   // All other game content related dialogs are placed on top of the gamePanels.
@@ -415,15 +438,32 @@ void GameLoop(
     std::chrono::steady_clock::duration gpuLoadSum{};
     std::string                         gpuLoadString;
     std::string                         memoryString;
+    std::string                         scratchString;
     bool                                isPerformanceDisplayReady = false;
     int                                 step                      = 0;
     int                                 drawStep                  = 0;
 
+    // When frames are interpolated, they are drawn as often as the display
+    // refreshes, and the game only steps forward whenever the frame timer is due.
+    FrameTimer renderTimer(GameWindow::RefreshRate());
+
     std::chrono::steady_clock::time_point base_start = std::chrono::steady_clock::now();
     while(!menuPanels.IsDone())
     {
-      if(++step == 60) step = 0;
-      if(toggleTimeout) --toggleTimeout;
+      // Fast-forward already draws fewer frames than the game steps, so it is never interpolated.
+      const bool interpolate = Preferences::Has("Interpolate frames") && !isFastForward;
+      // If the calculation thread is still busy with the last step, keep drawing
+      // frames and step forward once it is done, rather than waiting for it.
+      auto      *rootPanel     = static_cast<MainPanel *>(gamePanels.Root().get());
+      const bool isCalculating = interpolate && rootPanel && !rootPanel->GetEngine().IsCalculationDone();
+      const bool isStepping    = !interpolate || (!isCalculating && timer.IsDue());
+
+      if(isStepping)
+      {
+        if(++step == 60) step = 0;
+        if(toggleTimeout) --toggleTimeout;
+        ++cursorTime;
+      }
       std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
 
       if(!isFastForward || step % 3 == 0)
@@ -437,7 +477,6 @@ void GameLoop(
       // In full-screen mode, hide the cursor if inactive for ten seconds,
       // but only if the player is flying around in the main view.
       const bool inFlight = (menuPanels.IsEmpty() && gamePanels.Root() == gamePanels.Top());
-      ++cursorTime;
       const bool shouldShowCursor = (!GameWindow::IsFullscreen() || cursorTime < 600 || !inFlight);
       if(shouldShowCursor != showCursor)
       {
@@ -453,69 +492,53 @@ void GameLoop(
       if(Preferences::Has("Interrupt fast-forward") && !inFlight && isFastForward && !allowFastForward)
         isFastForward = false;
 
-      // Tell all the panels to step forward, then draw them.
-      (!isDebugPaused && menuPanels.IsEmpty() ? gamePanels : menuPanels).StepAll();
-
-      // Caps lock slows the frame rate in debug mode.
-      // Slowing eases in and out over a couple of frames.
-      if(mod & SDL_KMOD_CAPS && inFlight && debugMode)
+      if(isStepping)
       {
-        if(frameRate > 10)
-        {
-          frameRate = std::max(frameRate - 5, 10);
-          timer.SetFrameRate(frameRate);
-        }
-      }
-      else {
-        if(frameRate < 60)
+        // Any preferences changed by this frame's events apply from here on.
+        Preferences::PublishSnapshot();
+
+        // Tell all the panels to step forward, then draw them.
+        (!isDebugPaused && menuPanels.IsEmpty() ? gamePanels : menuPanels).StepAll();
+
+        // Caps lock slows the frame rate in debug mode.
+        // Slowing eases in and out over a couple of frames.
+        if(mod & SDL_KMOD_CAPS && inFlight && debugMode)
         {
-          frameRate = std::min(frameRate + 5, 60);
-          timer.SetFrameRate(frameRate);
+          if(frameRate > 10)
+          {
+            frameRate = std::max(frameRate - 5, 10);
+            timer.SetFrameRate(frameRate);
+          }
         }
+        else {
+          if(frameRate < 60)
+          {
+            frameRate = std::min(frameRate + 5, 60);
+            timer.SetFrameRate(frameRate);
+          }
 
-        if(isFastForward && inFlight && step % 3)
-        {
-          cpuLoadSum += std::chrono::steady_clock::now() - start;
-          continue;
+          if(isFastForward && inFlight && step % 3)
+          {
+            cpuLoadSum += std::chrono::steady_clock::now() - start;
+            continue;
+          }
         }
+
+        Audio::Step(isFastForward);
       }
 
-      Audio::Step(isFastForward);
+      // Only the flight view moves in between steps; anything else is drawn as it was in the last one.
+      MainPanel *mainPanel = static_cast<MainPanel *>(gamePanels.Root().get());
+      if(mainPanel) mainPanel->GetEngine().SetDrawProgress(interpolate && inFlight ? timer.Progress() : 1.);
 
       cpuLoadSum += std::chrono::steady_clock::now() - start;
       ++drawStep;
       std::chrono::steady_clock::time_point drawStart = std::chrono::steady_clock::now();
 
-      if(GameWindow::GetInstance()->StartDraw(Screen::Width(), Screen::Height()))
+      // Events in this frame may have cleared out the menu, in which case
+      // we should draw the game panels instead:
+      if(StartFrame(menuPanels.IsEmpty() ? gamePanels : menuPanels))
       {
-        GraphicsTypes::RenderState state;
-        state.DepthTest                = false;
-        state.Blending.BlendingEnabled = true;
-        state.Blending.SRCAlpha        = GraphicsTypes::BlendFactor::FACTOR_ONE;
-        state.Blending.DSTAlpha        = GraphicsTypes::BlendFactor::FACTOR_ONE_MINUS_SRC_ALPHA;
-        state.Blending.SRCColor        = GraphicsTypes::BlendFactor::FACTOR_ONE;
-        state.Blending.DSTColor        = GraphicsTypes::BlendFactor::FACTOR_ONE_MINUS_SRC_ALPHA;
-        state.ClearColor               = GraphicsTypes::Color{0.f, 0.f, 0.f, 0.f};
-        GameWindow::GetInstance()->SetState(state);
-
-        (menuPanels.IsEmpty() ? gamePanels : menuPanels).PreDrawAll();
-
-        GameWindow::GetInstance()->StartMainRenderPass();
-
-        SpriteShader::Bind();
-        ShaderInfo::CommonUniformBufferData cm_data;
-#ifdef __APPLE__
-        cm_data.scale = {2.f / Screen::Width(), -2.f / Screen::Height()};
-#else
-        cm_data.scale = {-2.f / Screen::Width(), -2.f / Screen::Height()};
-#endif
-        GameWindow::GetInstance()->SetCommonUniforms(cm_data);
-
-        // Events in this frame may have cleared out the menu, in which case
-        // we should draw the game panels instead:
-        (menuPanels.IsEmpty() ? gamePanels : menuPanels).DrawAll();
-
-        MainPanel *mainPanel = static_cast<MainPanel *>(gamePanels.Root().get());
         if(mainPanel && mainPanel->GetEngine().IsPaused())
           SpriteShader::Draw(SpriteSet::Get("ui/paused"), Screen::TopLeft() + Point(10., 10.));
         else if(isFastForward)
@@ -528,6 +551,7 @@ void GameLoop(
           performanceInfo.SetString("cpu", cpuLoadString);
           performanceInfo.SetString("gpu", gpuLoadString);
           performanceInfo.SetString("mem", memoryString);
+          performanceInfo.SetString("scratch", scratchString);
           if(isPerformanceDisplayReady) performanceInfo.SetCondition("ready");
           static const Interface &performanceDisplay = *GameData::Interfaces().Get("performance info");
           performanceDisplay.Draw(performanceInfo);
@@ -566,6 +590,14 @@ void GameLoop(
 #endif
             // bytes / (1024 * 1024) = megabytes
             memoryString              = "MEM: " + Format::Number(virtualMemoryUse / 1048576., 2, false) + " MB";
+            // How much memory the last game step needed for its temporary data, which is
+            // reused from one step to the next instead of being allocated each time.
+            if(mainPanel)
+            {
+              const Engine &engine = mainPanel->GetEngine();
+              scratchString = "TMP: " + Format::Number(engine.ScratchBytes() / 1024., 1, false) + " KB (" +
+                              Format::Number(static_cast<int64_t>(engine.ScratchAllocations())) + ")";
+            }
             isPerformanceDisplayReady = true;
           }
         }
@@ -577,8 +609,7 @@ void GameLoop(
           isPerformanceDisplayReady = false;
         }
 
-        GameWindow::GetInstance()->EndRenderPass();
-        GameWindow::GetInstance()->EndDraw(Screen::Width(), Screen::Height());
+        FinishFrame();
         gpuLoadSum += std::chrono::steady_clock::now() - drawStart;
 
         Logger::Log(std::to_string((std::chrono::steady_clock::now() - base_start).count() / 1e6), Logger::Level::INFO);
@@ -587,8 +618,14 @@ void GameLoop(
 
       GameWindow::Step();
 
-      // Lock the game loop to 60 FPS.
-      timer.Wait();
+      // Lock the game loop to 60 FPS, or to the refresh rate of the display if
+      // the frames in between steps are interpolated.
+      if(interpolate)
+      {
+        renderTimer.SetFrameRate(GameWindow::RefreshRate());
+        renderTimer.Wait();
+      }
+      else timer.Wait();
 
       // If the player ended this frame in-game, count the elapsed time as played time.
       if(menuPanels.IsEmpty()) player.AddPlayTime(std::chrono::steady_clock::now() - start);
@@ -629,16 +666,27 @@ void GameLoop(
         }
       }
 
+      Preferences::PublishSnapshot();
+
       // Tell all the panels to step forward, then draw them.
       (menuPanels.IsEmpty() ? gamePanels : menuPanels).StepAll();
 
-      if(!isHeadless)
+      if(benchmark)
+      {
+        // Draw every step, as quickly as possible.
+        if(StartFrame(menuPanels.IsEmpty() ? gamePanels : menuPanels))
+        {
+          FinishFrame();
+          benchmark->Add(*GameWindow::GetInstance());
+        }
+      }
+      else if(!isHeadless)
       {
         Audio::Step(isFastForward);
 
         // Events in this frame may have cleared out the menu, in which case
         // we should draw the game panels instead:
-        (menuPanels.IsEmpty() ? gamePanels : menuPanels).DrawAll();
+        if(StartFrame(menuPanels.IsEmpty() ? gamePanels : menuPanels)) FinishFrame();
 
         GameWindow::Step();
 
@@ -654,6 +702,41 @@ void GameLoop(
 }
 
 
+// Begin drawing a frame to the screen, and draw the given panels into it.
+// Returns false if there is nothing to draw to right now.
+bool StartFrame(UI &panels)
+{
+  GraphicsTypes::GraphicsInstance *instance = GameWindow::GetInstance();
+  if(!instance->StartDraw(Screen::Width(), Screen::Height())) return false;
+
+  instance->SetState(GameWindow::ScreenState());
+
+  panels.PreDrawAll();
+
+  instance->StartMainRenderPass();
+
+  SpriteShader::Bind();
+  ShaderInfo::CommonUniformBufferData cm_data;
+#ifdef __APPLE__
+  cm_data.scale = {2.f / Screen::Width(), -2.f / Screen::Height()};
+#else
+  cm_data.scale = {-2.f / Screen::Width(), -2.f / Screen::Height()};
+#endif
+  instance->SetCommonUniforms(cm_data);
+
+  panels.DrawAll();
+  return true;
+}
+
+
+// Submit the frame begun by StartFrame(), after anything else was drawn on top of the panels.
+void FinishFrame()
+{
+  GameWindow::GetInstance()->EndRenderPass();
+  GameWindow::GetInstance()->EndDraw(Screen::Width(), Screen::Height());
+}
+
+
 void PrintHelp()
 {
   std::cerr << std::endl;
@@ -672,6 +755,10 @@ void PrintHelp()
   std::cerr << "    --tests: print table of available tests, then exit." << std::endl;
   std::cerr << "    --test <name>: run given test from resources directory." << std::endl;
   std::cerr << "    --nomute: don't mute the game while running tests." << std::endl;
+  std::cerr << "    --render-benchmark <name>: run given test while drawing every frame offscreen,"
+               " then print how long drawing took."
+            << std::endl;
+  std::cerr << "    --dump-frames <path>: save every 60th frame of a render benchmark to given directory." << std::endl;
   PrintData::Help();
   std::cerr << std::endl;
   std::cerr << "Report bugs to: <https://github.com/endless-sky/endless-sky/issues>" << std::endl;
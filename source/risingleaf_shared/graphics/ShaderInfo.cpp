@@ -29,6 +29,13 @@ void ShaderInfo::AddInput(GraphicsTypes::ShaderType type, size_t offset, size_t
   VertexAttributes.emplace_back(type, offset, location);
 }
 
+void ShaderInfo::SetInstanceInputSize(const size_t size) { InstanceSize = size; }
+
+void ShaderInfo::AddInstanceInput(GraphicsTypes::ShaderType type, size_t offset, size_t location)
+{
+  InstanceAttributes.emplace_back(type, offset, location);
+}
+
 void ShaderInfo::AddUniformVariable(GraphicsTypes::ShaderType type)
 {
   UniformBufferEntry &entry  = SpecificUniformBuffer.emplace_back(type);
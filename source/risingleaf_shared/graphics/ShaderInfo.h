@@ -52,6 +52,9 @@ public:
 private:
   std::vector<VertexAttrib> VertexAttributes;
   size_t                    VertexSize = 0;
+  // Inputs that advance once per instance rather than once per vertex.
+  std::vector<VertexAttrib> InstanceAttributes;
+  size_t                    InstanceSize = 0;
 
   std::vector<std::string> Textures;
 
@@ -65,6 +68,8 @@ public:
   ShaderInfo();
   void SetInputSize(size_t size);
   void AddInput(GraphicsTypes::ShaderType type, size_t offset, size_t location);
+  void SetInstanceInputSize(size_t size);
+  void AddInstanceInput(GraphicsTypes::ShaderType type, size_t offset, size_t location);
   void AddUniformVariable(GraphicsTypes::ShaderType type);
   void AddTexture(std::string_view name);
 
@@ -81,6 +86,8 @@ public:
 
   [[nodiscard]] const std::vector<VertexAttrib> &GetVertexAttribs() const { return VertexAttributes; }
   [[nodiscard]] size_t                           GetVertexSize() const { return VertexSize; }
+  [[nodiscard]] const std::vector<VertexAttrib> &GetInstanceAttribs() const { return InstanceAttributes; }
+  [[nodiscard]] size_t                           GetInstanceSize() const { return InstanceSize; }
 
   [[nodiscard]] size_t                          GetSpecificTextureCount() const { return Textures.size(); }
   [[nodiscard]] const std::vector<std::string> &GetTextures() const { return Textures; }
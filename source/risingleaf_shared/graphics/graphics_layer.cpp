@@ -103,14 +103,15 @@ size_t graphics_layer::GetSizeOfType(const GraphicsTypes::ShaderType type)
   throw std::runtime_error("ShaderType size not implemented");
 }
 
-std::unique_ptr<GraphicsTypes::GraphicsInstance> graphics_layer::Init(const int width, const int height)
+std::unique_ptr<GraphicsTypes::GraphicsInstance>
+graphics_layer::Init(const int width, const int height, [[maybe_unused]] const bool offscreen)
 {
 #if defined(__APPLE__)
   return std::make_unique<graphics_metal::MetalGraphicsInstance>(width, height);
 #elif defined(ASL_BUILD_WASM)
   return std::make_unique<graphics_wgpu::WGPUGraphicsInstance>(width, height);
 #else
-  return std::make_unique<graphics_vulkan::VulkanGraphicsInstance>(width, height);
+  return std::make_unique<graphics_vulkan::VulkanGraphicsInstance>(width, height, offscreen);
 #endif
 }
 
@@ -237,6 +238,19 @@ namespace graphics_layer
     Instance->DrawIndexed(start, end > 0 ? end : Size, IndexBuffer.get(), prim_type);
   }
 
+  void ObjectHandle::DrawInstanced(
+      const GraphicsTypes::PrimitiveType           prim_type,
+      const std::vector<GraphicsTypes::DrawRange> &ranges,
+      const size_t                                 instance_size,
+      const void                                  *instance_data) const
+  {
+    if(ranges.empty()) return;
+    assert(!IndexBuffer && "Instanced draws of indexed objects are not supported!");
+
+    Instance->BindVertexBuffer(VertexBuffer.get());
+    Instance->DrawInstanced(ranges.data(), ranges.size(), instance_size, instance_data, prim_type);
+  }
+
   TextureHandle::TextureHandle(
       const GraphicsTypes::GraphicsInstance  *instance,
       const std::string_view                  name,
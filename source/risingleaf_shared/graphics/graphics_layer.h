@@ -35,7 +35,9 @@ namespace graphics_layer
   size_t GetAlignmentOfType(GraphicsTypes::ShaderType type);
   size_t GetSizeOfType(GraphicsTypes::ShaderType type);
 
-  std::unique_ptr<GraphicsTypes::GraphicsInstance> Init(int width, int height);
+  // An offscreen instance draws into images instead of a window, for benchmarks and tests.
+  // Backends without offscreen support ignore it.
+  std::unique_ptr<GraphicsTypes::GraphicsInstance> Init(int width, int height, bool offscreen = false);
 
   class FrameBufferHandle
   {
@@ -115,6 +117,12 @@ namespace graphics_layer
     }
 
     void Draw(GraphicsTypes::PrimitiveType prim_type, int start = 0, int end = -1) const;
+    // Draw several ranges of this object with a single instanced draw, see GraphicsInstance::DrawInstanced.
+    void DrawInstanced(
+        GraphicsTypes::PrimitiveType                 prim_type,
+        const std::vector<GraphicsTypes::DrawRange> &ranges,
+        size_t                                       instance_size,
+        const void                                  *instance_data) const;
   };
 
   class TextureHandle
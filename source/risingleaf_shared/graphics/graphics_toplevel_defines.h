@@ -17,6 +17,7 @@
 #ifndef GRAPHICS_H
 #define GRAPHICS_H
 
+#include <filesystem>
 #include <memory>
 #include <vector>
 
@@ -189,6 +190,16 @@ namespace GraphicsTypes
     COMPARE_LESS_EQUALS,
   };
 
+  // A range of vertices of an instanced draw. The range is drawn once for each
+  // of its instances, which take their data from consecutive entries of the
+  // instance data.
+  struct DrawRange
+  {
+    uint32_t Start     = 0;
+    uint32_t Count     = 0;
+    uint32_t Instances = 1;
+  };
+
   struct Viewport
   {
     uint64_t OffsetX;
@@ -304,6 +315,17 @@ namespace GraphicsTypes
     bool DepthWrite = true;
   };
 
+  // What it took to draw a frame.
+  struct FrameStatistics
+  {
+    size_t DrawCalls = 0;
+    size_t Commands  = 0;
+    // Time spent recording and submitting the frame's commands, in milliseconds.
+    double SubmitTime = 0.;
+    // Time the GPU spent on the frame, in milliseconds, or less than zero if it isn't known.
+    double GpuTime = -1.;
+  };
+
   class CommandBufferInstance
   {
   public:
@@ -372,6 +394,23 @@ namespace GraphicsTypes
     [[nodiscard]] const FrameBufferInfo &GetInfo() const { return Info; }
   };
 
+  // A draw whose vertices a compute shader writes from a list of records, rather than
+  // the CPU. The shader is run once for each record. It gets the uniforms as its specific
+  // uniform buffer, the records as its first storage buffer and writes the vertices of
+  // each record to its second one.
+  struct VertexGenerator
+  {
+    const ShaderInstance             *Shader            = nullptr;
+    const std::vector<unsigned char> *Uniforms          = nullptr;
+    const void                       *Records           = nullptr;
+    size_t                            RecordCount       = 0;
+    size_t                            RecordSize        = 0;
+    size_t                            VerticesPerRecord = 0;
+    size_t                            VertexSize        = 0;
+  };
+  // The number of records each work group of a generator shader handles.
+  constexpr uint32_t GENERATOR_GROUP_SIZE = 64;
+
 
   class GraphicsInstance
   {
@@ -440,6 +479,14 @@ namespace GraphicsTypes
     virtual void
     DrawIndexed(size_t start, size_t count, const BufferInstance *buffer_instance, PrimitiveType prim_type) const = 0;
     virtual void DrawDynamic(size_t count, size_t type_size, const void *data, PrimitiveType prim_type) const     = 0;
+    // Draw the given ranges of the bound vertex buffer in one go. The instance data of all
+    // ranges is uploaded once and read through the shader's instance inputs.
+    virtual void DrawInstanced(
+        const DrawRange *ranges,
+        size_t           range_count,
+        size_t           instance_size,
+        const void      *instance_data,
+        PrimitiveType    prim_type) const = 0;
 
     virtual void BindRenderBuffer(RenderBufferInstance *render_buffer_instance) const = 0;
     virtual void EndRenderBuffer(RenderBufferInstance *render_buffer_instance)        = 0;
@@ -450,6 +497,25 @@ namespace GraphicsTypes
     virtual void EndDraw(int width, int height) = 0;
 
     virtual void Wait() = 0;
+
+    // Backends that compile a pipeline for every combination of shader and render state can
+    // keep the compiled pipelines in this file across runs. Others ignore it.
+    virtual void LoadPipelineCache(const std::filesystem::path &) {}
+    // Compile the pipelines needed to draw with the given shader and state to the screen ahead
+    // of time, so that the first frame that uses them doesn't stall.
+    virtual void WarmUpShader(const ShaderInstance *, const RenderState &) const {}
+
+    // The statistics of the last frame that was drawn. The GPU time may lag a few frames behind.
+    [[nodiscard]] virtual FrameStatistics GetFrameStatistics() const { return {}; }
+    // Read back the last frame that was drawn, as rows of RGBA pixels, if the backend supports it.
+    // This waits for the GPU, so it is only meant for tools and tests.
+    virtual bool ReadFrame(std::vector<uint8_t> &, uint32_t &, uint32_t &) const { return false; }
+
+    // Whether this backend can generate the vertices of a draw with a compute shader.
+    [[nodiscard]] virtual bool CanGenerateVertices() const { return false; }
+    // Run the compute shader of the given generator, then draw the vertices it wrote with
+    // the bound shader, like DrawDynamic() would. Only used if CanGenerateVertices() is true.
+    virtual void DrawGenerated(const VertexGenerator &, PrimitiveType) const {}
   };
 } // namespace GraphicsTypes
 
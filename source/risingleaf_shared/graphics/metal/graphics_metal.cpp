@@ -414,8 +414,15 @@ namespace graphics_metal
 
     const MTL::VertexDescriptor *vertex_descriptor = render_pipeline_descriptor->vertexDescriptor();
 
-    for(const auto &[Type, Offset, Location] : state.shader->shader_info.GetVertexAttribs())
+    std::vector<std::pair<NS::UInteger, ShaderInfo::VertexAttrib>> attribs;
+    for(const auto &v_attrib : state.shader->shader_info.GetVertexAttribs())
+      attribs.emplace_back(0, v_attrib);
+    for(const auto &i_attrib : state.shader->shader_info.GetInstanceAttribs())
+      attribs.emplace_back(1, i_attrib);
+
+    for(const auto &[buffer_index, attrib] : attribs)
     {
+      const auto &[Type, Offset, Location] = attrib;
       MTL::VertexFormat format;
       switch(Type)
       {
@@ -433,11 +440,16 @@ namespace graphics_metal
       default:                                assert(false && "invalid type for input attribute, reconsider");
       }
       vertex_descriptor->attributes()->object(Location)->setFormat(format);
-      vertex_descriptor->attributes()->object(Location)->setBufferIndex(0);
+      vertex_descriptor->attributes()->object(Location)->setBufferIndex(buffer_index);
       vertex_descriptor->attributes()->object(Location)->setOffset(Offset);
     }
 
     vertex_descriptor->layouts()->object(0)->setStride(state.shader->shader_info.GetVertexSize());
+    if(!state.shader->shader_info.GetInstanceAttribs().empty())
+    {
+      vertex_descriptor->layouts()->object(1)->setStride(state.shader->shader_info.GetInstanceSize());
+      vertex_descriptor->layouts()->object(1)->setStepFunction(MTL::VertexStepFunctionPerInstance);
+    }
 
     render_pipeline_descriptor->setVertexDescriptor(vertex_descriptor);
 
@@ -1125,6 +1137,84 @@ void graphics_metal::MetalGraphicsInstance::DrawDynamic(
   current_encoder->drawPrimitives(mtl_prim_type, static_cast<NS::UInteger>(0), count);
 }
 
+void graphics_metal::MetalGraphicsInstance::DrawInstanced(
+    const GraphicsTypes::DrawRange    *ranges,
+    const size_t                       range_count,
+    const size_t                       instance_size,
+    const void                        *instance_data,
+    const GraphicsTypes::PrimitiveType prim_type) const
+{
+  const auto pipeline = GetPipelineForState(this, current_state);
+
+  if(!pipeline)
+  {
+    Log::Error << "Failed to retrieve pipeline, skipping draw." << Log::End;
+    return;
+  }
+
+  current_encoder->setRenderPipelineState(pipeline);
+  current_encoder->setDepthStencilState(GetDepthStencilForState(
+      this,
+      current_state.State.DepthTest,
+      current_state.State.DepthWrite,
+      current_state.State.DepthCompare));
+
+  current_encoder->setFrontFacingWinding(MTL::WindingCounterClockwise);
+  switch(current_state.State.Culling)
+  {
+  case GraphicsTypes::CullMode::CULL_BACK:  current_encoder->setCullMode(MTL::CullModeBack); break;
+  case GraphicsTypes::CullMode::CULL_FRONT: current_encoder->setCullMode(MTL::CullModeFront); break;
+  case GraphicsTypes::CullMode::CULL_NONE:  current_encoder->setCullMode(MTL::CullModeNone); break;
+  }
+
+  if(current_state.State.WireFrame) current_encoder->setTriangleFillMode(MTL::TriangleFillModeLines);
+  else current_encoder->setTriangleFillMode(MTL::TriangleFillModeFill);
+
+  if(common_data_changed)
+  {
+    std::vector<unsigned char> ubo_data(ShaderInfo::GetCommonUniformSize());
+    ShaderInfo::CopyCommonUniformDataToBuffer(ubo_data.data(), common_data);
+    current_encoder->setVertexBytes(ubo_data.data(), ShaderInfo::GetCommonUniformSize(), 2);
+    current_encoder->setFragmentBytes(ubo_data.data(), ShaderInfo::GetCommonUniformSize(), 2);
+    common_data_changed = false;
+  }
+
+  MTL::PrimitiveType mtl_prim_type = MTL::PrimitiveTypeTriangle;
+  switch(prim_type)
+  {
+  case GraphicsTypes::PrimitiveType::TRIANGLES:      mtl_prim_type = MTL::PrimitiveTypeTriangle; break;
+  case GraphicsTypes::PrimitiveType::TRIANGLE_STRIP: mtl_prim_type = MTL::PrimitiveTypeTriangleStrip; break;
+  case GraphicsTypes::PrimitiveType::LINES:          mtl_prim_type = MTL::PrimitiveTypeLineStrip; break;
+  case GraphicsTypes::PrimitiveType::POINTS:         mtl_prim_type = MTL::PrimitiveTypePoint; break;
+  }
+
+  size_t instance_count = 0;
+  for(size_t i = 0; i < range_count; i++)
+    instance_count += ranges[i].Instances;
+  const size_t size = instance_count * instance_size;
+
+  // The instance data is read from buffer 1, right after the vertices.
+  if(size < MaxBindBytes)
+  {
+    current_encoder->setVertexBytes(instance_data, size, 1);
+  }
+  else {
+    unsigned char *dst = static_cast<unsigned char *>(DynamicVertexBuffer->contents()) + DynamicVertexBufferOffset;
+    memcpy(dst, instance_data, size);
+    DynamicVertexBuffer->didModifyRange(NS::Range(DynamicVertexBufferOffset, size));
+    current_encoder->setVertexBuffer(DynamicVertexBuffer, DynamicVertexBufferOffset, 1);
+    DynamicVertexBufferOffset += size;
+  }
+
+  NS::UInteger first_instance = 0;
+  for(size_t i = 0; i < range_count; i++)
+  {
+    current_encoder->drawPrimitives(
+        mtl_prim_type, ranges[i].Start, ranges[i].Count, ranges[i].Instances, first_instance);
+    first_instance += ranges[i].Instances;
+  }
+}
+
 void graphics_metal::MetalGraphicsInstance::BindRenderBuffer(
     GraphicsTypes::RenderBufferInstance *render_buffer_instance) const
 {
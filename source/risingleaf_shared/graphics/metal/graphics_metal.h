@@ -156,6 +156,12 @@ namespace graphics_metal
         GraphicsTypes::PrimitiveType         prim_type) const override;
     void DrawDynamic(size_t count, size_t type_size, const void *data, GraphicsTypes::PrimitiveType prim_type)
         const override;
+    void DrawInstanced(
+        const GraphicsTypes::DrawRange *ranges,
+        size_t                          range_count,
+        size_t                          instance_size,
+        const void                     *instance_data,
+        GraphicsTypes::PrimitiveType    prim_type) const override;
 
     void BindRenderBuffer(GraphicsTypes::RenderBufferInstance *render_buffer_instance) const override;
     void EndRenderBuffer(GraphicsTypes::RenderBufferInstance *render_buffer_instance) override;
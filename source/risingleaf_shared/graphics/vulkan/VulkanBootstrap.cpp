@@ -152,6 +152,9 @@ VkDescriptorSetLayoutBinding VulkanBootstrap::GetDescriptorSetLayoutBinding(
   case VulkanTranslate::DescriptorType::STORAGE_TEXTURE:
     binding_info.descriptorType = VK_DESCRIPTOR_TYPE_STORAGE_IMAGE;
     break;
+  case VulkanTranslate::DescriptorType::STORAGE_BUFFER:
+    binding_info.descriptorType = VK_DESCRIPTOR_TYPE_STORAGE_BUFFER;
+    break;
   }
   switch(stage)
   {
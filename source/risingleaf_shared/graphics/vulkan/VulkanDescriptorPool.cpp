@@ -16,9 +16,43 @@
 //
 #include "VulkanDescriptorPool.h"
 
+#include <functional>
 #include <stdexcept>
 
 #include "VulkanHelpers.h"
+#include "VulkanTexture.h"
+
+
+namespace
+{
+  void WriteTextures(
+      const VkDevice                                     device,
+      const VkDescriptorSet                              set,
+      const VulkanObjects::VulkanTextureInstance *const *textures,
+      const int                                          count)
+  {
+    std::vector<VkDescriptorImageInfo> image_infos(count);
+    std::vector<VkWriteDescriptorSet>  descriptor_writes(count);
+    for(int i = 0; i < count; i++)
+    {
+      image_infos[i].imageLayout = textures[i]->GetImage()->GetLayout();
+      image_infos[i].imageView   = textures[i]->GetView()->Get();
+      image_infos[i].sampler     = textures[i]->GetSampler()->Get();
+
+      descriptor_writes[i].sType            = VK_STRUCTURE_TYPE_WRITE_DESCRIPTOR_SET;
+      descriptor_writes[i].dstSet           = set;
+      descriptor_writes[i].dstBinding       = i;
+      descriptor_writes[i].dstArrayElement  = 0;
+      descriptor_writes[i].descriptorType   = VK_DESCRIPTOR_TYPE_COMBINED_IMAGE_SAMPLER;
+      descriptor_writes[i].descriptorCount  = 1;
+      descriptor_writes[i].pBufferInfo      = nullptr;
+      descriptor_writes[i].pImageInfo       = &image_infos[i];
+      descriptor_writes[i].pTexelBufferView = nullptr;
+    }
+
+    vkUpdateDescriptorSets(device, count, descriptor_writes.data(), 0, nullptr);
+  }
+} // namespace
 
 
 VulkanObjects::VulkanDescriptorPool::VulkanDescriptorPool(const VulkanDeviceInstance *device) : Device(device)
@@ -33,15 +67,24 @@ VulkanObjects::VulkanDescriptorPool::VulkanDescriptorPool(const VulkanDeviceInst
   VkDescriptorPoolSize pool_size_storage{};
   pool_size_storage.type            = VK_DESCRIPTOR_TYPE_STORAGE_IMAGE;
   pool_size_storage.descriptorCount = 8192; // just a huge number, pray I never need to change it
+  // Generated vertices read their records from one storage buffer and write to another.
+  VkDescriptorPoolSize pool_size_storage_buffer{};
+  pool_size_storage_buffer.type            = VK_DESCRIPTOR_TYPE_STORAGE_BUFFER;
+  pool_size_storage_buffer.descriptorCount = 2 * 1024;
 
-  std::vector<VkDescriptorPoolSize> pool_sizes = {pool_size_ubo, pool_size_sampler, pool_size_storage};
+  std::vector<VkDescriptorPoolSize> pool_sizes = {
+      pool_size_ubo,
+      pool_size_sampler,
+      pool_size_storage,
+      pool_size_storage_buffer,
+  };
 
   VkDescriptorPoolCreateInfo descriptor_pool_info{};
   descriptor_pool_info.sType         = VK_STRUCTURE_TYPE_DESCRIPTOR_POOL_CREATE_INFO;
   descriptor_pool_info.poolSizeCount = pool_sizes.size();
   descriptor_pool_info.pPoolSizes    = pool_sizes.data();
   descriptor_pool_info.flags         = 0; // VK_DESCRIPTOR_POOL_CREATE_FREE_DESCRIPTOR_SET_BIT;
-  descriptor_pool_info.maxSets       = 16'384 + 8192 + 8192;
+  descriptor_pool_info.maxSets       = 16'384 + 8192 + 8192 + 1024;
 
   for(auto &pool : DescriptorPools)
   {
@@ -50,6 +93,25 @@ VulkanObjects::VulkanDescriptorPool::VulkanDescriptorPool(const VulkanDeviceInst
         __LINE__,
         __FILE__);
   }
+
+  VkDescriptorPoolSize cache_pool_size{};
+  cache_pool_size.type            = VK_DESCRIPTOR_TYPE_COMBINED_IMAGE_SAMPLER;
+  cache_pool_size.descriptorCount = MAX_CACHED_SETS * MAX_CACHED_TEXTURES;
+
+  VkDescriptorPoolCreateInfo cache_pool_info{};
+  cache_pool_info.sType         = VK_STRUCTURE_TYPE_DESCRIPTOR_POOL_CREATE_INFO;
+  cache_pool_info.poolSizeCount = 1;
+  cache_pool_info.pPoolSizes    = &cache_pool_size;
+  cache_pool_info.flags         = 0;
+  cache_pool_info.maxSets       = MAX_CACHED_SETS;
+
+  for(auto &pool : CachePools)
+  {
+    VulkanHelpers::VK_CHECK_RESULT(
+        vkCreateDescriptorPool(Device->GetDevice(), &cache_pool_info, nullptr, &pool),
+        __LINE__,
+        __FILE__);
+  }
 }
 
 VulkanObjects::VulkanDescriptorPool::~VulkanDescriptorPool()
@@ -59,6 +121,11 @@ VulkanObjects::VulkanDescriptorPool::~VulkanDescriptorPool()
     vkResetDescriptorPool(Device->GetDevice(), pool, 0);
     vkDestroyDescriptorPool(Device->GetDevice(), pool, nullptr);
   }
+  for(const auto &pool : CachePools)
+  {
+    vkResetDescriptorPool(Device->GetDevice(), pool, 0);
+    vkDestroyDescriptorPool(Device->GetDevice(), pool, nullptr);
+  }
 }
 
 VkDescriptorSet VulkanObjects::VulkanDescriptorPool::AllocateDescriptorSet(VkDescriptorSetLayout layout) const
@@ -75,7 +142,85 @@ VkDescriptorSet VulkanObjects::VulkanDescriptorPool::AllocateDescriptorSet(VkDes
   return set;
 }
 
+VkDescriptorSet VulkanObjects::VulkanDescriptorPool::GetTextureDescriptorSet(
+    VkDescriptorSetLayout               layout,
+    const VulkanTextureInstance *const *textures,
+    const int                           count) const
+{
+  if(count > MAX_CACHED_TEXTURES)
+  {
+    ++CacheMisses;
+    VkDescriptorSet set = AllocateDescriptorSet(layout);
+    WriteTextures(Device->GetDevice(), set, textures, count);
+    return set;
+  }
+
+  TextureSetKey key{};
+  key.Layout = layout;
+  key.Count  = count;
+  for(int i = 0; i < count; i++)
+  {
+    key.Textures[i] = {
+        textures[i]->GetId(),
+        textures[i]->GetView()->Get(),
+        textures[i]->GetSampler()->Get(),
+        textures[i]->GetImage()->GetLayout()};
+  }
+
+  auto &cache = Cache[Device->GetCurrentFrame()];
+  if(const auto it = cache.find(key); it != cache.end())
+  {
+    ++CacheHits;
+    return it->second;
+  }
+  ++CacheMisses;
+
+  // If the cache of this frame is full, the set is only used for this frame.
+  VkDescriptorSet set;
+  if(cache.size() < MAX_CACHED_SETS)
+  {
+    VkDescriptorSetAllocateInfo alloc_info{};
+    alloc_info.sType              = VK_STRUCTURE_TYPE_DESCRIPTOR_SET_ALLOCATE_INFO;
+    alloc_info.descriptorPool     = CachePools[Device->GetCurrentFrame()];
+    alloc_info.descriptorSetCount = 1;
+    alloc_info.pSetLayouts        = &layout;
+
+    VulkanHelpers::VK_CHECK_RESULT(
+        vkAllocateDescriptorSets(Device->GetDevice(), &alloc_info, &set),
+        __LINE__,
+        __FILE__);
+    cache.emplace(key, set);
+  }
+  else set = AllocateDescriptorSet(layout);
+
+  WriteTextures(Device->GetDevice(), set, textures, count);
+  return set;
+}
+
 void VulkanObjects::VulkanDescriptorPool::BeginFrame() const
 {
   vkResetDescriptorPool(Device->GetDevice(), DescriptorPools[Device->GetCurrentFrame()], 0);
+
+  // Sets of textures that no longer exist pile up in the cache, so it is
+  // recycled once it is full. The previous frame with this index is done by now.
+  auto &cache = Cache[Device->GetCurrentFrame()];
+  if(cache.size() >= MAX_CACHED_SETS)
+  {
+    vkResetDescriptorPool(Device->GetDevice(), CachePools[Device->GetCurrentFrame()], 0);
+    cache.clear();
+  }
+}
+
+size_t VulkanObjects::VulkanDescriptorPool::TextureSetKeyHash::operator()(const TextureSetKey &key) const
+{
+  size_t hash    = std::hash<VkDescriptorSetLayout>()(key.Layout);
+  const auto mix = [&hash](const size_t value) { hash ^= value + 0x9e3779b9 + (hash << 6) + (hash >> 2); };
+  for(int i = 0; i < key.Count; i++)
+  {
+    mix(std::hash<uint64_t>()(key.Textures[i].Id));
+    mix(std::hash<VkImageView>()(key.Textures[i].View));
+    mix(std::hash<VkSampler>()(key.Textures[i].Sampler));
+    mix(std::hash<int>()(key.Textures[i].Layout));
+  }
+  return hash;
 }
@@ -18,6 +18,8 @@
 #define VULKANDESCRIPTORPOOL_H
 
 #include <array>
+#include <cstdint>
+#include <unordered_map>
 
 #include <vulkan/vulkan_core.h>
 
@@ -26,10 +28,52 @@
 
 namespace VulkanObjects
 {
+  class VulkanTextureInstance;
   class VulkanDescriptorPool final
   {
+  public:
+    // Sets with more textures than this are not cached.
+    static constexpr int MAX_CACHED_TEXTURES = 4;
+    // Once this many sets were cached for a frame index, its cache is recycled.
+    static constexpr uint32_t MAX_CACHED_SETS = 4096;
+
+  private:
+    struct TextureKey
+    {
+      uint64_t      Id;
+      VkImageView   View;
+      VkSampler     Sampler;
+      VkImageLayout Layout;
+
+      bool operator==(const TextureKey &other) const = default;
+    };
+    struct TextureSetKey
+    {
+      VkDescriptorSetLayout                       Layout;
+      int                                         Count;
+      std::array<TextureKey, MAX_CACHED_TEXTURES> Textures;
+
+      bool operator==(const TextureSetKey &other) const = default;
+    };
+    struct TextureSetKeyHash
+    {
+      size_t operator()(const TextureSetKey &key) const;
+    };
+
     std::array<VkDescriptorPool, VulkanDeviceInstance::MAX_FRAMES_IN_FLIGHT> DescriptorPools{nullptr};
 
+    // Texture sets are written once and then reused for as long as the same
+    // textures are bound, so they live in their own pools that are only reset
+    // when they fill up, instead of every frame.
+    std::array<VkDescriptorPool, VulkanDeviceInstance::MAX_FRAMES_IN_FLIGHT> CachePools{nullptr};
+    mutable std::array<
+        std::unordered_map<TextureSetKey, VkDescriptorSet, TextureSetKeyHash>,
+        VulkanDeviceInstance::MAX_FRAMES_IN_FLIGHT>
+        Cache;
+
+    mutable uint64_t CacheHits   = 0;
+    mutable uint64_t CacheMisses = 0;
+
     const VulkanDeviceInstance *Device;
 
   public:
@@ -38,9 +82,16 @@ namespace VulkanObjects
     ~VulkanDescriptorPool();
 
     VkDescriptorSet AllocateDescriptorSet(VkDescriptorSetLayout layout) const;
+    // Get a set holding the given textures, only allocating and writing a new
+    // one if these textures weren't bound with this layout before.
+    VkDescriptorSet
+    GetTextureDescriptorSet(VkDescriptorSetLayout layout, const VulkanTextureInstance *const *textures, int count) const;
 
     void BeginFrame() const;
 
+    [[nodiscard]] uint64_t GetCacheHits() const { return CacheHits; }
+    [[nodiscard]] uint64_t GetCacheMisses() const { return CacheMisses; }
+
     VulkanDescriptorPool(const VulkanDescriptorPool &other)                = delete;
     VulkanDescriptorPool(VulkanDescriptorPool &&other) noexcept            = delete;
     VulkanDescriptorPool &operator=(const VulkanDescriptorPool &other)     = delete;
@@ -16,6 +16,8 @@
 //
 #include "VulkanDeviceInstance.h"
 
+#include <cstring>
+#include <fstream>
 #include <set>
 #include <stdexcept>
 
@@ -26,7 +28,7 @@
 
 #include "../../../GameWindow.h"
 
-VulkanObjects::VulkanDeviceInstance::VulkanDeviceInstance()
+VulkanObjects::VulkanDeviceInstance::VulkanDeviceInstance(const bool offscreen)
 {
   VkApplicationInfo app_info{};
   app_info.sType              = VK_STRUCTURE_TYPE_APPLICATION_INFO;
@@ -41,7 +43,8 @@ VulkanObjects::VulkanDeviceInstance::VulkanDeviceInstance()
   create_info.pApplicationInfo = &app_info;
 
   // TODO: maybe not have glfw included here
-  std::vector<const char *> required_extensions = VulkanHelpers::GetRequiredExtensions();
+  std::vector<const char *> required_extensions;
+  if(!offscreen) required_extensions = VulkanHelpers::GetRequiredExtensions();
   if(ENABLE_VALIDATION_LAYERS) required_extensions.push_back(VK_EXT_DEBUG_UTILS_EXTENSION_NAME);
 
   create_info.enabledExtensionCount   = static_cast<uint32_t>(required_extensions.size());
@@ -84,7 +87,7 @@ VulkanObjects::VulkanDeviceInstance::VulkanDeviceInstance()
         __FILE__);
   }
 
-  if(!SDL_Vulkan_CreateSurface(GameWindow::GetWindow(), Instance, nullptr, &Surface))
+  if(!offscreen && !SDL_Vulkan_CreateSurface(GameWindow::GetWindow(), Instance, nullptr, &Surface))
     throw std::runtime_error("Error creating sdl vulkan surface");
 
   uint32_t device_count = 0;
@@ -171,6 +174,13 @@ VulkanObjects::VulkanDeviceInstance::VulkanDeviceInstance()
   allocator_create_info.device         = Device;
   VulkanHelpers::VK_CHECK_RESULT(vmaCreateAllocator(&allocator_create_info, &Allocator), __LINE__, __FILE__);
 
+  VkPipelineCacheCreateInfo pipeline_cache_info{};
+  pipeline_cache_info.sType = VK_STRUCTURE_TYPE_PIPELINE_CACHE_CREATE_INFO;
+  VulkanHelpers::VK_CHECK_RESULT(
+      vkCreatePipelineCache(Device, &pipeline_cache_info, nullptr, &PipelineCache),
+      __LINE__,
+      __FILE__);
+
 #ifndef NDEBUG
   vkSetDebugUtilsObjectNameEXT =
       reinterpret_cast<PFN_vkSetDebugUtilsObjectNameEXT>(vkGetDeviceProcAddr(Device, "vkSetDebugUtilsObjectNameEXT"));
@@ -208,6 +218,69 @@ void VulkanObjects::VulkanDeviceInstance::QueuePipelineForDeletion(VkPipeline pi
   PipelineDeleteQueue[CurrentFrame].emplace_back(pipeline);
 }
 
+void VulkanObjects::VulkanDeviceInstance::LoadPipelineCache(const std::filesystem::path &path)
+{
+  PipelineCachePath = path;
+
+  std::ifstream file(path, std::ios::ate | std::ios::binary);
+  if(!file.is_open()) return;
+  std::vector<char> data(file.tellg());
+  file.seekg(0);
+  file.read(data.data(), static_cast<std::streamsize>(data.size()));
+  if(!file) return;
+
+  // The header is laid out as length, version, vendor id, device id and cache UUID. Data
+  // from another driver or device is useless, so don't bother handing it to the driver.
+  constexpr size_t HEADER_SIZE = 4 * sizeof(uint32_t) + VK_UUID_SIZE;
+  if(data.size() < HEADER_SIZE) return;
+  std::array<uint32_t, 4> header{};
+  std::memcpy(header.data(), data.data(), sizeof(header));
+  if(header[0] < HEADER_SIZE || header[1] != VK_PIPELINE_CACHE_HEADER_VERSION_ONE ||
+     header[2] != PhysicalDeviceProperties.vendorID || header[3] != PhysicalDeviceProperties.deviceID ||
+     std::memcmp(data.data() + sizeof(header), PhysicalDeviceProperties.pipelineCacheUUID, VK_UUID_SIZE) != 0)
+  {
+    Log::Info << "Discarding pipeline cache of another driver: " << path.string() << Log::End;
+    return;
+  }
+
+  VkPipelineCacheCreateInfo pipeline_cache_info{};
+  pipeline_cache_info.sType           = VK_STRUCTURE_TYPE_PIPELINE_CACHE_CREATE_INFO;
+  pipeline_cache_info.initialDataSize = data.size();
+  pipeline_cache_info.pInitialData    = data.data();
+  VkPipelineCache loaded_cache        = nullptr;
+  if(vkCreatePipelineCache(Device, &pipeline_cache_info, nullptr, &loaded_cache) != VK_SUCCESS) return;
+  VulkanHelpers::VK_CHECK_RESULT(vkMergePipelineCaches(Device, PipelineCache, 1, &loaded_cache), __LINE__, __FILE__);
+  vkDestroyPipelineCache(Device, loaded_cache, nullptr);
+
+  Log::Info << "Loaded pipeline cache: " << path.string() << " (" << data.size() << " bytes)" << Log::End;
+}
+
+void VulkanObjects::VulkanDeviceInstance::SavePipelineCache() const
+{
+  if(PipelineCachePath.empty() || !PipelineCache) return;
+
+  size_t size = 0;
+  if(vkGetPipelineCacheData(Device, PipelineCache, &size, nullptr) != VK_SUCCESS || !size) return;
+  std::vector<char> data(size);
+  if(vkGetPipelineCacheData(Device, PipelineCache, &size, data.data()) != VK_SUCCESS) return;
+
+  // Write to a temporary file first, so that a crash while writing can't leave a truncated cache behind.
+  std::filesystem::path temporary = PipelineCachePath;
+  temporary += ".tmp";
+  {
+    std::ofstream file(temporary, std::ios::binary | std::ios::trunc);
+    file.write(data.data(), static_cast<std::streamsize>(size));
+    if(!file)
+    {
+      Log::Warn << "Unable to write pipeline cache: " << temporary.string() << Log::End;
+      return;
+    }
+  }
+  std::error_code error;
+  std::filesystem::rename(temporary, PipelineCachePath, error);
+  if(error) Log::Warn << "Unable to write pipeline cache: " << PipelineCachePath.string() << Log::End;
+}
+
 void VulkanObjects::VulkanDeviceInstance::NameObject(
     const VkObjectType     object_type,
     const uint64_t         object_handle,
@@ -294,6 +367,9 @@ VulkanObjects::VulkanDeviceInstance::~VulkanDeviceInstance()
       if(image && allocation) vmaDestroyImage(Allocator, image, allocation);
   }
 
+  SavePipelineCache();
+  if(PipelineCache) vkDestroyPipelineCache(Device, PipelineCache, nullptr);
+
   if(Allocator) vmaDestroyAllocator(Allocator);
 
   if(Device) vkDestroyDevice(Device, nullptr);
@@ -20,6 +20,7 @@
 #include <vulkan/vulkan_core.h>
 
 #include <array>
+#include <filesystem>
 #include <string_view>
 #include <vector>
 
@@ -42,6 +43,10 @@ namespace VulkanObjects
     VkPhysicalDevice         PhysicalDevice = nullptr;
     VkDevice                 Device         = nullptr;
     VmaAllocator             Allocator      = nullptr;
+    VkPipelineCache          PipelineCache  = nullptr;
+
+    // Where the pipeline cache is written back to when the device is destroyed.
+    std::filesystem::path PipelineCachePath;
 
     VkQueue GraphicsQueue = nullptr;
     VkQueue ComputeQueue  = nullptr;
@@ -70,7 +75,9 @@ namespace VulkanObjects
     mutable std::array<std::vector<VkPipeline>, MAX_FRAMES_IN_FLIGHT>                         PipelineDeleteQueue;
 
   public:
-    explicit VulkanDeviceInstance();
+    // An offscreen device has no surface, so it can run without a window or display,
+    // e.g. on a software implementation like lavapipe.
+    explicit VulkanDeviceInstance(bool offscreen = false);
 
     VulkanDeviceInstance(const VulkanDeviceInstance &other)                = delete;
     VulkanDeviceInstance(VulkanDeviceInstance &&other) noexcept            = delete;
@@ -87,15 +94,22 @@ namespace VulkanObjects
 
     void NameObject(VkObjectType object_type, uint64_t object_handle, std::string_view name) const;
 
+    // Add the pipelines stored in the given file to the pipeline cache, if the file was
+    // written by this driver and device. The cache is saved back to it on destruction.
+    void LoadPipelineCache(const std::filesystem::path &path);
+    void SavePipelineCache() const;
+
     void BeginFrame() const;
 
     ~VulkanDeviceInstance();
 
+    [[nodiscard]] bool                       IsOffscreen() const { return !Surface; }
     [[nodiscard]] VkSurfaceKHR               GetSurface() const { return Surface; }
     [[nodiscard]] VkPhysicalDevice           GetPhysicalDevice() const { return PhysicalDevice; }
     [[nodiscard]] VkPhysicalDeviceProperties GetProperties() const { return PhysicalDeviceProperties; }
     [[nodiscard]] VkDevice                   GetDevice() const { return Device; }
     [[nodiscard]] VmaAllocator               GetAllocator() const { return Allocator; }
+    [[nodiscard]] VkPipelineCache            GetPipelineCache() const { return PipelineCache; }
     [[nodiscard]] VkQueue                    GetGraphicsQueue() const { return GraphicsQueue; }
     [[nodiscard]] VkQueue                    GetComputeQueue() const { return ComputeQueue; }
     [[nodiscard]] VkQueue                    GetPresentQueue() const { return PresentQueue; }
@@ -173,8 +173,9 @@ VulkanHelpers::QueueFamilyIndices VulkanHelpers::FindQueueFamilies(VkPhysicalDev
     if((queueFamily.queueFlags & VK_QUEUE_GRAPHICS_BIT) && (queueFamily.queueFlags & VK_QUEUE_COMPUTE_BIT))
       indices.GraphicsFamily = i;
 
-    VkBool32 presentSupport = false;
-    vkGetPhysicalDeviceSurfaceSupportKHR(device, i, surface, &presentSupport);
+    // Without a surface nothing is presented, so the graphics queue stands in for the present queue.
+    VkBool32 presentSupport = !surface && indices.GraphicsFamily;
+    if(surface) vkGetPhysicalDeviceSurfaceSupportKHR(device, i, surface, &presentSupport);
     if(presentSupport) indices.PresentFamily = i;
 
     if(indices.IsComplete()) break;
@@ -233,8 +234,8 @@ bool VulkanHelpers::IsDeviceSuitable(VkPhysicalDevice vk_physical_device, VkSurf
 
   QueueFamilyIndices queue_family_indices = FindQueueFamilies(vk_physical_device, surface);
 
-  bool swapChainAdequate = false;
-  if(extensions_supported)
+  bool swapChainAdequate = !surface;
+  if(surface && extensions_supported)
   {
     SwapChainSupportDetails swapChainSupport = AcquireSwapChainSupportDetails(vk_physical_device, surface);
     swapChainAdequate = !swapChainSupport.Formats.empty() && !swapChainSupport.PresentModes.empty();
@@ -58,6 +58,7 @@ namespace VulkanHelpers
 
     [[nodiscard]] bool IsComplete() const { return GraphicsFamily.has_value() && PresentFamily.has_value(); }
   };
+  // Without a surface, the queues are looked up for rendering offscreen.
   QueueFamilyIndices FindQueueFamilies(VkPhysicalDevice device, VkSurfaceKHR surface);
 
   struct SwapChainSupportDetails
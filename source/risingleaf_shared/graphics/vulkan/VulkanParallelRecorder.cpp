@@ -0,0 +1,128 @@
+//
+// This file is part of Astrolative.
+//
+// Copyright (c) 2026 by Torben Hans
+//
+// Astrolative is free software: you can redistribute it and/or modify it under the
+// terms of the GNU General Public License as published by the Free Software
+// Foundation, either version 3 of the License, or (at your option) any later version.
+//
+//  Astrolative is distributed in the hope that it will be useful, but WITHOUT ANY
+//  WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS FOR A
+//  PARTICULAR PURPOSE. See the GNU General Public License for more details.
+//
+//  You should have received a copy of the GNU General Public License along with Astrolative. If not, see
+//  <https://www.gnu.org/licenses/>.
+//
+#include "VulkanParallelRecorder.h"
+
+#include "VulkanBootstrap.h"
+#include "VulkanCommandPool.h"
+#include "VulkanHelpers.h"
+
+
+VulkanObjects::VulkanParallelRecorder::VulkanParallelRecorder(
+    const VulkanDeviceInstance *device,
+    const size_t                worker_count) :
+  Contexts(worker_count + 1), Device(device)
+{
+  for(auto &context : Contexts)
+    for(auto &pool : context.Pools)
+      pool = std::make_unique<VulkanCommandPool>(Device);
+
+  for(size_t thread = 1; thread < Contexts.size(); thread++)
+    Workers.emplace_back(&VulkanParallelRecorder::RunWorker, this, thread);
+}
+
+VulkanObjects::VulkanParallelRecorder::~VulkanParallelRecorder()
+{
+  {
+    std::lock_guard lock(Mutex);
+    Quit = true;
+  }
+  WorkReady.notify_all();
+  for(auto &worker : Workers)
+    worker.join();
+
+  // Destroying the pools frees their command buffers.
+}
+
+void VulkanObjects::VulkanParallelRecorder::BeginFrame()
+{
+  const uint8_t frame = Device->GetCurrentFrame();
+  for(auto &context : Contexts)
+  {
+    vkResetCommandPool(Device->GetDevice(), context.Pools[frame]->Get(), 0);
+    context.Used = 0;
+  }
+}
+
+std::span<const VkCommandBuffer> VulkanObjects::VulkanParallelRecorder::Record(
+    const size_t                                        count,
+    const VkCommandBufferInheritanceInfo               &inheritance,
+    const std::function<void(size_t, VkCommandBuffer)> &record)
+{
+  {
+    std::lock_guard lock(Mutex);
+    JobCount    = count;
+    Inheritance = &inheritance;
+    Job         = &record;
+    Pending     = count - 1;
+    Recorded.resize(count);
+    ++Generation;
+  }
+  if(count > 1) WorkReady.notify_all();
+
+  RecordOne(0);
+
+  std::unique_lock lock(Mutex);
+  WorkDone.wait(lock, [this] { return !Pending; });
+  return Recorded;
+}
+
+void VulkanObjects::VulkanParallelRecorder::RunWorker(const size_t thread)
+{
+  uint64_t         generation = 0;
+  std::unique_lock lock(Mutex);
+  while(true)
+  {
+    WorkReady.wait(lock, [this, generation] { return Quit || Generation != generation; });
+    if(Quit) return;
+    generation = Generation;
+    if(thread >= JobCount) continue;
+
+    lock.unlock();
+    RecordOne(thread);
+    lock.lock();
+
+    if(!--Pending) WorkDone.notify_one();
+  }
+}
+
+void VulkanObjects::VulkanParallelRecorder::RecordOne(const size_t thread)
+{
+  ThreadContext &context = Contexts[thread];
+  const uint8_t  frame   = Device->GetCurrentFrame();
+
+  if(context.Used == context.Buffers[frame].size())
+  {
+    auto allocate_info  = VulkanBootstrap::GetCommandBufferAllocate(context.Pools[frame]->Get(), 1);
+    allocate_info.level = VK_COMMAND_BUFFER_LEVEL_SECONDARY;
+    VulkanHelpers::VK_CHECK_RESULT(
+        vkAllocateCommandBuffers(Device->GetDevice(), &allocate_info, &context.Buffers[frame].emplace_back()),
+        __LINE__,
+        __FILE__);
+  }
+  const VkCommandBuffer command_buffer = context.Buffers[frame][context.Used++];
+
+  VkCommandBufferBeginInfo begin_info{};
+  begin_info.sType = VK_STRUCTURE_TYPE_COMMAND_BUFFER_BEGIN_INFO;
+  begin_info.flags = VK_COMMAND_BUFFER_USAGE_ONE_TIME_SUBMIT_BIT | VK_COMMAND_BUFFER_USAGE_RENDER_PASS_CONTINUE_BIT;
+  begin_info.pInheritanceInfo = Inheritance;
+  VulkanHelpers::VK_CHECK_RESULT(vkBeginCommandBuffer(command_buffer, &begin_info), __LINE__, __FILE__);
+
+  (*Job)(thread, command_buffer);
+
+  VulkanHelpers::VK_CHECK_RESULT(vkEndCommandBuffer(command_buffer), __LINE__, __FILE__);
+  Recorded[thread] = command_buffer;
+}
@@ -0,0 +1,96 @@
+//
+// This file is part of Astrolative.
+//
+// Copyright (c) 2026 by Torben Hans
+//
+// Astrolative is free software: you can redistribute it and/or modify it under the
+// terms of the GNU General Public License as published by the Free Software
+// Foundation, either version 3 of the License, or (at your option) any later version.
+//
+//  Astrolative is distributed in the hope that it will be useful, but WITHOUT ANY
+//  WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS FOR A
+//  PARTICULAR PURPOSE. See the GNU General Public License for more details.
+//
+//  You should have received a copy of the GNU General Public License along with Astrolative. If not, see
+//  <https://www.gnu.org/licenses/>.
+//
+#ifndef VULKANPARALLELRECORDER_H
+#define VULKANPARALLELRECORDER_H
+
+#include <array>
+#include <condition_variable>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <span>
+#include <thread>
+#include <vector>
+
+#include <vulkan/vulkan_core.h>
+
+#include "VulkanDeviceInstance.h"
+
+
+namespace VulkanObjects
+{
+  class VulkanCommandPool;
+
+  // Records the commands of a render pass into several secondary command buffers at
+  // once. The calling thread records the first buffer, and a worker thread each of the
+  // others. Every thread has its own command pools, so recording needs no locking.
+  class VulkanParallelRecorder final
+  {
+    struct ThreadContext
+    {
+      std::array<std::unique_ptr<VulkanCommandPool>, VulkanDeviceInstance::MAX_FRAMES_IN_FLIGHT> Pools;
+      std::array<std::vector<VkCommandBuffer>, VulkanDeviceInstance::MAX_FRAMES_IN_FLIGHT>        Buffers;
+      size_t                                                                                      Used = 0;
+    };
+    std::vector<ThreadContext> Contexts;
+    std::vector<std::thread>   Workers;
+
+    std::mutex              Mutex;
+    std::condition_variable WorkReady;
+    std::condition_variable WorkDone;
+    uint64_t                Generation = 0;
+    size_t                  Pending    = 0;
+    bool                    Quit       = false;
+
+    // The job currently being recorded.
+    size_t                                              JobCount    = 0;
+    const VkCommandBufferInheritanceInfo               *Inheritance = nullptr;
+    const std::function<void(size_t, VkCommandBuffer)> *Job         = nullptr;
+    std::vector<VkCommandBuffer>                        Recorded;
+
+    const VulkanDeviceInstance *Device;
+
+    void RunWorker(size_t thread);
+    void RecordOne(size_t thread);
+
+  public:
+    VulkanParallelRecorder(const VulkanDeviceInstance *device, size_t worker_count);
+
+    ~VulkanParallelRecorder();
+
+    VulkanParallelRecorder(const VulkanParallelRecorder &other)                = delete;
+    VulkanParallelRecorder(VulkanParallelRecorder &&other) noexcept            = delete;
+    VulkanParallelRecorder &operator=(const VulkanParallelRecorder &other)     = delete;
+    VulkanParallelRecorder &operator=(VulkanParallelRecorder &&other) noexcept = delete;
+
+    // Reset the command buffers of the current frame. Its fence must have been waited on.
+    void BeginFrame();
+
+    // Record the given number of secondary command buffers continuing the inherited render
+    // pass, each on its own thread, and return them in order. The count must not exceed
+    // GetThreadCount(). The record function is called with the index of each buffer.
+    std::span<const VkCommandBuffer> Record(
+        size_t                                              count,
+        const VkCommandBufferInheritanceInfo               &inheritance,
+        const std::function<void(size_t, VkCommandBuffer)> &record);
+
+    [[nodiscard]] size_t GetThreadCount() const { return Contexts.size(); }
+  };
+} // namespace VulkanObjects
+
+
+#endif // VULKANPARALLELRECORDER_H
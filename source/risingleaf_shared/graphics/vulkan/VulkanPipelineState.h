@@ -18,6 +18,10 @@
 #define VULKANPIPELINESTATE_H
 #include "graphics/graphics_toplevel_defines.h"
 
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+
 
 namespace VulkanObjects
 {
@@ -36,6 +40,37 @@ namespace VulkanObjects
              this->Shader == other.Shader && this->RenderState == other.RenderState;
     }
   };
+
+  // Hashes everything operator== compares, so states can be looked up in a hash map.
+  struct VulkanPipelineStateHash
+  {
+    size_t operator()(const VulkanPipelineState &state) const
+    {
+      size_t     hash    = 0;
+      const auto Combine = [&hash](const uint64_t value)
+      { hash ^= std::hash<uint64_t>{}(value) + 0x9e3779b9 + (hash << 6) + (hash >> 2); };
+
+      const GraphicsTypes::RenderState &render_state = state.RenderState;
+      Combine(reinterpret_cast<uintptr_t>(state.Shader));
+      Combine(reinterpret_cast<uintptr_t>(state.RenderPass));
+      Combine(static_cast<uint64_t>(state.Samples) << 1 | static_cast<uint64_t>(state.Color));
+      Combine(
+          static_cast<uint64_t>(render_state.DrawPrimitiveType) | static_cast<uint64_t>(render_state.Culling) << 8 |
+          static_cast<uint64_t>(render_state.DepthCompare) << 16 | static_cast<uint64_t>(render_state.ColorMask) << 24 |
+          static_cast<uint64_t>(render_state.DepthTest) << 32 | static_cast<uint64_t>(render_state.DepthWrite) << 33 |
+          static_cast<uint64_t>(render_state.WireFrame) << 34);
+      Combine(
+          static_cast<uint64_t>(render_state.Blending.BlendingEnabled) |
+          static_cast<uint64_t>(render_state.Blending.SRCColor) << 8 |
+          static_cast<uint64_t>(render_state.Blending.DSTColor) << 16 |
+          static_cast<uint64_t>(render_state.Blending.SRCAlpha) << 24 |
+          static_cast<uint64_t>(render_state.Blending.DSTAlpha) << 32);
+      Combine(render_state.PipelineVertexLayout.vertex_size);
+      for(const auto &[type, offset] : render_state.PipelineVertexLayout.values)
+        Combine(static_cast<uint64_t>(type) << 32 | offset);
+      return hash;
+    }
+  };
 } // namespace VulkanObjects
 
 #endif // VULKANPIPELINESTATE_H
@@ -157,24 +157,111 @@ VulkanObjects::VulkanShaderInstance::~VulkanShaderInstance()
     vkDestroyDescriptorSetLayout(Device->GetDevice(), DescriptorSetLayoutUBOSpecial, nullptr);
   if(DescriptorSetLayoutTexturesSpecial)
     vkDestroyDescriptorSetLayout(Device->GetDevice(), DescriptorSetLayoutTexturesSpecial, nullptr);
+  if(DescriptorSetLayoutStorage)
+    vkDestroyDescriptorSetLayout(Device->GetDevice(), DescriptorSetLayoutStorage, nullptr);
 
   if(PipelineLayout) vkDestroyPipelineLayout(Device->GetDevice(), PipelineLayout, nullptr);
+  if(GeneratorPipelineLayout) vkDestroyPipelineLayout(Device->GetDevice(), GeneratorPipelineLayout, nullptr);
+  if(GeneratorPipeline) Device->QueuePipelineForDeletion(GeneratorPipeline);
 
   if(VertexShader) vkDestroyShaderModule(Device->GetDevice(), VertexShader, nullptr);
   if(FragmentShader) vkDestroyShaderModule(Device->GetDevice(), FragmentShader, nullptr);
   if(ComputeShader) vkDestroyShaderModule(Device->GetDevice(), ComputeShader, nullptr);
 
-  for(const auto &pipeline : PipelinesWithState)
-    if(pipeline.second) Device->QueuePipelineForDeletion(pipeline.second);
+  if(const PipelineMap *pipelines = Pipelines.load(std::memory_order_acquire))
+    for(const auto &pipeline : *pipelines)
+      if(pipeline.second) Device->QueuePipelineForDeletion(pipeline.second);
 }
 
 VkPipeline VulkanObjects::VulkanShaderInstance::GetPipelineForState(const VulkanPipelineState &state) const
 {
+  const PipelineMap *pipelines = Pipelines.load(std::memory_order_acquire);
+  if(pipelines)
+    if(const auto it = pipelines->find(state); it != pipelines->end()) return it->second;
+
   std::lock_guard guard(PipelinesListMutex);
 
-  for(const auto &[it_state, it_pipeline] : PipelinesWithState)
-    if(state == it_state) return it_pipeline;
+  // Another thread may have created this pipeline while we were waiting for the lock.
+  pipelines = Pipelines.load(std::memory_order_acquire);
+  if(pipelines)
+    if(const auto it = pipelines->find(state); it != pipelines->end()) return it->second;
+
+  VkPipeline pipeline = CreatePipeline(state);
+
+  auto next = pipelines ? std::make_unique<PipelineMap>(*pipelines) : std::make_unique<PipelineMap>();
+  next->emplace(state, pipeline);
+  Pipelines.store(next.get(), std::memory_order_release);
+  PipelineMaps.emplace_back(std::move(next));
+
+  return pipeline;
+}
+
+VkPipeline VulkanObjects::VulkanShaderInstance::GetGeneratorPipeline() const
+{
+  if(!ComputeShader) return nullptr;
+  std::call_once(GeneratorCreated, [this] { CreateGenerator(); });
+  return GeneratorPipeline;
+}
+
+void VulkanObjects::VulkanShaderInstance::CreateGenerator() const
+{
+  // The records are read from the first storage buffer, the vertices written to the second.
+  std::vector<VkDescriptorSetLayoutBinding> storage_bindings;
+  for(uint32_t x = 0; x < 2; x++)
+  {
+    storage_bindings.emplace_back(
+        VulkanBootstrap::GetDescriptorSetLayoutBinding(
+            x,
+            VulkanTranslate::ShaderStage::COMPUTE,
+            VulkanTranslate::DescriptorType::STORAGE_BUFFER));
+  }
+  auto storage_create_info = VulkanBootstrap::GetDescriptorSetLayoutCreate(storage_bindings);
+  VulkanHelpers::VK_CHECK_RESULT(
+      vkCreateDescriptorSetLayout(Device->GetDevice(), &storage_create_info, nullptr, &DescriptorSetLayoutStorage),
+      __LINE__,
+      __FILE__);
+  Device->NameObject(
+      VK_OBJECT_TYPE_DESCRIPTOR_SET_LAYOUT,
+      reinterpret_cast<uint64_t>(DescriptorSetLayoutStorage),
+      Name + "_storage_layout");
+
+  // The storage buffers take the place of the textures.
+  std::vector descriptor_set_layouts = {
+      DescriptorSetLayoutUBOCommon,
+      DescriptorSetLayoutUBOSpecial,
+      DescriptorSetLayoutStorage,
+  };
+
+  VkPipelineLayoutCreateInfo pipeline_layout_info =
+      VulkanBootstrap::GetPipelineLayoutCreate(descriptor_set_layouts, {});
+  VulkanHelpers::VK_CHECK_RESULT(
+      vkCreatePipelineLayout(Device->GetDevice(), &pipeline_layout_info, nullptr, &GeneratorPipelineLayout),
+      __LINE__,
+      __FILE__);
+  Device->NameObject(
+      VK_OBJECT_TYPE_PIPELINE_LAYOUT,
+      reinterpret_cast<uint64_t>(GeneratorPipelineLayout),
+      Name + "_generator_pipeline_layout");
+
+  VkComputePipelineCreateInfo pipeline_info{};
+  pipeline_info.sType  = VK_STRUCTURE_TYPE_COMPUTE_PIPELINE_CREATE_INFO;
+  pipeline_info.layout = GeneratorPipelineLayout;
+  pipeline_info.stage  = ComputeShaderStage;
+  VulkanHelpers::VK_CHECK_RESULT(
+      vkCreateComputePipelines(
+          Device->GetDevice(),
+          Device->GetPipelineCache(),
+          1,
+          &pipeline_info,
+          nullptr,
+          &GeneratorPipeline),
+      __LINE__,
+      __FILE__);
+  Device->NameObject(VK_OBJECT_TYPE_PIPELINE, reinterpret_cast<uint64_t>(GeneratorPipeline), Name + "_generator");
+}
 
+VkPipeline VulkanObjects::VulkanShaderInstance::CreatePipeline(const VulkanPipelineState &state) const
+{
   // We are using a dynamic viewport and scissor.
   constexpr std::array DYNAMIC_STATES = {
       VK_DYNAMIC_STATE_VIEWPORT,
@@ -189,16 +276,29 @@ VkPipeline VulkanObjects::VulkanShaderInstance::GetPipelineForState(const Vulkan
   viewport_state_info.viewportCount = 1;
   viewport_state_info.scissorCount  = 1;
 
-  // Create Vertex Input Info:
-  VkVertexInputBindingDescription vertex_input_binding_info{};
-  vertex_input_binding_info.binding   = 0;
-  vertex_input_binding_info.stride    = Info.GetVertexSize();
-  vertex_input_binding_info.inputRate = VK_VERTEX_INPUT_RATE_VERTEX;
-  std::vector<VkVertexInputAttributeDescription> vertex_attrib_info{};
+  // Create Vertex Input Info, per instance inputs are read from a second binding:
+  std::vector<VkVertexInputBindingDescription> vertex_input_binding_info(1);
+  vertex_input_binding_info[0].binding   = 0;
+  vertex_input_binding_info[0].stride    = Info.GetVertexSize();
+  vertex_input_binding_info[0].inputRate = VK_VERTEX_INPUT_RATE_VERTEX;
+  if(!Info.GetInstanceAttribs().empty())
+  {
+    auto &instance_binding     = vertex_input_binding_info.emplace_back();
+    instance_binding.binding   = 1;
+    instance_binding.stride    = Info.GetInstanceSize();
+    instance_binding.inputRate = VK_VERTEX_INPUT_RATE_INSTANCE;
+  }
+  std::vector<std::pair<uint32_t, ShaderInfo::VertexAttrib>> attribs;
   for(const auto &v_attrib : Info.GetVertexAttribs())
+    attribs.emplace_back(0, v_attrib);
+  for(const auto &i_attrib : Info.GetInstanceAttribs())
+    attribs.emplace_back(1, i_attrib);
+
+  std::vector<VkVertexInputAttributeDescription> vertex_attrib_info{};
+  for(const auto &[binding, v_attrib] : attribs)
   {
     VkVertexInputAttributeDescription attribute_description;
-    attribute_description.binding  = 0;
+    attribute_description.binding  = binding;
     attribute_description.location = v_attrib.Location;
     attribute_description.offset   = v_attrib.Offset;
     switch(v_attrib.Type)
@@ -225,8 +325,8 @@ VkPipeline VulkanObjects::VulkanShaderInstance::GetPipelineForState(const Vulkan
 
   VkPipelineVertexInputStateCreateInfo vertex_input_info{};
   vertex_input_info.sType                           = VK_STRUCTURE_TYPE_PIPELINE_VERTEX_INPUT_STATE_CREATE_INFO;
-  vertex_input_info.vertexBindingDescriptionCount   = 1;
-  vertex_input_info.pVertexBindingDescriptions      = &vertex_input_binding_info;
+  vertex_input_info.vertexBindingDescriptionCount   = static_cast<uint32_t>(vertex_input_binding_info.size());
+  vertex_input_info.pVertexBindingDescriptions      = vertex_input_binding_info.data();
   vertex_input_info.vertexAttributeDescriptionCount = static_cast<uint32_t>(vertex_attrib_info.size());
   vertex_input_info.pVertexAttributeDescriptions    = vertex_attrib_info.data();
 
@@ -307,13 +407,12 @@ VkPipeline VulkanObjects::VulkanShaderInstance::GetPipelineForState(const Vulkan
   pipeline_info.basePipelineHandle  = VK_NULL_HANDLE; // Optional
   pipeline_info.basePipelineIndex   = -1;
 
-  auto &it = PipelinesWithState.emplace_back(state, nullptr);
-
+  VkPipeline pipeline = nullptr;
   VulkanHelpers::VK_CHECK_RESULT(
-      vkCreateGraphicsPipelines(Device->GetDevice(), VK_NULL_HANDLE, 1, &pipeline_info, nullptr, &it.second),
+      vkCreateGraphicsPipelines(Device->GetDevice(), Device->GetPipelineCache(), 1, &pipeline_info, nullptr, &pipeline),
       __LINE__,
       __FILE__);
-  Device->NameObject(VK_OBJECT_TYPE_PIPELINE, reinterpret_cast<uint64_t>(it.second), Name + "_pipeline");
+  Device->NameObject(VK_OBJECT_TYPE_PIPELINE, reinterpret_cast<uint64_t>(pipeline), Name + "_pipeline");
 
-  return it.second;
+  return pipeline;
 }
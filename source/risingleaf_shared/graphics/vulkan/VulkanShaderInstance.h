@@ -17,9 +17,13 @@
 #ifndef VULKANSHADERINSTANCE_H
 #define VULKANSHADERINSTANCE_H
 
+#include <atomic>
+#include <memory>
 #include <mutex>
+#include <unordered_map>
 #include <vulkan/vulkan_core.h>
 
+#include "VulkanPipelineState.h"
 #include "graphics/ShaderInfo.h"
 #include "graphics/graphics_toplevel_defines.h"
 
@@ -30,7 +34,6 @@ namespace File
 namespace VulkanObjects
 {
   class VulkanDeviceInstance;
-  struct VulkanPipelineState;
 
   class VulkanShaderInstance final : public GraphicsTypes::ShaderInstance
   {
@@ -49,13 +52,30 @@ namespace VulkanObjects
     VkPipelineShaderStageCreateInfo FragmentShaderStage{};
     VkPipelineShaderStageCreateInfo ComputeShaderStage{};
 
-    mutable std::vector<std::pair<VulkanPipelineState, VkPipeline>> PipelinesWithState;
-    mutable std::mutex                                              PipelinesListMutex;
+    using PipelineMap = std::unordered_map<VulkanPipelineState, VkPipeline, VulkanPipelineStateHash>;
+
+    // The pipelines are looked up on every draw call, so readers don't take a lock: a new
+    // pipeline is added to a copy of the map, which then replaces the published one. The
+    // replaced maps are kept alive until the shader is destroyed, since a reader may still
+    // be looking at them. Only a handful of pipelines exist per shader, so this is cheap.
+    mutable std::atomic<const PipelineMap *>               Pipelines = nullptr;
+    mutable std::vector<std::unique_ptr<const PipelineMap>> PipelineMaps;
+    mutable std::mutex                                      PipelinesListMutex;
+
+    // The pipeline to generate vertices with the compute stage. It is only created once it
+    // is used, since the compute stages of other shaders bind their inputs differently.
+    mutable VkDescriptorSetLayout DescriptorSetLayoutStorage = nullptr;
+    mutable VkPipelineLayout      GeneratorPipelineLayout    = nullptr;
+    mutable VkPipeline            GeneratorPipeline          = nullptr;
+    mutable std::once_flag        GeneratorCreated;
 
     const VulkanDeviceInstance *Device;
 
     std::string Name;
 
+    VkPipeline CreatePipeline(const VulkanPipelineState &state) const;
+    void       CreateGenerator() const;
+
   public:
     VulkanShaderInstance(
         const VulkanDeviceInstance            *device,
@@ -82,6 +102,11 @@ namespace VulkanObjects
       return DescriptorSetLayoutTexturesSpecial;
     }
     [[nodiscard]] VkPipelineLayout GetPipelineLayout() const { return PipelineLayout; }
+
+    // Get the compute pipeline that generates vertices, or nullptr if this shader has no compute stage.
+    VkPipeline                          GetGeneratorPipeline() const;
+    [[nodiscard]] VkPipelineLayout      GetGeneratorPipelineLayout() const { return GeneratorPipelineLayout; }
+    [[nodiscard]] VkDescriptorSetLayout GetDescriptorSetLayoutStorage() const { return DescriptorSetLayoutStorage; }
   };
 } // namespace VulkanObjects
 
@@ -32,6 +32,57 @@ void VulkanObjects::VulkanSwapChainInstance::Create(
 
   cmd.Begin();
 
+  GraphicsTypes::FrameBufferInfo info{};
+  info.Format    = GraphicsTypes::ImageFormat::BGRA;
+  info.Presenter = true;
+  info.Samples   = 4;
+  info.HasColor  = true;
+  info.HasDepth  = true;
+  GraphicsTypes::StateInfo state{};
+  state.Color      = true;
+  state.Depth      = true;
+  state.Samples    = 4;
+  state.DepthTest  = true;
+  state.DepthWrite = true;
+
+  if(Device->IsOffscreen())
+  {
+    info.Width  = width;
+    info.Height = height;
+
+    // The images can be copied out of, so that rendered frames can be read back.
+    auto create_info = VulkanBootstrap::GetImageCreate(
+        GraphicsTypes::TextureType::TYPE_2D,
+        info.Format,
+        GraphicsTypes::TextureTarget::DRAW,
+        1,
+        width,
+        height,
+        1,
+        1,
+        1);
+    create_info.usage |= VK_IMAGE_USAGE_TRANSFER_SRC_BIT;
+
+    VmaAllocationCreateInfo allocation_create_info{};
+    allocation_create_info.usage = VMA_MEMORY_USAGE_AUTO;
+
+    // There is nothing to wait for before drawing into an image again, so one per frame in flight is enough.
+    OffscreenImages.resize(VulkanDeviceInstance::MAX_FRAMES_IN_FLIGHT);
+    for(auto &[image, allocation] : OffscreenImages)
+    {
+      VulkanHelpers::VK_CHECK_RESULT(
+          vmaCreateImage(Device->GetAllocator(), &create_info, &allocation_create_info, &image, &allocation, nullptr),
+          __LINE__,
+          __FILE__);
+      Device->NameObject(VK_OBJECT_TYPE_IMAGE, reinterpret_cast<uint64_t>(image), "offscreen_image");
+      FrameBuffers.emplace_back(
+          std::make_unique<VulkanFrameBufferInstance>(Device, cmd.Get(), info, state, image, "offscreen"));
+    }
+
+    cmd.End();
+    return;
+  }
+
   const VulkanHelpers::SwapChainSupportDetails swap_chain_support =
       VulkanHelpers::AcquireSwapChainSupportDetails(Device->GetPhysicalDevice(), Device->GetSurface());
 
@@ -66,20 +117,8 @@ void VulkanObjects::VulkanSwapChainInstance::Create(
   images.resize(image_count);
   vkGetSwapchainImagesKHR(Device->GetDevice(), SwapChain, &image_count, images.data());
 
-  GraphicsTypes::FrameBufferInfo info{};
-  info.Format    = GraphicsTypes::ImageFormat::BGRA;
-  info.Width     = extent_2d.width;
-  info.Height    = extent_2d.height;
-  info.Presenter = true;
-  info.Samples   = 4;
-  info.HasColor  = true;
-  info.HasDepth  = true;
-  GraphicsTypes::StateInfo state{};
-  state.Color      = true;
-  state.Depth      = true;
-  state.Samples    = 4;
-  state.DepthTest  = true;
-  state.DepthWrite = true;
+  info.Width  = extent_2d.width;
+  info.Height = extent_2d.height;
   for(uint32_t i = 0; i < image_count; i++)
   {
     FrameBuffers.emplace_back(
@@ -104,6 +143,20 @@ void VulkanObjects::VulkanSwapChainInstance::Create(
   }
 }
 
+void VulkanObjects::VulkanSwapChainInstance::Destroy()
+{
+  FrameBuffers.clear();
+  for(const auto &semaphore : RenderFinishedSemaphores)
+    vkDestroySemaphore(Device->GetDevice(), semaphore, nullptr);
+  RenderFinishedSemaphores.clear();
+  for(const auto &[image, allocation] : OffscreenImages)
+    Device->QueueImageForDeletion(image, allocation);
+  OffscreenImages.clear();
+
+  if(SwapChain) vkDestroySwapchainKHR(Device->GetDevice(), SwapChain, nullptr);
+  SwapChain = nullptr;
+}
+
 VulkanObjects::VulkanSwapChainInstance::VulkanSwapChainInstance(
     const VulkanDeviceInstance *device,
     const VulkanCommandPool    *command_pool,
@@ -114,13 +167,7 @@ VulkanObjects::VulkanSwapChainInstance::VulkanSwapChainInstance(
   Create(command_pool, width, height);
 }
 
-VulkanObjects::VulkanSwapChainInstance::~VulkanSwapChainInstance()
-{
-  if(SwapChain) vkDestroySwapchainKHR(Device->GetDevice(), SwapChain, nullptr);
-  for(const auto &semaphore : RenderFinishedSemaphores)
-    vkDestroySemaphore(Device->GetDevice(), semaphore, nullptr);
-  RenderFinishedSemaphores.clear();
-}
+VulkanObjects::VulkanSwapChainInstance::~VulkanSwapChainInstance() { Destroy(); }
 
 void VulkanObjects::VulkanSwapChainInstance::Recreate(
     const VulkanCommandPool *command_pool,
@@ -129,12 +176,7 @@ void VulkanObjects::VulkanSwapChainInstance::Recreate(
 {
   vkDeviceWaitIdle(Device->GetDevice());
 
-  FrameBuffers.clear();
-  for(const auto &semaphore : RenderFinishedSemaphores)
-    vkDestroySemaphore(Device->GetDevice(), semaphore, nullptr);
-  RenderFinishedSemaphores.clear();
-
-  if(SwapChain) vkDestroySwapchainKHR(Device->GetDevice(), SwapChain, nullptr);
+  Destroy();
 
   Create(command_pool, width, height);
 }
@@ -144,6 +186,8 @@ bool VulkanObjects::VulkanSwapChainInstance::BeginFrame(
     const uint32_t           width,
     const uint32_t           height)
 {
+  if(!SwapChain) return true;
+
   const auto result = vkAcquireNextImageKHR(
       Device->GetDevice(),
       SwapChain,
@@ -162,6 +206,8 @@ void VulkanObjects::VulkanSwapChainInstance::EndFrame(
     const uint32_t           width,
     const uint32_t           height)
 {
+  if(!SwapChain) return;
+
   const VkSemaphore wait_semaphores[] = {RenderFinishedSemaphores[ImageIndex]};
   VkPresentInfoKHR  present_info{};
   present_info.sType              = VK_STRUCTURE_TYPE_PRESENT_INFO_KHR;
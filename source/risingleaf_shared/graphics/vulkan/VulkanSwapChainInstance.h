@@ -35,10 +35,14 @@ namespace VulkanObjects
     std::vector<VkSemaphore>                                RenderFinishedSemaphores{};
     uint32_t                                                ImageIndex = 0;
 
+    // Without a surface, frames are rendered into these images instead of a swap chain.
+    std::vector<std::pair<VkImage, VmaAllocation>> OffscreenImages;
+
     const VulkanDeviceInstance *Device;
 
 
     void Create(const VulkanCommandPool *command_pool, uint32_t width, uint32_t height);
+    void Destroy();
 
   public:
     VulkanSwapChainInstance(
@@ -64,7 +68,16 @@ namespace VulkanObjects
     {
       return FrameBuffers[Device->GetCurrentFrame()].get();
     }
+    [[nodiscard]] const std::vector<std::unique_ptr<VulkanFrameBufferInstance>> &GetFrameBuffers() const
+    {
+      return FrameBuffers;
+    }
     [[nodiscard]] VkSemaphore GetRenderFinished() const { return RenderFinishedSemaphores[ImageIndex]; }
+    // The image the current frame is rendered into, if rendering offscreen.
+    [[nodiscard]] VkImage GetOffscreenImage() const
+    {
+      return OffscreenImages.empty() ? nullptr : OffscreenImages[Device->GetCurrentFrame()].first;
+    }
   };
 } // namespace VulkanObjects
 
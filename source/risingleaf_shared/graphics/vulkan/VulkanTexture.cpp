@@ -16,6 +16,7 @@
 //
 #include "VulkanTexture.h"
 
+#include <atomic>
 #include <cassert>
 #include <cstring>
 
@@ -25,6 +26,11 @@
 #include "VulkanHelpers.h"
 
 
+namespace
+{
+  std::atomic<uint64_t> next_texture_id{1};
+} // namespace
+
 VulkanObjects::VulkanImageInstance::VulkanImageInstance(
     const VulkanDeviceInstance        *device,
     const std::string_view             name,
@@ -245,7 +251,8 @@ VulkanObjects::VulkanTextureInstance::VulkanTextureInstance(
     const std::string_view            name,
     VkCommandBuffer                   cmd,
     const void                       *data,
-    const GraphicsTypes::TextureInfo &info)
+    const GraphicsTypes::TextureInfo &info) :
+  Id(next_texture_id++)
 {
   Info  = info;
   Image = std::make_unique<VulkanImageInstance>(
@@ -286,7 +293,8 @@ VulkanObjects::VulkanTextureInstance::VulkanTextureInstance(
     const std::string_view            name,
     const VulkanImageInstance        *image,
     const VulkanViewInstance         *view,
-    const GraphicsTypes::TextureInfo &info)
+    const GraphicsTypes::TextureInfo &info) :
+  Id(next_texture_id++)
 {
   Info      = info;
   ImageLink = image;
@@ -17,6 +17,7 @@
 #ifndef VULKANTEXTURE_H
 #define VULKANTEXTURE_H
 
+#include <cstdint>
 #include <memory>
 #include <optional>
 
@@ -144,6 +145,10 @@ namespace VulkanObjects
     std::optional<const VulkanImageInstance *> ImageLink;
     std::optional<const VulkanViewInstance *>  ViewLink;
 
+    // Unique for every texture ever created, so that cached descriptor sets
+    // can never be mistaken for ones of a texture created at the same address.
+    const uint64_t Id;
+
   public:
     VulkanTextureInstance(
         const VulkanDeviceInstance       *device,
@@ -176,6 +181,7 @@ namespace VulkanObjects
       return ViewLink.has_value() ? ViewLink.value() : View.get();
     }
     [[nodiscard]] const VulkanSamplerInstance *GetSampler() const { return Sampler.get(); }
+    [[nodiscard]] uint64_t                     GetId() const { return Id; }
   };
 } // namespace VulkanObjects
 
@@ -47,6 +47,7 @@ namespace VulkanTranslate
     UNIFORM_BUFFER,
     TEXTURE,
     STORAGE_TEXTURE,
+    STORAGE_BUFFER,
   };
   enum class AttachmentType : uint8_t
   {
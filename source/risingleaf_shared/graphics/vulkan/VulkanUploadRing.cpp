@@ -0,0 +1,84 @@
+//
+// This file is part of Astrolative.
+//
+// Copyright (c) 2026 by Torben Hans
+//
+// Astrolative is free software: you can redistribute it and/or modify it under the
+// terms of the GNU General Public License as published by the Free Software
+// Foundation, either version 3 of the License, or (at your option) any later version.
+//
+//  Astrolative is distributed in the hope that it will be useful, but WITHOUT ANY
+//  WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS FOR A
+//  PARTICULAR PURPOSE. See the GNU General Public License for more details.
+//
+//  You should have received a copy of the GNU General Public License along with Astrolative. If not, see
+//  <https://www.gnu.org/licenses/>.
+//
+#include "VulkanUploadRing.h"
+
+#include <string>
+
+#include "VulkanHelpers.h"
+
+
+VulkanObjects::VulkanUploadRing::VulkanUploadRing(
+    const VulkanDeviceInstance *device,
+    const size_t                size,
+    const std::string_view      name) :
+  Size(size), Device(device)
+{
+  // Compute shaders that generate vertices read their input from the ring and write the vertices back into it.
+  const VkBufferUsageFlags usage =
+      VK_BUFFER_USAGE_UNIFORM_BUFFER_BIT | VK_BUFFER_USAGE_VERTEX_BUFFER_BIT | VK_BUFFER_USAGE_STORAGE_BUFFER_BIT;
+
+  VkBufferCreateInfo create_info{};
+  create_info.sType       = VK_STRUCTURE_TYPE_BUFFER_CREATE_INFO;
+  create_info.size        = size;
+  create_info.usage       = usage;
+  create_info.sharingMode = VK_SHARING_MODE_EXCLUSIVE;
+
+  VmaAllocationCreateInfo vma_allocation_create_info{};
+  vma_allocation_create_info.usage         = VMA_MEMORY_USAGE_AUTO;
+  vma_allocation_create_info.requiredFlags = VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT | VK_MEMORY_PROPERTY_HOST_COHERENT_BIT;
+  vma_allocation_create_info.flags =
+      VMA_ALLOCATION_CREATE_HOST_ACCESS_SEQUENTIAL_WRITE_BIT | VMA_ALLOCATION_CREATE_MAPPED_BIT;
+
+  for(size_t i = 0; i < Buffers.size(); i++)
+  {
+    VmaAllocationInfo allocation_info{};
+    VulkanHelpers::VK_CHECK_RESULT(
+        vmaCreateBuffer(
+            Device->GetAllocator(),
+            &create_info,
+            &vma_allocation_create_info,
+            &Buffers[i].Buffer,
+            &Buffers[i].Allocation,
+            &allocation_info),
+        __LINE__,
+        __FILE__);
+    Buffers[i].Data = static_cast<unsigned char *>(allocation_info.pMappedData);
+    Device->NameObject(
+        VK_OBJECT_TYPE_BUFFER,
+        reinterpret_cast<uint64_t>(Buffers[i].Buffer),
+        std::string(name) + "_" + std::to_string(i));
+  }
+}
+
+VulkanObjects::VulkanUploadRing::~VulkanUploadRing()
+{
+  for(const auto &buffer : Buffers)
+    Device->QueueBufferForDeletion(buffer.Buffer, buffer.Allocation);
+}
+
+void VulkanObjects::VulkanUploadRing::BeginFrame() const { Offset = 0; }
+
+unsigned char *
+VulkanObjects::VulkanUploadRing::Allocate(const size_t size, const size_t alignment, VkDeviceSize &offset) const
+{
+  const size_t start = (Offset + alignment - 1) & ~(alignment - 1);
+  if(start + size > Size) return nullptr;
+
+  offset = start;
+  Offset = start + size;
+  return Buffers[Device->GetCurrentFrame()].Data + start;
+}
@@ -0,0 +1,73 @@
+//
+// This file is part of Astrolative.
+//
+// Copyright (c) 2026 by Torben Hans
+//
+// Astrolative is free software: you can redistribute it and/or modify it under the
+// terms of the GNU General Public License as published by the Free Software
+// Foundation, either version 3 of the License, or (at your option) any later version.
+//
+//  Astrolative is distributed in the hope that it will be useful, but WITHOUT ANY
+//  WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS FOR A
+//  PARTICULAR PURPOSE. See the GNU General Public License for more details.
+//
+//  You should have received a copy of the GNU General Public License along with Astrolative. If not, see
+//  <https://www.gnu.org/licenses/>.
+//
+#ifndef VULKANUPLOADRING_H
+#define VULKANUPLOADRING_H
+
+#include <array>
+
+#include <vulkan/vulkan_core.h>
+
+#include "VulkanDeviceInstance.h"
+#include "external/vk_mem_alloc.h"
+
+
+namespace VulkanObjects
+{
+  // A persistently mapped buffer per frame in flight, that per frame data like
+  // uniforms and dynamic vertices is written into directly while recording.
+  // Allocations are linear and the whole buffer is reused once the frame that
+  // used it last is done.
+  class VulkanUploadRing final
+  {
+    struct FrameBuffer
+    {
+      VkBuffer       Buffer     = nullptr;
+      VmaAllocation  Allocation = nullptr;
+      unsigned char *Data       = nullptr;
+    };
+    std::array<FrameBuffer, VulkanDeviceInstance::MAX_FRAMES_IN_FLIGHT> Buffers{};
+
+    const size_t   Size;
+    mutable size_t Offset = 0;
+
+    const VulkanDeviceInstance *Device;
+
+  public:
+    VulkanUploadRing(const VulkanDeviceInstance *device, size_t size, std::string_view name);
+
+    ~VulkanUploadRing();
+
+    VulkanUploadRing(const VulkanUploadRing &other)                = delete;
+    VulkanUploadRing(VulkanUploadRing &&other) noexcept            = delete;
+    VulkanUploadRing &operator=(const VulkanUploadRing &other)     = delete;
+    VulkanUploadRing &operator=(VulkanUploadRing &&other) noexcept = delete;
+
+    // Start allocating from the beginning of the buffer of the current frame.
+    void BeginFrame() const;
+
+    // Reserve the given number of bytes in the buffer of the current frame and
+    // return where to write them, or nullptr if the buffer is full.
+    unsigned char *Allocate(size_t size, size_t alignment, VkDeviceSize &offset) const;
+
+    [[nodiscard]] VkBuffer Get() const { return Buffers[Device->GetCurrentFrame()].Buffer; }
+    [[nodiscard]] size_t   GetSize() const { return Size; }
+    [[nodiscard]] size_t   GetUsed() const { return Offset; }
+  };
+} // namespace VulkanObjects
+
+
+#endif // VULKANUPLOADRING_H
@@ -14,9 +14,13 @@
 //  You should have received a copy of the GNU General Public License along with Astrolative. If not, see
 //  <https://www.gnu.org/licenses/>.
 //
+#include <algorithm>
 #include <array>
+#include <chrono>
 #include <cstring>
 #include <stdexcept>
+#include <thread>
+#include <utility>
 #include <vector>
 
 #include "graphics/ShaderInfo.h"
@@ -33,297 +37,311 @@
 #include "VulkanDeviceInstance.h"
 #include "VulkanFrameBufferInstance.h"
 #include "VulkanHelpers.h"
+#include "VulkanParallelRecorder.h"
 #include "VulkanPipelineState.h"
 #include "VulkanShaderInstance.h"
 #include "VulkanSwapChainInstance.h"
 #include "VulkanTexture.h"
+#include "VulkanUploadRing.h"
 
 #define VMA_IMPLEMENTATION
 #include "external/vk_mem_alloc.h"
 
 namespace graphics_vulkan
 {
-  void BindBuffers(
-      const VulkanGraphicsInstance               *graphics_instance,
-      const VulkanObjects::VulkanShaderInstance  *current_shader_instance,
-      const GraphicsTypes::BufferInstance *const *buffer_instance,
-      const int                                   count,
-      const GraphicsTypes::UBOBindPoint           bind_point,
-      const int                                   set,
-      const size_t                                offset,
-      const size_t                                size)
-  {
-    if(!buffer_instance)
-    {
-      Log::Error << "Trying to bind invalid buffer." << Log::End;
-      return;
-    }
-    auto *const *vulkan_buffer_instances =
-        reinterpret_cast<const VulkanObjects::VulkanBufferInstance *const *>(buffer_instance);
-
-    VkDescriptorSet descriptor_set = nullptr;
-    switch(bind_point)
-    {
-    case GraphicsTypes::UBOBindPoint::Common:
-      descriptor_set = graphics_instance->DescriptorPool->AllocateDescriptorSet(
-          current_shader_instance->GetDescriptorSetLayoutUBOCommon());
-      break;
-    case GraphicsTypes::UBOBindPoint::Specific:
-      descriptor_set = graphics_instance->DescriptorPool->AllocateDescriptorSet(
-          current_shader_instance->GetDescriptorSetLayoutUBOSpecial());
-      break;
-    }
+  // The largest minUniformBufferOffsetAlignment any implementation may have.
+  constexpr size_t UNIFORM_ALIGNMENT = 256;
+  constexpr size_t VERTEX_ALIGNMENT  = 16;
+  // The largest minStorageBufferOffsetAlignment any implementation may have.
+  constexpr size_t STORAGE_ALIGNMENT = 256;
+
+  // Render passes with fewer commands than this are recorded inline, since splitting
+  // them up would cost more than it saves.
+  constexpr size_t PARALLEL_RECORDING_THRESHOLD = 2048;
+  // The least number of commands worth recording on another thread.
+  constexpr size_t COMMANDS_PER_THREAD = 1024;
+  // Common uniforms, specific uniforms and textures.
+  constexpr size_t DESCRIPTOR_SET_COUNT = 3;
+
+  // The state recorded commands depend on that earlier commands set up. Secondary
+  // command buffers inherit none of it, so each of them starts by restoring it.
+  struct CommandState
+  {
+    const VulkanObjects::VulkanShaderInstance        *Shader       = nullptr;
+    VkBuffer                                          VertexBuffer = nullptr;
+    VkDeviceSize                                      VertexOffset = 0;
+    VkBuffer                                          IndexBuffer  = nullptr;
+    // The descriptor sets are only valid for the pipeline layout they were bound with.
+    VkPipelineLayout                                  Layout = nullptr;
+    std::array<VkDescriptorSet, DESCRIPTOR_SET_COUNT> DescriptorSets{};
+  };
+
+  void SetViewport(const VkCommandBuffer command_buffer, const VkExtent2D extent)
+  {
+    VkViewport viewport{};
+    viewport.x        = 0.0f;
+    viewport.y        = 0.0f;
+    viewport.width    = static_cast<float>(extent.width);
+    viewport.height   = static_cast<float>(extent.height);
+    viewport.minDepth = 0.0f;
+    viewport.maxDepth = 1.0f;
+    vkCmdSetViewport(command_buffer, 0, 1, &viewport);
+    VkRect2D scissor{};
+    scissor.offset = {0, 0};
+    scissor.extent = extent;
+    vkCmdSetScissor(command_buffer, 0, 1, &scissor);
+  }
 
-    for(int i = 0; i < count; i++)
+  void RestoreState(const VkCommandBuffer command_buffer, const CommandState &state)
+  {
+    if(state.VertexBuffer) vkCmdBindVertexBuffers(command_buffer, 0, 1, &state.VertexBuffer, &state.VertexOffset);
+    if(state.IndexBuffer) vkCmdBindIndexBuffer(command_buffer, state.IndexBuffer, 0, VK_INDEX_TYPE_UINT32);
+    if(!state.Shader || state.Shader->GetPipelineLayout() != state.Layout) return;
+    for(uint32_t set = 0; set < DESCRIPTOR_SET_COUNT; set++)
     {
-      VkDescriptorBufferInfo buffer_info{};
-      buffer_info.buffer = vulkan_buffer_instances[i]->Get();
-      buffer_info.offset = offset;
-      buffer_info.range  = size ? size : vulkan_buffer_instances[i]->GetSize();
-
-      VkWriteDescriptorSet descriptor_write{};
-      descriptor_write.sType            = VK_STRUCTURE_TYPE_WRITE_DESCRIPTOR_SET;
-      descriptor_write.dstSet           = descriptor_set;
-      descriptor_write.dstBinding       = i;
-      descriptor_write.dstArrayElement  = 0;
-      descriptor_write.descriptorType   = VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER;
-      descriptor_write.descriptorCount  = 1;
-      descriptor_write.pBufferInfo      = &buffer_info;
-      descriptor_write.pImageInfo       = nullptr;
-      descriptor_write.pTexelBufferView = nullptr;
-
-      vkUpdateDescriptorSets(graphics_instance->Device->GetDevice(), 1, &descriptor_write, 0, nullptr);
+      if(!state.DescriptorSets[set]) continue;
+      vkCmdBindDescriptorSets(
+          command_buffer,
+          VK_PIPELINE_BIND_POINT_GRAPHICS,
+          state.Layout,
+          set,
+          1,
+          &state.DescriptorSets[set],
+          0,
+          nullptr);
     }
-
-    vkCmdBindDescriptorSets(
-        graphics_instance->CommandBuffers[graphics_instance->Device->GetCurrentFrame()],
-        VK_PIPELINE_BIND_POINT_GRAPHICS,
-        current_shader_instance->GetPipelineLayout(),
-        set,
-        1,
-        &descriptor_set,
-        0,
-        nullptr);
   }
 
-  void SubmitDrawCommands(const VulkanGraphicsInstance *graphics_instance)
+  void TrackCommand(const VulkanGraphicsInstance *graphics_instance, const size_t command, CommandState &state)
   {
-    // Populate dynamic buffers:
-    std::vector<uint32_t> common_offsets;
-    std::vector<uint32_t> custom_offsets;
-    std::vector<uint32_t> vertex_offsets;
+    const auto &[type, index] = graphics_instance->CommandsRecorded[command];
+    switch(type)
     {
-      void *to_data;
-      graphics_instance->DynamicUniformBuffersCommon[graphics_instance->Device->GetCurrentFrame()]->Map(&to_data);
-      for(const auto &buffer : graphics_instance->CommonUniformBufferBindings)
+    case CommandType::SHADER_BIND:
       {
-        memcpy(
-            static_cast<unsigned char *>(to_data) + graphics_instance->DynamicUniformBuffersCommonOffset,
-            buffer.data(),
-            buffer.size());
-
-        common_offsets.emplace_back(graphics_instance->DynamicUniformBuffersCommonOffset);
-
-        graphics_instance->DynamicUniformBuffersCommonOffset += buffer.size();
-        graphics_instance->DynamicUniformBuffersCommonOffset =
-            (graphics_instance->DynamicUniformBuffersCommonOffset + 255) & ~(255);
+        state.Shader = graphics_instance->BoundShaders[index];
+        // Sets bound with a different layout can not be used with this shader.
+        const VkPipelineLayout layout = state.Shader ? state.Shader->GetPipelineLayout() : nullptr;
+        if(layout != state.Layout)
+        {
+          state.Layout = layout;
+          state.DescriptorSets.fill(nullptr);
+        }
+        break;
       }
-      graphics_instance->DynamicUniformBuffersCommon[graphics_instance->Device->GetCurrentFrame()]->UnMap();
-    }
-    {
-      void *to_data;
-      graphics_instance->DynamicUniformBuffersSpecific[graphics_instance->Device->GetCurrentFrame()]->Map(&to_data);
-      for(const auto &buffer : graphics_instance->CustomUniformBufferBindings)
+    case CommandType::INDEX_BIND: state.IndexBuffer = graphics_instance->BoundBuffers[index]->Get(); break;
+    case CommandType::VERTEX_BIND:
       {
-        memcpy(
-            static_cast<unsigned char *>(to_data) + graphics_instance->DynamicUniformBuffersSpecificOffset,
-            buffer.data(),
-            buffer.size());
-
-        custom_offsets.emplace_back(graphics_instance->DynamicUniformBuffersSpecificOffset);
-
-        graphics_instance->DynamicUniformBuffersSpecificOffset += buffer.size();
-        graphics_instance->DynamicUniformBuffersSpecificOffset =
-            (graphics_instance->DynamicUniformBuffersSpecificOffset + 255) & ~(255);
+        state.VertexBuffer = graphics_instance->BoundBuffers[index]->Get();
+        state.VertexOffset = 0;
+        break;
       }
-      graphics_instance->DynamicUniformBuffersSpecific[graphics_instance->Device->GetCurrentFrame()]->UnMap();
-    }
-    {
-      void *to_data;
-      graphics_instance->DynamicVertexBuffers[graphics_instance->Device->GetCurrentFrame()]->Map(&to_data);
-      for(const auto &buffer : graphics_instance->DynamicDrawCalls)
+    case CommandType::DESCRIPTOR_SET_BIND:
       {
-        memcpy(
-            static_cast<unsigned char *>(to_data) + graphics_instance->DynamicVertexBuffersOffset,
-            buffer.Data.data(),
-            buffer.Data.size());
-
-        vertex_offsets.emplace_back(graphics_instance->DynamicVertexBuffersOffset);
-
-        graphics_instance->DynamicVertexBuffersOffset += buffer.Data.size();
-        graphics_instance->DynamicVertexBuffersOffset  = (graphics_instance->DynamicVertexBuffersOffset + 255) & ~(255);
+        const auto &binding = graphics_instance->BoundDescriptorSets[index];
+        if(state.Shader) state.DescriptorSets[binding.Set] = binding.DescriptorSet;
+        break;
       }
-      graphics_instance->DynamicVertexBuffers[graphics_instance->Device->GetCurrentFrame()]->UnMap();
+    case CommandType::DRAW_DYNAMIC:
+      {
+        state.VertexBuffer = graphics_instance->UploadRing->Get();
+        state.VertexOffset = graphics_instance->DynamicDrawCalls[index].Vertices.Offset;
+        break;
+      }
+    case CommandType::DRAW:
+    case CommandType::DRAW_INDEXED:
+    case CommandType::DRAW_INSTANCED: break;
     }
+  }
 
-    const auto &current_command_buffer =
-        graphics_instance->CommandBuffers[graphics_instance->Device->GetCurrentFrame()];
-    const VulkanObjects::VulkanShaderInstance *current_shader_instance = nullptr;
-    VkPipeline                                 current_pipeline        = nullptr;
+  void RecordCommands(
+      const VulkanGraphicsInstance *graphics_instance,
+      const VkCommandBuffer         command_buffer,
+      const size_t                  begin,
+      const size_t                  end,
+      CommandState                  state)
+  {
+    VkPipeline current_pipeline = nullptr;
+    const auto BindPipeline     = [&](const VkPipeline pipeline)
+    {
+      if(current_pipeline == pipeline) return;
+      vkCmdBindPipeline(command_buffer, VK_PIPELINE_BIND_POINT_GRAPHICS, pipeline);
+      current_pipeline = pipeline;
+    };
 
-    for(const auto &[command, index] : graphics_instance->CommandsRecorded)
+    for(size_t command = begin; command < end; command++)
     {
-      switch(command)
+      TrackCommand(graphics_instance, command, state);
+
+      const auto &[type, index] = graphics_instance->CommandsRecorded[command];
+      switch(type)
       {
-      case CommandType::SHADER_BIND:
-        {
-          current_shader_instance = graphics_instance->BoundShaders[index];
-          break;
-        }
+      case CommandType::SHADER_BIND: break;
       case CommandType::INDEX_BIND:
         {
-          vkCmdBindIndexBuffer(
-              current_command_buffer,
-              graphics_instance->BoundBuffers[index]->Get(),
-              0,
-              VK_INDEX_TYPE_UINT32);
+          vkCmdBindIndexBuffer(command_buffer, state.IndexBuffer, 0, VK_INDEX_TYPE_UINT32);
           break;
         }
       case CommandType::VERTEX_BIND:
         {
-          const VkBuffer         vertexBuffers[] = {graphics_instance->BoundBuffers[index]->Get()};
-          constexpr VkDeviceSize offsets[]       = {0};
-
-          vkCmdBindVertexBuffers(current_command_buffer, 0, 1, vertexBuffers, offsets);
+          vkCmdBindVertexBuffers(command_buffer, 0, 1, &state.VertexBuffer, &state.VertexOffset);
           break;
         }
-      case CommandType::TEXTURE_BIND:
+      case CommandType::DESCRIPTOR_SET_BIND:
         {
-          if(current_shader_instance)
+          if(state.Shader)
           {
+            const auto &binding = graphics_instance->BoundDescriptorSets[index];
             vkCmdBindDescriptorSets(
-                current_command_buffer,
+                command_buffer,
                 VK_PIPELINE_BIND_POINT_GRAPHICS,
-                current_shader_instance->GetPipelineLayout(),
-                graphics_instance->BoundTextures[index].Set,
+                state.Shader->GetPipelineLayout(),
+                binding.Set,
                 1,
-                &graphics_instance->BoundTextures[index].DescriptorSet,
+                &binding.DescriptorSet,
                 0,
                 nullptr);
           }
           break;
         }
-      case CommandType::COMMON_UNIFORM_UPDATE:
-        {
-          if(current_shader_instance)
-          {
-            auto *buffer =
-                graphics_instance->DynamicUniformBuffersCommon[graphics_instance->Device->GetCurrentFrame()].get();
-            BindBuffers(
-                graphics_instance,
-                current_shader_instance,
-                reinterpret_cast<GraphicsTypes::BufferInstance **>(&buffer),
-                1,
-                GraphicsTypes::UBOBindPoint::Common,
-                0,
-                common_offsets[index],
-                graphics_instance->CommonUniformBufferBindings[index].size());
-          }
-          break;
-        }
-      case CommandType::CUSTOM_UNIFORM_UPDATE:
-        {
-          if(current_shader_instance)
-          {
-            auto *buffer =
-                graphics_instance->DynamicUniformBuffersSpecific[graphics_instance->Device->GetCurrentFrame()].get();
-            BindBuffers(
-                graphics_instance,
-                current_shader_instance,
-                reinterpret_cast<GraphicsTypes::BufferInstance **>(&buffer),
-                1,
-                GraphicsTypes::UBOBindPoint::Specific,
-                1,
-                custom_offsets[index],
-                graphics_instance->CustomUniformBufferBindings[index].size());
-          }
-          break;
-        }
       case CommandType::DRAW:
         {
-          if(current_pipeline != graphics_instance->DrawCalls[index].Pipeline)
-          {
-            vkCmdBindPipeline(
-                current_command_buffer,
-                VK_PIPELINE_BIND_POINT_GRAPHICS,
-                graphics_instance->DrawCalls[index].Pipeline);
-            current_pipeline = graphics_instance->DrawCalls[index].Pipeline;
-          }
-          vkCmdDraw(
-              current_command_buffer,
-              graphics_instance->DrawCalls[index].Count,
-              1,
-              graphics_instance->DrawCalls[index].Start,
-              0);
+          const auto &draw = graphics_instance->DrawCalls[index];
+          BindPipeline(draw.Pipeline);
+          vkCmdDraw(command_buffer, draw.Count, 1, draw.Start, 0);
           break;
         }
       case CommandType::DRAW_INDEXED:
         {
-          if(current_pipeline != graphics_instance->DrawCalls[index].Pipeline)
-          {
-            vkCmdBindPipeline(
-                current_command_buffer,
-                VK_PIPELINE_BIND_POINT_GRAPHICS,
-                graphics_instance->DrawCalls[index].Pipeline);
-            current_pipeline = graphics_instance->DrawCalls[index].Pipeline;
-          }
-          vkCmdDrawIndexed(
-              current_command_buffer,
-              graphics_instance->DrawCalls[index].Count,
-              1,
-              graphics_instance->DrawCalls[index].Start,
-              0,
-              0);
+          const auto &draw = graphics_instance->DrawCalls[index];
+          BindPipeline(draw.Pipeline);
+          vkCmdDrawIndexed(command_buffer, draw.Count, 1, draw.Start, 0, 0);
           break;
         }
       case CommandType::DRAW_DYNAMIC:
         {
-          const VkBuffer vertexBuffers[] = {
-              graphics_instance->DynamicVertexBuffers[graphics_instance->Device->GetCurrentFrame()]->Get()};
-          const VkDeviceSize offsets[] = {vertex_offsets[index]};
+          const auto &draw = graphics_instance->DynamicDrawCalls[index];
+          vkCmdBindVertexBuffers(command_buffer, 0, 1, &state.VertexBuffer, &state.VertexOffset);
+          BindPipeline(draw.Pipeline);
+          vkCmdDraw(command_buffer, draw.Count, 1, 0, 0);
+          break;
+        }
+      case CommandType::DRAW_INSTANCED:
+        {
+          const auto &draw = graphics_instance->InstancedDrawCalls[index];
 
-          vkCmdBindVertexBuffers(current_command_buffer, 0, 1, vertexBuffers, offsets);
+          const VkBuffer     instanceBuffers[] = {graphics_instance->UploadRing->Get()};
+          const VkDeviceSize offsets[]         = {draw.Instances.Offset};
 
-          if(current_pipeline != graphics_instance->DynamicDrawCalls[index].Pipeline)
+          vkCmdBindVertexBuffers(command_buffer, 1, 1, instanceBuffers, offsets);
+
+          BindPipeline(draw.Pipeline);
+          // All ranges share the bound state, so each one is only a draw with its own first instance.
+          uint32_t first_instance = 0;
+          for(size_t i = draw.FirstRange; i < draw.FirstRange + draw.RangeCount; i++)
           {
-            vkCmdBindPipeline(
-                current_command_buffer,
-                VK_PIPELINE_BIND_POINT_GRAPHICS,
-                graphics_instance->DynamicDrawCalls[index].Pipeline);
-            current_pipeline = graphics_instance->DynamicDrawCalls[index].Pipeline;
+            const auto &range = graphics_instance->InstancedDrawRanges[i];
+            vkCmdDraw(command_buffer, range.Count, range.Instances, range.Start, first_instance);
+            first_instance += range.Instances;
           }
-          vkCmdDraw(current_command_buffer, graphics_instance->DynamicDrawCalls[index].Count, 1, 0, 0);
           break;
         }
       }
     }
+  }
+
+  void SubmitDrawCommands(const VulkanGraphicsInstance *graphics_instance)
+  {
+    const auto &current_command_buffer =
+        graphics_instance->CommandBuffers[graphics_instance->Device->GetCurrentFrame()];
+    const VkRenderPassBeginInfo &render_pass = graphics_instance->PendingRenderPass;
+    const VkExtent2D             extent      = render_pass.renderArea.extent;
+
+    // The vertices that compute shaders generated for these commands have to be written before they are read.
+    if(graphics_instance->VerticesGenerated)
+    {
+      VkMemoryBarrier2 barrier{};
+      barrier.sType         = VK_STRUCTURE_TYPE_MEMORY_BARRIER_2;
+      barrier.srcStageMask  = VK_PIPELINE_STAGE_2_COMPUTE_SHADER_BIT;
+      barrier.srcAccessMask = VK_ACCESS_2_SHADER_STORAGE_WRITE_BIT;
+      barrier.dstStageMask  = VK_PIPELINE_STAGE_2_VERTEX_ATTRIBUTE_INPUT_BIT;
+      barrier.dstAccessMask = VK_ACCESS_2_VERTEX_ATTRIBUTE_READ_BIT;
+
+      VkDependencyInfo dep_info{};
+      dep_info.sType              = VK_STRUCTURE_TYPE_DEPENDENCY_INFO;
+      dep_info.memoryBarrierCount = 1;
+      dep_info.pMemoryBarriers    = &barrier;
+
+      vkCmdPipelineBarrier2(current_command_buffer, &dep_info);
+      graphics_instance->VerticesGenerated = false;
+    }
+
+    const size_t command_count = graphics_instance->CommandsRecorded.size();
+    const size_t part_count =
+        std::min(graphics_instance->Recorder->GetThreadCount(), command_count / COMMANDS_PER_THREAD);
+    if(command_count < PARALLEL_RECORDING_THRESHOLD || part_count < 2)
+    {
+      vkCmdBeginRenderPass(current_command_buffer, &render_pass, VK_SUBPASS_CONTENTS_INLINE);
+      SetViewport(current_command_buffer, extent);
+      RecordCommands(graphics_instance, current_command_buffer, 0, command_count, {});
+    }
+    else {
+      // Split the commands into even parts, and find the state each of them starts with.
+      std::vector<size_t>       part_begin(part_count + 1);
+      std::vector<CommandState> part_state(part_count);
+      for(size_t part = 1; part <= part_count; part++)
+      {
+        part_begin[part] = command_count * part / part_count;
+        if(part == part_count) break;
+        part_state[part] = part_state[part - 1];
+        for(size_t command = part_begin[part - 1]; command < part_begin[part]; command++)
+          TrackCommand(graphics_instance, command, part_state[part]);
+      }
+
+      VkCommandBufferInheritanceInfo inheritance{};
+      inheritance.sType       = VK_STRUCTURE_TYPE_COMMAND_BUFFER_INHERITANCE_INFO;
+      inheritance.renderPass  = render_pass.renderPass;
+      inheritance.subpass     = 0;
+      inheritance.framebuffer = render_pass.framebuffer;
+
+      const auto secondary_buffers = graphics_instance->Recorder->Record(
+          part_count,
+          inheritance,
+          [&](const size_t part, const VkCommandBuffer command_buffer)
+          {
+            SetViewport(command_buffer, extent);
+            RestoreState(command_buffer, part_state[part]);
+            RecordCommands(graphics_instance, command_buffer, part_begin[part], part_begin[part + 1], part_state[part]);
+          });
+
+      vkCmdBeginRenderPass(current_command_buffer, &render_pass, VK_SUBPASS_CONTENTS_SECONDARY_COMMAND_BUFFERS);
+      vkCmdExecuteCommands(
+          current_command_buffer,
+          static_cast<uint32_t>(secondary_buffers.size()),
+          secondary_buffers.data());
+    }
+
+    auto &statistics = graphics_instance->CurrentStatistics;
+    statistics.DrawCalls += graphics_instance->DrawCalls.size() + graphics_instance->DynamicDrawCalls.size() +
+                            graphics_instance->InstancedDrawRanges.size();
+    statistics.Commands += command_count;
 
     graphics_instance->BoundShaders.clear();
     graphics_instance->BoundBuffers.clear();
-    graphics_instance->BoundTextures.clear();
+    graphics_instance->BoundDescriptorSets.clear();
     graphics_instance->DrawCalls.clear();
     graphics_instance->DynamicDrawCalls.clear();
-    graphics_instance->CommonUniformBufferBindings.clear();
-    graphics_instance->CustomUniformBufferBindings.clear();
+    graphics_instance->InstancedDrawCalls.clear();
+    graphics_instance->InstancedDrawRanges.clear();
     graphics_instance->CommandsRecorded.clear();
   }
 } // namespace graphics_vulkan
 
-graphics_vulkan::VulkanGraphicsInstance::VulkanGraphicsInstance(const int width, const int height)
+graphics_vulkan::VulkanGraphicsInstance::VulkanGraphicsInstance(const int width, const int height, const bool offscreen)
 {
   ShaderInfo::Init();
 
-  Device         = std::make_unique<VulkanObjects::VulkanDeviceInstance>();
+  Device         = std::make_unique<VulkanObjects::VulkanDeviceInstance>(offscreen);
   CommandPool    = std::make_unique<VulkanObjects::VulkanCommandPool>(Device.get());
   DescriptorPool = std::make_unique<VulkanObjects::VulkanDescriptorPool>(Device.get());
   SwapChain = std::make_unique<VulkanObjects::VulkanSwapChainInstance>(Device.get(), CommandPool.get(), width, height);
@@ -336,23 +354,31 @@ graphics_vulkan::VulkanGraphicsInstance::VulkanGraphicsInstance(const int width,
       __LINE__,
       __FILE__);
 
-  for(size_t i = 0; i < VulkanObjects::VulkanDeviceInstance::MAX_FRAMES_IN_FLIGHT; i++)
+  // Shared by common uniforms, specific uniforms, dynamic vertices and instance data.
+  UploadRing = std::make_unique<VulkanObjects::VulkanUploadRing>(Device.get(), 1024 * 1024 * 24, "upload_ring");
+
+  // Leave most cores to the game's own threads.
+  Recorder = std::make_unique<VulkanObjects::VulkanParallelRecorder>(
+      Device.get(),
+      std::min<size_t>(3, std::thread::hardware_concurrency() / 2));
+
+  const auto &limits = Device->GetProperties().limits;
+  if(limits.timestampComputeAndGraphics)
   {
-    DynamicUniformBuffersCommon[i] = std::make_unique<VulkanObjects::VulkanBufferInstance>(
-        Device.get(),
-        GraphicsTypes::BufferType::UNIFORM_DYNAMIC,
-        1024 * 1024 * 8,
-        "dynamic_ubo_cm");
-    DynamicUniformBuffersSpecific[i] = std::make_unique<VulkanObjects::VulkanBufferInstance>(
-        Device.get(),
-        GraphicsTypes::BufferType::UNIFORM_DYNAMIC,
-        1024 * 1024 * 8,
-        "dynamic_ubo_spec");
-    DynamicVertexBuffers[i] = std::make_unique<VulkanObjects::VulkanBufferInstance>(
-        Device.get(),
-        GraphicsTypes::BufferType::VERTEX_DYNAMIC,
-        1024 * 1024 * 8,
-        "dynamic_vert");
+    TimestampPeriod = limits.timestampPeriod;
+
+    VkQueryPoolCreateInfo query_pool_info{};
+    query_pool_info.sType      = VK_STRUCTURE_TYPE_QUERY_POOL_CREATE_INFO;
+    query_pool_info.queryType  = VK_QUERY_TYPE_TIMESTAMP;
+    query_pool_info.queryCount = 2;
+    for(auto &pool : TimestampPools)
+    {
+      VulkanHelpers::VK_CHECK_RESULT(
+          vkCreateQueryPool(Device->GetDevice(), &query_pool_info, nullptr, &pool),
+          __LINE__,
+          __FILE__);
+      Device->NameObject(VK_OBJECT_TYPE_QUERY_POOL, reinterpret_cast<uint64_t>(pool), "frame_timestamps");
+    }
   }
 }
 
@@ -596,21 +622,41 @@ bool graphics_vulkan::VulkanGraphicsInstance::StartDraw(const int width, const i
 {
   Device->BeginFrame();
 
-  DynamicUniformBuffersCommonOffset   = 0;
-  DynamicUniformBuffersSpecificOffset = 0;
-  DynamicVertexBuffersOffset          = 0;
+  // The last use of this frame's resources has finished, so its timestamps are available.
+  const uint8_t frame = Device->GetCurrentFrame();
+  if(TimestampsWritten[frame])
+  {
+    std::array<uint64_t, 2> timestamps{};
+    if(vkGetQueryPoolResults(
+           Device->GetDevice(),
+           TimestampPools[frame],
+           0,
+           2,
+           sizeof(timestamps),
+           timestamps.data(),
+           sizeof(uint64_t),
+           VK_QUERY_RESULT_64_BIT) == VK_SUCCESS)
+      CurrentStatistics.GpuTime = static_cast<double>(timestamps[1] - timestamps[0]) * TimestampPeriod / 1e6;
+    TimestampsWritten[frame] = false;
+  }
+
+  UploadRing->BeginFrame();
+  Recorder->BeginFrame();
 
   if(!SwapChain->BeginFrame(CommandPool.get(), width, height)) return false;
 
   DescriptorPool->BeginFrame();
 
-  vkResetCommandBuffer(CommandBuffers[Device->GetCurrentFrame()], 0);
+  vkResetCommandBuffer(CommandBuffers[frame], 0);
 
   const auto buffer_begin_info = VulkanBootstrap::GetCommandBufferBegin(VulkanTranslate::CommandBufferType::REUSE);
-  VulkanHelpers::VK_CHECK_RESULT(
-      vkBeginCommandBuffer(CommandBuffers[Device->GetCurrentFrame()], &buffer_begin_info),
-      __LINE__,
-      __FILE__);
+  VulkanHelpers::VK_CHECK_RESULT(vkBeginCommandBuffer(CommandBuffers[frame], &buffer_begin_info), __LINE__, __FILE__);
+
+  if(TimestampPools[frame])
+  {
+    vkCmdResetQueryPool(CommandBuffers[frame], TimestampPools[frame], 0, 2);
+    vkCmdWriteTimestamp(CommandBuffers[frame], VK_PIPELINE_STAGE_TOP_OF_PIPE_BIT, TimestampPools[frame], 0);
+  }
 
   return true;
 }
@@ -622,15 +668,80 @@ void graphics_vulkan::VulkanGraphicsInstance::SetState(const GraphicsTypes::Rend
 
 int graphics_vulkan::VulkanGraphicsInstance::AcquireFrameIndex() const { return Device->GetCurrentFrame(); }
 
+unsigned char *
+graphics_vulkan::VulkanGraphicsInstance::Upload(const size_t size, const size_t alignment, UploadRange &range) const
+{
+  unsigned char *data = UploadRing->Allocate(size, alignment, range.Offset);
+  if(!data)
+  {
+    Log::Error << "Upload ring is full (" << UploadRing->GetUsed() << " of " << UploadRing->GetSize()
+               << " bytes used), skipping." << Log::End;
+    return nullptr;
+  }
+  range.Size = size;
+  return data;
+}
+
+VkDescriptorSet graphics_vulkan::VulkanGraphicsInstance::WriteBufferDescriptorSet(
+    const VkDescriptorSetLayout layout,
+    const VkDescriptorType      type,
+    const UploadRange          *ranges,
+    const size_t                count) const
+{
+  VkDescriptorSet descriptor_set = DescriptorPool->AllocateDescriptorSet(layout);
+
+  std::vector<VkDescriptorBufferInfo> buffer_infos(count);
+  std::vector<VkWriteDescriptorSet>   descriptor_writes(count);
+  for(size_t i = 0; i < count; i++)
+  {
+    buffer_infos[i].buffer = UploadRing->Get();
+    buffer_infos[i].offset = ranges[i].Offset;
+    buffer_infos[i].range  = ranges[i].Size;
+
+    descriptor_writes[i].sType            = VK_STRUCTURE_TYPE_WRITE_DESCRIPTOR_SET;
+    descriptor_writes[i].dstSet           = descriptor_set;
+    descriptor_writes[i].dstBinding       = static_cast<uint32_t>(i);
+    descriptor_writes[i].dstArrayElement  = 0;
+    descriptor_writes[i].descriptorType   = type;
+    descriptor_writes[i].descriptorCount  = 1;
+    descriptor_writes[i].pBufferInfo      = &buffer_infos[i];
+    descriptor_writes[i].pImageInfo       = nullptr;
+    descriptor_writes[i].pTexelBufferView = nullptr;
+  }
+
+  vkUpdateDescriptorSets(Device->GetDevice(), static_cast<uint32_t>(count), descriptor_writes.data(), 0, nullptr);
+
+  return descriptor_set;
+}
+
+VkDescriptorSet graphics_vulkan::VulkanGraphicsInstance::WriteUniformDescriptorSet(
+    const GraphicsTypes::UBOBindPoint bind_point,
+    const UploadRange                &range) const
+{
+  VkDescriptorSetLayout layout = nullptr;
+  switch(bind_point)
+  {
+  case GraphicsTypes::UBOBindPoint::Common:   layout = State.Shader->GetDescriptorSetLayoutUBOCommon(); break;
+  case GraphicsTypes::UBOBindPoint::Specific: layout = State.Shader->GetDescriptorSetLayoutUBOSpecial(); break;
+  }
+
+  return WriteBufferDescriptorSet(layout, VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER, &range, 1);
+}
+
 void graphics_vulkan::VulkanGraphicsInstance::SetCommonUniforms(const ShaderInfo::CommonUniformBufferData &data) const
 {
-  std::vector<unsigned char> ubo_data;
-  ubo_data.resize(ShaderInfo::GetCommonUniformSize());
-  ShaderInfo::CopyCommonUniformDataToBuffer(ubo_data.data(), data);
+  if(!State.Shader)
+  {
+    Log::Warn << "Trying to set common uniforms while no shader is bound, ignoring!" << Log::End;
+    return;
+  }
+  UploadRange    range;
+  unsigned char *ubo_data = Upload(ShaderInfo::GetCommonUniformSize(), UNIFORM_ALIGNMENT, range);
+  if(!ubo_data) return;
+  ShaderInfo::CopyCommonUniformDataToBuffer(ubo_data, data);
 
-  CommonUniformBufferBindings.emplace_back();
-  CommonUniformBufferBindings.back().swap(ubo_data);
-  CommandsRecorded.emplace_back(CommandType::COMMON_UNIFORM_UPDATE, CommonUniformBufferBindings.size() - 1);
+  BoundDescriptorSets.emplace_back(WriteUniformDescriptorSet(GraphicsTypes::UBOBindPoint::Common, range), 0);
+  CommandsRecorded.emplace_back(CommandType::DESCRIPTOR_SET_BIND, BoundDescriptorSets.size() - 1);
 }
 
 void graphics_vulkan::VulkanGraphicsInstance::SetColorState(const bool state) const { State.Color = state; }
@@ -646,21 +757,19 @@ void graphics_vulkan::VulkanGraphicsInstance::BindBufferDynamic(
     const std::vector<unsigned char> &data,
     const GraphicsTypes::UBOBindPoint bind_point) const
 {
-  switch(bind_point)
+  if(!State.Shader)
   {
-  case GraphicsTypes::UBOBindPoint::Common:
-    {
-      CommonUniformBufferBindings.emplace_back(data);
-      CommandsRecorded.emplace_back(CommandType::COMMON_UNIFORM_UPDATE, CommonUniformBufferBindings.size() - 1);
-      break;
-    }
-  case GraphicsTypes::UBOBindPoint::Specific:
-    {
-      CustomUniformBufferBindings.emplace_back(data);
-      CommandsRecorded.emplace_back(CommandType::CUSTOM_UNIFORM_UPDATE, CustomUniformBufferBindings.size() - 1);
-      break;
-    }
+    Log::Warn << "Trying to bind uniforms while no shader is bound, ignoring!" << Log::End;
+    return;
   }
+  UploadRange    range;
+  unsigned char *ubo_data = Upload(data.size(), UNIFORM_ALIGNMENT, range);
+  if(!ubo_data) return;
+  std::memcpy(ubo_data, data.data(), data.size());
+
+  const int set = bind_point == GraphicsTypes::UBOBindPoint::Common ? 0 : 1;
+  BoundDescriptorSets.emplace_back(WriteUniformDescriptorSet(bind_point, range), set);
+  CommandsRecorded.emplace_back(CommandType::DESCRIPTOR_SET_BIND, BoundDescriptorSets.size() - 1);
 }
 
 void graphics_vulkan::VulkanGraphicsInstance::BindTextures(
@@ -681,32 +790,13 @@ void graphics_vulkan::VulkanGraphicsInstance::BindTextures(
   auto *const *vulkan_texture_instances =
       reinterpret_cast<const VulkanObjects::VulkanTextureInstance *const *>(texture_instance);
 
-  VkDescriptorSet descriptor_set =
-      DescriptorPool->AllocateDescriptorSet(State.Shader->GetDescriptorSetLayoutTexturesSpecial());
-
-  for(int i = 0; i < count; i++)
-  {
-    VkDescriptorImageInfo image_info{};
-    image_info.imageLayout = vulkan_texture_instances[i]->GetImage()->GetLayout();
-    image_info.imageView   = vulkan_texture_instances[i]->GetView()->Get();
-    image_info.sampler     = vulkan_texture_instances[i]->GetSampler()->Get();
-
-    VkWriteDescriptorSet descriptor_write{};
-    descriptor_write.sType            = VK_STRUCTURE_TYPE_WRITE_DESCRIPTOR_SET;
-    descriptor_write.dstSet           = descriptor_set;
-    descriptor_write.dstBinding       = i;
-    descriptor_write.dstArrayElement  = 0;
-    descriptor_write.descriptorType   = VK_DESCRIPTOR_TYPE_COMBINED_IMAGE_SAMPLER;
-    descriptor_write.descriptorCount  = 1;
-    descriptor_write.pBufferInfo      = nullptr;
-    descriptor_write.pImageInfo       = &image_info;
-    descriptor_write.pTexelBufferView = nullptr;
-
-    vkUpdateDescriptorSets(Device->GetDevice(), 1, &descriptor_write, 0, nullptr);
-  }
+  VkDescriptorSet descriptor_set = DescriptorPool->GetTextureDescriptorSet(
+      State.Shader->GetDescriptorSetLayoutTexturesSpecial(),
+      vulkan_texture_instances,
+      count);
 
-  BoundTextures.emplace_back(vulkan_texture_instances, descriptor_set, set);
-  CommandsRecorded.emplace_back(CommandType::TEXTURE_BIND, BoundTextures.size() - 1);
+  BoundDescriptorSets.emplace_back(descriptor_set, set);
+  CommandsRecorded.emplace_back(CommandType::DESCRIPTOR_SET_BIND, BoundDescriptorSets.size() - 1);
 }
 
 void graphics_vulkan::VulkanGraphicsInstance::BindVertexBuffer(GraphicsTypes::BufferInstance *buffer_instance) const
@@ -752,12 +842,105 @@ void graphics_vulkan::VulkanGraphicsInstance::DrawDynamic(
     const void                        *data,
     const GraphicsTypes::PrimitiveType prim_type) const
 {
+  UploadRange    range;
+  unsigned char *vertices = Upload(count * type_size, VERTEX_ALIGNMENT, range);
+  if(!vertices) return;
+  std::memcpy(vertices, data, range.Size);
+
   State.RenderState.DrawPrimitiveType = prim_type;
+  DynamicDrawCalls.emplace_back(State.Shader->GetPipelineForState(State), count, range);
 
-  auto &entry = DynamicDrawCalls.emplace_back(State.Shader->GetPipelineForState(State), count);
+  CommandsRecorded.emplace_back(CommandType::DRAW_DYNAMIC, DynamicDrawCalls.size() - 1);
+}
 
-  entry.Data.resize(count * type_size);
-  std::memcpy(entry.Data.data(), data, entry.Data.size());
+void graphics_vulkan::VulkanGraphicsInstance::DrawInstanced(
+    const GraphicsTypes::DrawRange    *ranges,
+    const size_t                       range_count,
+    const size_t                       instance_size,
+    const void                        *instance_data,
+    const GraphicsTypes::PrimitiveType prim_type) const
+{
+  size_t instance_count = 0;
+  for(size_t i = 0; i < range_count; i++)
+    instance_count += ranges[i].Instances;
+
+  UploadRange    range;
+  unsigned char *instances = Upload(instance_count * instance_size, VERTEX_ALIGNMENT, range);
+  if(!instances) return;
+  std::memcpy(instances, instance_data, range.Size);
+
+  State.RenderState.DrawPrimitiveType = prim_type;
+  InstancedDrawCalls.emplace_back(
+      State.Shader->GetPipelineForState(State),
+      InstancedDrawRanges.size(),
+      range_count,
+      range);
+  InstancedDrawRanges.insert(InstancedDrawRanges.end(), ranges, ranges + range_count);
+
+  CommandsRecorded.emplace_back(CommandType::DRAW_INSTANCED, InstancedDrawCalls.size() - 1);
+}
+
+void graphics_vulkan::VulkanGraphicsInstance::DrawGenerated(
+    const GraphicsTypes::VertexGenerator &generator,
+    const GraphicsTypes::PrimitiveType    prim_type) const
+{
+  const auto *generator_shader = reinterpret_cast<const VulkanObjects::VulkanShaderInstance *>(generator.Shader);
+  if(!generator_shader || !generator.RecordCount) return;
+  const VkPipeline generator_pipeline = generator_shader->GetGeneratorPipeline();
+  if(!generator_pipeline)
+  {
+    Log::Error << "Trying to generate vertices with a shader that has no compute stage." << Log::End;
+    return;
+  }
+
+  // The records and the vertices written from them are placed in the upload ring as well,
+  // so the vertices can be drawn like those of a dynamic draw.
+  UploadRange    uniform_range;
+  UploadRange    record_range;
+  UploadRange    vertex_range;
+  unsigned char *uniforms = Upload(generator.Uniforms->size(), UNIFORM_ALIGNMENT, uniform_range);
+  if(!uniforms) return;
+  unsigned char *records = Upload(generator.RecordCount * generator.RecordSize, STORAGE_ALIGNMENT, record_range);
+  if(!records) return;
+  const size_t vertex_count = generator.RecordCount * generator.VerticesPerRecord;
+  if(!Upload(vertex_count * generator.VertexSize, STORAGE_ALIGNMENT, vertex_range)) return;
+  std::memcpy(uniforms, generator.Uniforms->data(), uniform_range.Size);
+  std::memcpy(records, generator.Records, record_range.Size);
+
+  const std::array storage_ranges  = {record_range, vertex_range};
+  const std::array descriptor_sets = {
+      WriteBufferDescriptorSet(
+          generator_shader->GetDescriptorSetLayoutUBOSpecial(),
+          VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER,
+          &uniform_range,
+          1),
+      WriteBufferDescriptorSet(
+          generator_shader->GetDescriptorSetLayoutStorage(),
+          VK_DESCRIPTOR_TYPE_STORAGE_BUFFER,
+          storage_ranges.data(),
+          storage_ranges.size()),
+  };
+
+  // While draw commands are collected no render pass is active in the frame's command buffer,
+  // so the dispatch is recorded there right away, ahead of the render pass that draws its output.
+  const VkCommandBuffer command_buffer = CommandBuffers[Device->GetCurrentFrame()];
+  vkCmdBindPipeline(command_buffer, VK_PIPELINE_BIND_POINT_COMPUTE, generator_pipeline);
+  vkCmdBindDescriptorSets(
+      command_buffer,
+      VK_PIPELINE_BIND_POINT_COMPUTE,
+      generator_shader->GetGeneratorPipelineLayout(),
+      1,
+      static_cast<uint32_t>(descriptor_sets.size()),
+      descriptor_sets.data(),
+      0,
+      nullptr);
+  const size_t group_count =
+      (generator.RecordCount + GraphicsTypes::GENERATOR_GROUP_SIZE - 1) / GraphicsTypes::GENERATOR_GROUP_SIZE;
+  vkCmdDispatch(command_buffer, static_cast<uint32_t>(group_count), 1, 1);
+  VerticesGenerated = true;
+
+  State.RenderState.DrawPrimitiveType = prim_type;
+  DynamicDrawCalls.emplace_back(State.Shader->GetPipelineForState(State), vertex_count, vertex_range);
 
   CommandsRecorded.emplace_back(CommandType::DRAW_DYNAMIC, DynamicDrawCalls.size() - 1);
 }
@@ -827,24 +1010,7 @@ void graphics_vulkan::VulkanGraphicsInstance::EndRenderBuffer(
   render_pass_info.framebuffer       = vulkan_render_buffer_instance->Get(Device->GetCurrentFrame());
   render_pass_info.renderArea.offset = {0, 0};
   render_pass_info.renderArea.extent = extent_2d;
-  render_pass_info.clearValueCount   = static_cast<uint32_t>(clear_values.size());
-  render_pass_info.pClearValues      = clear_values.data();
-
-  vkCmdBeginRenderPass(CommandBuffers[Device->GetCurrentFrame()], &render_pass_info, VK_SUBPASS_CONTENTS_INLINE);
-
-  VkViewport viewport{};
-  viewport.x        = 0.0f;
-  viewport.y        = 0.0f;
-  viewport.width    = static_cast<float>(extent_2d.width);
-  viewport.height   = static_cast<float>(extent_2d.height);
-  viewport.minDepth = 0.0f;
-  viewport.maxDepth = 1.0f;
-  vkCmdSetViewport(CommandBuffers[Device->GetCurrentFrame()], 0, 1, &viewport);
-  VkRect2D scissor{};
-  scissor.offset = {0, 0};
-  scissor.extent = extent_2d;
-  vkCmdSetScissor(CommandBuffers[Device->GetCurrentFrame()], 0, 1, &scissor);
-
+  BeginRenderPass(render_pass_info, std::move(clear_values));
   EndRenderPass();
 
   if(vulkan_render_buffer_instance->IsInUse())
@@ -915,68 +1081,203 @@ void graphics_vulkan::VulkanGraphicsInstance::StartMainRenderPass()
   render_pass_info.renderArea.offset = {0, 0};
   render_pass_info.renderArea.extent =
       VkExtent2D(current_frame_buffer->GetInfo().Width, current_frame_buffer->GetInfo().Height);
-  render_pass_info.clearValueCount = static_cast<uint32_t>(clear_values.size());
-  render_pass_info.pClearValues    = clear_values.data();
-
-  vkCmdBeginRenderPass(CommandBuffers[Device->GetCurrentFrame()], &render_pass_info, VK_SUBPASS_CONTENTS_INLINE);
+  BeginRenderPass(render_pass_info, std::move(clear_values));
 
-  VkViewport viewport{};
-  viewport.x        = 0.0f;
-  viewport.y        = 0.0f;
-  viewport.width    = static_cast<float>(current_frame_buffer->GetInfo().Width);
-  viewport.height   = static_cast<float>(current_frame_buffer->GetInfo().Height);
-  viewport.minDepth = 0.0f;
-  viewport.maxDepth = 1.0f;
-  vkCmdSetViewport(CommandBuffers[Device->GetCurrentFrame()], 0, 1, &viewport);
-  VkRect2D scissor{};
-  scissor.offset = {0, 0};
-  scissor.extent = VkExtent2D(current_frame_buffer->GetInfo().Width, current_frame_buffer->GetInfo().Height);
-  vkCmdSetScissor(CommandBuffers[Device->GetCurrentFrame()], 0, 1, &scissor);
+  State.RenderPass = current_frame_buffer->GetRenderPass();
+  State.Samples    = static_cast<int>(current_frame_buffer->GetInfo().Samples);
+}
 
-  State.RenderPass = SwapChain->GetCurrentFrameBuffer()->GetRenderPass();
+void graphics_vulkan::VulkanGraphicsInstance::BeginRenderPass(
+    const VkRenderPassBeginInfo &render_pass_info,
+    std::vector<VkClearValue>    clear_values)
+{
+  PendingClearValues                = std::move(clear_values);
+  PendingRenderPass                 = render_pass_info;
+  PendingRenderPass.clearValueCount = static_cast<uint32_t>(PendingClearValues.size());
+  PendingRenderPass.pClearValues    = PendingClearValues.data();
 }
 
 void graphics_vulkan::VulkanGraphicsInstance::EndRenderPass()
 {
+  const auto start = std::chrono::steady_clock::now();
+
   SubmitDrawCommands(this);
 
   vkCmdEndRenderPass(CommandBuffers[Device->GetCurrentFrame()]);
+
+  CurrentStatistics.SubmitTime +=
+      std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
 }
 
 void graphics_vulkan::VulkanGraphicsInstance::EndDraw(const int width, const int height)
 {
-  VulkanHelpers::VK_CHECK_RESULT(vkEndCommandBuffer(CommandBuffers[Device->GetCurrentFrame()]), __LINE__, __FILE__);
+  const auto    start = std::chrono::steady_clock::now();
+  const uint8_t frame = Device->GetCurrentFrame();
+
+  if(TimestampPools[frame])
+  {
+    vkCmdWriteTimestamp(CommandBuffers[frame], VK_PIPELINE_STAGE_BOTTOM_OF_PIPE_BIT, TimestampPools[frame], 1);
+    TimestampsWritten[frame] = true;
+  }
 
+  VulkanHelpers::VK_CHECK_RESULT(vkEndCommandBuffer(CommandBuffers[frame]), __LINE__, __FILE__);
+
+  // When rendering offscreen, there is no image to wait for and nothing to present.
+  const bool                     offscreen           = Device->IsOffscreen();
   const VkSemaphore              wait_semaphores[]   = {Device->GetImageAvailable()};
   constexpr VkPipelineStageFlags wait_stages[]       = {VK_PIPELINE_STAGE_COLOR_ATTACHMENT_OUTPUT_BIT};
-  const VkSemaphore              signal_semaphores[] = {SwapChain->GetRenderFinished()};
+  const VkSemaphore              signal_semaphores[] = {offscreen ? nullptr : SwapChain->GetRenderFinished()};
   VkSubmitInfo                   submit_info{};
   submit_info.sType                = VK_STRUCTURE_TYPE_SUBMIT_INFO;
-  submit_info.waitSemaphoreCount   = 1;
+  submit_info.waitSemaphoreCount   = offscreen ? 0 : 1;
   submit_info.pWaitSemaphores      = wait_semaphores;
   submit_info.pWaitDstStageMask    = wait_stages;
   submit_info.commandBufferCount   = 1;
-  submit_info.pCommandBuffers      = &CommandBuffers[Device->GetCurrentFrame()];
-  submit_info.signalSemaphoreCount = 1;
+  submit_info.pCommandBuffers      = &CommandBuffers[frame];
+  submit_info.signalSemaphoreCount = offscreen ? 0 : 1;
   submit_info.pSignalSemaphores    = signal_semaphores;
   VulkanHelpers::VK_CHECK_RESULT(
       vkQueueSubmit(Device->GetGraphicsQueue(), 1, &submit_info, Device->GetFence()),
       __LINE__,
       __FILE__);
 
+  CurrentStatistics.SubmitTime +=
+      std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+  LastStatistics            = std::exchange(CurrentStatistics, {});
+  CurrentStatistics.GpuTime = LastStatistics.GpuTime;
+
   SwapChain->EndFrame(CommandPool.get(), width, height);
 }
 
 void graphics_vulkan::VulkanGraphicsInstance::Wait() { vkDeviceWaitIdle(Device->GetDevice()); }
 
+void graphics_vulkan::VulkanGraphicsInstance::LoadPipelineCache(const std::filesystem::path &path)
+{
+  Device->LoadPipelineCache(path);
+}
+
+void graphics_vulkan::VulkanGraphicsInstance::WarmUpShader(
+    const GraphicsTypes::ShaderInstance *shader_instance,
+    const GraphicsTypes::RenderState    &state) const
+{
+  const auto *vulkan_shader_instance = reinterpret_cast<const VulkanObjects::VulkanShaderInstance *>(shader_instance);
+
+  // Every frame in flight has its own render pass, so the pipelines are needed once for each.
+  VulkanObjects::VulkanPipelineState pipeline_state;
+  pipeline_state.Shader      = vulkan_shader_instance;
+  pipeline_state.RenderState = state;
+  for(const auto &frame_buffer : SwapChain->GetFrameBuffers())
+  {
+    pipeline_state.RenderPass = frame_buffer->GetRenderPass();
+    pipeline_state.Samples    = static_cast<int>(frame_buffer->GetInfo().Samples);
+    vulkan_shader_instance->GetPipelineForState(pipeline_state);
+  }
+}
+
+bool graphics_vulkan::VulkanGraphicsInstance::ReadFrame(
+    std::vector<uint8_t> &pixels,
+    uint32_t             &width,
+    uint32_t             &height) const
+{
+  // Swap chain images can't be copied from, and are gone once presented anyway.
+  const VkImage image = SwapChain->GetOffscreenImage();
+  if(!image) return false;
+
+  vkDeviceWaitIdle(Device->GetDevice());
+
+  const auto &info = SwapChain->GetCurrentFrameBuffer()->GetInfo();
+  width            = info.Width;
+  height           = info.Height;
+
+  VkBufferCreateInfo buffer_info{};
+  buffer_info.sType       = VK_STRUCTURE_TYPE_BUFFER_CREATE_INFO;
+  buffer_info.size        = static_cast<VkDeviceSize>(width) * height * 4;
+  buffer_info.usage       = VK_BUFFER_USAGE_TRANSFER_DST_BIT;
+  buffer_info.sharingMode = VK_SHARING_MODE_EXCLUSIVE;
+
+  VmaAllocationCreateInfo allocation_create_info{};
+  allocation_create_info.usage = VMA_MEMORY_USAGE_AUTO;
+  allocation_create_info.flags = VMA_ALLOCATION_CREATE_HOST_ACCESS_RANDOM_BIT | VMA_ALLOCATION_CREATE_MAPPED_BIT;
+
+  VkBuffer          buffer     = nullptr;
+  VmaAllocation     allocation = nullptr;
+  VmaAllocationInfo allocation_info{};
+  VulkanHelpers::VK_CHECK_RESULT(
+      vmaCreateBuffer(
+          Device->GetAllocator(),
+          &buffer_info,
+          &allocation_create_info,
+          &buffer,
+          &allocation,
+          &allocation_info),
+      __LINE__,
+      __FILE__);
+
+  VulkanObjects::VulkanSingleCommandBuffer cmd(Device.get(), CommandPool.get());
+  cmd.Begin();
+
+  // The render pass leaves the image ready to be presented.
+  const auto present_info  = VulkanTranslate::GetVkLayoutInfo(VK_IMAGE_LAYOUT_PRESENT_SRC_KHR);
+  const auto transfer_info = VulkanTranslate::GetVkLayoutInfo(VK_IMAGE_LAYOUT_TRANSFER_SRC_OPTIMAL);
+  auto       barrier       = VulkanBootstrap::GetImageMemoryBarrierWithoutAccess(
+      image,
+      VK_IMAGE_ASPECT_COLOR_BIT,
+      VK_IMAGE_LAYOUT_PRESENT_SRC_KHR,
+      VK_IMAGE_LAYOUT_TRANSFER_SRC_OPTIMAL);
+  barrier.srcAccessMask = VK_ACCESS_COLOR_ATTACHMENT_WRITE_BIT;
+  barrier.dstAccessMask = VK_ACCESS_TRANSFER_READ_BIT;
+  vkCmdPipelineBarrier(
+      cmd.Get(),
+      VK_PIPELINE_STAGE_COLOR_ATTACHMENT_OUTPUT_BIT,
+      transfer_info.first,
+      0,
+      0,
+      nullptr,
+      0,
+      nullptr,
+      1,
+      &barrier);
+
+  const VkBufferImageCopy region =
+      VulkanBootstrap::GetSimpleBufferImageCopyRegion(VK_IMAGE_ASPECT_COLOR_BIT, width, height, 1, 0, 0, 0);
+  vkCmdCopyImageToBuffer(cmd.Get(), image, VK_IMAGE_LAYOUT_TRANSFER_SRC_OPTIMAL, buffer, 1, &region);
+
+  std::swap(barrier.oldLayout, barrier.newLayout);
+  barrier.srcAccessMask = VK_ACCESS_TRANSFER_READ_BIT;
+  barrier.dstAccessMask = present_info.second;
+  vkCmdPipelineBarrier(
+      cmd.Get(),
+      transfer_info.first,
+      present_info.first,
+      0,
+      0,
+      nullptr,
+      0,
+      nullptr,
+      1,
+      &barrier);
+
+  cmd.End();
+
+  // The image is stored as BGRA.
+  vmaInvalidateAllocation(Device->GetAllocator(), allocation, 0, VK_WHOLE_SIZE);
+  const auto *data = static_cast<const uint8_t *>(allocation_info.pMappedData);
+  pixels.resize(buffer_info.size);
+  for(size_t i = 0; i < pixels.size(); i += 4)
+  {
+    pixels[i]     = data[i + 2];
+    pixels[i + 1] = data[i + 1];
+    pixels[i + 2] = data[i];
+    pixels[i + 3] = data[i + 3];
+  }
+
+  vmaDestroyBuffer(Device->GetAllocator(), buffer, allocation);
+  return true;
+}
+
 graphics_vulkan::VulkanGraphicsInstance::~VulkanGraphicsInstance()
 {
-  for(auto &buffer : DynamicUniformBuffersCommon)
-    buffer.reset();
-  for(auto &buffer : DynamicUniformBuffersSpecific)
-    buffer.reset();
-  for(auto &buffer : DynamicVertexBuffers)
-    buffer.reset();
+  UploadRing.reset();
   Wait();
 
   vkFreeCommandBuffers(
@@ -985,6 +1286,11 @@ graphics_vulkan::VulkanGraphicsInstance::~VulkanGraphicsInstance()
       VulkanObjects::VulkanDeviceInstance::MAX_FRAMES_IN_FLIGHT,
       CommandBuffers.data());
 
+  for(const auto &pool : TimestampPools)
+    if(pool) vkDestroyQueryPool(Device->GetDevice(), pool, nullptr);
+
+  Log::Info << "Texture descriptor set cache: " << DescriptorPool->GetCacheHits() << " hits, "
+            << DescriptorPool->GetCacheMisses() << " misses." << Log::End;
   DescriptorPool.reset();
   SwapChain.reset();
   CommandPool.reset();
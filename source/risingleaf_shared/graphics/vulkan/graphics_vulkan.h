@@ -17,6 +17,7 @@
 #ifndef GRAPHICS_VULKAN_H
 #define GRAPHICS_VULKAN_H
 
+#include <array>
 #include <memory>
 #include <vector>
 
@@ -31,8 +32,10 @@ namespace VulkanObjects
 {
   class VulkanCommandPool;
   class VulkanDescriptorPool;
+  class VulkanParallelRecorder;
   class VulkanSwapChainInstance;
   class VulkanBufferInstance;
+  class VulkanUploadRing;
   class VulkanShaderInstance;
   class VulkanTextureInstance;
 } // namespace VulkanObjects
@@ -51,19 +54,18 @@ namespace graphics_vulkan
     SHADER_BIND,
     INDEX_BIND,
     VERTEX_BIND,
-    TEXTURE_BIND,
-    COMMON_UNIFORM_UPDATE,
-    CUSTOM_UNIFORM_UPDATE,
+    DESCRIPTOR_SET_BIND,
     DRAW,
     DRAW_INDEXED,
-    DRAW_DYNAMIC
+    DRAW_DYNAMIC,
+    DRAW_INSTANCED
   };
 
-  struct TextureBinding
+  // A descriptor set of textures or uniforms, written when it was bound.
+  struct DescriptorSetBinding
   {
-    const VulkanObjects::VulkanTextureInstance *const *TextureInstances;
-    VkDescriptorSet                                    DescriptorSet;
-    int                                                Set;
+    VkDescriptorSet DescriptorSet;
+    int             Set;
   };
 
   struct DrawCall
@@ -73,13 +75,30 @@ namespace graphics_vulkan
     size_t     Start = 0;
   };
 
+  // Where the data of a draw or uniform update was written to in the upload ring.
+  struct UploadRange
+  {
+    VkDeviceSize Offset = 0;
+    size_t       Size   = 0;
+  };
+
   struct DynamicDrawCall
   {
-    VkPipeline                 Pipeline;
-    size_t                     Count;
-    std::vector<unsigned char> Data;
+    VkPipeline  Pipeline;
+    size_t      Count;
+    UploadRange Vertices;
+  };
+
+  struct InstancedDrawCall
+  {
+    VkPipeline  Pipeline;
+    size_t      FirstRange;
+    size_t      RangeCount;
+    UploadRange Instances;
   };
 
+  struct CommandState;
+
   class VulkanGraphicsInstance final : public GraphicsTypes::GraphicsInstance
   {
     std::unique_ptr<VulkanObjects::VulkanDeviceInstance>    Device;
@@ -90,49 +109,69 @@ namespace graphics_vulkan
     // From here on this stuff should really be packed into some sort of command buffer info struct
 
     mutable std::array<VkCommandBuffer, VulkanObjects::VulkanDeviceInstance::MAX_FRAMES_IN_FLIGHT> CommandBuffers{};
-    mutable std::array<
-        std::unique_ptr<VulkanObjects::VulkanBufferInstance>,
-        VulkanObjects::VulkanDeviceInstance::MAX_FRAMES_IN_FLIGHT>
-                   DynamicUniformBuffersCommon;
-    mutable size_t DynamicUniformBuffersCommonOffset = 0;
-    mutable std::array<
-        std::unique_ptr<VulkanObjects::VulkanBufferInstance>,
-        VulkanObjects::VulkanDeviceInstance::MAX_FRAMES_IN_FLIGHT>
-                   DynamicUniformBuffersSpecific;
-    mutable size_t DynamicUniformBuffersSpecificOffset = 0;
-    mutable std::array<
-        std::unique_ptr<VulkanObjects::VulkanBufferInstance>,
-        VulkanObjects::VulkanDeviceInstance::MAX_FRAMES_IN_FLIGHT>
-                   DynamicVertexBuffers;
-    mutable size_t DynamicVertexBuffersOffset = 0;
+    // Uniforms and dynamic vertices are written straight into this while recording.
+    std::unique_ptr<VulkanObjects::VulkanUploadRing> UploadRing;
 
     mutable std::vector<const VulkanObjects::VulkanShaderInstance *> BoundShaders;
     mutable std::vector<const VulkanObjects::VulkanBufferInstance *> BoundBuffers;
-    mutable std::vector<TextureBinding>                              BoundTextures;
+    mutable std::vector<DescriptorSetBinding>                        BoundDescriptorSets;
     mutable std::vector<DrawCall>                                    DrawCalls;
     mutable std::vector<DynamicDrawCall>                             DynamicDrawCalls;
-    mutable std::vector<std::vector<unsigned char>>                  CommonUniformBufferBindings;
-    mutable std::vector<std::vector<unsigned char>>                  CustomUniformBufferBindings;
+    mutable std::vector<InstancedDrawCall>                           InstancedDrawCalls;
+    mutable std::vector<GraphicsTypes::DrawRange>                    InstancedDrawRanges;
 
     mutable std::vector<std::pair<CommandType, size_t>> CommandsRecorded;
+    // Whether any of the recorded draws reads vertices that a compute shader writes.
+    mutable bool VerticesGenerated = false;
+
+    // The render pass the recorded commands belong to. It is only begun once they are
+    // submitted, since only then it is known whether they are recorded inline or into
+    // secondary command buffers.
+    mutable VkRenderPassBeginInfo     PendingRenderPass{};
+    mutable std::vector<VkClearValue> PendingClearValues;
+    // Records long render passes on several threads.
+    std::unique_ptr<VulkanObjects::VulkanParallelRecorder> Recorder;
+
+    // Timestamps at the start and end of each frame in flight, to measure the time the GPU takes.
+    std::array<VkQueryPool, VulkanObjects::VulkanDeviceInstance::MAX_FRAMES_IN_FLIGHT> TimestampPools{};
+    std::array<bool, VulkanObjects::VulkanDeviceInstance::MAX_FRAMES_IN_FLIGHT>        TimestampsWritten{};
+    // Nanoseconds per timestamp tick.
+    double TimestampPeriod = 0.;
+
+    mutable GraphicsTypes::FrameStatistics CurrentStatistics;
+    GraphicsTypes::FrameStatistics         LastStatistics;
 
     mutable ShaderInfo::CommonUniformBufferData CommonData{};
     mutable bool                                CommonDataChanged = false;
     mutable VulkanObjects::VulkanPipelineState  State;
 
-    friend void BindBuffers(
-        const VulkanGraphicsInstance               *instance,
-        const VulkanObjects::VulkanShaderInstance  *current_shader_instance,
-        const GraphicsTypes::BufferInstance *const *buffer_instance,
-        int                                         count,
-        GraphicsTypes::UBOBindPoint                 bind_point,
-        int                                         set,
-        size_t                                      offset,
-        size_t                                      size);
+    friend void TrackCommand(const VulkanGraphicsInstance *graphics_instance, size_t command, CommandState &state);
+    friend void RecordCommands(
+        const VulkanGraphicsInstance *graphics_instance,
+        VkCommandBuffer               command_buffer,
+        size_t                        begin,
+        size_t                        end,
+        CommandState                  state);
     friend void SubmitDrawCommands(const VulkanGraphicsInstance *graphics_instance);
 
+    // Reserve space for per frame data in the upload ring. Returns nullptr,
+    // after logging an error, if the ring of this frame is full.
+    unsigned char *Upload(size_t size, size_t alignment, UploadRange &range) const;
+
+    // Write the given ranges of the upload ring into a new descriptor set with the given layout.
+    VkDescriptorSet WriteBufferDescriptorSet(
+        VkDescriptorSetLayout layout,
+        VkDescriptorType      type,
+        const UploadRange    *ranges,
+        size_t                count) const;
+    // Write the given range of the upload ring into a new uniform descriptor set of the bound shader.
+    VkDescriptorSet WriteUniformDescriptorSet(GraphicsTypes::UBOBindPoint bind_point, const UploadRange &range) const;
+
+    // Remember the render pass the following commands are recorded for.
+    void BeginRenderPass(const VkRenderPassBeginInfo &render_pass_info, std::vector<VkClearValue> clear_values);
+
   public:
-    explicit VulkanGraphicsInstance(int width, int height);
+    explicit VulkanGraphicsInstance(int width, int height, bool offscreen = false);
 
     void CreateShader(
         std::unique_ptr<GraphicsTypes::ShaderInstance> &shader_instance,
@@ -204,6 +243,15 @@ namespace graphics_vulkan
         GraphicsTypes::PrimitiveType         prim_type) const override;
     void DrawDynamic(size_t count, size_t type_size, const void *data, GraphicsTypes::PrimitiveType prim_type)
         const override;
+    void DrawInstanced(
+        const GraphicsTypes::DrawRange *ranges,
+        size_t                          range_count,
+        size_t                          instance_size,
+        const void                     *instance_data,
+        GraphicsTypes::PrimitiveType    prim_type) const override;
+    [[nodiscard]] bool CanGenerateVertices() const override { return true; }
+    void DrawGenerated(const GraphicsTypes::VertexGenerator &generator, GraphicsTypes::PrimitiveType prim_type)
+        const override;
 
     void BindRenderBuffer(GraphicsTypes::RenderBufferInstance *render_buffer_instance) const override;
     void EndRenderBuffer(GraphicsTypes::RenderBufferInstance *render_buffer_instance) override;
@@ -214,6 +262,14 @@ namespace graphics_vulkan
     void EndDraw(int width, int height) override;
 
     void Wait() override;
+
+    void LoadPipelineCache(const std::filesystem::path &path) override;
+    void WarmUpShader(const GraphicsTypes::ShaderInstance *shader_instance, const GraphicsTypes::RenderState &state)
+        const override;
+
+    [[nodiscard]] GraphicsTypes::FrameStatistics GetFrameStatistics() const override { return LastStatistics; }
+    bool ReadFrame(std::vector<uint8_t> &pixels, uint32_t &width, uint32_t &height) const override;
+
     ~VulkanGraphicsInstance() override;
   };
 }; // namespace graphics_vulkan
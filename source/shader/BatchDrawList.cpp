@@ -17,22 +17,81 @@ this program. If not, see <https://www.gnu.org/licenses/>.
 
 #include "../Body.h"
 #include "../Screen.h"
+#include "../VisualList.h"
 #include "../image/Sprite.h"
+#include "../pi.h"
 #include "BatchShader.h"
 
+#include <algorithm>
 #include <cmath>
+#include <limits>
 
 
 namespace
 {
-  void Push(std::vector<float> &v, const Point &pos, float s, float t, float frame, float alpha)
+  // The sprite is drawn turned around its center, which is also what it turns around in between steps.
+  struct Motion
   {
+    Point center;
+    Point velocity;
+    float spin;
+  };
+
+
+  void Push(std::vector<float> &v, const Point &pos, float s, float t, float frame, float alpha, const Motion &motion)
+  {
+    const Point corner = pos - motion.center;
     v.push_back(pos.X());
     v.push_back(pos.Y());
     v.push_back(s);
     v.push_back(t);
     v.push_back(frame);
     v.push_back(alpha);
+    v.push_back(motion.velocity.X());
+    v.push_back(motion.velocity.Y());
+    v.push_back(corner.X());
+    v.push_back(corner.Y());
+    v.push_back(motion.spin);
+  }
+
+
+  // Add a sprite at the given position, with its height along the given unit vector.
+  void PushQuad(
+      std::vector<float> &v,
+      const Point        &position,
+      const Point        &unit,
+      double              width,
+      double              height,
+      float               frame,
+      float               alpha,
+      float               clip,
+      const Point        &velocity,
+      float               spin)
+  {
+    // Get unit vectors in the direction of the object's width and height.
+    Point uw = Point(-unit.Y(), unit.X()) * width;
+    Point uh = unit * height;
+
+    // Get the "bottom" corner, the one that won't be clipped.
+    Point topLeft = position - (uw + uh);
+    // Scale the vectors and apply clipping to the "height" of the sprite.
+    uw *= 2.;
+    uh *= 2.f * clip;
+
+    // Calculate the other three corners.
+    Point topRight    = topLeft + uw;
+    Point bottomLeft  = topLeft + uh;
+    Point bottomRight = bottomLeft + uw;
+
+    // Push two copies of the first and last vertices to mark the break between
+    // the sprites.
+    const Motion motion{position, velocity, spin};
+    Push(v, topLeft, 0.f, 1.f, frame, alpha, motion);
+    Push(v, topLeft, 0.f, 1.f, frame, alpha, motion);
+    Push(v, topRight, 1.f, 1.f, frame, alpha, motion);
+    Push(v, bottomLeft, 0.f, 1.f - clip, frame, alpha, motion);
+    Push(v, bottomRight, 1.f, 1.f - clip, frame, alpha, motion);
+    Push(v, bottomRight, 1.f, 1.f - clip, frame, alpha, motion);
   }
 } // namespace
 
@@ -41,12 +100,18 @@ namespace
 void BatchDrawList::Clear(int step, double zoom)
 {
   data.clear();
+  // The records of the visuals are kept, but not drawn again unless they are added.
+  hasVisuals = false;
   this->step = step;
   this->zoom = zoom;
 }
 
 
-void BatchDrawList::SetCenter(const Point &center) { this->center = center; }
+void BatchDrawList::SetCenter(const Point &center, const Point &centerVelocity)
+{
+  this->center         = center;
+  this->centerVelocity = centerVelocity;
+}
 
 
 // Add an unswizzled object based on the Body class.
@@ -66,17 +131,56 @@ bool BatchDrawList::Add(const Body &body, float clip)
 }
 
 
-// TODO: Once we have sprite reference positions, this method will not be needed.
-bool BatchDrawList::AddVisual(const Body &visual) { return Add(visual, (visual.Position() - center) * zoom, 1.f); }
+// Add all the visuals in the given list.
+void BatchDrawList::AddVisuals(const VisualList &visuals)
+{
+  // If the GPU moves and animates the visuals, it only needs their records.
+  if(BatchShader::CanDrawVisuals())
+  {
+    hasVisuals = true;
+    if(&visuals != visualSource || visuals.Generation() != visualGeneration)
+    {
+      this->visuals.clear();
+      visualSource     = &visuals;
+      visualGeneration = visuals.Generation();
+      visualStep       = std::numeric_limits<int>::min();
+    }
+
+    // Drop the records that have expired since this list was last filled, and copy the ones
+    // that were added since then. The records of each sprite are in the order of their steps.
+    for(auto &it : this->visuals)
+      erase_if(it.second, [this](const Visual::Record &record) { return !record.IsAlive(step); });
+    for(const auto &[sprite, records] : visuals.Records())
+    {
+      const auto added = std::upper_bound(
+          records.begin(),
+          records.end(),
+          visualStep,
+          [](int copied, const Visual::Record &record) { return copied < record.spawnStep; });
+      if(added == records.end()) continue;
+      std::vector<Visual::Record> &copy = this->visuals[sprite];
+      copy.insert(copy.end(), added, records.end());
+    }
+    visualStep = step;
+    return;
+  }
+
+  for(const auto &[sprite, records] : visuals.Records())
+    for(const Visual::Record &record : records)
+      Add(sprite, record);
+}
 
 
-// Draw all the items in this list.
-void BatchDrawList::Draw() const
+// Draw all the items in this list, where they were the given fraction of a step earlier.
+void BatchDrawList::Draw(float lag) const
 {
-  BatchShader::Bind();
+  BatchShader::Bind(lag);
 
   for(const std::pair<const Sprite *const, std::vector<float>> &it : data)
     BatchShader::Add(it.first, it.second);
+  if(!hasVisuals) return;
+  for(const auto &[sprite, records] : visuals)
+    if(!records.empty()) BatchShader::AddVisuals(sprite, records, step, zoom, center, centerVelocity);
 }
 
 
@@ -84,12 +188,17 @@ bool BatchDrawList::Cull(const Body &body, const Point &position) const
 {
   if(!body.HasSprite() || !body.Zoom()) return true;
 
-  Point unit = body.Unit();
+  return Cull(position, body.Unit(), body.Width(), body.Height());
+}
+
+
+bool BatchDrawList::Cull(const Point &position, const Point &unit, double width, double height) const
+{
   // Cull sprites that are completely off screen, to reduce the number of draw
   // calls that we issue (which may be the bottleneck on some systems).
   Point size(
-      fabs(unit.X() * body.Height()) + fabs(unit.Y() * body.Width()),
-      fabs(unit.X() * body.Width()) + fabs(unit.Y() * body.Height()));
+      fabs(unit.X() * height) + fabs(unit.Y() * width),
+      fabs(unit.X() * width) + fabs(unit.Y() * height));
   Point topLeft     = position - size * zoom;
   Point bottomRight = position + size * zoom;
   if(bottomRight.X() < Screen::Left() || bottomRight.Y() < Screen::Top()) return true;
@@ -105,35 +214,31 @@ bool BatchDrawList::Add(const Body &body, Point position, float clip)
 
   // Get the data vector for this particular sprite.
   std::vector<float> &v = data[body.GetSprite()];
-  // The sprite frame is the same for every vertex.
-  float frame = body.GetFrame(step);
-
-  // Get unit vectors in the direction of the object's width and height.
-  Point unit = body.Unit() * zoom;
-  Point uw   = Point(-unit.Y(), unit.X()) * body.Width();
-  Point uh   = unit * body.Height();
-
-  // Get the "bottom" corner, the one that won't be clipped.
-  Point topLeft = position - (uw + uh);
-  // Scale the vectors and apply clipping to the "height" of the sprite.
-  uw *= 2.;
-  uh *= 2.f * clip;
-
-  // Calculate the other three corners.
-  Point topRight    = topLeft + uw;
-  Point bottomLeft  = topLeft + uh;
-  Point bottomRight = bottomLeft + uw;
-
-  float alpha = body.Alpha(center);
-
-  // Push two copies of the first and last vertices to mark the break between
-  // the sprites.
-  Push(v, topLeft, 0.f, 1.f, frame, alpha);
-  Push(v, topLeft, 0.f, 1.f, frame, alpha);
-  Push(v, topRight, 1.f, 1.f, frame, alpha);
-  Push(v, bottomLeft, 0.f, 1.f - clip, frame, alpha);
-  Push(v, bottomRight, 1.f, 1.f - clip, frame, alpha);
-  Push(v, bottomRight, 1.f, 1.f - clip, frame, alpha);
+  // The sprite frame and how far the sprite moves are the same for every vertex.
+  float frame    = body.GetFrame(step);
+  Point velocity = (body.Velocity() - centerVelocity) * zoom;
+  float alpha    = body.Alpha(center);
+  float spin     = body.Spin().Degrees() * TO_RAD;
+
+  PushQuad(v, position, body.Unit() * zoom, body.Width(), body.Height(), frame, alpha, clip, velocity, spin);
 
   return true;
 }
+
+
+// Add the vertices of the given visual.
+void BatchDrawList::Add(const Sprite *sprite, const Visual::Record &record)
+{
+  if(!record.IsAlive(step)) return;
+
+  // A record's size already includes the zoom of its visual, so its unit vector is not scaled.
+  Point position = (record.Position(step) - center) * zoom;
+  Point unit     = record.Facing(step).Unit();
+  if(Cull(position, unit, record.width, record.height)) return;
+
+  float frame    = record.Frame(step, sprite->Frames());
+  Point velocity = (Point(record.vx, record.vy) - centerVelocity) * zoom;
+  float alpha    = record.Alpha(step, center);
+  float spin     = record.spin * TO_RAD;
+  PushQuad(data[sprite], position, unit * zoom, record.width, record.height, frame, alpha, 1.f, velocity, spin);
+}
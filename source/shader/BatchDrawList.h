@@ -16,12 +16,14 @@ this program. If not, see <https://www.gnu.org/licenses/>.
 #pragma once
 
 #include "../Point.h"
+#include "../Visual.h"
 
 #include <map>
 #include <vector>
 
 class Body;
 class Sprite;
+class VisualList;
 
 
 // This class collects a set of OpenGL draw commands to issue and groups them by
@@ -31,32 +33,49 @@ class BatchDrawList
 public:
   // Clear the list, also setting the global time step for animation.
   void Clear(int step = 0, double zoom = 1.);
-  void SetCenter(const Point &center);
+  void SetCenter(const Point &center, const Point &centerVelocity = Point());
 
   // Add an unswizzled object based on the Body class.
   bool Add(const Body &body, float clip = 1.f);
-  bool AddVisual(const Body &visual);
+  // Add all the visuals in the given list.
+  void AddVisuals(const VisualList &visuals);
 
-  // Draw all the items in this list.
-  void Draw() const;
+  // Draw all the items in this list, where they were the given fraction of a step earlier.
+  void Draw(float lag = 0.f) const;
 
 
 private:
   // Determine if the given body should be drawn at all.
   bool Cull(const Body &body, const Point &position) const;
+  // Determine if a sprite of the given size, facing along the given unit vector, is on screen.
+  bool Cull(const Point &position, const Point &unit, double width, double height) const;
 
   // Add the given body at the given position.
   bool Add(const Body &body, Point position, float clip);
+  // Add the vertices of the given visual.
+  void Add(const Sprite *sprite, const Visual::Record &record);
 
 
 private:
   int    step      = 0;
   double zoom      = 1.;
   Point  center;
+  Point  centerVelocity;
 
   // Each sprite consists of six vertices (four vertices to form a quad and
   // two dummy vertices to mark the break in between them). Each of those
-  // vertices has six attributes: (x, y) position in pixels, (s, t) texture
-  // coordinates, the index of the sprite frame, and the alpha value.
+  // vertices has eleven attributes: (x, y) position in pixels, (s, t) texture
+  // coordinates, the index of the sprite frame, the alpha value, the (x, y)
+  // distance in pixels that the sprite moves in one step, the (x, y) offset of
+  // the vertex from the sprite's center, and how far the sprite turns in one
+  // step, in radians.
   std::map<const Sprite *, std::vector<float>> data;
+  // If the graphics backend moves and animates the visuals, they are drawn from their records instead.
+  // The records are kept from one step to the next, so that only the visuals that were added since
+  // this list was last filled have to be copied, along with the list and step they were copied from.
+  std::map<const Sprite *, std::vector<Visual::Record>> visuals;
+  const VisualList                                     *visualSource     = nullptr;
+  int                                                   visualGeneration = 0;
+  int                                                   visualStep       = 0;
+  bool                                                  hasVisuals       = false;
 };
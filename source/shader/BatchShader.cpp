@@ -17,6 +17,7 @@ this program. If not, see <https://www.gnu.org/licenses/>.
 
 #include "../GameData.h"
 #include "../GameWindow.h"
+#include "../Point.h"
 #include "../image/Sprite.h"
 #include "Shader.h"
 #include "graphics/graphics_layer.h"
@@ -25,30 +26,82 @@ this program. If not, see <https://www.gnu.org/licenses/>.
 namespace
 {
   Shader shader("batch shader");
-}
+  // How far back along their last step the sprites are drawn.
+  float drawLag = 0.f;
+  // Writes the vertices of visuals from their records, in the layout the batch shader reads.
+  Shader visualShader("visual shader");
+
+  // Bind the texture of the given sprite, and its frame count.
+  void BindSprite(const Sprite *sprite)
+  {
+    graphics_layer::TextureList texture_list;
+    texture_list.AddTexture(sprite->Texture().GetTexture(), 0, false);
+    texture_list.Bind(GameWindow::GetInstance());
+
+    const auto                 info = shader.GetInfo();
+    std::vector<unsigned char> data_cp(info.GetUniformSize());
+
+    const auto frame_count = static_cast<float>(sprite->Frames());
+
+    int i = -1;
+    info.CopyUniformEntryToBuffer(data_cp.data(), &frame_count, ++i);
+    info.CopyUniformEntryToBuffer(data_cp.data(), &drawLag, ++i);
+
+    GameWindow::GetInstance()->BindBufferDynamic(data_cp, GraphicsTypes::UBOBindPoint::Specific);
+  }
+} // namespace
 
 
 // Initialize the shaders.
 void BatchShader::Init()
 {
   auto &info = shader.GetInfo();
-  info.SetInputSize(6 * sizeof(float));
-  info.AddInput(GraphicsTypes::ShaderType::FLOAT2, 0, 0);                 // vert
-  info.AddInput(GraphicsTypes::ShaderType::FLOAT3, 2 * sizeof(float), 1); // texCoord
-  info.AddInput(GraphicsTypes::ShaderType::FLOAT, 5 * sizeof(float), 2);  // alpha
+  info.SetInputSize(11 * sizeof(float));
+  info.AddInput(GraphicsTypes::ShaderType::FLOAT2, 0, 0);                  // vert
+  info.AddInput(GraphicsTypes::ShaderType::FLOAT3, 2 * sizeof(float), 1);  // texCoord
+  info.AddInput(GraphicsTypes::ShaderType::FLOAT, 5 * sizeof(float), 2);   // alpha
+  info.AddInput(GraphicsTypes::ShaderType::FLOAT2, 6 * sizeof(float), 3);  // velocity
+  info.AddInput(GraphicsTypes::ShaderType::FLOAT2, 8 * sizeof(float), 4);  // corner
+  info.AddInput(GraphicsTypes::ShaderType::FLOAT, 10 * sizeof(float), 5);  // spin
 
   info.AddUniformVariable(GraphicsTypes::ShaderType::FLOAT); // frameCount
+  info.AddUniformVariable(GraphicsTypes::ShaderType::FLOAT); // lag
 
   info.AddTexture("tex");
 
   shader.Create(*GameData::Shaders().Find("batch"));
+  shader.WarmUp(GraphicsTypes::PrimitiveType::TRIANGLE_STRIP);
+
+  // If the graphics backend can generate vertices, the visuals are moved and animated on
+  // the GPU. Otherwise their vertices are written by the CPU, like those of any other sprite.
+  const auto *visualCode = GameData::Shaders().Find("visual");
+  if(visualCode && GameWindow::GetInstance()->CanGenerateVertices())
+  {
+    auto &visualInfo = visualShader.GetInfo();
+    visualInfo.AddUniformVariable(GraphicsTypes::ShaderType::INT);    // count
+    visualInfo.AddUniformVariable(GraphicsTypes::ShaderType::INT);    // step
+    visualInfo.AddUniformVariable(GraphicsTypes::ShaderType::FLOAT);  // zoom
+    visualInfo.AddUniformVariable(GraphicsTypes::ShaderType::FLOAT);  // frameCount
+    visualInfo.AddUniformVariable(GraphicsTypes::ShaderType::FLOAT2); // center
+    visualInfo.AddUniformVariable(GraphicsTypes::ShaderType::FLOAT2); // centerVelocity
+
+    visualShader.Create(*visualCode);
+  }
 }
 
 
-void BatchShader::Clear() { shader.Clear(); }
+void BatchShader::Clear()
+{
+  shader.Clear();
+  visualShader.Clear();
+}
 
 
-void BatchShader::Bind() { shader.Bind(); }
+void BatchShader::Bind(float lag)
+{
+  drawLag = lag;
+  shader.Bind();
+}
 
 
 void BatchShader::Add(const Sprite *sprite, const std::vector<float> &data)
@@ -56,20 +109,56 @@ void BatchShader::Add(const Sprite *sprite, const std::vector<float> &data)
   // Do nothing if there are no sprites to draw.
   if(data.empty()) return;
 
-  graphics_layer::TextureList texture_list;
-  texture_list.AddTexture(sprite->Texture().GetTexture(), 0, false);
-  texture_list.Bind(GameWindow::GetInstance());
+  BindSprite(sprite);
 
-  const auto                 info = shader.GetInfo();
-  std::vector<unsigned char> data_cp(info.GetUniformSize());
+  GameWindow::GetInstance()
+      ->DrawDynamic(data.size() / 11, 11 * sizeof(float), data.data(), GraphicsTypes::PrimitiveType::TRIANGLE_STRIP);
+}
 
-  const auto frame_count = static_cast<float>(sprite->Frames());
 
-  int i = -1;
-  info.CopyUniformEntryToBuffer(data_cp.data(), &frame_count, ++i);
+// Check whether the graphics backend can move and animate visuals itself.
+bool BatchShader::CanDrawVisuals() { return visualShader(); }
 
-  GameWindow::GetInstance()->BindBufferDynamic(data_cp, GraphicsTypes::UBOBindPoint::Specific);
 
-  GameWindow::GetInstance()
-      ->DrawDynamic(data.size() / 6, 6 * sizeof(float), data.data(), GraphicsTypes::PrimitiveType::TRIANGLE_STRIP);
+// Draw the visuals of the given sprite as they are at the given step.
+void BatchShader::AddVisuals(
+    const Sprite                     *sprite,
+    const std::vector<Visual::Record> &records,
+    int                               step,
+    double                            zoom,
+    const Point                      &center,
+    const Point                      &centerVelocity)
+{
+  if(records.empty()) return;
+
+  BindSprite(sprite);
+
+  const auto                &info = visualShader.GetInfo();
+  std::vector<unsigned char> uniforms(info.GetUniformSize());
+
+  const auto  count           = static_cast<int>(records.size());
+  const auto  viewZoom        = static_cast<float>(zoom);
+  const auto  frameCount      = static_cast<float>(sprite->Frames());
+  const float viewCenter[2]   = {static_cast<float>(center.X()), static_cast<float>(center.Y())};
+  const float viewVelocity[2] = {static_cast<float>(centerVelocity.X()), static_cast<float>(centerVelocity.Y())};
+
+  int i = -1;
+  info.CopyUniformEntryToBuffer(uniforms.data(), &count, ++i);
+  info.CopyUniformEntryToBuffer(uniforms.data(), &step, ++i);
+  info.CopyUniformEntryToBuffer(uniforms.data(), &viewZoom, ++i);
+  info.CopyUniformEntryToBuffer(uniforms.data(), &frameCount, ++i);
+  info.CopyUniformEntryToBuffer(uniforms.data(), viewCenter, ++i);
+  info.CopyUniformEntryToBuffer(uniforms.data(), viewVelocity, ++i);
+
+  // Each record becomes a quad of six vertices, like the ones BatchDrawList writes.
+  GraphicsTypes::VertexGenerator generator;
+  generator.Shader            = visualShader.Instance();
+  generator.Uniforms          = &uniforms;
+  generator.Records           = records.data();
+  generator.RecordCount       = records.size();
+  generator.RecordSize        = sizeof(Visual::Record);
+  generator.VerticesPerRecord = 6;
+  generator.VertexSize        = 11 * sizeof(float);
+
+  GameWindow::GetInstance()->DrawGenerated(generator, GraphicsTypes::PrimitiveType::TRIANGLE_STRIP);
 }
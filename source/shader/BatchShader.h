@@ -15,13 +15,17 @@ this program. If not, see <https://www.gnu.org/licenses/>.
 
 #pragma once
 
+#include "../Visual.h"
+
 #include <vector>
 
+class Point;
 class Sprite;
 
 
 // Class for drawing sprites in a batch. The input to each draw command is a
-// sprite and the vertex data.
+// sprite and the vertex data. Each vertex also holds how far it moves on screen
+// in one step, so that the batch can be drawn where it was part of a step earlier.
 class BatchShader
 {
 public:
@@ -29,6 +33,19 @@ public:
   static void Init();
   static void Clear();
 
-  static void Bind();
+  // Bind the shader, to draw everything where it was the given fraction of a step earlier.
+  static void Bind(float lag = 0.f);
   static void Add(const Sprite *sprite, const std::vector<float> &data);
+
+  // Check whether the graphics backend can move and animate visuals itself, so
+  // that the vertices of visuals don't have to be written by the CPU.
+  static bool CanDrawVisuals();
+  // Draw the visuals of the given sprite as they are at the given step.
+  static void AddVisuals(
+      const Sprite                     *sprite,
+      const std::vector<Visual::Record> &records,
+      int                               step,
+      double                            zoom,
+      const Point                      &center,
+      const Point                      &centerVelocity);
 };
@@ -19,6 +19,7 @@ this program. If not, see <https://www.gnu.org/licenses/>.
 #include "../Preferences.h"
 #include "../Screen.h"
 #include "../image/Sprite.h"
+#include "../pi.h"
 #include "SpriteShader.h"
 
 #include <cmath>
@@ -77,14 +78,38 @@ bool DrawList::AddSwizzled(const Body &body, const Swizzle *swizzle, double cloa
 }
 
 
-// Draw all the items in this list.
-void DrawList::Draw() const
+// Add an object at the given position even if it is not on screen right now.
+bool DrawList::AddUnculled(const Body &body, Point position, double cloak)
+{
+  if(!body.HasSprite() || !body.Zoom()) return false;
+
+  position   -= center;
+  Point blur  = body.Velocity() - centerVelocity;
+  Push(body, std::move(position), std::move(blur), cloak, body.GetSwizzle());
+  return true;
+}
+
+
+// Draw all the items in this list, where they were the given fraction of a step earlier,
+// and moved by the given offset (in screen pixels).
+void DrawList::Draw(float lag, const Point &offset) const
 {
   SpriteShader::Bind();
 
-  bool withBlur = Preferences::Has("Render motion blur");
-  for(const SpriteShader::Item &item : items)
-    SpriteShader::Add(item, withBlur);
+  bool withBlur = Preferences::Current().Has(Preferences::Flag::RENDER_MOTION_BLUR);
+  if(!offset)
+  {
+    for(const SpriteShader::Item &item : items)
+      SpriteShader::Add(item, withBlur, lag);
+  }
+  else {
+    for(SpriteShader::Item item : items)
+    {
+      item.position[0] += static_cast<float>(offset.X());
+      item.position[1] += static_cast<float>(offset.Y());
+      SpriteShader::Add(item, withBlur, lag);
+    }
+  }
 
   SpriteShader::Unbind();
 }
@@ -142,6 +167,12 @@ void DrawList::Push(const Body &body, Point pos, Point blur, double cloak, const
   item.blur[0]  = unit.Cross(blur) / (width * 4.);
   item.blur[1]  = -unit.Dot(blur) / (height * 4.);
 
+  // Even objects that are drawn without blur move relative to the view.
+  Point velocity   = (body.Velocity() - centerVelocity) * zoom;
+  item.velocity[0] = static_cast<float>(velocity.X());
+  item.velocity[1] = static_cast<float>(velocity.Y());
+  item.spin        = static_cast<float>(body.Spin().Degrees() * TO_RAD);
+
   item.alpha   = (1. - cloak) * body.Alpha(center);
   item.swizzle = swizzle;
   item.clip    = 1.;
@@ -47,9 +47,13 @@ public:
   bool AddUnblurred(const Body &body);
   // Add an object using a specific swizzle (rather than its own).
   bool AddSwizzled(const Body &body, const Swizzle *swizzle, double cloak = 0.);
+  // Add an object at the given position even if it is not on screen right now,
+  // for a list that is drawn again after the view has moved.
+  bool AddUnculled(const Body &body, Point position, double cloak = 0.);
 
-  // Draw all the items in this list.
-  void Draw() const;
+  // Draw all the items in this list, where they were the given fraction of a step earlier,
+  // and moved by the given offset (in screen pixels).
+  void Draw(float lag = 0.f, const Point &offset = Point()) const;
 
 
 private:
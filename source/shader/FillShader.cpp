@@ -46,6 +46,7 @@ void FillShader::Init()
   info.AddUniformVariable(GraphicsTypes::ShaderType::FLOAT4); // u_in vec4 color;
 
   shader.Create(*GameData::Shaders().Find("fill"));
+  shader.WarmUp(GraphicsTypes::PrimitiveType::TRIANGLE_STRIP);
 
   constexpr float vertexData[] = {-.5f, -.5f, .5f, -.5f, -.5f, .5f, .5f, .5f};
 
@@ -72,6 +72,7 @@ void FogShader::Init()
   info.AddTexture("tex");
 
   shader.Create(*GameData::Shaders().Find("fog"));
+  shader.WarmUp(GraphicsTypes::PrimitiveType::TRIANGLE_STRIP);
 
   constexpr float vertexData[] = {0.f, 0.f, 0.f, 1.f, 1.f, 0.f, 1.f, 1.f};
 
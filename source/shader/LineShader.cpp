@@ -49,6 +49,7 @@ void LineShader::Init()
 
 
   shader.Create(*GameData::Shaders().Find("line"));
+  shader.WarmUp(GraphicsTypes::PrimitiveType::TRIANGLE_STRIP);
 
   constexpr float vertexData[] = {-1.f, -1.f, 1.f, -1.f, -1.f, 1.f, 1.f, 1.f};
 
@@ -50,6 +50,7 @@ void OutlineShader::Init()
   info.AddTexture("tex");
 
   shader.Create(*GameData::Shaders().Find("outline"));
+  shader.WarmUp(GraphicsTypes::PrimitiveType::TRIANGLE_STRIP);
 
   constexpr float vertexData[] = {-.5f, -.5f, 0.f, 0.f, .5f, -.5f, 1.f, 0.f, -.5f, .5f, 0.f, 1.f, .5f, .5f, 1.f, 1.f};
 
@@ -46,6 +46,7 @@ void PointerShader::Init()
   info.AddUniformVariable(GraphicsTypes::ShaderType::FLOAT4);
 
   shader.Create(*GameData::Shaders().Find("pointer"));
+  shader.WarmUp(GraphicsTypes::PrimitiveType::TRIANGLES);
 
   constexpr float vertexData[] = {
       0.f,
@@ -48,6 +48,7 @@ void RingShader::Init()
   info.AddUniformVariable(GraphicsTypes::ShaderType::FLOAT4); // u_in vec4  color;
 
   shader.Create(*GameData::Shaders().Find("ring"));
+  shader.WarmUp(GraphicsTypes::PrimitiveType::TRIANGLE_STRIP);
 
   constexpr float vertexData[] = {-1.f, -1.f, -1.f, 1.f, 1.f, -1.f, 1.f, 1.f};
   square =
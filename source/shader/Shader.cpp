@@ -33,6 +33,13 @@ void Shader::Create(const std::vector<File::ShaderString> &shader_code)
   if(!ShaderInstance) throw std::runtime_error("Shader Instance not found: " + std::string(Name));
 }
 
+void Shader::WarmUp(const GraphicsTypes::PrimitiveType primitiveType) const
+{
+  GraphicsTypes::RenderState state = GameWindow::ScreenState();
+  state.DrawPrimitiveType          = primitiveType;
+  GameWindow::GetInstance()->WarmUpShader(ShaderInstance.get(), state);
+}
+
 void Shader::Bind() const { GameWindow::GetInstance()->BindShader(ShaderInstance.get()); }
 
 void Shader::Clear() { ShaderInstance.reset(); }
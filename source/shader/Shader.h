@@ -38,9 +38,13 @@ public:
   const ShaderInfo &GetInfo() const { return Info; }
 
   void Create(const std::vector<File::ShaderString> &shader_code);
+  // Compile what this shader needs to draw the given primitives to the screen now,
+  // rather than stalling the first frame that draws with it.
+  void WarmUp(GraphicsTypes::PrimitiveType primitiveType) const;
   void Bind() const;
 
   bool operator()() const { return ShaderInstance.get(); }
+  const GraphicsTypes::ShaderInstance *Instance() const { return ShaderInstance.get(); }
 
   void Clear();
 
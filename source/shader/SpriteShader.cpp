@@ -22,12 +22,84 @@ this program. If not, see <https://www.gnu.org/licenses/>.
 #include "GameWindow.h"
 #include "Shader.h"
 
+#include <algorithm>
+#include <cmath>
+#include <cstddef>
+#include <cstring>
+#include <vector>
+
 
 namespace
 {
+  // The per-sprite data, read by the shader as instanced vertex inputs.
+  struct Instance
+  {
+    float position[2];
+    float transform[4];
+    float blurClipAlpha[4];
+    float frameSwizzle[4];
+    float swizzle[16];
+  };
+
+  // Sprites that share their textures are drawn together with one instanced draw.
+  struct Batch
+  {
+    const GraphicsTypes::TextureInstance *texture;
+    const GraphicsTypes::TextureInstance *swizzleMask;
+    float                                 frameCount;
+    // The screen area covered by the sprites in this batch.
+    float                 left, top, right, bottom;
+    std::vector<Instance> instances;
+  };
+
+  // Batching may only move a sprite in front of batches it doesn't overlap,
+  // and only this many batches back, so that grouping stays cheap.
+  constexpr size_t MAX_LOOKBACK = 32;
+
   Shader                        shader("sprite shader");
   graphics_layer::ObjectHandle  square;
   graphics_layer::TextureHandle dummy_tex;
+
+  // The batches of the current frame. They are kept between flushes, so that
+  // their instance vectors don't have to be reallocated every frame.
+  std::vector<Batch>                    batches;
+  size_t                                batchCount = 0;
+  std::vector<GraphicsTypes::DrawRange> ranges(1);
+
+
+  bool Overlaps(const Batch &batch, const float left, const float top, const float right, const float bottom)
+  {
+    return left < batch.right && batch.left < right && top < batch.bottom && batch.top < bottom;
+  }
+
+
+  void Flush()
+  {
+    const auto                &info = shader.GetInfo();
+    std::vector<unsigned char> data_cp(info.GetUniformSize());
+    for(size_t i = 0; i < batchCount; ++i)
+    {
+      Batch &batch = batches[i];
+
+      graphics_layer::TextureList texture_list;
+      texture_list.AddTexture(batch.texture, 0, false);
+      texture_list.AddTexture(batch.swizzleMask, 1, false);
+      texture_list.Bind(GameWindow::GetInstance());
+
+      info.CopyUniformEntryToBuffer(data_cp.data(), &batch.frameCount, 0);
+      GameWindow::GetInstance()->BindBufferDynamic(data_cp, GraphicsTypes::UBOBindPoint::Specific);
+
+      ranges.front() = {0, 4, static_cast<uint32_t>(batch.instances.size())};
+      square.DrawInstanced(
+          GraphicsTypes::PrimitiveType::TRIANGLE_STRIP,
+          ranges,
+          sizeof(Instance),
+          batch.instances.data());
+
+      batch.instances.clear();
+    }
+    batchCount = 0;
+  }
 } // namespace
 
 void SpriteShader::Init()
@@ -35,22 +107,24 @@ void SpriteShader::Init()
   auto &info = shader.GetInfo();
   info.SetInputSize(2 * sizeof(float));
   info.AddInput(GraphicsTypes::ShaderType::FLOAT2, 0, 0); // vert
-
-  info.AddUniformVariable(GraphicsTypes::ShaderType::FLOAT2); // u_in vec2  position;
-  info.AddUniformVariable(GraphicsTypes::ShaderType::MAT2);   // u_in mat2  transform;
-  info.AddUniformVariable(GraphicsTypes::ShaderType::FLOAT2); // u_in vec2  blur;
-  info.AddUniformVariable(GraphicsTypes::ShaderType::FLOAT);  // u_in float clip;
-  info.AddUniformVariable(GraphicsTypes::ShaderType::FLOAT);  // u_in float frame;
-  info.AddUniformVariable(GraphicsTypes::ShaderType::FLOAT);  // u_in float frameCount;
-  info.AddUniformVariable(GraphicsTypes::ShaderType::MAT4);   // u_in mat4  swizzleMatrix;
-  info.AddUniformVariable(GraphicsTypes::ShaderType::INT);    // u_in int   useSwizzle;
-  info.AddUniformVariable(GraphicsTypes::ShaderType::FLOAT);  // u_in float alpha;
-  info.AddUniformVariable(GraphicsTypes::ShaderType::INT);    // u_in int   useSwizzleMask;
+  info.SetInstanceInputSize(sizeof(Instance));
+  info.AddInstanceInput(GraphicsTypes::ShaderType::FLOAT2, offsetof(Instance, position), 1);
+  info.AddInstanceInput(GraphicsTypes::ShaderType::FLOAT4, offsetof(Instance, transform), 2);
+  info.AddInstanceInput(GraphicsTypes::ShaderType::FLOAT4, offsetof(Instance, blurClipAlpha), 3);
+  info.AddInstanceInput(GraphicsTypes::ShaderType::FLOAT4, offsetof(Instance, frameSwizzle), 4);
+  for(size_t column = 0; column < 4; ++column)
+    info.AddInstanceInput(
+        GraphicsTypes::ShaderType::FLOAT4,
+        offsetof(Instance, swizzle) + column * 4 * sizeof(float),
+        5 + column);
+
+  info.AddUniformVariable(GraphicsTypes::ShaderType::FLOAT); // u_in float frameCount;
 
   info.AddTexture("tex");
   info.AddTexture("swizzleMask");
 
   shader.Create(*GameData::Shaders().Find("sprite"));
+  shader.WarmUp(GraphicsTypes::PrimitiveType::TRIANGLE_STRIP);
 
   constexpr float vertexData[] = {-.5f, -.5f, -.5f, .5f, .5f, -.5f, .5f, .5f};
 
@@ -72,6 +146,8 @@ void SpriteShader::Init()
 
 void SpriteShader::Clear()
 {
+  batches.clear();
+  batchCount = 0;
   shader.Clear();
   square    = {};
   dummy_tex = {};
@@ -130,7 +206,7 @@ SpriteShader::Item SpriteShader::Prepare(
 void SpriteShader::Bind() { shader.Bind(); }
 
 
-void SpriteShader::Add(const Item &item, bool withBlur)
+void SpriteShader::Add(const Item &item, bool withBlur, float lag)
 {
   if(!item.texture) return;
 
@@ -141,24 +217,31 @@ void SpriteShader::Add(const Item &item, bool withBlur)
     use_swizzle      = !item.swizzle->IsIdentity();
     use_swizzle_mask = !item.swizzle->OverrideMask() && item.swizzleMask;
   }
-
-  graphics_layer::TextureList texture_list;
-  texture_list.AddTexture(item.texture, 0, false);
-  if(item.swizzleMask) texture_list.AddTexture(item.swizzleMask, 1, false);
-  else texture_list.AddTexture(dummy_tex.GetTexture(), 1, false);
-  texture_list.Bind(GameWindow::GetInstance());
-
-  const auto                &info = shader.GetInfo();
-  std::vector<unsigned char> data_cp(info.GetUniformSize());
-  int                        i = -1;
-
-  info.CopyUniformEntryToBuffer(data_cp.data(), item.position, ++i);
-  info.CopyUniformEntryToBuffer(data_cp.data(), &item.transform, ++i);
-  static constexpr float UNBLURRED[2] = {0.f, 0.f};
-  info.CopyUniformEntryToBuffer(data_cp.data(), withBlur ? item.blur : UNBLURRED, ++i);
-  info.CopyUniformEntryToBuffer(data_cp.data(), &item.clip, ++i);
-  info.CopyUniformEntryToBuffer(data_cp.data(), &item.frame, ++i);
-  info.CopyUniformEntryToBuffer(data_cp.data(), &item.frameCount, ++i);
+  const GraphicsTypes::TextureInstance *swizzle_mask = item.swizzleMask ? item.swizzleMask : dummy_tex.GetTexture();
+
+  const float blur_x = withBlur ? item.blur[0] : 0.f;
+  const float blur_y = withBlur ? item.blur[1] : 0.f;
+
+  // Turn the sprite back by as much as it turns in the part of the step that is left.
+  const float turn = -lag * item.spin;
+  const float co   = cos(turn);
+  const float si   = sin(turn);
+
+  Instance instance;
+  instance.position[0]      = item.position[0] - lag * item.velocity[0];
+  instance.position[1]      = item.position[1] - lag * item.velocity[1];
+  instance.transform[0]     = co * item.transform.col0[0] - si * item.transform.col0[1];
+  instance.transform[1]     = si * item.transform.col0[0] + co * item.transform.col0[1];
+  instance.transform[2]     = co * item.transform.col1[0] - si * item.transform.col1[1];
+  instance.transform[3]     = si * item.transform.col1[0] + co * item.transform.col1[1];
+  instance.blurClipAlpha[0] = blur_x;
+  instance.blurClipAlpha[1] = blur_y;
+  instance.blurClipAlpha[2] = item.clip;
+  instance.blurClipAlpha[3] = item.alpha;
+  instance.frameSwizzle[0]  = item.frame;
+  instance.frameSwizzle[1]  = static_cast<float>(use_swizzle);
+  instance.frameSwizzle[2]  = static_cast<float>(use_swizzle_mask);
+  instance.frameSwizzle[3]  = 0.f;
   static constexpr float UNSWIZZLED[16] = {
       1.f,
       0.f,
@@ -177,15 +260,54 @@ void SpriteShader::Add(const Item &item, bool withBlur)
       0.f,
       1.f,
   };
-  info.CopyUniformEntryToBuffer(data_cp.data(), item.swizzle ? item.swizzle->MatrixPtr() : UNSWIZZLED, ++i);
-  info.CopyUniformEntryToBuffer(data_cp.data(), &use_swizzle, ++i);
-  info.CopyUniformEntryToBuffer(data_cp.data(), &item.alpha, ++i);
-  info.CopyUniformEntryToBuffer(data_cp.data(), &use_swizzle_mask, ++i);
-
-  GameWindow::GetInstance()->BindBufferDynamic(data_cp, GraphicsTypes::UBOBindPoint::Specific);
+  std::memcpy(instance.swizzle, item.swizzle ? item.swizzle->MatrixPtr() : UNSWIZZLED, sizeof(instance.swizzle));
+
+  // The area this sprite covers on screen, including its blur.
+  const float scale_x = 1.f + 2.f * std::abs(blur_x);
+  const float scale_y = 1.f + 2.f * std::abs(blur_y);
+  const float extent_x =
+      .5f * (std::abs(item.transform.col0[0]) * scale_x + std::abs(item.transform.col1[0]) * scale_y);
+  const float extent_y =
+      .5f * (std::abs(item.transform.col0[1]) * scale_x + std::abs(item.transform.col1[1]) * scale_y);
+  const float left   = instance.position[0] - extent_x;
+  const float top    = instance.position[1] - extent_y;
+  const float right  = instance.position[0] + extent_x;
+  const float bottom = instance.position[1] + extent_y;
+
+  // Find a batch with the same textures that this sprite can join without
+  // changing how it overlaps the sprites that were added after that batch.
+  Batch *target = nullptr;
+  for(size_t i = batchCount; i-- > 0 && batchCount - i <= MAX_LOOKBACK;)
+  {
+    Batch &batch = batches[i];
+    if(batch.texture == item.texture && batch.swizzleMask == swizzle_mask && batch.frameCount == item.frameCount)
+    {
+      target = &batch;
+      break;
+    }
+    if(Overlaps(batch, left, top, right, bottom)) break;
+  }
 
-  square.Draw(GraphicsTypes::PrimitiveType::TRIANGLE_STRIP);
+  if(target)
+  {
+    target->left   = std::min(target->left, left);
+    target->top    = std::min(target->top, top);
+    target->right  = std::max(target->right, right);
+    target->bottom = std::max(target->bottom, bottom);
+  }
+  else {
+    if(batchCount == batches.size()) batches.emplace_back();
+    target              = &batches[batchCount++];
+    target->texture     = item.texture;
+    target->swizzleMask = swizzle_mask;
+    target->frameCount  = item.frameCount;
+    target->left        = left;
+    target->top         = top;
+    target->right       = right;
+    target->bottom      = bottom;
+  }
+  target->instances.push_back(instance);
 }
 
 
-void SpriteShader::Unbind() {}
+void SpriteShader::Unbind() { Flush(); }
@@ -47,6 +47,9 @@ public:
     float                                 blur[2] = {0.f, 0.f};
     float                                 clip    = 1.f;
     float                                 alpha   = 1.f;
+    // How far the sprite moves on screen in one step, and how far it turns, in radians.
+    float velocity[2] = {0.f, 0.f};
+    float spin        = 0.f;
   };
 
 
@@ -74,7 +77,10 @@ public:
       float          frame   = 0.f,
       const Point   &unit    = Point(0., -1.));
 
+  // Sprites added between Bind() and Unbind() are grouped by their textures and
+  // drawn with one instanced draw per group once Unbind() is called. A sprite is
+  // drawn where it was the given fraction of a step earlier.
   static void Bind();
-  static void Add(const Item &item, bool withBlur = false);
+  static void Add(const Item &item, bool withBlur = false, float lag = 0.f);
   static void Unbind();
 };
@@ -75,7 +75,7 @@ namespace
       // Draw any instances of this haze that are on screen.
       for(int y = 0; y < y_count; y++)
         for(int x = 0; x < x_count; x++)
-          drawList.Add(it, Point(startX + x * HAZE_WRAP, startY + y * HAZE_WRAP), transparency);
+          drawList.AddUnculled(it, Point(startX + x * HAZE_WRAP, startY + y * HAZE_WRAP), transparency);
     }
   }
 } // namespace
@@ -116,6 +116,10 @@ void StarField::Clear()
 {
   shader.Clear();
   vertices = {};
+
+  // The cached haze refers to textures that may not survive this.
+  hazeList.Clear();
+  hazeSprite = nullptr;
 }
 
 
@@ -134,7 +138,11 @@ void StarField::FinishLoading()
 const Point &StarField::Position() const { return pos; }
 
 
-void StarField::SetPosition(const Point &position) { pos = position; }
+void StarField::SetPosition(const Point &position)
+{
+  pos      = position;
+  velocity = Point();
+}
 
 
 void StarField::SetHaze(const Sprite *sprite, bool allowAnimation)
@@ -157,7 +165,7 @@ void StarField::SetHaze(const Sprite *sprite, bool allowAnimation)
 
 void StarField::Step(Point vel, double zoom)
 {
-  if(Preferences::Has("Fixed starfield zoom"))
+  if(Preferences::Current().Has(Preferences::Flag::FIXED_STARFIELD_ZOOM))
   {
     baseZoom  = fixedZoom;
     vel      /= velocityReducer;
@@ -181,16 +189,20 @@ void StarField::Step(Point vel, double zoom)
     baseZoom = zoom;
   }
 
-  pos += vel;
+  pos      += vel;
+  velocity  = vel;
 }
 
 
-void StarField::Draw(const Point &blur, const System *system) const
+void StarField::Draw(const Point &blur, const System *system, float lag) const
 {
+  // Move the starfield back along its last step by the given fraction of it.
+  const Point position = pos - velocity * lag;
+
   const double density = system ? system->StarfieldDensity() : 1.;
 
   // Check preferences for the parallax quality.
-  const auto parallaxSetting = Preferences::GetBackgroundParallax();
+  const auto parallaxSetting = Preferences::Current().backgroundParallax;
   const int  layers          = (parallaxSetting == Preferences::BackgroundParallax::FANCY) ? 3 : 1;
   const bool isParallax =
       (parallaxSetting == Preferences::BackgroundParallax::FANCY ||
@@ -198,10 +210,12 @@ void StarField::Draw(const Point &blur, const System *system) const
 
   // Draw the starfield unless it is disabled in the preferences.
   double zoom = baseZoom;
-  if(Preferences::Has("Draw starfield") && density > 0.)
+  if(Preferences::Current().Has(Preferences::Flag::DRAW_STARFIELD) && density > 0.)
   {
     shader.Bind();
 
+    const auto                &info = shader.GetInfo();
+    std::vector<unsigned char> data_cp(info.GetUniformSize());
     for(int pass = 1; pass <= layers; pass++)
     {
       // Modify zoom for the first parallax layer.
@@ -221,69 +235,95 @@ void StarField::Draw(const Point &blur, const System *system) const
       const float elongation = length * static_cast<float>(zoom);
       const float brightness = std::min<float>(1.f, std::pow(static_cast<float>(zoom), .5f));
 
-      const auto                &info = shader.GetInfo();
-      std::vector<unsigned char> data_cp(info.GetUniformSize());
       {
         const auto zoom_f = static_cast<float>(zoom);
         info.CopyUniformEntryToBuffer(data_cp.data(), &zoom_f, 0);
       }
       info.CopyUniformEntryToBuffer(data_cp.data(), &rotate, 1);
-      info.CopyUniformEntryToBuffer(data_cp.data(), &elongation, 3);
-      info.CopyUniformEntryToBuffer(data_cp.data(), &brightness, 4);
+      info.CopyUniformEntryToBuffer(data_cp.data(), &elongation, 2);
+      info.CopyUniformEntryToBuffer(data_cp.data(), &brightness, 3);
 
       // Stars this far beyond the border may still overlap the screen.
       const double borderX = fabs(blur.X()) + 1.;
       const double borderY = fabs(blur.Y()) + 1.;
       // Find the absolute bounds of the star field we must draw.
-      int       minX = static_cast<int>(pos.X()) + static_cast<int>((Screen::Left() - borderX) / zoom);
-      int       minY = static_cast<int>(pos.Y()) + static_cast<int>((Screen::Top() - borderY) / zoom);
-      const int maxX = static_cast<int>(pos.X()) + static_cast<int>((Screen::Right() + borderX) / zoom);
-      const int maxY = static_cast<int>(pos.Y()) + static_cast<int>((Screen::Bottom() + borderY) / zoom);
+      int       minX = static_cast<int>(position.X()) + static_cast<int>((Screen::Left() - borderX) / zoom);
+      int       minY = static_cast<int>(position.Y()) + static_cast<int>((Screen::Top() - borderY) / zoom);
+      const int maxX = static_cast<int>(position.X()) + static_cast<int>((Screen::Right() + borderX) / zoom);
+      const int maxY = static_cast<int>(position.Y()) + static_cast<int>((Screen::Bottom() + borderY) / zoom);
       // Round down to the start of the nearest tile.
       minX &= ~(TILE_SIZE - 1l);
       minY &= ~(TILE_SIZE - 1l);
 
+      // Gather the stars of every visible tile, so that the whole layer can be
+      // drawn at once instead of binding new uniforms for each tile.
+      tileRanges.clear();
+      tileOffsets.clear();
       for(int gy = minY; gy < maxY; gy += TILE_SIZE)
       {
         for(int gx = minX; gx < maxX; gx += TILE_SIZE)
         {
-          Point       off          = Point(gx, gy) - pos;
-          const float translate[2] = {static_cast<float>(off.X()), static_cast<float>(off.Y())};
-          info.CopyUniformEntryToBuffer(data_cp.data(), translate, 2);
-
-          GameWindow::GetInstance()->BindBufferDynamic(data_cp, GraphicsTypes::UBOBindPoint::Specific);
-
           const int index = (gx & widthMod) / TILE_SIZE + ((gy & widthMod) / TILE_SIZE) * tileCols;
           const int first = tileIndex[index];
           const int count = static_cast<int>((tileIndex[index + 1] - first) * density / layers);
-          vertices.Draw(GraphicsTypes::PrimitiveType::TRIANGLES, 6 * (first + (pass - 1) * count), 6 * (count / pass));
+          if(count / pass <= 0) continue;
+
+          Point off = Point(gx, gy) - position;
+          tileOffsets.push_back(static_cast<float>(off.X()));
+          tileOffsets.push_back(static_cast<float>(off.Y()));
+          tileRanges.emplace_back(
+              static_cast<uint32_t>(6 * (first + (pass - 1) * count)),
+              static_cast<uint32_t>(6 * (count / pass)));
         }
       }
+
+      GameWindow::GetInstance()->BindBufferDynamic(data_cp, GraphicsTypes::UBOBindPoint::Specific);
+      vertices.DrawInstanced(
+          GraphicsTypes::PrimitiveType::TRIANGLES,
+          tileRanges,
+          2 * sizeof(float),
+          tileOffsets.data());
     }
   }
 
   // Draw the background haze unless it is disabled in the preferences.
-  if(!Preferences::Has("Draw background haze")) return;
+  if(!Preferences::Current().Has(Preferences::Flag::DRAW_BACKGROUND_HAZE)) return;
 
   // Modify zoom for the second parallax layer.
   if(isParallax) zoom = baseZoom * HAZE_ZOOM;
 
-  DrawList drawList;
-  drawList.Clear(0, zoom);
-  drawList.SetCenter(pos);
-
   if(transparency > FADE_PER_FRAME) transparency -= FADE_PER_FRAME;
   else transparency = 0.;
 
-  // Any object within this range must be drawn. Some haze sprites may repeat
-  // more than once if the view covers a very large area.
-  Point size        = Point(1., 1.) * haze[0].front().Radius();
-  Point topLeft     = pos + Screen::TopLeft() / zoom - size;
-  Point bottomRight = pos + Screen::BottomRight() / zoom + size;
-  if(transparency > 0.) AddHaze(drawList, haze[1], topLeft, bottomRight, 1 - transparency);
-  AddHaze(drawList, haze[0], topLeft, bottomRight, transparency);
+  // The haze is laid out for half a screen beyond each edge of the view, so
+  // that it only needs to be laid out again once the view has moved that far.
+  const Sprite *sprite    = haze[0].front().GetSprite();
+  const Point   margin    = Screen::Dimensions() * (.5 / zoom);
+  const Point   moved     = position - hazeCenter;
+  const bool    isCovered = fabs(moved.X()) <= margin.X() && fabs(moved.Y()) <= margin.Y();
+  if(sprite != hazeSprite || zoom != hazeZoom || transparency != hazeTransparency ||
+     Screen::Dimensions() != hazeScreen || !isCovered)
+  {
+    hazeSprite       = sprite;
+    hazeCenter       = position;
+    hazeScreen       = Screen::Dimensions();
+    hazeZoom         = zoom;
+    hazeTransparency = transparency;
+
+    hazeList.Clear(0, zoom);
+    hazeList.SetCenter(position);
+
+    // Any object within this range must be drawn. Some haze sprites may repeat
+    // more than once if the view covers a very large area.
+    Point size        = Point(1., 1.) * haze[0].front().Radius() + margin;
+    Point topLeft     = position + Screen::TopLeft() / zoom - size;
+    Point bottomRight = position + Screen::BottomRight() / zoom + size;
+    if(transparency > 0.) AddHaze(hazeList, haze[1], topLeft, bottomRight, 1 - transparency);
+    AddHaze(hazeList, haze[0], topLeft, bottomRight, transparency);
+  }
 
-  drawList.Draw();
+  // Move the haze to where the view is now.
+  hazeList.Draw(0.f, (hazeCenter - position) * zoom);
 }
 
 
@@ -295,14 +335,16 @@ void StarField::SetUpGraphics()
   info.AddInput(GraphicsTypes::ShaderType::FLOAT2, 0, 0);
   info.AddInput(GraphicsTypes::ShaderType::FLOAT, 2 * sizeof(float), 1);
   info.AddInput(GraphicsTypes::ShaderType::FLOAT, 3 * sizeof(float), 2);
+  info.SetInstanceInputSize(2 * sizeof(float));
+  info.AddInstanceInput(GraphicsTypes::ShaderType::FLOAT2, 0, 3);
 
   info.AddUniformVariable(GraphicsTypes::ShaderType::FLOAT);
   info.AddUniformVariable(GraphicsTypes::ShaderType::MAT2);
-  info.AddUniformVariable(GraphicsTypes::ShaderType::FLOAT2);
   info.AddUniformVariable(GraphicsTypes::ShaderType::FLOAT);
   info.AddUniformVariable(GraphicsTypes::ShaderType::FLOAT);
 
   shader.Create(*GameData::Shaders().Find("starfield"));
+  shader.WarmUp(GraphicsTypes::PrimitiveType::TRIANGLES);
 }
 
 
@@ -16,6 +16,7 @@ this program. If not, see <https://www.gnu.org/licenses/>.
 #pragma once
 
 #include "../Point.h"
+#include "DrawList.h"
 #include "Shader.h"
 
 #include <vector>
@@ -45,7 +46,8 @@ public:
   void         SetHaze(const Sprite *sprite, bool allowAnimation);
 
   void Step(Point vel, double zoom = 1.);
-  void Draw(const Point &blur, const System *system = nullptr) const;
+  // Draw the starfield where it was the given fraction of a step earlier.
+  void Draw(const Point &blur, const System *system = nullptr, float lag = 0.f) const;
 
 
 private:
@@ -64,6 +66,8 @@ private:
 
   Point  pos;
   double baseZoom = 1.;
+  // How far the starfield moved in the last step.
+  Point velocity;
 
   double minZoom;
   double zoomClamp;
@@ -74,6 +78,20 @@ private:
   mutable double    transparency = 0.;
   std::vector<Body> haze[2];
 
+  // The haze is laid out for an area larger than the screen, around hazeCenter, and
+  // only laid out again when the haze itself, the zoom or the screen size changed, or
+  // when the view has moved too far away from where it was laid out.
+  mutable DrawList      hazeList;
+  mutable const Sprite *hazeSprite       = nullptr;
+  mutable Point         hazeCenter;
+  mutable Point         hazeScreen;
+  mutable double        hazeZoom         = 0.;
+  mutable double        hazeTransparency = -1.;
+
   Shader                       shader = Shader("starfield shader");
   graphics_layer::ObjectHandle vertices;
+  // The visible tiles of a layer, reused from frame to frame. Each tile is one
+  // instance, with its offset as the instance data.
+  mutable std::vector<GraphicsTypes::DrawRange> tileRanges;
+  mutable std::vector<float>                    tileOffsets;
 };
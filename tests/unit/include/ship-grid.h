@@ -0,0 +1,43 @@
+/* ship-grid.h
+Copyright (c) 2026 by RisingLeaf
+
+Endless Sky is free software: you can redistribute it and/or modify it under the
+terms of the GNU General Public License as published by the Free Software
+Foundation, either version 3 of the License, or (at your option) any later version.
+
+Endless Sky is distributed in the hope that it will be useful, but WITHOUT ANY
+WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS FOR A
+PARTICULAR PURPOSE. See the GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License along with
+this program. If not, see <https://www.gnu.org/licenses/>.
+*/
+
+
+#pragma once
+
+#include "../../../source/Point.h"
+
+#include <functional>
+#include <memory>
+#include <memory_resource>
+#include <vector>
+
+class Ship;
+
+
+
+// The ship indices are tested with a grid that wraps around every 8 cells of 256 units,
+// so ships that are spread out over more than 2048 units share grid cells with ships far away.
+constexpr unsigned GRID_CELL_SIZE = 256;
+constexpr unsigned GRID_CELL_COUNT = 8;
+
+// Get points spread evenly over a square around the origin. The same seed always gives the same points.
+std::vector<Point> RandomPoints(unsigned seed, int count, double spread);
+// Create a ship at each of the given positions.
+std::vector<std::shared_ptr<Ship>> ShipsAt(const std::vector<Point> &positions);
+// Find the ships that pass the given check by checking every one of them in order,
+// the way the indices did before they had a grid.
+std::vector<Ship *> CheckEveryShip(const std::vector<Ship *> &ships, const std::function<bool(const Ship &)> &isFound);
+// Copy the ships found by an index out of its memory resource, so that they can be compared.
+std::vector<Ship *> AsVector(const std::pmr::vector<Ship *> &ships);
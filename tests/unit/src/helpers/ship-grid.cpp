@@ -0,0 +1,72 @@
+/* ship-grid.cpp
+Copyright (c) 2026 by RisingLeaf
+
+Endless Sky is free software: you can redistribute it and/or modify it under the
+terms of the GNU General Public License as published by the Free Software
+Foundation, either version 3 of the License, or (at your option) any later version.
+
+Endless Sky is distributed in the hope that it will be useful, but WITHOUT ANY
+WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS FOR A
+PARTICULAR PURPOSE. See the GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License along with
+this program. If not, see <https://www.gnu.org/licenses/>.
+*/
+
+
+#include "ship-grid.h"
+
+#include "../../../../source/Point.h"
+#include "../../../../source/Ship.h"
+
+#include <functional>
+#include <memory>
+#include <memory_resource>
+#include <random>
+#include <vector>
+
+
+
+// Get points spread evenly over a square around the origin. The same seed always gives the same points.
+std::vector<Point> RandomPoints(unsigned seed, int count, double spread)
+{
+	std::mt19937 generator(seed);
+	std::uniform_real_distribution<double> coordinate(-spread, spread);
+	std::vector<Point> points;
+	for(int i = 0; i < count; ++i)
+	{
+		// The order in which function arguments are evaluated is unspecified.
+		const double x = coordinate(generator);
+		points.emplace_back(x, coordinate(generator));
+	}
+	return points;
+}
+
+// Create a ship at each of the given positions.
+std::vector<std::shared_ptr<Ship>> ShipsAt(const std::vector<Point> &positions)
+{
+	std::vector<std::shared_ptr<Ship>> ships;
+	for(const Point &position : positions)
+	{
+		ships.push_back(std::make_shared<Ship>());
+		ships.back()->SetPosition(position);
+	}
+	return ships;
+}
+
+// Find the ships that pass the given check by checking every one of them in order,
+// the way the indices did before they had a grid.
+std::vector<Ship *> CheckEveryShip(const std::vector<Ship *> &ships, const std::function<bool(const Ship &)> &isFound)
+{
+	std::vector<Ship *> found;
+	for(Ship *ship : ships)
+		if(isFound(*ship))
+			found.push_back(ship);
+	return found;
+}
+
+// Copy the ships found by an index out of its memory resource, so that they can be compared.
+std::vector<Ship *> AsVector(const std::pmr::vector<Ship *> &ships)
+{
+	return std::vector<Ship *>(ships.begin(), ships.end());
+}
@@ -0,0 +1,231 @@
+/* test_aiScheduler.cpp
+Copyright (c) 2026 by RisingLeaf
+
+Endless Sky is free software: you can redistribute it and/or modify it under the
+terms of the GNU General Public License as published by the Free Software
+Foundation, either version 3 of the License, or (at your option) any later version.
+
+Endless Sky is distributed in the hope that it will be useful, but WITHOUT ANY
+WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS FOR A
+PARTICULAR PURPOSE. See the GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License along with
+this program. If not, see <https://www.gnu.org/licenses/>.
+*/
+
+#include "es-test.hpp"
+
+// Include only the tested class's header.
+#include "../../../source/AIScheduler.h"
+
+// The ships that are scheduled.
+#include "../../../source/Ship.h"
+#include "../../../source/System.h"
+
+// ... and any system includes needed for the test file.
+#include <list>
+#include <map>
+#include <memory>
+
+namespace { // test namespace
+
+// #region mock data
+// Ships in flight in the given system.
+std::list<std::shared_ptr<Ship>> MakeShips(int count, const System &system)
+{
+	std::list<std::shared_ptr<Ship>> ships;
+	for(int i = 0; i < count; ++i)
+	{
+		ships.push_back(std::make_shared<Ship>());
+		ships.back()->SetSystem(&system);
+	}
+	return ships;
+}
+
+// Count how many of the given ships have a strategic turn this step.
+int CountTurns(const AIScheduler &scheduler, const std::list<std::shared_ptr<Ship>> &ships)
+{
+	int turns = 0;
+	for(const auto &ship : ships)
+		turns += scheduler.IsStrategicTurn(*ship);
+	return turns;
+}
+// #endregion mock data
+
+
+
+// #region unit tests
+SCENARIO( "Spreading strategic turns across steps", "[AIScheduler]" ) {
+	System system;
+	AIScheduler scheduler;
+	GIVEN( "more ships than there are steps in a period, and no budget" ) {
+		const auto ships = MakeShips(AIScheduler::PERIOD + 8, system);
+		WHEN( "they are first seen" ) {
+			scheduler.Step(ships, 0);
+			THEN( "they all get a turn right away" ) {
+				CHECK( CountTurns(scheduler, ships) == AIScheduler::PERIOD + 8 );
+			}
+		}
+		WHEN( "many periods have passed" ) {
+			scheduler.Step(ships, 0);
+			// The first regular turn may come sooner than a period after the one a new ship gets.
+			std::map<const Ship *, int> lastTurn;
+			for(int step = 1; step <= 5 * AIScheduler::PERIOD; ++step)
+			{
+				scheduler.Step(ships, 0);
+				// The phases wrap around, so no step has more than two turns.
+				CHECK( CountTurns(scheduler, ships) <= 2 );
+				for(const auto &ship : ships)
+					if(scheduler.IsStrategicTurn(*ship))
+					{
+						if(lastTurn.contains(ship.get()))
+							CHECK( step - lastTurn[ship.get()] == AIScheduler::PERIOD );
+						lastTurn[ship.get()] = step;
+					}
+			}
+			THEN( "every ship has had a turn once every period" ) {
+				REQUIRE( lastTurn.size() == ships.size() );
+				for(const auto &it : lastTurn)
+					CHECK( it.second > 4 * AIScheduler::PERIOD );
+			}
+		}
+	}
+	GIVEN( "ships that are not in flight" ) {
+		auto ships = MakeShips(3, system);
+		ships.back()->SetSystem(nullptr);
+		WHEN( "a step passes" ) {
+			scheduler.Step(ships, 0);
+			THEN( "only the ones in a system get a turn" ) {
+				CHECK( scheduler.IsStrategicTurn(*ships.front()) );
+				CHECK_FALSE( scheduler.IsStrategicTurn(*ships.back()) );
+			}
+		}
+	}
+}
+
+SCENARIO( "Limiting the strategic turns on a single step", "[AIScheduler]" ) {
+	System system;
+	AIScheduler scheduler;
+	GIVEN( "more new ships than the budget allows" ) {
+		const auto ships = MakeShips(100, system);
+		WHEN( "steps pass" ) {
+			std::map<const Ship *, int> turns;
+			for(int step = 0; step < 10; ++step)
+			{
+				scheduler.Step(ships, 12);
+				CHECK( CountTurns(scheduler, ships) <= 12 );
+				for(const auto &ship : ships)
+					turns[ship.get()] += scheduler.IsStrategicTurn(*ship);
+			}
+			THEN( "the ships that waited get their turns on the next steps" ) {
+				for(const auto &ship : ships)
+					CHECK( turns[ship.get()] >= 1 );
+			}
+		}
+	}
+	GIVEN( "a ship that is woken up while other ships are due" ) {
+		// With more ships than steps in a period, some ship is due on every step.
+		const auto ships = MakeShips(40, system);
+		scheduler.Step(ships, 0);
+		const Ship &sleeper = *ships.back();
+		WHEN( "the next step passes" ) {
+			scheduler.Wake(&sleeper);
+			scheduler.Step(ships, 1);
+			THEN( "it goes first" ) {
+				CHECK( scheduler.IsStrategicTurn(sleeper) );
+				CHECK( CountTurns(scheduler, ships) == 1 );
+			}
+		}
+	}
+	GIVEN( "ships that have waited for different numbers of steps" ) {
+		const auto ships = MakeShips(8, system);
+		// Give all the ships their first turn, and then wake them all up in the next step,
+		// with a budget that only lets one ship have its turn on each step.
+		scheduler.Step(ships, 0);
+		for(const auto &ship : ships)
+			scheduler.Wake(ship.get());
+		scheduler.Step(ships, 1);
+		const Ship *first = nullptr;
+		for(const auto &ship : ships)
+			if(scheduler.IsStrategicTurn(*ship))
+				first = ship.get();
+		REQUIRE( first );
+		WHEN( "they are all woken up again" ) {
+			for(const auto &ship : ships)
+				scheduler.Wake(ship.get());
+			scheduler.Step(ships, 1);
+			THEN( "the one that just had a turn waits" ) {
+				CHECK( CountTurns(scheduler, ships) == 1 );
+				CHECK_FALSE( scheduler.IsStrategicTurn(*first) );
+			}
+		}
+	}
+}
+
+SCENARIO( "Ships entering and leaving in the middle of a period", "[AIScheduler]" ) {
+	System system;
+	AIScheduler scheduler;
+	auto ships = MakeShips(10, system);
+	for(int step = 0; step < 10; ++step)
+		scheduler.Step(ships, 0);
+	GIVEN( "a ship that arrives" ) {
+		const auto arrival = MakeShips(1, system).front();
+		ships.push_back(arrival);
+		WHEN( "the next step passes" ) {
+			scheduler.Step(ships, 0);
+			THEN( "it gets a turn right away" ) {
+				CHECK( scheduler.IsStrategicTurn(*arrival) );
+			}
+			AND_WHEN( "a period passes" ) {
+				int turns = 0;
+				for(int step = 1; step < AIScheduler::PERIOD; ++step)
+				{
+					scheduler.Step(ships, 0);
+					turns += scheduler.IsStrategicTurn(*arrival);
+				}
+				THEN( "it has had one regular turn" ) {
+					CHECK( turns == 1 );
+				}
+			}
+		}
+	}
+	GIVEN( "a ship that leaves" ) {
+		const auto departure = ships.front();
+		ships.pop_front();
+		WHEN( "the next steps pass" ) {
+			int turns = 0;
+			for(int step = 0; step < AIScheduler::PERIOD; ++step)
+			{
+				scheduler.Step(ships, 0);
+				turns += scheduler.IsStrategicTurn(*departure);
+			}
+			THEN( "it does not get a turn" ) {
+				CHECK( turns == 0 );
+			}
+			AND_WHEN( "it comes back" ) {
+				ships.push_back(departure);
+				scheduler.Step(ships, 0);
+				THEN( "it is treated as a new ship and gets a turn right away" ) {
+					CHECK( scheduler.IsStrategicTurn(*departure) );
+				}
+			}
+		}
+	}
+	GIVEN( "the scheduler is cleared" ) {
+		scheduler.Clear();
+		THEN( "no ship has a turn" ) {
+			CHECK( CountTurns(scheduler, ships) == 0 );
+		}
+		WHEN( "the next step passes" ) {
+			scheduler.Step(ships, 0);
+			THEN( "every ship gets a turn right away" ) {
+				CHECK( CountTurns(scheduler, ships) == 10 );
+			}
+		}
+	}
+}
+// #endregion unit tests
+
+
+
+} // test namespace
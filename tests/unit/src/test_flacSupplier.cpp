@@ -0,0 +1,155 @@
+/* test_flacSupplier.cpp
+Copyright (c) 2026 by RisingLeaf
+
+Endless Sky is free software: you can redistribute it and/or modify it under the
+terms of the GNU General Public License as published by the Free Software
+Foundation, either version 3 of the License, or (at your option) any later version.
+
+Endless Sky is distributed in the hope that it will be useful, but WITHOUT ANY
+WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS FOR A
+PARTICULAR PURPOSE. See the GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License along with
+this program. If not, see <https://www.gnu.org/licenses/>.
+*/
+
+#include "es-test.hpp"
+
+// Include only the tested class's header.
+#include "../../../source/audio/supplier/FlacSupplier.h"
+
+// The encoder that creates the streams to decode.
+#include <FLAC++/encoder.h>
+
+// ... and any system includes needed for the test file.
+#include <chrono>
+#include <cstdint>
+#include <memory>
+#include <sstream>
+#include <thread>
+#include <vector>
+
+namespace { // test namespace
+
+// #region mock data
+// Writes an encoded stream to the given output. Seeking is not supported, so the
+// stream info is not updated with the total sample count once encoding is finished.
+class Encoder : public FLAC::Encoder::Stream {
+public:
+	explicit Encoder(std::ostream &out) : out(out) {}
+
+protected:
+	FLAC__StreamEncoderWriteStatus write_callback(const FLAC__byte buffer[], size_t bytes, uint32_t,
+			uint32_t) override
+	{
+		out.write(reinterpret_cast<const char *>(buffer), bytes);
+		return out ? FLAC__STREAM_ENCODER_WRITE_STATUS_OK : FLAC__STREAM_ENCODER_WRITE_STATUS_FATAL_ERROR;
+	}
+
+private:
+	std::ostream &out;
+};
+
+// Interleaved 16-bit stereo samples, where no two neighbouring samples are the same.
+std::vector<int16_t> MakeSamples(int frames)
+{
+	std::vector<int16_t> samples;
+	for(int i = 0; i < 2 * frames; ++i)
+		samples.push_back(static_cast<int16_t>((i * 7919) % 20000 - 10000));
+	return samples;
+}
+
+// Encode the samples as a 44.1 kHz stereo FLAC stream.
+std::shared_ptr<std::iostream> Encode(const std::vector<int16_t> &samples)
+{
+	auto stream = std::make_shared<std::stringstream>();
+	Encoder encoder(*stream);
+	encoder.set_channels(2);
+	encoder.set_bits_per_sample(16);
+	encoder.set_sample_rate(44100);
+	REQUIRE( encoder.init() == FLAC__STREAM_ENCODER_INIT_STATUS_OK );
+	const std::vector<FLAC__int32> wide(samples.begin(), samples.end());
+	REQUIRE( encoder.process_interleaved(wide.data(), wide.size() / 2) );
+	REQUIRE( encoder.finish() );
+	return stream;
+}
+
+// Take every chunk the supplier provides, waiting for the decoder where needed.
+std::vector<std::vector<int16_t>> Drain(AudioSupplier &supplier)
+{
+	std::vector<std::vector<int16_t>> chunks;
+	const auto deadline = std::chrono::steady_clock::now() + std::chrono::seconds(10);
+	while(supplier.MaxChunks() && std::chrono::steady_clock::now() < deadline)
+	{
+		if(!supplier.AvailableChunks())
+		{
+			std::this_thread::sleep_for(std::chrono::milliseconds(1));
+			continue;
+		}
+		const auto chunk = supplier.NextDataChunk();
+		chunks.emplace_back(chunk.begin(), chunk.end());
+	}
+	return chunks;
+}
+// #endregion mock data
+
+
+
+// #region unit tests
+SCENARIO( "Decoding a FLAC stream that does not loop", "[FlacSupplier]" ) {
+	GIVEN( "a stream longer than the ring of output chunks" ) {
+		// About 5.4 output chunks, so the decoder has to wait for chunks to be taken,
+		// and the last one is only partly filled.
+		const auto samples = MakeSamples(20000);
+		FlacSupplier supplier(Encode(samples));
+		WHEN( "every chunk is taken" ) {
+			const auto chunks = Drain(supplier);
+			REQUIRE_FALSE( chunks.empty() );
+			const size_t chunkSize = chunks.front().size();
+			THEN( "every sample is in the output, followed by silence up to the end of the last chunk" ) {
+				CHECK( chunks.size() == (samples.size() + chunkSize - 1) / chunkSize );
+				std::vector<int16_t> output;
+				for(const auto &chunk : chunks)
+					output.insert(output.end(), chunk.begin(), chunk.end());
+				REQUIRE( output.size() >= samples.size() );
+				CHECK( std::vector<int16_t>(output.begin(), output.begin() + samples.size()) == samples );
+				CHECK( std::vector<int16_t>(output.begin() + samples.size(), output.end())
+					== std::vector<int16_t>(output.size() - samples.size(), 0) );
+				CHECK( supplier.MaxChunks() == 0 );
+			}
+		}
+	}
+	GIVEN( "a stream shorter than one output chunk" ) {
+		const auto samples = MakeSamples(1000);
+		FlacSupplier supplier(Encode(samples));
+		WHEN( "every chunk is taken" ) {
+			const auto chunks = Drain(supplier);
+			THEN( "the samples are in a single chunk that is padded with silence" ) {
+				REQUIRE( chunks.size() == 1 );
+				CHECK( std::vector<int16_t>(chunks[0].begin(), chunks[0].begin() + samples.size()) == samples );
+				CHECK( std::vector<int16_t>(chunks[0].begin() + samples.size(), chunks[0].end())
+					== std::vector<int16_t>(chunks[0].size() - samples.size(), 0) );
+			}
+		}
+	}
+}
+
+SCENARIO( "Destroying a FLAC supplier while it is decoding", "[FlacSupplier]" ) {
+	GIVEN( "a looping stream whose decoder is waiting for space in the ring" ) {
+		auto supplier = std::make_unique<FlacSupplier>(Encode(MakeSamples(20000)), true);
+		while(supplier->AvailableChunks() < 2)
+			std::this_thread::sleep_for(std::chrono::milliseconds(1));
+		supplier->NextDataChunk();
+		WHEN( "it is destroyed" ) {
+			supplier.reset();
+			THEN( "the decoder stops" ) {
+				CHECK_FALSE( supplier );
+			}
+		}
+	}
+}
+// #endregion unit tests
+
+
+
+} // test namespace
@@ -0,0 +1,75 @@
+/* test_frameTimer.cpp
+Copyright (c) 2026 by RisingLeaf
+
+Endless Sky is free software: you can redistribute it and/or modify it under the
+terms of the GNU General Public License as published by the Free Software
+Foundation, either version 3 of the License, or (at your option) any later version.
+
+Endless Sky is distributed in the hope that it will be useful, but WITHOUT ANY
+WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS FOR A
+PARTICULAR PURPOSE. See the GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License along with
+this program. If not, see <https://www.gnu.org/licenses/>.
+*/
+
+#include "es-test.hpp"
+
+// Include only the tested class's header.
+#include "../../../source/FrameTimer.h"
+
+// ... and any system includes needed for the test file.
+#include <chrono>
+
+namespace { // test namespace
+
+// #region mock data
+// Count how many times a 60 FPS timer is due in the given number of seconds,
+// if it is checked once for every frame drawn at the given refresh rate.
+int CountSteps(int refreshRate, int seconds)
+{
+	FrameTimer timer(60);
+	const auto start = std::chrono::steady_clock::now();
+	const auto frame = std::chrono::nanoseconds(1'000'000'000 / refreshRate);
+	int steps = 0;
+	for(int i = 0; i < refreshRate * seconds; ++i)
+		steps += timer.IsDue(start + i * frame);
+	return steps;
+}
+// #endregion mock data
+
+
+
+// #region unit tests
+SCENARIO( "Stepping the game when a frame timer is due", "[FrameTimer]" ) {
+	GIVEN( "a display that refreshes faster than the game steps" ) {
+		const int seconds = 10;
+		THEN( "the game steps 60 times per second at 75 Hz" ) {
+			CHECK_THAT( CountSteps(75, seconds), Catch::Matchers::WithinAbs(60 * seconds, 1) );
+		}
+		THEN( "the game steps 60 times per second at 100 Hz" ) {
+			CHECK_THAT( CountSteps(100, seconds), Catch::Matchers::WithinAbs(60 * seconds, 1) );
+		}
+		THEN( "the game steps 60 times per second at 144 Hz" ) {
+			CHECK_THAT( CountSteps(144, seconds), Catch::Matchers::WithinAbs(60 * seconds, 1) );
+		}
+	}
+	GIVEN( "a display that refreshes slower than the game steps" ) {
+		THEN( "the game steps once for every frame, without trying to catch up" ) {
+			CHECK_THAT( CountSteps(30, 10), Catch::Matchers::WithinAbs(300, 1) );
+		}
+	}
+	GIVEN( "a timer that has not been checked for a while" ) {
+		FrameTimer timer(60);
+		const auto later = std::chrono::steady_clock::now() + std::chrono::seconds(1);
+		THEN( "it is only due once" ) {
+			CHECK( timer.IsDue(later) );
+			CHECK_FALSE( timer.IsDue(later + std::chrono::milliseconds(1)) );
+		}
+	}
+}
+// #endregion unit tests
+
+
+
+} // test namespace
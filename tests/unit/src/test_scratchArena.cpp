@@ -0,0 +1,99 @@
+/* test_scratchArena.cpp
+Copyright (c) 2026 by RisingLeaf
+
+Endless Sky is free software: you can redistribute it and/or modify it under the
+terms of the GNU General Public License as published by the Free Software
+Foundation, either version 3 of the License, or (at your option) any later version.
+
+Endless Sky is distributed in the hope that it will be useful, but WITHOUT ANY
+WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS FOR A
+PARTICULAR PURPOSE. See the GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License along with
+this program. If not, see <https://www.gnu.org/licenses/>.
+*/
+
+#include "es-test.hpp"
+
+// Include only the tested class's header.
+#include "../../../source/ScratchArena.h"
+
+// ... and any system includes needed for the test file.
+#include <cstdint>
+#include <memory_resource>
+#include <vector>
+
+namespace { // test namespace
+
+// #region mock data
+class alignas(64) Aligned {
+public:
+	char data[64];
+};
+
+// Fill a vector in the arena the way a collision check would fill its results.
+std::size_t Fill(ScratchArena &arena, int count)
+{
+	std::pmr::vector<int> values(&arena);
+	for(int i = 0; i < count; ++i)
+		values.push_back(i);
+	std::size_t sum = 0;
+	for(int value : values)
+		sum += value;
+	return sum;
+}
+// #endregion mock data
+
+
+
+// #region unit tests
+SCENARIO( "Allocating temporary data from a scratch arena", "[ScratchArena]" ) {
+	GIVEN( "a new arena" ) {
+		ScratchArena arena;
+		REQUIRE( arena.Allocations() == 0 );
+		REQUIRE( arena.BytesUsed() == 0 );
+		REQUIRE( arena.Capacity() == 0 );
+
+		WHEN( "containers are filled from it" ) {
+			CHECK( Fill(arena, 1000) == 499500 );
+			THEN( "it counts the allocations" ) {
+				CHECK( arena.Allocations() > 0 );
+				CHECK( arena.BytesUsed() >= 1000 * sizeof(int) );
+				CHECK( arena.Capacity() >= arena.BytesUsed() );
+			}
+		}
+		WHEN( "over-aligned data is allocated" ) {
+			std::pmr::vector<Aligned> values(3, &arena);
+			THEN( "it is aligned correctly" ) {
+				CHECK( reinterpret_cast<std::uintptr_t>(values.data()) % alignof(Aligned) == 0 );
+			}
+		}
+	}
+	GIVEN( "an arena that has been used for a busy step" ) {
+		ScratchArena arena;
+		for(int i = 0; i < 100; ++i)
+			Fill(arena, 10000);
+		const std::size_t capacity = arena.Capacity();
+
+		WHEN( "it is reset" ) {
+			arena.Reset();
+			THEN( "its statistics start over, but it keeps its memory" ) {
+				CHECK( arena.Allocations() == 0 );
+				CHECK( arena.BytesUsed() == 0 );
+				CHECK( arena.Capacity() == capacity );
+			}
+			AND_WHEN( "the same step is repeated" ) {
+				for(int i = 0; i < 100; ++i)
+					Fill(arena, 10000);
+				THEN( "it does not need any more memory" ) {
+					CHECK( arena.Capacity() == capacity );
+				}
+			}
+		}
+	}
+}
+// #endregion unit tests
+
+
+
+} // test namespace
@@ -0,0 +1,206 @@
+/* test_shipIndex.cpp
+Copyright (c) 2026 by RisingLeaf
+
+Endless Sky is free software: you can redistribute it and/or modify it under the
+terms of the GNU General Public License as published by the Free Software
+Foundation, either version 3 of the License, or (at your option) any later version.
+
+Endless Sky is distributed in the hope that it will be useful, but WITHOUT ANY
+WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS FOR A
+PARTICULAR PURPOSE. See the GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License along with
+this program. If not, see <https://www.gnu.org/licenses/>.
+*/
+
+#include "es-test.hpp"
+
+// Include only the tested class's header.
+#include "../../../source/ShipIndex.h"
+
+// Include a helper for creating well-formed DataNodes (to enable loading governments).
+#include "datanode-factory.h"
+// Include a helper for scattering ships over the grid of the index.
+#include "ship-grid.h"
+
+// The ships and governments that go into the index.
+#include "../../../source/Government.h"
+#include "../../../source/Point.h"
+#include "../../../source/Ship.h"
+
+// ... and any system includes needed for the test file.
+#include <algorithm>
+#include <map>
+#include <memory>
+#include <memory_resource>
+#include <vector>
+
+namespace { // test namespace
+
+// #region mock data
+// Pirates are hostile to everyone, while merchants and militia get along.
+class Governments {
+public:
+	Governments()
+	{
+		pirate.Load(AsDataNode("government Pirate\n\t\"default attitude\" -1"), nullptr, nullptr);
+		merchant.Load(AsDataNode("government Merchant"), nullptr, nullptr);
+		militia.Load(AsDataNode("government Militia"), nullptr, nullptr);
+	}
+
+	Government pirate;
+	Government merchant;
+	Government militia;
+};
+
+// A system full of ships of all three governments, at random positions and drifting slowly.
+class Fleet {
+public:
+	Fleet(const Governments &governments, int count, double spread)
+		: ships(ShipsAt(RandomPoints(count, count, spread)))
+	{
+		const Government *const all[3] = {&governments.pirate, &governments.merchant, &governments.militia};
+		const std::vector<Point> velocities = RandomPoints(count + 1, count, spread * .001);
+		for(int i = 0; i < count; ++i)
+		{
+			ships[i]->SetGovernment(all[i % 3]);
+			ships[i]->SetVelocity(velocities[i]);
+			rosters[all[i % 3]].push_back(ships[i].get());
+		}
+		// The index goes through the rosters one government at a time.
+		for(const auto &it : rosters)
+			order.insert(order.end(), it.second.begin(), it.second.end());
+	}
+
+	std::vector<std::shared_ptr<Ship>> ships;
+	std::map<const Government *, std::vector<Ship *>> rosters;
+	std::vector<Ship *> order;
+};
+
+// The ships that are (or are not) enemies of the given ship, and closer to it than the
+// given range if there is one, in roster order.
+std::vector<Ship *> BruteForce(const Fleet &fleet, const Ship &ship, bool targetEnemies, double maxRange)
+{
+	return CheckEveryShip(fleet.order, [&ship, targetEnemies, maxRange](const Ship &other)
+		{
+			return ship.GetGovernment()->IsEnemy(other.GetGovernment()) == targetEnemies
+				&& (maxRange < 0. || ship.Position().Distance(other.Position()) < maxRange);
+		});
+}
+
+std::vector<Ship *> Radius(const ShipIndex &index, const Ship &ship, bool targetEnemies, double maxRange)
+{
+	std::pmr::vector<Ship *> result;
+	index.Radius(ship, targetEnemies, maxRange, result);
+	return AsVector(result);
+}
+
+std::vector<Ship *> Nearest(const ShipIndex &index, const Ship &ship, bool targetEnemies, size_t count,
+		double maxRange)
+{
+	std::pmr::vector<Ship *> result;
+	index.Nearest(ship, targetEnemies, count, maxRange, result);
+	return AsVector(result);
+}
+// #endregion mock data
+
+
+
+// #region unit tests
+SCENARIO( "Finding the ships within a radius", "[ShipIndex][Radius]" ) {
+	const Governments governments;
+	GIVEN( "ships spread over many times the size of the grid" ) {
+		const Fleet fleet(governments, 300, 6000.);
+		REQUIRE( fleet.ships.front()->IsTargetable() );
+		ShipIndex index(GRID_CELL_SIZE, GRID_CELL_COUNT);
+		index.Build(fleet.rosters);
+		THEN( "the same ships are found as by checking every ship, in roster order" ) {
+			// Ranges of 300 and 1000 search the grid, while the larger ones check every ship.
+			for(double maxRange : {300., 1000., 5000., -1.})
+				for(const auto &ship : fleet.ships)
+					for(bool targetEnemies : {true, false})
+					{
+						CHECK( Radius(index, *ship, targetEnemies, maxRange)
+							== BruteForce(fleet, *ship, targetEnemies, maxRange) );
+					}
+		}
+	}
+	GIVEN( "an index without any ships" ) {
+		const Fleet fleet(governments, 3, 100.);
+		ShipIndex index(GRID_CELL_SIZE, GRID_CELL_COUNT);
+		index.Build({});
+		THEN( "nothing is found" ) {
+			CHECK( Radius(index, *fleet.ships.front(), true, 300.).empty() );
+			CHECK( Radius(index, *fleet.ships.front(), false, -1.).empty() );
+		}
+	}
+	GIVEN( "an index with governments that have no ships" ) {
+		const Fleet fleet(governments, 3, 100.);
+		ShipIndex index(GRID_CELL_SIZE, GRID_CELL_COUNT);
+		index.Build({{&governments.pirate, {}}, {&governments.merchant, {}}});
+		THEN( "nothing is found" ) {
+			CHECK( Radius(index, *fleet.ships[0], true, 300.).empty() );
+			CHECK( Radius(index, *fleet.ships[1], false, -1.).empty() );
+		}
+	}
+}
+
+SCENARIO( "Finding the nearest ships", "[ShipIndex][Nearest]" ) {
+	const Governments governments;
+	GIVEN( "ships spread over many times the size of the grid" ) {
+		const Fleet fleet(governments, 300, 6000.);
+		ShipIndex index(GRID_CELL_SIZE, GRID_CELL_COUNT);
+		index.Build(fleet.rosters);
+		THEN( "the nearest ships are the same as found by checking every ship" ) {
+			for(double maxRange : {700., -1.})
+				for(size_t count : {1u, 5u, 400u})
+					for(const auto &ship : fleet.ships)
+						for(bool targetEnemies : {true, false})
+						{
+							// Ships that are equally far away are found in roster order.
+							auto expected = BruteForce(fleet, *ship, targetEnemies, maxRange);
+							const Point &position = ship->Position();
+							std::stable_sort(expected.begin(), expected.end(), [&position](const Ship *a, const Ship *b)
+								{ return position.Distance(a->Position()) < position.Distance(b->Position()); });
+							if(expected.size() > count)
+								expected.resize(count);
+							CHECK( Nearest(index, *ship, targetEnemies, count, maxRange) == expected );
+						}
+		}
+	}
+	GIVEN( "an index without any ships" ) {
+		const Fleet fleet(governments, 3, 100.);
+		ShipIndex index(GRID_CELL_SIZE, GRID_CELL_COUNT);
+		index.Build({});
+		THEN( "nothing is found" ) {
+			CHECK( Nearest(index, *fleet.ships.front(), true, 5, -1.).empty() );
+			CHECK( Nearest(index, *fleet.ships.front(), false, 5, 300.).empty() );
+		}
+	}
+}
+
+SCENARIO( "Finding the fastest ship", "[ShipIndex][MaxSpeed]" ) {
+	const Governments governments;
+	GIVEN( "a built index" ) {
+		const Fleet fleet(governments, 30, 1000.);
+		ShipIndex index(GRID_CELL_SIZE, GRID_CELL_COUNT);
+		index.Build(fleet.rosters);
+		THEN( "the fastest ship sets the maximum speed" ) {
+			double expected = 0.;
+			for(const auto &ship : fleet.ships)
+				expected = std::max(expected, ship->Velocity().Length());
+			CHECK( index.MaxSpeed() == expected );
+		}
+		WHEN( "it is rebuilt without any ships" ) {
+			index.Build({});
+			THEN( "the maximum speed is reset" ) {
+				CHECK( index.MaxSpeed() == 0. );
+			}
+		}
+	}
+}
+// #endregion unit tests
+
+
+
+} // test namespace
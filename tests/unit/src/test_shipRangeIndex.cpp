@@ -0,0 +1,167 @@
+/* test_shipRangeIndex.cpp
+Copyright (c) 2026 by RisingLeaf
+
+Endless Sky is free software: you can redistribute it and/or modify it under the
+terms of the GNU General Public License as published by the Free Software
+Foundation, either version 3 of the License, or (at your option) any later version.
+
+Endless Sky is distributed in the hope that it will be useful, but WITHOUT ANY
+WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS FOR A
+PARTICULAR PURPOSE. See the GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License along with
+this program. If not, see <https://www.gnu.org/licenses/>.
+*/
+
+#include "es-test.hpp"
+
+// Include only the tested class's header.
+#include "../../../source/ShipRangeIndex.h"
+
+// Include a helper for scattering ships over the grid of the index.
+#include "ship-grid.h"
+
+// The ships that go into the index.
+#include "../../../source/Point.h"
+#include "../../../source/Ship.h"
+
+// ... and any system includes needed for the test file.
+#include <map>
+#include <memory>
+#include <memory_resource>
+#include <random>
+#include <vector>
+
+namespace { // test namespace
+
+// #region mock data
+// Ships at random positions, each of which can reach anything within a random range of it.
+class Defenders {
+public:
+	Defenders(int count, double spread, double minRange, double maxRange)
+		: ships(ShipsAt(RandomPoints(count, count, spread)))
+	{
+		std::mt19937 generator(count);
+		std::uniform_real_distribution<double> range(minRange, maxRange);
+		for(const auto &ship : ships)
+		{
+			order.push_back(ship.get());
+			ranges[ship.get()] = range(generator);
+		}
+	}
+
+	void AddTo(ShipRangeIndex &index) const
+	{
+		index.Clear();
+		for(Ship *ship : order)
+			index.Add(ship, ranges.at(ship));
+		index.Finish();
+	}
+
+	// The ships whose range the point is in, in the order they were added to the index.
+	std::vector<Ship *> Reaching(const Point &point) const
+	{
+		return CheckEveryShip(order, [this, &point](const Ship &ship)
+			{ return point.Distance(ship.Position()) <= ranges.at(&ship); });
+	}
+
+	std::vector<std::shared_ptr<Ship>> ships;
+	std::vector<Ship *> order;
+	std::map<const Ship *, double> ranges;
+};
+
+std::vector<Ship *> Reaching(const ShipRangeIndex &index, const Point &point)
+{
+	std::pmr::vector<Ship *> result;
+	index.Reaching(point, result);
+	return AsVector(result);
+}
+
+// Points all over the area the ships are in, a little beyond the farthest ship, and the
+// positions of the ships themselves, which every ship with a range reaches.
+std::vector<Point> Targets(const Defenders &defenders, double spread)
+{
+	std::vector<Point> targets = RandomPoints(1, 500, spread);
+	for(const Ship *ship : defenders.order)
+		targets.push_back(ship->Position());
+	return targets;
+}
+// #endregion mock data
+
+
+
+// #region unit tests
+SCENARIO( "Finding the ships that can reach a point", "[ShipRangeIndex][Reaching]" ) {
+	ShipRangeIndex index(GRID_CELL_SIZE, GRID_CELL_COUNT);
+	GIVEN( "many ships with short ranges" ) {
+		// The longest range covers few enough grid cells that the grid is searched.
+		const Defenders defenders(400, 6000., 50., 300.);
+		defenders.AddTo(index);
+		THEN( "the same ships are found as by checking every ship, in the order they were added" ) {
+			for(const Point &point : Targets(defenders, 6500.))
+				CHECK( Reaching(index, point) == defenders.Reaching(point) );
+		}
+	}
+	GIVEN( "a few ships with long ranges" ) {
+		// The longest range covers more grid cells than there are ships, so every ship is checked.
+		const Defenders defenders(20, 3000., 500., 2000.);
+		defenders.AddTo(index);
+		THEN( "the same ships are found as by checking every ship, in the order they were added" ) {
+			for(const Point &point : Targets(defenders, 3500.))
+				CHECK( Reaching(index, point) == defenders.Reaching(point) );
+		}
+	}
+	GIVEN( "an index without any ships" ) {
+		index.Clear();
+		index.Finish();
+		THEN( "nothing is found" ) {
+			CHECK( Reaching(index, Point()).empty() );
+		}
+	}
+	GIVEN( "an index that is rebuilt with other ships" ) {
+		const Defenders first(400, 6000., 50., 300.);
+		const Defenders second(20, 3000., 500., 2000.);
+		first.AddTo(index);
+		second.AddTo(index);
+		THEN( "only the ships added since it was cleared are found" ) {
+			for(const Point &point : Targets(second, 3500.))
+				CHECK( Reaching(index, point) == second.Reaching(point) );
+		}
+	}
+}
+
+SCENARIO( "A point exactly at the range of a ship", "[ShipRangeIndex][Reaching]" ) {
+	ShipRangeIndex index(GRID_CELL_SIZE, GRID_CELL_COUNT);
+	auto ship = std::make_shared<Ship>();
+	ship->SetPosition(Point(10., -20.));
+	// This point is exactly 100 away from the ship, and the other is just beyond that.
+	const Point edge(70., 60.);
+	const Point beyond(70., 60.001);
+	GIVEN( "only that ship, so that every ship is checked" ) {
+		index.Clear();
+		index.Add(ship.get(), 100.);
+		index.Finish();
+		THEN( "the ship reaches the point at its range" ) {
+			CHECK( Reaching(index, edge) == std::vector<Ship *>{ship.get()} );
+			CHECK( Reaching(index, beyond).empty() );
+		}
+	}
+	GIVEN( "enough other ships far away that the grid is searched" ) {
+		const Defenders others(50, 6000., 1., 1.);
+		index.Clear();
+		index.Add(ship.get(), 100.);
+		for(Ship *other : others.order)
+			if(other->Position().Distance(edge) > others.ranges.at(other))
+				index.Add(other, others.ranges.at(other));
+		index.Finish();
+		THEN( "the ship reaches the point at its range" ) {
+			CHECK( Reaching(index, edge) == std::vector<Ship *>{ship.get()} );
+			CHECK( Reaching(index, beyond).empty() );
+		}
+	}
+}
+// #endregion unit tests
+
+
+
+} // test namespace
@@ -0,0 +1,254 @@
+/* test_turretSolver.cpp
+Copyright (c) 2026 by RisingLeaf
+
+Endless Sky is free software: you can redistribute it and/or modify it under the
+terms of the GNU General Public License as published by the Free Software
+Foundation, either version 3 of the License, or (at your option) any later version.
+
+Endless Sky is distributed in the hope that it will be useful, but WITHOUT ANY
+WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS FOR A
+PARTICULAR PURPOSE. See the GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License along with
+this program. If not, see <https://www.gnu.org/licenses/>.
+*/
+
+#include "es-test.hpp"
+
+// Include only the tested class's header.
+#include "../../../source/TurretSolver.h"
+
+// ... and any system includes needed for the test file.
+#include <algorithm>
+#include <cmath>
+#include <random>
+#include <tuple>
+#include <vector>
+
+namespace { // test namespace
+
+// #region mock data
+class Scenario {
+public:
+	explicit Scenario(unsigned seed) : engine(seed) {}
+
+	double Real(double low, double high) { return std::uniform_real_distribution<double>(low, high)(engine); }
+	Point RandomPoint(double range) { return Point(Real(-range, range), Real(-range, range)); }
+
+	// Fill the solver with targets scattered around the origin.
+	void AddTargets(TurretSolver &solver, int count)
+	{
+		solver.Clear(RandomPoint(8.));
+		for(int i = 0; i < count; ++i)
+			solver.Add(RandomPoint(3000.), RandomPoint(12.));
+	}
+
+	TurretSolver::Turret RandomTurret()
+	{
+		TurretSolver::Turret turret;
+		turret.start = RandomPoint(100.);
+		turret.aim = Angle(Real(-180., 180.));
+		turret.isOmnidirectional = Real(0., 1.) < .5;
+		turret.minArc = turret.aim - Angle(Real(10., 90.));
+		turret.maxArc = turret.aim + Angle(Real(10., 90.));
+		turret.turnRate = Real(.5, 6.);
+		turret.velocity = Real(2., 40.);
+		// Some weapons are beams, which hit instantaneously.
+		turret.lifetime = Real(0., 1.) < .2 ? 1. : Real(20., 200.);
+		turret.hasAcceleration = Real(0., 1.) < .3;
+		return turret;
+	}
+
+private:
+	std::mt19937 engine;
+};
+
+// How close a projectile fired from the turret along its current aim comes to the given
+// target, found with the same math as Mask::Collide() uses.
+double ClosestApproach(const TurretSolver::Turret &turret, const Point &shipVelocity, const Point &position,
+		const Point &velocity)
+{
+	Point v = velocity;
+	if(!turret.hasAcceleration)
+		v -= shipVelocity;
+	const Point p = position - turret.start + v;
+	const Point path = (turret.aim.Unit() * turret.velocity - v) * turret.lifetime;
+	// The closest point to the target along the path, relative to the target.
+	const Point start = -p;
+	const double length = path.LengthSquared();
+	const double along = length > 0. ? std::clamp(path.Dot(p) / length, 0., 1.) : 0.;
+	return (start + path * along).Length();
+}
+// #endregion mock data
+
+
+
+// #region unit tests
+SCENARIO( "Aiming a turret at a list of targets", "[TurretSolver]" ) {
+	GIVEN( "no targets" ) {
+		TurretSolver solver;
+		solver.Clear(Point());
+		REQUIRE( solver.IsEmpty() );
+		THEN( "no target is chosen" ) {
+			const auto result = solver.Aim(TurretSolver::Turret());
+			CHECK( result.target == -1 );
+			CHECK( result.degrees == 0. );
+		}
+	}
+	GIVEN( "a single stationary target in front of a turret" ) {
+		TurretSolver solver;
+		solver.Clear(Point());
+		solver.Add(Point(0., -500.), Point());
+		TurretSolver::Turret turret;
+		turret.velocity = 10.;
+		turret.lifetime = 100.;
+		THEN( "the turret does not need to turn" ) {
+			const auto result = solver.Aim(turret);
+			CHECK( result.target == 0 );
+			CHECK_THAT( result.degrees, Catch::Matchers::WithinAbs(0., 0.0001) );
+		}
+	}
+	GIVEN( "a target behind a turret with a limited arc" ) {
+		TurretSolver solver;
+		solver.Clear(Point());
+		solver.Add(Point(0., 500.), Point());
+		TurretSolver::Turret turret;
+		turret.isOmnidirectional = false;
+		turret.minArc = Angle(-45.);
+		turret.maxArc = Angle(45.);
+		turret.velocity = 10.;
+		turret.lifetime = 100.;
+		THEN( "the turret turns only up to the edge of its arc" ) {
+			const auto result = solver.Aim(turret);
+			CHECK( result.target == 0 );
+			CHECK_THAT( std::abs(result.degrees), Catch::Matchers::WithinAbs(45., 0.0001) );
+		}
+	}
+	GIVEN( "a beam turret with one target in range and one beyond it" ) {
+		TurretSolver solver;
+		solver.Clear(Point());
+		solver.Add(Point(0., -700.), Point());
+		solver.Add(Point(0., -500.), Point());
+		TurretSolver::Turret turret;
+		turret.velocity = 600.;
+		turret.lifetime = 1.;
+		THEN( "the target in range is hit right away" ) {
+			const auto result = solver.Aim(turret);
+			CHECK( result.target == 1 );
+			CHECK_THAT( result.score, Catch::Matchers::WithinAbs(0., 0.0001) );
+			CHECK_THAT( result.score, Catch::Matchers::WithinAbs(solver.AimEach(turret).score, 0.0001) );
+		}
+	}
+	GIVEN( "many random turrets and targets" ) {
+		Scenario scenario(1234u);
+		TurretSolver solver;
+		THEN( "the solver agrees with checking each target in turn" ) {
+			for(int round = 0; round < 50; ++round)
+			{
+				scenario.AddTargets(solver, 1 + round * 3);
+				for(int i = 0; i < 20; ++i)
+				{
+					const TurretSolver::Turret turret = scenario.RandomTurret();
+					const auto result = solver.Aim(turret);
+					const auto expected = solver.AimEach(turret);
+					// If two targets are equally good, either may be chosen.
+					CHECK_THAT( result.score, Catch::Matchers::WithinRel(expected.score, 1e-9) );
+					if(result.target == expected.target)
+						CHECK_THAT( result.degrees, Catch::Matchers::WithinAbs(expected.degrees, 1e-6) );
+				}
+			}
+		}
+	}
+}
+
+SCENARIO( "Finding the targets in a weapon's line of fire", "[TurretSolver]" ) {
+	GIVEN( "a gun pointing at one of two targets" ) {
+		TurretSolver solver;
+		solver.Clear(Point());
+		solver.Add(Point(300., 0.), Point(), 20.);
+		solver.Add(Point(0., -300.), Point(), 20.);
+		TurretSolver::Turret turret;
+		turret.velocity = 10.;
+		turret.lifetime = 100.;
+		THEN( "only the target it is pointing at is found" ) {
+			std::vector<int> indices;
+			solver.InLineOfFire(turret, indices);
+			CHECK( indices == std::vector<int>{1} );
+		}
+		WHEN( "its projectiles do not live long enough to reach the target" ) {
+			turret.lifetime = 20.;
+			THEN( "no target is found" ) {
+				std::vector<int> indices;
+				solver.InLineOfFire(turret, indices);
+				CHECK( indices.empty() );
+			}
+		}
+	}
+	GIVEN( "many random guns and targets" ) {
+		Scenario scenario(4321u);
+		TurretSolver solver;
+		THEN( "every target the projectiles pass within the radius of is found, and nothing far beyond it" ) {
+			for(int round = 0; round < 30; ++round)
+			{
+				const Point shipVelocity = scenario.RandomPoint(8.);
+				solver.Clear(shipVelocity);
+				std::vector<std::tuple<Point, Point, double>> targets;
+				for(int i = 0; i < 1 + round * 5; ++i)
+				{
+					targets.emplace_back(scenario.RandomPoint(1500.), scenario.RandomPoint(12.),
+						scenario.Real(10., 200.));
+					solver.Add(std::get<0>(targets.back()), std::get<1>(targets.back()), std::get<2>(targets.back()));
+				}
+				for(int i = 0; i < 20; ++i)
+				{
+					const TurretSolver::Turret turret = scenario.RandomTurret();
+					std::vector<int> indices;
+					solver.InLineOfFire(turret, indices);
+					std::vector<int> expected;
+					for(int j = 0; j < static_cast<int>(targets.size()); ++j)
+					{
+						const auto &[position, velocity, radius] = targets[j];
+						const double distance = ClosestApproach(turret, shipVelocity, position, velocity);
+						if(distance <= radius)
+							expected.push_back(j);
+						else if(distance > radius + 1.001)
+							CHECK( std::find(indices.begin(), indices.end(), j) == indices.end() );
+					}
+					CHECK( std::includes(indices.begin(), indices.end(), expected.begin(), expected.end()) );
+					CHECK( std::is_sorted(indices.begin(), indices.end()) );
+				}
+			}
+		}
+	}
+}
+// #endregion unit tests
+
+// #region benchmarks
+#ifdef CATCH_CONFIG_ENABLE_BENCHMARKING
+TEST_CASE( "Benchmark TurretSolver::Aim", "[!benchmark][TurretSolver]" ) {
+	Scenario scenario(42u);
+	TurretSolver solver;
+	scenario.AddTargets(solver, 150);
+	std::vector<TurretSolver::Turret> turrets;
+	for(int i = 0; i < 20; ++i)
+		turrets.push_back(scenario.RandomTurret());
+
+	BENCHMARK( "TurretSolver::Aim()" ) {
+		double total = 0.;
+		for(const auto &turret : turrets)
+			total += solver.Aim(turret).degrees;
+		return total;
+	};
+	BENCHMARK( "TurretSolver::AimEach()" ) {
+		double total = 0.;
+		for(const auto &turret : turrets)
+			total += solver.AimEach(turret).degrees;
+		return total;
+	};
+}
+#endif
+// #endregion benchmarks
+
+
+
+} // test namespace
@@ -0,0 +1,125 @@
+/* test_visual.cpp
+Copyright (c) 2026 by RisingLeaf
+
+Endless Sky is free software: you can redistribute it and/or modify it under the
+terms of the GNU General Public License as published by the Free Software
+Foundation, either version 3 of the License, or (at your option) any later version.
+
+Endless Sky is distributed in the hope that it will be useful, but WITHOUT ANY
+WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS FOR A
+PARTICULAR PURPOSE. See the GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License along with
+this program. If not, see <https://www.gnu.org/licenses/>.
+*/
+
+#include "es-test.hpp"
+
+// Include only the tested class's header.
+#include "../../../source/Visual.h"
+
+// ... and any system includes needed for the test file.
+#include <tuple>
+#include <vector>
+
+namespace { // test namespace
+
+// #region mock data
+// A visual that can be set up and moved without an Effect, the way visuals
+// were moved every step before they were drawn from their records.
+class TestVisual : public Visual {
+public:
+	TestVisual(Point position, Point velocity, Angle facing, double invisible = 0., double visible = 0.)
+	{
+		this->position = position;
+		this->velocity = velocity;
+		this->angle = facing;
+		distanceInvisible = invisible;
+		distanceVisible = visible;
+	}
+
+	void Move() { position += velocity; }
+	void SetAnimation(float framesPerSecond, int pausedSteps)
+	{
+		SetFrameRate(framesPerSecond);
+		for(int i = 0; i < pausedSteps; ++i)
+			PauseAnimation();
+	}
+};
+// #endregion mock data
+
+
+
+// #region unit tests
+SCENARIO( "Drawing a visual from its record", "[Visual]" ) {
+	GIVEN( "a visual that moves away from the view and fades with its distance" ) {
+		const Point center(0., 0.);
+		TestVisual visual(Point(30., 40.), Point(3., 4.), Angle(30.), 200., 100.);
+		const int spawnStep = 10;
+		const Visual::Record record = visual.GetRecord(spawnStep);
+
+		THEN( "the record gives the same position, facing and alpha as moving the visual" ) {
+			for(int step = spawnStep; step < spawnStep + 60; ++step)
+			{
+				CHECK_THAT( record.Position(step).X(), Catch::Matchers::WithinAbs(visual.Position().X(), 0.001) );
+				CHECK_THAT( record.Position(step).Y(), Catch::Matchers::WithinAbs(visual.Position().Y(), 0.001) );
+				CHECK_THAT( record.Facing(step).Degrees(),
+					Catch::Matchers::WithinAbs(visual.Facing().Degrees(), 0.001) );
+				CHECK_THAT( record.Alpha(step, center), Catch::Matchers::WithinAbs(visual.Alpha(center), 0.0001) );
+				visual.Move();
+			}
+		}
+		THEN( "it fades out completely once it is far enough away" ) {
+			CHECK( record.Alpha(spawnStep, center) == 1. );
+			CHECK( record.Alpha(spawnStep + 25, center) > 0. );
+			CHECK( record.Alpha(spawnStep + 25, center) < 1. );
+			CHECK( record.Alpha(spawnStep + 40, center) == 0. );
+		}
+		THEN( "a visual with no lifetime is only drawn at the step it was created" ) {
+			CHECK( record.IsAlive(spawnStep) );
+			CHECK_FALSE( record.IsAlive(spawnStep + 1) );
+		}
+	}
+	GIVEN( "a visual that does not fade with its distance" ) {
+		TestVisual visual(Point(), Point(100., 0.), Angle());
+		const Visual::Record record = visual.GetRecord(0);
+		THEN( "it is drawn at full alpha wherever it is" ) {
+			CHECK( record.Alpha(0, Point()) == 1. );
+			CHECK( record.Alpha(1000, Point()) == 1. );
+		}
+	}
+}
+
+SCENARIO( "Animating a visual from its record", "[Visual]" ) {
+	GIVEN( "a visual whose animation was paused" ) {
+		TestVisual visual(Point(), Point(), Angle(0.));
+		const int pausedSteps = 7;
+		visual.SetAnimation(30.f, pausedSteps);
+		const int spawnStep = 20;
+		const Visual::Record record = visual.GetRecord(spawnStep);
+
+		THEN( "the animation starts as many frames late as it was paused for" ) {
+			// At 30 frames per second, the animation advances half a frame per step, and the
+			// 7 paused steps put it 3.5 frames behind: frame = (step / 2 - 3.5) % frames.
+			const std::vector<std::tuple<int, float, float>> expected = {
+				{20, 1.f, 0.f},
+				{20, 4.f, 2.5f},
+				{21, 4.f, 3.f},
+				{22, 4.f, 3.5f},
+				{23, 4.f, 0.f},
+				{30, 4.f, 3.5f},
+				{20, 9.f, 6.5f},
+				{24, 9.f, 8.5f},
+				{25, 9.f, 0.f},
+				{27, 9.f, 1.f},
+			};
+			for(const auto &[step, frames, frame] : expected)
+				CHECK_THAT( record.Frame(step, frames), Catch::Matchers::WithinAbs(frame, 0.0001) );
+		}
+	}
+}
+// #endregion unit tests
+
+
+
+} // test namespace
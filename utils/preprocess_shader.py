@@ -57,9 +57,14 @@ has_comp_shader = new_shader_code.find("CS_BEGIN") != -1
 
 ubo_vars     = []
 v_in_vars    = []
+i_in_vars    = []
 v_out_vars   = []
+v_flat_vars  = []
 c_in_objects = []
+c_buffers    = []
 textures     = []
+# The number of invocations per work group of the compute shader.
+local_size   = 1
 
 def resolve_argument_line(to_list, identifier, in_line):
     pos = in_line.find(identifier)
@@ -109,13 +114,29 @@ def get_compute_texture_type(in_type):
         print(f"ERROR: unknown texture type: {in_type}, defaulting to 2D")
         return "image2D"
 
+def resolve_local_size_line(in_line):
+    global local_size
+    pos = in_line.find("cs_local_size")
+    if pos > -1:
+        ids = in_line[pos:in_line.find(";")].split()
+        if len(ids) != 2 or not ids[1].isdigit():
+            print(f"ERROR: wrong usage of cs_local_size: {in_line}")
+        else:
+            local_size = int(ids[1])
+        return True
+    return False
+
 pruned_code = ""
 
 for line in new_shader_code.split("\n"):
-    if  (  resolve_argument_line(ubo_vars,         "u_in",       line)
+    if  (  resolve_local_size_line(line)
+            or resolve_argument_line(ubo_vars,     "u_in",       line)
             or resolve_argument_line(v_in_vars,    "v_in",       line)
+            or resolve_argument_line(i_in_vars,    "i_in",       line)
             or resolve_argument_line(v_out_vars,   "v_out",      line)
+            or resolve_argument_line(v_flat_vars,  "v_flat",     line)
             or resolve_argument_line(c_in_objects, "cs_in",      line)
+            or resolve_argument_line(c_buffers,    "cs_buffer",  line)
             or resolve_texture_line( textures,     "in_texture", line) ):
         continue
     pruned_code += line + "\n"
@@ -132,18 +153,29 @@ v_in_struct = ""
 for var in v_in_vars:
     v_in_struct += f"layout(location={v_in_num_elem}) in {var[0]} {var[1]};\n"
     v_in_num_elem += 1
+# Per instance inputs follow the per vertex ones.
+for var in i_in_vars:
+    v_in_struct += f"layout(location={v_in_num_elem}) in {var[0]} {var[1]};\n"
+    v_in_num_elem += 1
 
 v_out_num_elem = 0
 v_out_struct = ""
 for var in v_out_vars:
     v_out_struct += f"layout(location={v_out_num_elem}) out {var[0]} {var[1]};\n"
     v_out_num_elem += 1
+# Flat outputs are not interpolated, every fragment gets the value of the provoking vertex.
+for var in v_flat_vars:
+    v_out_struct += f"layout(location={v_out_num_elem}) flat out {var[0]} {var[1]};\n"
+    v_out_num_elem += 1
 
 f_in_num_elem = 0
 f_in_struct = ""
 for var in v_out_vars:
     f_in_struct += f"layout(location={f_in_num_elem}) in {var[0]} {var[1]};\n"
     f_in_num_elem += 1
+for var in v_flat_vars:
+    f_in_struct += f"layout(location={f_in_num_elem}) flat in {var[0]} {var[1]};\n"
+    f_in_num_elem += 1
 
 textures_input_layout = ""
 texture_counter       = 0
@@ -180,12 +212,17 @@ fs_end_replacement = "}"
 cs_begin_replacement  = "void main()\n"
 cs_begin_replacement += "{\n"
 
-cs_header             = "layout(local_size_x = 1, local_size_y = 1, local_size_z = 1) in;\n"
+cs_header             = f"layout(local_size_x = {local_size}, local_size_y = 1, local_size_z = 1) in;\n"
 if len(c_in_objects) > 0:
     tex_id = 0
     for c_in_object in c_in_objects:
         cs_header += f"layout(rgba8, set = 0, binding = {tex_id}) uniform {get_compute_texture_type(c_in_object[0])} {c_in_object[1]};\n"
         tex_id += 1
+# Storage buffers take the place of the textures.
+buffer_id = 0
+for c_buffer in c_buffers:
+    cs_header += f"layout(std430, set = 2, binding = {buffer_id}) buffer {c_buffer[1]}_buffer {{ {c_buffer[0]} {c_buffer[1]}[]; }};\n"
+    buffer_id += 1
 
 ##### CREATE CS_END replacement
 cs_end_replacement = "}"
@@ -49,8 +49,11 @@ for line in shader_code.split("\n"):
 
 ubo_vars      = []
 v_in_vars     = []
+i_in_vars     = []
 v_out_vars    = []
+v_flat_vars   = []
 c_in_objects  = []
+c_buffers     = []
 textures      = []
 
 def resolve_argument_line(to_list, identifier, in_line):
@@ -93,10 +96,16 @@ def get_texture_type(in_type):
 pruned_code = ""
 
 for line in new_shader_code.split("\n"):
+    # The size of a thread group is chosen when dispatching.
+    if line.find("cs_local_size") > -1:
+        continue
     if  (  resolve_argument_line(ubo_vars,      "u_in",       line)
         or resolve_argument_line(v_in_vars,     "v_in",       line)
+        or resolve_argument_line(i_in_vars,     "i_in",       line)
         or resolve_argument_line(v_out_vars,    "v_out",      line)
+        or resolve_argument_line(v_flat_vars,   "v_flat",     line)
         or resolve_argument_line(c_in_objects,  "cs_in",      line)
+        or resolve_argument_line(c_buffers,     "cs_buffer",  line)
         or resolve_texture_line( textures,      "in_texture", line)):
         continue
     pruned_code += line + "\n"
@@ -108,7 +117,8 @@ spec_struct += "};\n"
 
 v_in_num_elem = 0
 v_in_struct = "struct InVert {\n"
-for var in v_in_vars:
+# Per instance inputs follow the per vertex ones.
+for var in v_in_vars + i_in_vars:
     v_in_struct += f"  {var[0]} {var[1]}[[attribute({v_in_num_elem})]];\n"
     v_in_num_elem += 1
 v_in_struct += "};\n"
@@ -118,6 +128,8 @@ v_out_struct += "  float4 gl_Position[[position]];\n"
 v_out_struct += "  float  gl_PointSize[[point_size]];\n"
 for var in v_out_vars:
     v_out_struct += f"  {var[0]} {var[1]};\n"
+for var in v_flat_vars:
+    v_out_struct += f"  {var[0]} {var[1]} [[flat]];\n"
 v_out_struct += "};\n"
 
 ##### CREATE VS_BEGIN replacement
@@ -140,12 +152,12 @@ vs_begin_replacement += ")"\
                         "{\n"
 
 vs_begin_replacement += "  OutVert out;\n"
-for var in v_in_vars:
+for var in v_in_vars + i_in_vars:
     vs_begin_replacement += f"  {var[0]} {var[1]} = in_data.{var[1]};\n"
 
 
 vs_begin_replacement += f"  float4 gl_Position;\n"
-for var in v_out_vars:
+for var in v_out_vars + v_flat_vars:
     vs_begin_replacement += f"  {var[0]} {var[1]};\n"
 
 new_shader_code = pruned_code.replace("VS_BEGIN", vs_begin_replacement)
@@ -153,7 +165,7 @@ new_shader_code = pruned_code.replace("VS_BEGIN", vs_begin_replacement)
 ##### CREATE VS_END replacement
 vs_end_replacement  = "  out.gl_Position = gl_Position;\n"
 vs_end_replacement += "  out.gl_PointSize = 2.;\n"
-for var in v_out_vars:
+for var in v_out_vars + v_flat_vars:
     vs_end_replacement += f"  out.{var[1]} = {var[1]};\n"
 vs_end_replacement += "  return out;\n"
 vs_end_replacement += "}\n"
@@ -174,7 +186,7 @@ for tex in textures:
     texture_counter      += 1
 fs_begin_replacement     += ")\n{\n"
 fs_begin_replacement     += "  float4 out_color;\n"
-for var in v_out_vars:
+for var in v_out_vars + v_flat_vars:
     fs_begin_replacement += f"  {var[0]} {var[1]} = in.{var[1]};\n"
 
 
@@ -186,12 +198,22 @@ new_shader_code    = new_shader_code.replace("FS_END", fs_end_replacement)
 
 
 ## COMPUTE
-cs_begin_replacement = "kernel void kernel_main(uint3 gl_GlobalInvocationID [[thread_position_in_grid]]"
+cs_begin_replacement = ""
+# Without a vertex shader, nothing else declares the uniforms.
+if new_shader_code.find("VS_BEGIN") == -1 and len(c_buffers) > 0:
+    cs_begin_replacement += spec_struct
+cs_begin_replacement += "kernel void kernel_main(uint3 gl_GlobalInvocationID [[thread_position_in_grid]]"
 if len(c_in_objects) > 0:
     tex_id = 0
     for c_in_object in c_in_objects:
         cs_begin_replacement += ",texture" + c_in_object[0] + "<float, access::write> " + c_in_object[1] + "[[texture(" + str(tex_id) + ")]]"
         tex_id += 1
+if len(c_buffers) > 0:
+    cs_begin_replacement += ", constant const SpecUBO *in_spec [[buffer(0)]]"
+    buffer_id = 1
+    for c_buffer in c_buffers:
+        cs_begin_replacement += f", device {c_buffer[0]} *{c_buffer[1]} [[buffer({buffer_id})]]"
+        buffer_id += 1
 cs_begin_replacement += "){\n"
 
 new_shader_code = new_shader_code.replace("CS_BEGIN", cs_begin_replacement)
@@ -221,6 +243,7 @@ header += "//Math functions\n"
 header += "template<typename A, typename B> A atan(A x, B y) { return atan2(x, y); }\n"
 header += "template<typename A> A fwidth(A x) { return abs(dfdx(x)) + abs(dfdy(x)); }\n"
 header += "int mod(int x, int y) { return x % y; }\n"
+header += "#define floatBitsToInt(x) as_type<int>(x)\n"
 header += "#define M_PI 3.1415926535897932384626433832795\n"
 header += "\n"
 header += "//Texture stuff\n"